@@ -0,0 +1,17 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_CONTRIB
+    
+
+// Module headers:
+#include "average.h"
+#include "config-store.h"
+#include "delay-jitter-estimation.h"
+#include "event-garbage-collector.h"
+#include "file-config.h"
+#include "flow-id-tag.h"
+#include "gnuplot.h"
+#endif
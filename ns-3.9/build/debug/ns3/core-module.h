@@ -0,0 +1,57 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_CORE
+    
+
+// Module headers:
+#include "abort.h"
+#include "assert.h"
+#include "attribute-accessor-helper.h"
+#include "attribute-helper.h"
+#include "attribute-list.h"
+#include "attribute.h"
+#include "boolean.h"
+#include "breakpoint.h"
+#include "callback.h"
+#include "command-line.h"
+#include "config.h"
+#include "default-deleter.h"
+#include "deprecated.h"
+#include "double.h"
+#include "empty.h"
+#include "enum.h"
+#include "fatal-error.h"
+#include "fatal-impl.h"
+#include "global-value.h"
+#include "int-to-type.h"
+#include "integer.h"
+#include "log.h"
+#include "names.h"
+#include "object-base.h"
+#include "object-factory.h"
+#include "object-vector.h"
+#include "object.h"
+#include "pointer.h"
+#include "ptr.h"
+#include "random-variable.h"
+#include "ref-count-base.h"
+#include "rng-stream.h"
+#include "simple-ref-count.h"
+#include "string.h"
+#include "system-condition.h"
+#include "system-mutex.h"
+#include "system-thread.h"
+#include "system-wall-clock-ms.h"
+#include "test.h"
+#include "trace-source-accessor.h"
+#include "traced-callback.h"
+#include "traced-value.h"
+#include "type-id.h"
+#include "type-name.h"
+#include "type-traits.h"
+#include "uinteger.h"
+#include "vector.h"
+#endif
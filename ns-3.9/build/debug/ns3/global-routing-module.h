@@ -0,0 +1,13 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_GLOBAL_ROUTING
+    
+
+// Module headers:
+#include "global-route-manager.h"
+#include "global-router-interface.h"
+#include "ipv4-global-routing.h"
+#endif
@@ -0,0 +1,14 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_OLSR
+    
+
+// Module headers:
+#include "olsr-header.h"
+#include "olsr-repositories.h"
+#include "olsr-routing-protocol.h"
+#include "olsr-state.h"
+#endif
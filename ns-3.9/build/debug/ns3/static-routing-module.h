@@ -0,0 +1,14 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_STATIC_ROUTING
+    
+
+// Module headers:
+#include "ipv4-routing-table-entry.h"
+#include "ipv4-static-routing.h"
+#include "ipv6-routing-table-entry.h"
+#include "ipv6-static-routing.h"
+#endif
@@ -0,0 +1,14 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_UDP_CLIENT_SERVER
+    
+
+// Module headers:
+#include "packet-loss-counter.h"
+#include "udp-client.h"
+#include "udp-server.h"
+#include "udp-trace-client.h"
+#endif
@@ -0,0 +1,92 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Daniel Halperin <dhalperi@cs.washington.edu>
+ */
+
+#ifndef ANTENNA_H
+#define ANTENNA_H
+
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+
+/**
+ * \brief Antenna functionality for wireless devices
+ *
+ */
+class Antenna : public Object
+{
+
+public:
+  static TypeId GetTypeId (void);
+
+  Antenna ();
+  virtual ~Antenna ();
+
+  virtual double GetTxGainDbi (double azimuth, double elevation) const = 0;
+  virtual double GetRxGainDbi (double azimuth, double elevation) const = 0;
+
+  /**
+   * \returns the highest gain (dBi) this antenna can provide in any
+   * direction, in its current configuration.
+   *
+   * Used by channels to bound the distance over which a transmission
+   * can still be heard.
+   */
+  virtual double GetMaxGainDbi (void) const = 0;
+
+  /**
+   * \param azimuth the azimuth angles of n directions
+   * \param elevation the elevation angles of n directions
+   * \param gainDbi receives the n gains (dBi)
+   * \param n the number of directions
+   *
+   * Batch forms of GetTxGainDbi and GetRxGainDbi, used by channels to
+   * evaluate a whole set of receivers in a single pass. The default
+   * implementations invoke the scalar forms for each direction.
+   */
+  virtual void GetTxGainDbiBatch (const double *azimuth, const double *elevation,
+                                  double *gainDbi, uint32_t n) const;
+  virtual void GetRxGainDbiBatch (const double *azimuth, const double *elevation,
+                                  double *gainDbi, uint32_t n) const;
+
+  /**
+   * \param azimuth the azimuth angle (XY-plane) to point at, in radians
+   * \param elevation the elevation angle (Z-plane) to point at, in radians
+   *
+   * Points the main lobe of the antenna in the given direction, with a
+   * single pattern change notification. Antennas which cannot be
+   * steered, such as the default implementation, ignore it.
+   */
+  virtual void Steer (double azimuth, double elevation);
+
+protected:
+  /**
+   * Must be invoked by subclasses whenever the orientation or the
+   * radiation pattern of the antenna changes, to notify listeners.
+   */
+  void NotifyPatternChange (void) const;
+
+private:
+  TracedCallback<Ptr<const Antenna> > m_patternChangeTrace;
+};
+
+} // namespace ns3
+
+#endif /* ANTENNA_H */
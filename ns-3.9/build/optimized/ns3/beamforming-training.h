@@ -0,0 +1,119 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef BEAMFORMING_TRAINING_H
+#define BEAMFORMING_TRAINING_H
+
+#include <map>
+#include <utility>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "ns3/traced-callback.h"
+#include "wifi-mode.h"
+
+namespace ns3 {
+
+class YansWifiPhy;
+class SectorCodebook;
+
+/**
+ * \brief Sector level sweep between pairs of 60 GHz PHYs
+ *
+ * Modelled on the 802.11ad sector level sweep. The initiator sends one
+ * SSW frame per sector of its codebook (the initiator sector sweep),
+ * then the responder does the same while the initiator listens on the
+ * best sector found (the responder sector sweep), and the exchange ends
+ * with an SSW-Feedback and an SSW-Ack frame. All these frames are sent
+ * on the air through YansWifiPhy::SendPacket, so the training takes
+ * airtime and can be disturbed by other transmissions.
+ *
+ * The antennas modelled here have no quasi-omni pattern: during the
+ * initiator sweep, the responder listens on one of its sectors, and
+ * moves on to the next one until it hears the initiator.
+ *
+ * The codebook of a PHY is the SectorCodebook aggregated to its
+ * antenna; a default one is aggregated if there is none. The best
+ * sectors of each trained pair are cached, and a later Train of the
+ * same pair steers the antennas without any sweep until the entry
+ * expires.
+ */
+class BeamformingTraining : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  BeamformingTraining ();
+  virtual ~BeamformingTraining ();
+
+  /**
+   * Invoked at the end of a training, with true if both antennas are
+   * now steered at each other.
+   */
+  typedef Callback<void, bool> DoneCallback;
+
+  /**
+   * \param initiator the PHY which starts the sweep
+   * \param responder the PHY it trains with, on the same channel
+   * \param done invoked at the end of the training, may be null
+   */
+  void Train (Ptr<YansWifiPhy> initiator, Ptr<YansWifiPhy> responder, DoneCallback done);
+
+  /**
+   * \param a one PHY of the pair
+   * \param b the other PHY of the pair
+   * \param sectorA receives the best sector of a towards b
+   * \param sectorB receives the best sector of b towards a
+   * \returns true if the pair has a valid cache entry.
+   */
+  bool Lookup (Ptr<const YansWifiPhy> a, Ptr<const YansWifiPhy> b,
+               uint32_t *sectorA, uint32_t *sectorB) const;
+  void Forget (Ptr<const YansWifiPhy> a, Ptr<const YansWifiPhy> b);
+  void ForgetAll (void);
+
+  /**
+   * \returns the codebook of the antenna of the PHY.
+   */
+  static Ptr<SectorCodebook> GetCodebook (Ptr<YansWifiPhy> phy);
+
+private:
+  class Session;
+  friend class Session;
+  struct CacheEntry
+  {
+    uint32_t initiatorSector;
+    uint32_t responderSector;
+    Time learnt;
+  };
+  typedef std::pair<Ptr<const YansWifiPhy>, Ptr<const YansWifiPhy> > Pair;
+  typedef std::map<Pair, struct CacheEntry> Cache;
+
+  virtual void DoDispose (void);
+  void Learn (Ptr<const YansWifiPhy> initiator, Ptr<const YansWifiPhy> responder,
+              uint32_t initiatorSector, uint32_t responderSector);
+  void NotifyDone (Ptr<const YansWifiPhy> initiator, Ptr<const YansWifiPhy> responder,
+                   Time duration, bool success, DoneCallback done);
+
+  WifiMode m_mode;
+  Time m_spacing;
+  Time m_cacheTimeout;
+  uint8_t m_txPowerLevel;
+  Cache m_cache;
+  TracedCallback<Ptr<const YansWifiPhy>, Ptr<const YansWifiPhy>, Time, bool> m_trainingTrace;
+};
+
+} // namespace ns3
+
+#endif /* BEAMFORMING_TRAINING_H */
@@ -0,0 +1,44 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_COMMON
+    
+
+// Module headers:
+#include "antenna.h"
+#include "buffer.h"
+#include "byte-tag-list.h"
+#include "chunk.h"
+#include "cone-antenna.h"
+#include "cost231-propagation-loss-model.h"
+#include "data-rate.h"
+#include "error-model.h"
+#include "friis-spectrum-propagation-loss.h"
+#include "header.h"
+#include "isotropic-antenna.h"
+#include "jakes-propagation-loss-model.h"
+#include "measured-2d-antenna.h"
+#include "nix-vector.h"
+#include "omni-antenna.h"
+#include "output-stream-wrapper.h"
+#include "packet-burst.h"
+#include "packet-metadata.h"
+#include "packet-tag-list.h"
+#include "packet.h"
+#include "pcap-file-wrapper.h"
+#include "pcap-file.h"
+#include "propagation-delay-model.h"
+#include "propagation-loss-model.h"
+#include "sequence-number.h"
+#include "sgi-hashmap.h"
+#include "spectrum-converter.h"
+#include "spectrum-model.h"
+#include "spectrum-propagation-loss-model.h"
+#include "spectrum-type.h"
+#include "spectrum-value.h"
+#include "tag-buffer.h"
+#include "tag.h"
+#include "trailer.h"
+#endif
@@ -0,0 +1,9 @@
+/* Configuration header created by Waf - do not edit */
+#ifndef _NS3_CORE_CONFIG_H_WAF
+#define _NS3_CORE_CONFIG_H_WAF
+
+#define HAVE_STDLIB_H 1
+#define HAVE_GETENV 1
+#define HAVE_SIGNAL_H 1
+#define HAVE_PTHREAD_H 1
+#endif /* _NS3_CORE_CONFIG_H_WAF */
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: George Riley <riley@ece.gatech.edu>
+ */
+
+#ifndef DISTRIBUTED_SIMULATOR_IMPL_H
+#define DISTRIBUTED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/ptr.h"
+#include "mpi-interface.h"
+
+#include <list>
+
+namespace ns3 {
+
+/**
+ * \brief distributed simulator implementation using lookahead
+ *
+ * Each rank runs the events of its nodes up to the time it was granted,
+ * the lower bound on the timestamp of the next event anywhere (LBTS)
+ * plus the lookahead, the smallest delay of the links between ranks. The
+ * LBTS is computed in rounds, each a pair of non-blocking all-reductions:
+ * the minimum of the timestamps of the next events of the ranks, and the
+ * sums of the packets they sent and received, which must be equal for
+ * the minimum to hold, as no packet is then in flight. A rank starts a
+ * round as soon as the last one is over, after it has received the
+ * packets arrived and sent those of the round before, in one message
+ * per rank, and runs its events while the round goes on; it only waits
+ * for a round when it has run all the events it was granted.
+ *
+ * A rank which has stopped, or has run out of events, takes part in the
+ * rounds until all the ranks have, and no packet is left in flight.
+ */
+class DistributedSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  DistributedSimulatorImpl ();
+  ~DistributedSimulatorImpl ();
+
+  // virtual from SimulatorImpl
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual Time Next (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &time);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual void RunOneEvent (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+private:
+  virtual void DoDispose (void);
+  void CalculateLookAhead (void);
+
+  void ProcessOneEvent (void);
+  uint64_t NextTs (void) const;
+  // start a round of the LBTS computation
+  void StartLbts (void);
+  // complete the round if it is over, or wait for it to be if wait is true
+  void TestLbts (bool wait);
+  typedef std::list<EventId> DestroyEvents;
+
+  DestroyEvents m_destroyEvents;
+  bool m_stop;
+  Ptr<Scheduler> m_events;
+  uint32_t m_uid;
+  uint32_t m_currentUid;
+  uint64_t m_currentTs;
+  uint32_t m_currentContext;
+  // number of events that have been inserted but not yet scheduled,
+  // not counting the "destroy" events; this is used for validation
+  int m_unscheduledEvents;
+
+  uint32_t     m_myId;        // MPI Rank
+  uint32_t     m_systemCount; // MPI Size
+  Time         m_grantedTime; // Last LBTS plus the lookahead
+  static Time  m_lookAhead;   // Lookahead value
+
+  // the round of the LBTS computation in progress: the timestamp of the
+  // next event of this rank and the smallest of all, and the packets sent
+  // and received by this rank and by all
+  bool         m_lbtsPending;
+  uint64_t     m_lbtsTs[2];
+  uint64_t     m_lbtsCounts[4];
+  MPI_Request  m_lbtsRequests[2];
+  // true once all the ranks have stopped or run out of events
+  bool         m_finished;
+
+};
+
+} // namespace ns3
+
+#endif /* DISTRIBUTED_SIMULATOR_IMPL_H */
@@ -0,0 +1,19 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_ENERGY
+    
+
+// Module headers:
+#include "basic-energy-source-helper.h"
+#include "basic-energy-source.h"
+#include "device-energy-model-container.h"
+#include "device-energy-model.h"
+#include "energy-model-helper.h"
+#include "energy-source-container.h"
+#include "energy-source.h"
+#include "wifi-radio-energy-model-helper.h"
+#include "wifi-radio-energy-model.h"
+#endif
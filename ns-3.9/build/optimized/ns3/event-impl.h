@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef EVENT_IMPL_H
+#define EVENT_IMPL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief a simulation event
+ *
+ * Each subclass of this base class represents a simulation event. The
+ * EventImpl::Invoke method will be invoked by the simulation engine
+ * when the time associated to this event expires. This class is
+ * obviously (there are Ref and Unref methods) reference-counted and
+ * most subclasses are usually created by one of the many Simulator::Schedule
+ * methods.
+ */
+class EventImpl : public SimpleRefCount<EventImpl>
+{
+public:
+  /**
+   * The counters of the event allocator of a thread.
+   */
+  struct PoolCounters
+  {
+    // the events allocated
+    uint64_t allocations;
+    // those of them which took the memory of an event gone
+    uint64_t recycled;
+    // the events freed by other threads and given back to this one
+    uint64_t returned;
+    // the memory taken from the system for events
+    uint64_t chunkBytes;
+  };
+
+  EventImpl ();
+  virtual ~EventImpl () = 0;
+  /**
+   * Called by the simulation engine to notify the event that it has expired.
+   */
+  void Invoke (void);
+  /**
+   * Marks the event as 'canceled'. The event will not be removed from
+   * the event list but the simulation engine will check its canceled status
+   * before calling Invoke.
+   */
+  void Cancel (void);
+  /**
+   * \returns true if the event has been canceled.
+   *
+   * Invoked by the simulation engine before calling Invoke.
+   */
+  bool IsCancelled (void);
+
+  /**
+   * The events are allocated by the thread which creates them, from free
+   * lists of a few classes of sizes, which grow by chunks of memory and
+   * never shrink: once a simulation has reached its steady state,
+   * scheduling and running an event calls neither malloc nor free.
+   *
+   * Every block records the pool it came from. An event deleted by
+   * another thread, as when a partition of a parallel simulator runs an
+   * event made by another, is handed back to that pool without a lock and
+   * reused by its owner. The pool of a thread which exits is kept, with
+   * the events it still has out, for the next thread which starts.
+   * The events larger than the largest class are left to malloc.
+   */
+  static void *operator new (size_t size);
+  static void operator delete (void *p, size_t size);
+  /**
+   * \returns the counters of the event allocator of the calling thread
+   */
+  static PoolCounters GetPoolCounters (void);
+
+protected:
+  virtual void Notify (void) = 0;
+
+private:
+  bool m_cancel;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_IMPL_H */
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef FLYWAY_CHANNEL_ASSIGNER_H
+#define FLYWAY_CHANNEL_ASSIGNER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/object-factory.h"
+#include "ns3/attribute.h"
+#include "ns3/random-variable.h"
+
+namespace ns3 {
+
+class FlywaysTopoHelper;
+class FlywayFeasibilityEngine;
+class FlywayChannelAssigner;
+
+/**
+ * \brief a way to give channels to the flyways pending in a
+ *        FlywayChannelAssigner.
+ */
+class FlywayChannelStrategy : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual ~FlywayChannelStrategy ();
+
+  /**
+   * \param assigner the assigner whose pending flyways need a channel
+   * \param commit true if the flyways are kept once placed, false if the
+   *        assignment is only evaluated and will be undone
+   * \returns true if every pending flyway has been placed and the whole
+   *          set of flyways is feasible.
+   *
+   * On failure, the assigner undoes whatever the strategy placed.
+   */
+  virtual bool Assign (FlywayChannelAssigner *assigner, bool commit) = 0;
+};
+
+/**
+ * \brief place the pending flyways one at a time, in order, on the first
+ *        channel that keeps the set feasible.
+ *
+ * The channels are tried round robin, starting one channel further for
+ * every flyway kept.
+ */
+class GreedyFlywayChannelStrategy : public FlywayChannelStrategy
+{
+public:
+  static TypeId GetTypeId (void);
+  GreedyFlywayChannelStrategy ();
+  virtual bool Assign (FlywayChannelAssigner *assigner, bool commit);
+
+private:
+  uint32_t m_next;
+};
+
+/**
+ * \brief DSatur colouring of the conflict graph of the pending flyways.
+ *
+ * Flyways which share a node conflict, as a node has a single dongle on
+ * each channel. The flyway left with the fewest usable channels is placed
+ * first, ties broken by the number of pending flyways it conflicts with,
+ * on the usable channel which gives the highest total rate.
+ */
+class DsaturFlywayChannelStrategy : public FlywayChannelStrategy
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual bool Assign (FlywayChannelAssigner *assigner, bool commit);
+};
+
+/**
+ * \brief simulated annealing over the channels of the pending flyways.
+ *
+ * Starts from the first usable channel of every flyway, then repeatedly
+ * moves one flyway to another usable channel. The cost of an assignment
+ * is the number of infeasible flyways times InfeasiblePenalty, less the
+ * total rate. Moves which lower the cost are kept, others with
+ * probability exp (-delta / temperature). The best assignment seen wins.
+ */
+class AnnealingFlywayChannelStrategy : public FlywayChannelStrategy
+{
+public:
+  static TypeId GetTypeId (void);
+  AnnealingFlywayChannelStrategy ();
+  virtual bool Assign (FlywayChannelAssigner *assigner, bool commit);
+
+private:
+  double Cost (FlywayChannelAssigner *assigner) const;
+
+  uint32_t m_iterations;
+  double m_initialTemperature;
+  double m_cooling;
+  double m_infeasiblePenalty;
+  UniformVariable m_random;
+};
+
+/**
+ * \brief give channels and dongles to flyways so that they are feasible
+ *        together.
+ *
+ * A node has a single dongle on each channel, so two flyways which share
+ * a node must use different channels. Any number of channels and of
+ * dongles per node is supported. The flyways kept so far live in the
+ * FlywayFeasibilityEngine, in the same order as here.
+ *
+ * A batch of flyways is either added for good with Add, or only checked
+ * with Check, which leaves the assigner as it was. Both steer the dongles
+ * of the batch at each other, give a dongle to the ends which have none,
+ * and let the strategy choose the channels.
+ */
+class FlywayChannelAssigner
+{
+public:
+  struct Flyway
+  {
+    uint32_t from;
+    int32_t dongleFrom;
+    uint32_t to;
+    int32_t dongleTo;
+    int32_t channel;
+  };
+  /**
+   * Why the last batch could not be assigned.
+   */
+  enum Failure
+  {
+    NONE,
+    SAME_ENDPOINTS,
+    NO_FREE_DONGLE,
+    NO_FREE_CHANNEL,
+    TOO_WEAK,
+    INFEASIBLE
+  };
+
+  /**
+   * \param topo the topology whose dongles carry the flyways
+   * \param engine the engine which decides feasibility. It must be
+   *        empty, and only this assigner may add flyways to it.
+   *
+   * The strategy defaults to ns3::GreedyFlywayChannelStrategy, with
+   * three channels.
+   */
+  FlywayChannelAssigner (FlywaysTopoHelper *topo, FlywayFeasibilityEngine *engine);
+
+  /**
+   * \param n the number of channels. Only while no flyway is kept.
+   */
+  void SetNumChannels (uint32_t n);
+  uint32_t GetNumChannels (void) const;
+  /**
+   * \param type the type of FlywayChannelStrategy to use
+   *
+   * The other parameters set the attributes of the strategy.
+   */
+  void SetStrategy (std::string type,
+                    std::string n0 = "", const AttributeValue &v0 = EmptyAttributeValue (),
+                    std::string n1 = "", const AttributeValue &v1 = EmptyAttributeValue (),
+                    std::string n2 = "", const AttributeValue &v2 = EmptyAttributeValue (),
+                    std::string n3 = "", const AttributeValue &v3 = EmptyAttributeValue ());
+  Ptr<FlywayChannelStrategy> GetStrategy (void) const;
+
+  /**
+   * \param batch the flyways to add. A dongle of -1 asks for the lowest
+   *        free dongle of the node; the channels are ignored.
+   * \returns true if the whole batch was added. Otherwise nothing was.
+   */
+  bool Add (const std::vector<struct Flyway> &batch);
+  /**
+   * \param batch the flyways to check, as for Add
+   * \param assignment if not null, the flyways kept followed by the
+   *        batch in its own order, with their dongles and channels,
+   *        when feasible
+   * \param rates if not null, the rate of every flyway of assignment,
+   *        in the same order
+   * \returns true if the batch could be added
+   */
+  bool Check (const std::vector<struct Flyway> &batch,
+              std::vector<struct Flyway> *assignment, std::vector<double> *rates);
+  /**
+   * \returns why the last Add or Check failed
+   */
+  enum Failure GetFailure (void) const;
+  void Clear (void);
+  /**
+   * \returns the number of flyways kept
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param i a flyway kept. The flyways of a batch are kept in the
+   *        order the strategy placed them, which may not be theirs.
+   */
+  const struct Flyway &Get (uint32_t i) const;
+  /**
+   * \param rates the rate of every flyway kept
+   * \returns true if they are all feasible
+   */
+  bool GetRates (std::vector<double> *rates) const;
+
+  /**
+   * \name Used by the strategies
+   *
+   * The flyways of the batch being assigned are pending until placed on
+   * a channel. Placed flyways come last in the engine, in the order they
+   * were placed.
+   */
+  //\{
+  uint32_t GetNPending (void) const;
+  const struct Flyway &GetPending (uint32_t j) const;
+  /**
+   * \returns true if neither end of pending flyway j uses channel yet
+   */
+  bool IsFree (uint32_t j, uint32_t channel) const;
+  void Place (uint32_t j, uint32_t channel);
+  void Unplace (uint32_t j);
+  bool IsFeasible (void) const;
+  /**
+   * \param infeasible the number of flyways which are not feasible
+   * \returns the total rate of the feasible flyways
+   */
+  double Evaluate (uint32_t *infeasible) const;
+  //\}
+
+private:
+  bool Run (const std::vector<struct Flyway> &batch, bool commit,
+            std::vector<struct Flyway> *assignment, std::vector<double> *rates);
+  bool Prepare (void);
+  uint32_t FindPlaced (uint32_t j) const;
+  int32_t FindFreeDongle (uint32_t node) const;
+  void Release (void);
+
+  FlywaysTopoHelper *m_topo;
+  FlywayFeasibilityEngine *m_engine;
+  uint32_t m_numChannels;
+  ObjectFactory m_strategyFactory;
+  Ptr<FlywayChannelStrategy> m_strategy;
+  // the flyways in the engine, in its order
+  std::vector<struct Flyway> m_flyways;
+  std::vector<struct Flyway> m_pending;
+  // the pending dongles given by Prepare
+  std::vector<std::pair<uint32_t, int32_t> > m_allocated;
+  // for each node, which channels and dongles are in use
+  std::vector<std::vector<bool> > m_busyChannels;
+  std::vector<std::vector<bool> > m_busyDongles;
+  enum Failure m_failure;
+};
+
+} // namespace ns3
+
+#endif /* FLYWAY_CHANNEL_ASSIGNER_H */
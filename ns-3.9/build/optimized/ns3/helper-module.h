@@ -0,0 +1,59 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_HELPER
+    
+
+// Module headers:
+#include "adhoc-aloha-noack-ideal-phy-helper.h"
+#include "animation-interface.h"
+#include "aodv-helper.h"
+#include "application-container.h"
+#include "athstats-helper.h"
+#include "bridge-helper.h"
+#include "canvas-location.h"
+#include "csma-helper.h"
+#include "csma-star-helper.h"
+#include "emu-helper.h"
+#include "flow-monitor-helper.h"
+#include "flyways-topo-helper.h"
+#include "internet-stack-helper.h"
+#include "ipv4-address-helper.h"
+#include "ipv4-global-routing-helper.h"
+#include "ipv4-interface-container.h"
+#include "ipv4-list-routing-helper.h"
+#include "ipv4-routing-helper.h"
+#include "ipv4-static-routing-helper.h"
+#include "ipv6-address-helper.h"
+#include "ipv6-interface-container.h"
+#include "ipv6-list-routing-helper.h"
+#include "ipv6-routing-helper.h"
+#include "ipv6-static-routing-helper.h"
+#include "mobility-helper.h"
+#include "net-device-container.h"
+#include "node-container.h"
+#include "nqos-wifi-mac-helper.h"
+#include "ns2-mobility-helper.h"
+#include "olsr-helper.h"
+#include "on-off-helper.h"
+#include "packet-sink-helper.h"
+#include "packet-socket-helper.h"
+#include "point-to-point-dumbbell-helper.h"
+#include "point-to-point-grid-helper.h"
+#include "point-to-point-helper.h"
+#include "point-to-point-star-helper.h"
+#include "qos-wifi-mac-helper.h"
+#include "spectrum-analyzer-helper.h"
+#include "spectrum-helper.h"
+#include "tap-bridge-helper.h"
+#include "topology-reader-helper.h"
+#include "trace-helper.h"
+#include "udp-client-server-helper.h"
+#include "udp-echo-helper.h"
+#include "v4ping-helper.h"
+#include "waveform-generator-helper.h"
+#include "wifi-helper.h"
+#include "yans-wifi-helper.h"
+#endif
@@ -0,0 +1,210 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef INTERFERENCE_HELPER_H
+#define INTERFERENCE_HELPER_H
+
+#include <stdint.h>
+#include <vector>
+#include <list>
+#include <map>
+#include <utility>
+#include "wifi-mode.h"
+#include "wifi-preamble.h"
+#include "wifi-phy-standard.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+class ErrorRateModel;
+
+class InterferenceHelper
+{
+public:
+  class Event : public SimpleRefCount<InterferenceHelper::Event>
+  {
+  public:
+    Event (uint32_t size, WifiMode payloadMode, 
+	     enum WifiPreamble preamble,
+	     Time duration, double rxPower);
+    ~Event ();
+  
+    Time GetDuration (void) const;
+    Time GetStartTime (void) const;
+    Time GetEndTime (void) const;
+    double GetRxPowerW (void) const;
+    uint32_t GetSize (void) const;
+    WifiMode GetPayloadMode (void) const;
+    enum WifiPreamble GetPreambleType (void) const;
+  private:
+    uint32_t m_size;
+    WifiMode m_payloadMode;
+    enum WifiPreamble m_preamble;
+    Time m_startTime;
+    Time m_endTime;
+    double m_rxPowerW;
+  };
+  struct SnrPer 
+  {
+    double snr;
+    double per;
+  };
+
+  InterferenceHelper ();
+  ~InterferenceHelper ();
+
+  void SetNoiseFigure (double value);
+  void SetErrorRateModel (Ptr<ErrorRateModel> rate);
+
+  double GetNoiseFigure (void) const;
+  Ptr<ErrorRateModel> GetErrorRateModel (void) const;
+
+
+  /**
+   * \param energyW the minimum energy (W) requested
+   * \returns the expected amount of time the observed 
+   *          energy on the medium will be higher than
+   *          the requested threshold.
+   */
+  Time GetEnergyDuration (double energyW);
+
+  
+  static WifiMode GetPlcpHeaderMode (WifiMode payloadMode, WifiPreamble preamble);
+  static uint32_t GetPlcpHeaderDurationNanoSeconds (WifiMode payloadMode, WifiPreamble preamble);
+  static uint32_t GetPlcpPreambleDurationNanoSeconds (WifiMode mode, WifiPreamble preamble);
+  /**
+   * \param size the size of the payload (bytes)
+   * \param payloadMode the mode used to transmit the payload
+   * \returns the duration of the payload (ns)
+   *
+   * Uses per-mode integer coefficients computed the first time a mode
+   * is seen, so that the duration is a handful of integer divisions.
+   * Falls back to CalculatePayloadDurationNanoSeconds for DSSS modes
+   * and whenever SlowdownFactor is not 1.
+   */
+  static uint32_t GetPayloadDurationNanoSeconds (uint32_t size, WifiMode payloadMode);
+  /**
+   * \param size the size of the payload (bytes)
+   * \param payloadMode the mode used to transmit the payload
+   * \returns the duration of the payload (ns), evaluated with the
+   *          floating point formulas of the standard.
+   */
+  static uint32_t CalculatePayloadDurationNanoSeconds (uint32_t size, WifiMode payloadMode);
+  static double SlowdownFactor;
+  static Time CalculateTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamble preamble);
+  Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiMode payloadMode, 
+				      enum WifiPreamble preamble,
+				      Time duration, double rxPower);
+
+  /**
+   * \param duration the duration of the signal
+   * \param rxPowerW the power of the signal (W)
+   *
+   * Adds the energy of a signal which will never be received to the
+   * background noise, rather than tracking it as an interference event.
+   * The background noise is sampled when a reception starts and is
+   * assumed constant until it ends, but GetEnergyDuration accounts for
+   * the end of each background signal.
+   */
+  void AddBackgroundNoise (Time duration, double rxPowerW);
+
+  struct InterferenceHelper::SnrPer CalculateSnrPer (Ptr<InterferenceHelper::Event> event);
+  void NotifyRxStart ();
+  void NotifyRxEnd ();
+  void EraseEvents (void); 
+private:
+  class NiChange {
+  public:
+    NiChange (Time time, double delta);
+    Time GetTime (void) const;
+    double GetDelta (void) const;
+    bool operator < (const NiChange& o) const;
+  private:
+    Time m_time;
+    double m_delta;
+  };
+  typedef std::vector <NiChange> NiChanges;
+  /**
+   * The pending noise and interference changes, by time. Changes at the
+   * same time keep their insertion order.
+   */
+  typedef std::multimap<Time, double> NiChangeStore;
+  typedef std::list<Ptr<Event> > Events;
+  /// the power of the background signals, by end time
+  typedef std::multimap<Time, double> BackgroundSignals;
+
+  /**
+   * The payload duration of a mode, in integer form:
+   * codedBits = ceil ((8 * size + extraBits) * codeRateNum / codeRateDen),
+   * codewords = ceil (codedBits / codewordBits),
+   * blocks = ceil (codewords * codewordBits / bitsPerBlock) and
+   * duration = ceil (blocks * blockNumNs / blockDenNs).
+   * bitsPerBlock is zero when the mode has no integer form.
+   */
+  struct PayloadCoefficients
+  {
+    uint32_t extraBits;
+    uint32_t codeRateNum;
+    uint32_t codeRateDen;
+    uint32_t codewordBits;
+    uint32_t bitsPerBlock;
+    uint32_t blockNumNs;
+    uint32_t blockDenNs;
+  };
+  typedef std::vector<struct PayloadCoefficients> PayloadCoefficientsList;
+
+  static struct PayloadCoefficients GetPayloadCoefficients (WifiMode payloadMode);
+  static struct PayloadCoefficients ComputePayloadCoefficients (WifiMode payloadMode);
+  static PayloadCoefficientsList ComputeAllPayloadCoefficients (void);
+
+  InterferenceHelper (const InterferenceHelper &o);
+  InterferenceHelper &operator = (const InterferenceHelper &o);
+  void AppendEvent (Ptr<Event> event);
+  double CalculateSnr (double signal, double noiseInterference, WifiMode mode) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateChunkSuccessRate (double snir, Time delay, WifiMode mode) const;
+  double CalculatePer (Ptr<const Event> event, NiChanges *ni) const;
+  double GetBackgroundNoiseW (void);
+
+  double m_noiseFigure; /**< noise figure (linear) */
+  Ptr<ErrorRateModel> m_errorRateModel;
+  ///Experimental: needed for energy duration calculation
+  NiChangeStore m_niChanges;
+  double m_firstPower;
+  bool m_rxing;
+  /**
+   * First change not earlier than the last time the cursor was moved to,
+   * and m_firstPower plus the changes before it. Time only moves forward,
+   * so the changes of the past are summed only once.
+   */
+  NiChangeStore::iterator m_cursor;
+  double m_cursorPower;
+  /// signals folded into the background noise, by end time
+  BackgroundSignals m_background;
+  double m_backgroundW;
+  /// background noise at the start of the current reception
+  double m_rxBackgroundW;
+  void AddNiChangeEvent (NiChange change);
+  void MoveCursor (Time moment);
+};
+
+} // namespace ns3
+
+#endif /* INTERFERENCE_HELPER_H */
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This scheduler is the ladder queue of W. T. Tang, R. S. M. Goh and
+ * I. L.-J. Thng, "Ladder Queue: An O(1) Priority Queue Structure for
+ * Large-Scale Discrete Event Simulation", ACM TOMACS 15(3), 2005. The
+ * events are kept in three tiers:
+ *   - the top, an unsorted list of the events far in the future,
+ *   - the rungs, up to eight arrays of unsorted buckets, each rung
+ *     splitting one bucket of the rung above into finer ones,
+ *   - the bottom, a short sorted list of the next events.
+ *
+ * The next event is always taken from the bottom. When the bottom runs
+ * dry, the first non-empty bucket of the lowest rung is sorted into it,
+ * unless it holds too many events, in which case it is spread over a new
+ * rung first; when there are no rungs left, the top is spread over a
+ * new first rung sized from its own number of events and range of
+ * timestamps. The buckets thus adapt to the distribution of the
+ * timestamps without the resizing of the CalendarScheduler, and a burst
+ * of events a few nanoseconds apart costs no more than events spread
+ * over seconds.
+ *
+ * Remove looks for the event in the one bucket or list which would
+ * receive it if it were inserted again.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  enum {
+    // the events a bucket may send to the bottom at once, unsplit
+    THRESHOLD = 50,
+    MAX_RUNGS = 8
+  };
+  typedef std::vector<Event> Bucket;
+  struct Rung
+  {
+    uint64_t start;
+    uint64_t width;
+    // the first bucket not yet sent down
+    uint32_t current;
+    uint32_t nBuckets;
+    uint32_t count;
+    std::vector<Bucket> buckets;
+  };
+
+  // the lowest timestamp a rung still takes
+  static uint64_t GetCurrentTs (const Rung &rung);
+  // spread events over a new lowest rung, from start up to end
+  void SpawnRung (const Bucket &events, uint64_t start, uint64_t end);
+  // fill the empty bottom from the rungs or from the top
+  void Refill (void);
+  void InsertBottom (const Event &ev);
+  void RemoveBottom (const Event &ev);
+  static void RemoveFrom (Bucket &bucket, const Event &ev);
+
+  Bucket m_top;
+  uint64_t m_topStart;
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  std::vector<Rung> m_rungs;
+  uint32_t m_nRungs;
+  // sorted; the events before m_bottomHead are gone already
+  Bucket m_bottom;
+  uint32_t m_bottomHead;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -0,0 +1,103 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Daniel Halperin <dhalperi@cs.washington.edu>
+ */
+
+#ifndef M2D_ANTENNA_H
+#define M2D_ANTENNA_H
+
+#include "ns3/antenna.h"
+#include "ns3/vector.h"
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Antenna functionality for wireless devices
+ *
+ * The azimuth pattern is given as a list of measured (angle, gain) points,
+ * either one of the built-in patterns selected by the Mode attribute or one
+ * read from the file named by the PatternFile attribute.  Whenever the
+ * pattern changes it is resampled every 0.1 degree, and the measured points
+ * are kept as breakpoints of their own so that the gain at each of them is
+ * the measured one.  A lookup indexes the 0.1 degree cell of the angle and
+ * interpolates linearly between the breakpoints around it.
+ */
+class Measured2DAntenna : public Antenna
+{
+
+public:
+  static TypeId GetTypeId (void);
+
+  Measured2DAntenna ();
+  ~Measured2DAntenna ();
+
+  double GetTxGainDbi (double azimuth, double elevation) const;
+  double GetRxGainDbi (double azimuth, double elevation) const;
+  double GetMaxGainDbi (void) const;
+  void GetTxGainDbiBatch (const double *azimuth, const double *elevation,
+                          double *gainDbi, uint32_t n) const;
+  void GetRxGainDbiBatch (const double *azimuth, const double *elevation,
+                          double *gainDbi, uint32_t n) const;
+
+  double GetAzimuthAngle (void) const;
+  void SetAzimuthAngle (double azimuth);
+
+  double GetElevationAngle (void) const;
+  void SetElevationAngle (double elevation);
+
+  void Steer (double azimuth, double elevation);
+
+  double GetBeamwidth (void) const;
+  void SetBeamwidth (double beamwidth);
+
+  double GetMode (void) const;
+  void SetMode (double);
+
+  std::string GetPatternFile (void) const;
+  void SetPatternFile (std::string filename);
+
+private:
+  Measured2DAntenna (const Measured2DAntenna &o);
+  Measured2DAntenna & operator = (const Measured2DAntenna &o);
+
+  double GetGain(double angle) const;
+  double InterpolateMeasurements(double angle) const;
+  void SetPattern(const double pattern[][2], unsigned int n, double offset);
+  void CompileTable(void);
+
+  double m_mode;
+  std::string m_patternFile;
+  double m_maxGainDbi;
+  double m_verticalBeamwidth;
+  double m_elevation;
+  double m_azimuth;
+  std::vector<double> m_angles;
+  std::vector<double> m_gains;
+  // breakpoints of the compiled pattern, over [0, 2*pi] radians
+  std::vector<double> m_breakAngles;
+  std::vector<double> m_breakGains;
+  std::vector<double> m_breakSlopes;
+  // the last breakpoint at or before the start of each 0.1 degree cell
+  std::vector<uint32_t> m_cells;
+};
+
+}; // namespace ns3
+
+#endif /* M2D_ANTENNA_H */
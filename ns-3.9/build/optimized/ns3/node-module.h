@@ -0,0 +1,59 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_NODE
+    
+
+// Module headers:
+#include "address-utils.h"
+#include "address.h"
+#include "application.h"
+#include "channel-list.h"
+#include "channel.h"
+#include "drop-tail-queue.h"
+#include "ethernet-header.h"
+#include "ethernet-trailer.h"
+#include "inet-socket-address.h"
+#include "inet6-socket-address.h"
+#include "ipv4-address-generator.h"
+#include "ipv4-address.h"
+#include "ipv4-header.h"
+#include "ipv4-interface-address.h"
+#include "ipv4-packet-info-tag.h"
+#include "ipv4-raw-socket-factory.h"
+#include "ipv4-route.h"
+#include "ipv4-routing-protocol.h"
+#include "ipv4.h"
+#include "ipv6-address.h"
+#include "ipv6-header.h"
+#include "ipv6-interface-address.h"
+#include "ipv6-packet-info-tag.h"
+#include "ipv6-raw-socket-factory.h"
+#include "ipv6-route.h"
+#include "ipv6-routing-protocol.h"
+#include "ipv6.h"
+#include "llc-snap-header.h"
+#include "mac48-address.h"
+#include "mac64-address.h"
+#include "net-device.h"
+#include "node-list.h"
+#include "node.h"
+#include "packet-socket-address.h"
+#include "packet-socket-factory.h"
+#include "packetbb.h"
+#include "phy-mac.h"
+#include "queue.h"
+#include "radiotap-header.h"
+#include "simple-channel.h"
+#include "simple-net-device.h"
+#include "socket-factory.h"
+#include "socket.h"
+#include "spectrum-channel.h"
+#include "spectrum-phy.h"
+#include "tcp-socket-factory.h"
+#include "tcp-socket.h"
+#include "udp-socket-factory.h"
+#include "udp-socket.h"
+#endif
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef NODE_PARTITIONER_H
+#define NODE_PARTITIONER_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+class FlywayTopologyPlan;
+
+/**
+ * \brief split the nodes of a network into the partitions of a parallel
+ *        run, the system ids of the nodes.
+ *
+ * The network is a graph of nodes and links, each link with its delay
+ * and the traffic expected on it, and of groups of coupled nodes, which
+ * must share a partition: the nodes of a shared medium such as a wifi
+ * channel, which no parallel simulator may cut. The graph is either
+ * described node by node, before the nodes exist, so that they can be
+ * created with their system id, or read from the channels of the nodes
+ * already created.
+ *
+ * The smallest delay of the links cut is the lookahead of the run, which
+ * bounds the time the partitions may run ahead of each other, and comes
+ * first: the partitioner looks for the largest delay d for which the
+ * nodes joined by the links shorter than d still fit in balanced
+ * partitions, and keeps these links uncut. Among the partitions with
+ * that lookahead, it looks for one which cuts little traffic, by growing
+ * the partitions one at a time from their heaviest node along the links
+ * of most traffic, and then moving the nodes on the boundary for as long
+ * as this lowers the traffic cut without unbalancing the partitions.
+ *
+ * A partition may weigh up to 1 + imbalance times the average weight,
+ * except where coupled nodes alone weigh more.
+ */
+class NodePartitioner
+{
+public:
+  NodePartitioner ();
+
+  /**
+   * \param imbalance how much heavier than the average a partition may be,
+   *        0.1 by default
+   */
+  void SetImbalance (double imbalance);
+  /**
+   * \param nNodes the number of nodes of the graph, numbered from 0, if
+   *        more than those added so far
+   */
+  void SetNNodes (uint32_t nNodes);
+  /**
+   * \param node the node
+   * \param weight the load of the node, 1 by default
+   */
+  void SetNodeWeight (uint32_t node, double weight);
+  /**
+   * \param a one end of the link
+   * \param b the other end
+   * \param delay the delay of the link
+   * \param traffic the traffic expected on the link, in any unit common
+   *        to all the links, such as the rate of the link
+   */
+  void AddLink (uint32_t a, uint32_t b, Time delay, double traffic);
+  /**
+   * Keep a and b in the same partition.
+   */
+  void Couple (uint32_t a, uint32_t b);
+  /**
+   * Add all the nodes of the NodeList and all the channels of the
+   * ChannelList: the point-to-point channels as links, with their delay
+   * and the rate of their devices as traffic, and the other channels as
+   * the coupling of all the nodes they reach.
+   */
+  void AddChannels (void);
+  /**
+   * Add the nodes and the links of plan, with the delay given and their
+   * rate as traffic.
+   */
+  void AddPlan (const FlywayTopologyPlan &plan, Time delay);
+
+  /**
+   * \param nPartitions the number of partitions wanted
+   * \returns the partition of every node, from 0 to GetNPartitions () - 1
+   *
+   * There are fewer partitions than wanted when the coupled nodes and the
+   * links kept uncut leave fewer groups of nodes; the partition 0 is the
+   * one of the node 0.
+   */
+  std::vector<uint32_t> Partition (uint32_t nPartitions);
+
+  /**
+   * \returns the number of partitions of the last Partition
+   */
+  uint32_t GetNPartitions (void) const;
+  /**
+   * \returns the traffic of the links cut by the last Partition
+   */
+  double GetCutTraffic (void) const;
+  /**
+   * \returns the number of links cut by the last Partition
+   */
+  uint32_t GetNCutLinks (void) const;
+  /**
+   * \returns the smallest delay of the links cut by the last Partition,
+   *          or the maximum time if none is
+   */
+  Time GetLookAhead (void) const;
+
+private:
+  struct Link
+  {
+    uint32_t a;
+    uint32_t b;
+    int64_t delay;
+    double traffic;
+  };
+  // the links between the groups of nodes kept together, merged
+  typedef std::vector<std::vector<std::pair<uint32_t, double> > > Adjacency;
+
+  static uint32_t Find (std::vector<uint32_t> &parent, uint32_t i);
+  // group the nodes coupled or joined by links shorter than delay, and
+  // return the number of groups
+  uint32_t Group (int64_t delay, std::vector<uint32_t> &group) const;
+  // the heaviest group, for the groups made by Group
+  double GetMaxWeight (const std::vector<uint32_t> &group, uint32_t nGroups) const;
+  void Grow (const Adjacency &adjacency, const std::vector<double> &weight,
+             uint32_t nPartitions, std::vector<uint32_t> &part) const;
+  void Refine (const Adjacency &adjacency, const std::vector<double> &weight,
+               uint32_t nPartitions, double limit, std::vector<uint32_t> &part) const;
+
+  double m_imbalance;
+  std::vector<double> m_weight;
+  std::vector<Link> m_links;
+  std::vector<std::pair<uint32_t, uint32_t> > m_couples;
+  uint32_t m_nPartitions;
+  double m_cutTraffic;
+  uint32_t m_nCutLinks;
+  int64_t m_lookAhead;
+};
+
+} // namespace ns3
+
+#endif /* NODE_PARTITIONER_H */
@@ -0,0 +1,8 @@
+/**
+ * \ingroup tests
+ * \defgroup Ns3WifiTests ns-3 Wifi Implementation Tests
+ *
+ * \section Ns3WifiTestsOverview ns-3 Wifi Implementation Tests Overview
+ *
+ * ns-3 has a Wifi implementation and we test it a little.
+ */
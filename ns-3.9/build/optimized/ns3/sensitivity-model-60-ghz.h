@@ -0,0 +1,64 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef SENSITIVITY_MODEL_60_GHZ
+#define SENSITIVITY_MODEL_60_GHZ
+
+#include <stdint.h>
+#include <vector>
+#include "wifi-mode.h"
+#include "error-rate-model.h"
+#include "dsss-error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \brief error rate model for 802.11ad PHYs based on receiver sensitivity
+ *
+ * The SNR of a chunk is converted back to a received signal strength and
+ * compared against the sensitivity of the mode; the difference indexes a
+ * measured BER table.  The per-mode offsets of the modes known when the
+ * model is made are resolved then, and only read afterwards, so that the
+ * threads of a parallel simulator can share a model.  The table is kept as
+ * log(1-BER) so that the success rate of a chunk is a single exp().
+ */
+class SensitivityModel60GHz : public ErrorRateModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  SensitivityModel60GHz ();
+
+  virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
+
+private:
+  struct RssOffset
+  {
+    RssOffset () : resolved (false), offset (0) {}
+    bool resolved;
+    double offset;
+  };
+
+  double GetRssOffset (WifiMode mode) const;
+  static double ComputeRssOffset (WifiMode mode);
+
+  std::vector<RssOffset> m_rssOffsets;
+  std::vector<double> m_logSuccess;
+};
+
+} // namespace ns3
+
+#endif /* SENSITIVITY_MODEL_60_GHZ */
@@ -0,0 +1,40 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef WIFI_PHY_STANDARD_H
+#define WIFI_PHY_STANDARD_H
+
+namespace ns3 {
+
+enum WifiPhyStandard {
+  WIFI_PHY_STANDARD_80211a,
+  WIFI_PHY_STANDARD_80211b,
+  WIFI_PHY_STANDARD_80211_10Mhz,
+  WIFI_PHY_STANDARD_80211_5Mhz,
+  WIFI_PHY_STANDARD_holland,
+  WIFI_PHY_STANDARD_80211p_CCH,
+  WIFI_PHY_STANDARD_80211p_SCH,
+  WIFI_PHY_STANDARD_80211ad_SC,
+  WIFI_PHY_STANDARD_80211ad_OFDM,
+  WIFI_PHY_UNKNOWN
+};
+
+} // namespace ns3
+
+#endif /* WIFI_PHY_STANDARD_H */
@@ -0,0 +1,252 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef YANS_WIFI_CHANNEL_H
+#define YANS_WIFI_CHANNEL_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <stdint.h>
+#include "ns3/packet.h"
+#include "ns3/vector.h"
+#include "ns3/nstime.h"
+#include "ns3/mobility-model.h"
+#include "ns3/antenna.h"
+#include "wifi-channel.h"
+#include "wifi-mode.h"
+#include "wifi-preamble.h"
+
+namespace ns3 {
+
+class NetDevice;
+class PropagationLossModel;
+class PropagationDelayModel;
+class YansWifiPhy;
+
+/**
+ * \brief A Yans wifi channel
+ *
+ * This wifi channel implements the propagation model described in
+ * "Yet Another Network Simulator", (http://cutebugs.net/files/wns2-yans.pdf).
+ *
+ * This class is expected to be used in tandem with the ns3::YansWifiPhy 
+ * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
+ * By default, no propagation models are set so, it is the caller's responsability
+ * to set them before using the channel.
+ *
+ * To avoid evaluating the propagation models towards every PHY for every
+ * frame, the channel keeps its PHYs bucketed by channel number, with a
+ * uniform grid over their positions. The propagation loss model and the
+ * peak antenna gains bound the distance over which a frame can still be
+ * received above MinRxPower, and only the grid cells within that distance
+ * are visited. The index is rebuilt lazily whenever a PHY is added, moves
+ * or has its antenna reconfigured. A PHY switching channel number is moved
+ * from one bucket to the other without rebuilding the index.
+ *
+ * By default, PHYs on different channel numbers do not interfere at all.
+ * The AdjacentChannelRejection attribute describes how much of a frame
+ * leaks into the channels next to the one it is sent on: the energy which
+ * leaks is added to the interference seen by the PHYs on these channels,
+ * which never try to receive the frame itself.
+ *
+ * The PHYs which survive this culling are handed to the propagation loss
+ * model and to the antenna of the sender as a single batch.
+ *
+ * When the StaticGeometry attribute is set, the channel additionally keeps
+ * a sender x receiver matrix of the received power and propagation delay
+ * of every link it evaluated. An entry is reused until either end of the
+ * link moves, changes channel number or has its antenna reconfigured, so
+ * the propagation models are only evaluated once per link and geometry.
+ * This assumes deterministic propagation models: random loss models such
+ * as NakagamiPropagationLossModel would be frozen to their first draw.
+ */
+class YansWifiChannel : public WifiChannel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  YansWifiChannel ();
+  virtual ~YansWifiChannel ();
+
+  // inherited from Channel.
+  virtual uint32_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (uint32_t i) const;
+
+  void Add (Ptr<YansWifiPhy> phy);
+
+  /**
+   * \param loss the new propagation loss model.
+   */
+  void SetPropagationLossModel (Ptr<PropagationLossModel> loss);
+  Ptr<PropagationLossModel> GetPropagationLossModel ();
+  /**
+   * \param delay the new propagation delay model.
+   */
+  void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
+
+  /**
+   * \param sender the device from which the packet is originating.
+   * \param packet the packet to send
+   * \param txPowerDbm the tx power associated to the packet
+   * \param wifiMode the tx mode associated to the packet
+   * \param preamble the preamble associated to the packet
+   *
+   * This method should not be invoked by normal users. It is 
+   * currently invoked only from WifiPhy::Send. YansWifiChannel 
+   * delivers packets only between PHYs with the same m_channelNumber,
+   * e.g. PHYs that are operating on the same channel.
+   */
+  void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
+             WifiMode wifiMode, WifiPreamble preamble) const;
+
+  /**
+   * \param phy the PHY whose configuration changed.
+   *
+   * Invoked by YansWifiPhy when its channel number, antenna or mobility
+   * model changes, to refresh the spatial index of this channel.
+   */
+  void NotifyPhyChange (Ptr<const YansWifiPhy> phy);
+  /**
+   * \param phy the PHY which switched channel.
+   * \param previous the channel number it was operating on.
+   *
+   * Invoked by YansWifiPhy when its channel number changes.
+   */
+  void NotifyChannelSwitch (Ptr<const YansWifiPhy> phy, uint16_t previous);
+
+  /**
+   * \param mask the rejection (dB) of the channels 1, 2, ... channel
+   *        numbers away from the one a frame is sent on, separated by
+   *        spaces. An empty mask disables inter-channel interference.
+   */
+  void SetAdjacentChannelRejection (std::string mask);
+  std::string GetAdjacentChannelRejection (void) const;
+
+private:
+  typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+  /**
+   * The PHYs operating on one channel number, with a uniform grid
+   * over their XY positions. Cells hold indexes into m_phyList.
+   */
+  struct PhyBucket
+  {
+    std::vector<uint32_t> phys;
+    double maxRxGainDbi;
+    bool isStatic;
+    double xMin;
+    double yMin;
+    double cellSize;
+    uint32_t nx;
+    uint32_t ny;
+    std::vector<std::vector<uint32_t> > cells;
+  };
+  struct PhyState
+  {
+    PhyState () : isStatic (false), epoch (1) {}
+    Ptr<MobilityModel> mobility;
+    Ptr<Antenna> antenna;
+    Vector position;
+    // true if the position only changes with a CourseChange notification
+    bool isStatic;
+    // bumped whenever the cached link budgets to and from this PHY go stale
+    uint32_t epoch;
+  };
+  /**
+   * A cached link budget, valid as long as the epochs of both ends
+   * match the ones it was computed with.
+   */
+  struct LinkBudget
+  {
+    LinkBudget () : senderEpoch (0), receiverEpoch (0) {}
+    double txPowerDbm;
+    double rxPowerDbm;
+    Time delay;
+    uint32_t senderEpoch;
+    uint32_t receiverEpoch;
+  };
+  /**
+   * The receivers of the frame being sent, as parallel arrays so that the
+   * propagation and antenna models can evaluate all of them in one pass.
+   */
+  struct ReceiverBatch
+  {
+    void Clear (void);
+    void Add (uint32_t phy, Ptr<MobilityModel> mobility, const Vector &position);
+    std::vector<uint32_t> phys;
+    // the rejection (dB) of the channel of each receiver, 0 if co-channel
+    std::vector<double> rejectionDb;
+    std::vector<Ptr<MobilityModel> > mobility;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> rxPowerDbm;
+    std::vector<Time> delay;
+    // the links whose budget is not cached, and their geometry
+    std::vector<uint32_t> pending;
+    std::vector<Ptr<MobilityModel> > pendingMobility;
+    std::vector<double> distance;
+    std::vector<double> azimuth;
+    std::vector<double> elevation;
+    std::vector<double> lossDbm;
+    std::vector<double> txGainDbi;
+  };
+  typedef std::map<uint16_t, PhyBucket> PhyBuckets;
+  typedef std::map<Ptr<const YansWifiPhy>, uint32_t> PhyIndexes;
+
+  virtual void DoDispose (void);
+  void Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
+                WifiMode txMode, WifiPreamble preamble) const;
+  void ReceiveInterference (uint32_t i, uint32_t size, double rxPowerDbm,
+                            WifiMode txMode, WifiPreamble preamble) const;
+  void Propagate (uint32_t i, Ptr<MobilityModel> senderMobility, const Vector &sender_pos,
+                  Ptr<Antenna> senderAntenna, Ptr<const Packet> packet,
+                  double txPowerDbm, WifiMode wifiMode, WifiPreamble preamble) const;
+  void CollectAll (Ptr<YansWifiPhy> sender, uint16_t channel, double rejectionDb) const;
+  void CollectBucket (const PhyBucket &bucket, Ptr<YansWifiPhy> sender, const Vector &sender_pos,
+                      double range, double rejectionDb) const;
+  void UpdateIndex (void) const;
+  bool RemoveFromBucket (uint32_t j, uint16_t channel);
+  bool AddToBucket (uint32_t j, uint16_t channel);
+  void InvalidateLinks (uint32_t j) const;
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility) const;
+  void NotifyPatternChange (Ptr<const Antenna> antenna) const;
+
+  PhyList m_phyList;
+  Ptr<PropagationLossModel> m_loss;
+  Ptr<PropagationDelayModel> m_delay;
+  double m_minRxPowerDbm;
+  double m_cellSize;
+  bool m_staticGeometry;
+  std::string m_rejectionMask;
+  std::vector<double> m_rejectionDb;
+  PhyIndexes m_phyIndexes;
+
+  mutable bool m_indexValid;
+  mutable std::vector<PhyState> m_phyStates;
+  mutable PhyBuckets m_buckets;
+  mutable std::vector<uint32_t> m_candidates;
+  mutable std::vector<LinkBudget> m_links;
+  mutable ReceiverBatch m_batch;
+};
+
+} // namespace ns3
+
+
+#endif /* YANS_WIFI_CHANNEL_H */
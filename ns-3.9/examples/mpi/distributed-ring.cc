@@ -0,0 +1,150 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// A ring of point-to-point links, each node sending to the node across
+// the ring, over UDP and TCP in turn. Run with MPI, the nodes are split
+// between the ranks by a NodePartitioner:
+//
+//     mpirun -np 4 ./build/optimized/examples/mpi/distributed-ring
+//
+// and without, with --distributed=0, they all run in a single process.
+// Each sink prints the bytes it received and the time of its last
+// reception, which are the same either way once sorted:
+//
+//     ./build/optimized/examples/mpi/distributed-ring --distributed=0 | sort
+//     mpirun -np 4 ./build/optimized/examples/mpi/distributed-ring | sort
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/node-partitioner.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/packet-sink.h"
+
+#include <iostream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("DistributedRing");
+
+using namespace ns3;
+
+struct Sink
+{
+  uint32_t bytes;
+  int64_t lastRx;
+};
+
+static void
+SinkRx (Sink *sink, Ptr<const Packet> p, const Address &from)
+{
+  sink->bytes += p->GetSize ();
+  sink->lastRx = Simulator::Now ().GetTimeStep ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nNodes = 8;
+  bool distributed = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "number of nodes of the ring [default 8]", nNodes);
+  cmd.AddValue ("distributed", "split the nodes between the MPI ranks [default 1]", distributed);
+  cmd.Parse (argc, argv);
+
+  uint32_t systemId = 0;
+  std::vector<uint32_t> systemIds (nNodes, 0);
+  if (distributed)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+      MpiInterface::Enable (&argc, &argv);
+      systemId = MpiInterface::GetSystemId ();
+      NodePartitioner partitioner;
+      for (uint32_t i = 0; i < nNodes; i++)
+        {
+          partitioner.AddLink (i, (i + 1) % nNodes, MilliSeconds (2), 1e7);
+        }
+      systemIds = partitioner.Partition (MpiInterface::GetSize ());
+    }
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      nodes.Add (CreateObject<Node> (systemIds[i]));
+    }
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  std::vector<Ipv4InterfaceContainer> interfaces;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      NetDeviceContainer link = p2p.Install (nodes.Get (i), nodes.Get ((i + 1) % nNodes));
+      interfaces.push_back (address.Assign (link));
+      address.NewNetwork ();
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  // the applications only go on the nodes of this rank
+  std::vector<Sink> sinks (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      std::string protocol = i % 2 == 0 ? "ns3::UdpSocketFactory" : "ns3::TcpSocketFactory";
+      uint32_t to = (i + nNodes / 2) % nNodes;
+      Address sinkAddress (InetSocketAddress (interfaces[to].GetAddress (0), 9000 + i));
+      sinks[i].bytes = 0;
+      sinks[i].lastRx = 0;
+      if (systemIds[to] == systemId)
+        {
+          PacketSinkHelper sink (protocol, sinkAddress);
+          ApplicationContainer sinkApp = sink.Install (nodes.Get (to));
+          sinkApp.Get (0)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&SinkRx, &sinks[i]));
+        }
+      if (systemIds[i] == systemId)
+        {
+          OnOffHelper source (protocol, sinkAddress);
+          source.SetAttribute ("OnTime", RandomVariableValue (ConstantVariable (1)));
+          source.SetAttribute ("OffTime", RandomVariableValue (ConstantVariable (0)));
+          source.SetAttribute ("DataRate", StringValue ("4Mbps"));
+          source.SetAttribute ("PacketSize", UintegerValue (1000));
+          ApplicationContainer sourceApp = source.Install (nodes.Get (i));
+          sourceApp.Start (Seconds (0.1 + 0.01 * i));
+          sourceApp.Stop (Seconds (1.5));
+        }
+    }
+
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      if (systemIds[(i + nNodes / 2) % nNodes] == systemId)
+        {
+          std::cout << "sink " << i << " bytes " << sinks[i].bytes << " last " << sinks[i].lastRx << std::endl;
+        }
+    }
+  Simulator::Destroy ();
+  if (distributed)
+    {
+      MpiInterface::Disable ();
+    }
+  return 0;
+}
@@ -0,0 +1,574 @@
+#define NAME "flyway-batch"
+
+/*
+ * Runs a batch of flyway-data experiments, in one process or spread over
+ * several worker processes.
+ *
+ * The manifest lists one job per line:
+ *
+ *     label flowFile allocationFile gain
+ *
+ * flowFile holds the flows, in the format FlywaysTopoHelper reads.
+ * allocationFile holds the same flows, with the link type of each in its
+ * last column; the wireless ones get a flyway. "-" means flowFile holds
+ * the link types itself, as the alloc__ files of run-flows.py do. Lines
+ * starting with '#' are skipped. Both files may also be in the binary
+ * format written by flyway-convert.
+ *
+ * gen_multiflow_data.py writes such a manifest next to the flow logs it
+ * generates, and run-flows.py writes one for its directory of flows.
+ *
+ * Every job gets a fresh simulator, topology and random number streams.
+ * Job i of the manifest runs with SeedManager run number firstRun + i, so
+ * its results depend neither on the jobs before it nor on the worker
+ * which runs it.
+ *
+ * With --workers=N, N processes are forked and take the jobs from a
+ * common queue. Each writes its rows to outfile.partK; once all of them
+ * are done the parts are merged into outfile, in manifest order, one row
+ * per flow and simulated second:
+ *
+ *     label,run,time,app,rx_bytes,throughput_mbps
+ *
+ * With --snapshot=1, the topology and its routes are built only once.
+ * Each job then runs in a child forked from that state, which only sets
+ * up its own flows and flyways; up to --workers such children run at
+ * once, and the child of job i writes outfile.partI. Job i still runs with
+ * run number firstRun + i.
+ *
+ * With --lazy=1, the applications of a flow are only created just before
+ * it begins, and let go of their sockets once it has finished, so that
+ * jobs with many flows do not hold all of them at once. The results are
+ * the same.
+ */
+
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/common-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/flyways-topo-helper.h"
+#include "ns3/flyway-tables.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/rng-stream.h"
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define WIRELESS_T 1
+#define WIRED_T 2
+
+using namespace std;
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("flyway-batch");
+
+InternetStackHelper stack;
+FlywaysTopoHelper *fth;
+
+vector < double > last;
+
+FILE *results;
+char topoFile[1000];
+char manifestFile[1000];
+char outputFile[1000];
+uint32_t workers = 1;
+uint32_t firstRun = 1;
+bool snapshot = false;
+bool lazy = false;
+bool staticGeometry = false;
+double maxTS = 0;
+
+struct Job
+{
+    string label;
+    string flowFile;
+    string allocFile;
+    double gain;
+};
+
+struct Flyway
+{
+    int fromNodeId;
+    int toNodeId;
+    int dongleNumber;
+    int channel;
+    double gain;
+    int link_type;
+};
+
+void PointAllNowhere()
+{
+	for (int i = 0; i < fth->GetNumFlyways(); ++i)
+	{
+		fth->PointNowhere(i, 0);	/* Assumes only 1 dongle! */
+	}
+}
+
+void AddFlyway(Flyway f)
+{
+    int fromNodeId = f.fromNodeId;
+    int toNodeId = f.toNodeId;
+    int dongleNumber = f.dongleNumber;
+
+    // Turn on the wireless interfaces
+    fth->SetFlywayInterfaceUpDown(FW_Node_ToR, fromNodeId, dongleNumber, true);
+    fth->SetFlywayInterfaceUpDown(FW_Node_ToR, toNodeId, dongleNumber, true);
+
+    // Set channels.
+    fth->ChangeChannel(fromNodeId, dongleNumber, f.channel);
+    fth->ChangeChannel(toNodeId, dongleNumber, f.channel);
+
+    // Set antenna gain
+    fth->SetAntennaGain(fromNodeId, dongleNumber, f.gain);
+    fth->SetAntennaGain(toNodeId, dongleNumber, f.gain);
+
+    // Point antenna.
+    fth->PointAtEachOther(fromNodeId, dongleNumber, toNodeId, dongleNumber);
+
+    // Get ipv4 objects.
+    Ptr<Ipv4> fromIpv4 = fth->GetNode(fromNodeId)->GetObject<Ipv4>();
+    Ptr<Ipv4> toIpv4 = fth->GetNode(toNodeId)->GetObject<Ipv4>();
+
+    // Get the wired and wireless interfaces on both nodes.
+    uint32_t fromInterfaces[2];
+    fromInterfaces[0] = fth->GetWiredUplinks(fromNodeId).Get(0)->GetIfIndex();
+    fromInterfaces[1] = fth->GetFlywayLinks(fromNodeId).Get(dongleNumber)->GetIfIndex();
+
+    uint32_t toInterfaces[2];
+    toInterfaces[0] = fth->GetWiredUplinks(toNodeId).Get(0)->GetIfIndex();
+    toInterfaces[1] = fth->GetFlywayLinks(toNodeId).Get(dongleNumber)->GetIfIndex();
+
+    // The destination is the wired address of the toNode.
+    Ipv4Address dest = toIpv4->GetAddress(toInterfaces[0], 0).GetLocal();
+
+    // Now, set up next hops.
+    Ipv4Address gateways[2];
+    gateways[0] = Ipv4Address::GetZero ();
+    gateways[1] = toIpv4->GetAddress(toInterfaces[1], 0).GetLocal();
+
+    // All the traffic goes over the flyway.
+    double fraction[] = {0, 1};
+
+    // Set up routes.
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    Ptr<Ipv4StaticRouting> fromStaticRouting = ipv4RoutingHelper.GetStaticRouting(fromIpv4);
+    fromStaticRouting->AddFractionalHostRouteTo(dest, gateways, fromInterfaces, fraction, 2);
+}
+
+/* Rows of the part files start with the index of their job. */
+void Sample (uint32_t index, string label)
+{
+    double now = Simulator::Now ().GetSeconds ();
+    for (int i=0; i < (int)fth->GetNumApps(); i++) {
+        double curr = fth->GetTotalRx(i);
+        double tp = (curr - last[i])*8.0/ 1e6;
+        last[i] = curr;
+        fprintf (results, "%u,%s,%u,%.3f,%d,%.0f,%.3f\n", index, label.c_str (),
+                 SeedManager::GetRun (), now, i, curr, tp);
+    }
+    Simulator::Schedule (Seconds (1), Sample, index, label);
+}
+
+void SetSimulationDefaults()
+{
+    /* We want large MTUs */
+    Config::SetDefault ("ns3::PointToPointNetDevice::Mtu", UintegerValue (65535-8));
+    Config::SetDefault ("ns3::WifiNetDevice::Mtu", UintegerValue (65535-8));
+
+    /* Various wireless settings */
+    Config::SetDefault ("ns3::WifiRemoteStationManager::FragmentationThreshold", StringValue ("120000"));
+    Config::SetDefault ("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue ("120000"));
+    Config::SetDefault ("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue ("VHTMCS1"));
+    Config::SetDefault ("ns3::YansWifiPhy::TxPowerStart", DoubleValue(10.0));
+    Config::SetDefault ("ns3::YansWifiPhy::TxPowerEnd", DoubleValue(10.0));
+    Config::SetDefault ("ns3::YansWifiPhy::TxPowerLevels", UintegerValue(1));
+    Config::SetDefault ("ns3::YansWifiPhy::RxNoiseFigure", DoubleValue(0.0));
+    Config::SetDefault ("ns3::YansWifiPhy::EnergyDetectionThreshold", DoubleValue (-77));
+    Config::SetDefault ("ns3::YansWifiPhy::CcaMode1Threshold", DoubleValue (80));
+    /* Racks do not move: the link budgets between dongles can be cached,
+     * at the cost of a dongles x dongles matrix per channel */
+    Config::SetDefault ("ns3::YansWifiChannel::StaticGeometry", BooleanValue (staticGeometry));
+
+    /* On-off app is set to write infinite data, in 1MB chunks. */
+    Config::SetDefault ("ns3::OnOffApplication::MaxBytes", UintegerValue(0));
+    Config::SetDefault ("ns3::OnOffApplication::PacketSize", UintegerValue(2e6));
+    Config::SetDefault ("ns3::OnOffApplication::OnTime", RandomVariableValue(ConstantVariable(1e6)));
+    Config::SetDefault ("ns3::OnOffApplication::DataRate", DataRateValue(DataRate("10Gbps")));
+    Config::SetDefault ("ns3::OnOffApplication::OffTime", RandomVariableValue(ConstantVariable(0)));
+
+    /* TCP defaults to send large packets. We only send 10K large packets to
+     * avoid wireless unfairness. */
+    Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue(10000));
+    Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue(1e9));
+    Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue(1e9));
+    Config::SetDefault ("ns3::TcpSocket::InitialCwnd", UintegerValue(32));
+    Config::SetDefault ("ns3::RttEstimator::MinRTO", TimeValue(Seconds(0.01)));
+}
+
+void ReadAllocation(const char *filename, double gain)
+{
+  FlywayFlowTable flows;
+  if (!flows.Load(filename)) {
+      printf("cannot read allocation file: %s\n", flows.GetError().c_str());
+      exit(-1);
+  }
+  maxTS = 0;
+  for (uint32_t i = 0; i < flows.GetN(); ++i)
+  {
+      const FlywayFlow &flow = flows.Get(i);
+      Flyway f;
+      f.fromNodeId = flow.fromNode;
+      f.toNodeId = flow.toNode;
+      f.dongleNumber = 0;
+      f.channel = 1;
+      f.gain = gain;
+      f.link_type = flow.linkType;
+      if (flow.beginTime > maxTS)
+      {
+          maxTS = flow.beginTime;
+      }
+      if(f.link_type == WIRELESS_T)
+          Simulator::Schedule(Seconds(0), AddFlyway, f);
+  }
+}
+
+bool ReadManifest(vector<Job> &jobs)
+{
+    FILE *fp = fopen(manifestFile, "r");
+    if (fp == NULL)
+    {
+        printf("cannot read manifest: %s\n", manifestFile);
+        return false;
+    }
+    char line[3000];
+    char label[1000], flow[1000], alloc[1000];
+    int n = 0;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        n++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+            continue;
+        Job j;
+        if (sscanf(line, "%999s %999s %999s %lf", label, flow, alloc, &j.gain) != 4)
+        {
+            printf("%s:%d: expected label flowFile allocationFile gain\n", manifestFile, n);
+            fclose(fp);
+            return false;
+        }
+        j.label = label;
+        j.flowFile = flow;
+        j.allocFile = strcmp(alloc, "-") == 0 ? flow : alloc;
+        jobs.push_back(j);
+    }
+    fclose(fp);
+    return true;
+}
+
+/* Build the topology and its routes, with the flows of flowFile if any. */
+void BuildTopology(const char *flowFile)
+{
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.0.0"); // link local ip addresses
+
+    if (flowFile != NULL)
+        fth = new FlywaysTopoHelper(topoFile, const_cast<char *> (flowFile), stack, address);
+    else
+        fth = new FlywaysTopoHelper(topoFile, stack, address);
+
+    PointAllNowhere();
+
+    // Fill in the default routes.
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+}
+
+/* Set up the flows of the job, at once or as they begin, on a topology
+ * built without them. */
+void SetupJobFlows(const Job &job)
+{
+    if (!lazy)
+    {
+        fth->SetupFlows(job.flowFile.c_str ());
+        return;
+    }
+    FlywayFlowTable flows;
+    if (!flows.Load(job.flowFile))
+    {
+        printf("cannot read flow file: %s\n", flows.GetError().c_str());
+        exit(-1);
+    }
+    fth->SetupFlowsLazily(flows, MilliSeconds(1));
+}
+
+/* Set up the flyways of the job and run it on the topology built. */
+void Simulate(uint32_t index, const Job &job)
+{
+    last.assign(fth->GetNumApps(), 0);
+
+    // Set up all flyways.
+    ReadAllocation(job.allocFile.c_str (), job.gain);
+
+    // Measure throughput every 1 second.
+    Simulator::Schedule(Seconds(1), Sample, index, job.label);
+
+    // Stop after all flows, plus 2 seconds.
+    Simulator::Stop(Seconds(maxTS + 2 + 0.001));
+    Simulator::Run ();
+    fflush(results);
+}
+
+void RunJob(uint32_t index, const Job &job)
+{
+    time_t start = time(NULL);
+
+    /* Every job draws the random numbers of its own run, whichever
+     * process runs it and whatever ran there before. */
+    SeedManager::SetRun (firstRun + index);
+    RngStream::SetPackageSeed (SeedManager::GetSeed ());
+
+    if (lazy)
+    {
+        BuildTopology(NULL);
+        SetupJobFlows(job);
+    }
+    else
+        BuildTopology(job.flowFile.c_str ());
+    Simulate(index, job);
+
+    // Tear the topology down for the next job.
+    Simulator::Destroy ();
+    delete fth;
+    fth = 0;
+    Ipv4AddressGenerator::Reset ();
+
+    printf("job %s: %d flows, %.0f s\n", job.label.c_str (), (int)last.size (), difftime(time(NULL), start));
+    fflush(stdout);
+}
+
+string PartFile(uint32_t worker)
+{
+    char name[1100];
+    snprintf(name, sizeof(name), "%s.part%u", outputFile, worker);
+    return name;
+}
+
+/* Run the jobs whose indices come out of the queue, until it is empty,
+ * or all of them in order if there is no queue. */
+void RunWorker(uint32_t worker, int queue, const vector<Job> &jobs)
+{
+    results = fopen(PartFile(worker).c_str (), "w");
+    if (results == NULL)
+    {
+        printf("cannot open results file: %s\n", PartFile(worker).c_str ());
+        exit(-1);
+    }
+    uint32_t index;
+    if (queue < 0)
+    {
+        for (index = 0; index < jobs.size(); ++index)
+            RunJob(index, jobs[index]);
+    }
+    else
+    {
+        while (read(queue, &index, sizeof(index)) == sizeof(index))
+            RunJob(index, jobs[index]);
+    }
+    fclose(results);
+}
+
+/* Build the topology once, then run each job in a child forked from it,
+ * at most workers at a time. The child of job i writes part file i. */
+bool RunFromSnapshot(const vector<Job> &jobs)
+{
+    SeedManager::SetRun (firstRun);
+    RngStream::SetPackageSeed (SeedManager::GetSeed ());
+    BuildTopology(NULL);
+
+    bool ok = true;
+    uint32_t running = 0;
+    for (uint32_t i = 0; i < jobs.size(); ++i)
+    {
+        if (running == workers)
+        {
+            int status;
+            wait(&status);
+            running--;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                ok = false;
+        }
+        pid_t pid = fth->ForkFromSnapshot(firstRun + i);
+        if (pid < 0)
+        {
+            perror("fork");
+            exit(-1);
+        }
+        if (pid == 0)
+        {
+            time_t start = time(NULL);
+            results = fopen(PartFile(i).c_str (), "w");
+            if (results == NULL)
+            {
+                printf("cannot open results file: %s\n", PartFile(i).c_str ());
+                fflush(stdout);
+                _exit(1);
+            }
+            SetupJobFlows(jobs[i]);
+            Simulate(i, jobs[i]);
+            fclose(results);
+            printf("job %s: %d flows, %.0f s\n", jobs[i].label.c_str (), (int)last.size (), difftime(time(NULL), start));
+            /* The static destructors and atexit handlers belong to the
+             * parent: leave without them. */
+            fflush(stdout);
+            _exit(0);
+        }
+        running++;
+    }
+    while (running > 0)
+    {
+        int status;
+        wait(&status);
+        running--;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            ok = false;
+    }
+    if (!ok)
+        printf("a job failed\n");
+    return ok;
+}
+
+/* Merge the numParts part files into outputFile, in manifest order. */
+bool MergeResults(uint32_t numJobs, uint32_t numParts)
+{
+    vector<string> rows(numJobs);
+    char line[3000];
+    for (uint32_t w = 0; w < numParts; ++w)
+    {
+        FILE *part = fopen(PartFile(w).c_str (), "r");
+        if (part == NULL)
+            return false;
+        while (fgets(line, sizeof(line), part) != NULL)
+        {
+            char *comma = strchr(line, ',');
+            uint32_t index = atoi(line);
+            if (comma == NULL || index >= numJobs)
+                continue;
+            rows[index] += comma + 1;
+        }
+        fclose(part);
+        remove(PartFile(w).c_str ());
+    }
+
+    FILE *out = fopen(outputFile, "w");
+    if (out == NULL)
+    {
+        printf("cannot open results file: %s\n", outputFile);
+        return false;
+    }
+    fprintf(out, "label,run,time,app,rx_bytes,throughput_mbps\n");
+    for (uint32_t i = 0; i < numJobs; ++i)
+        fputs(rows[i].c_str (), out);
+    fclose(out);
+    return true;
+}
+
+int
+main (int argc, char **argv)
+{
+    CommandLine cmd;
+    cmd.AddValue ("topo", "topo file", topoFile);
+    cmd.AddValue ("manifest", "one job per line: label flowFile allocationFile gain", manifestFile);
+    cmd.AddValue ("outfile", "csv file for the results of all the jobs", outputFile);
+    cmd.AddValue ("workers", "number of worker processes [default 1]", workers);
+    cmd.AddValue ("firstRun", "run number of the first job [default 1]", firstRun);
+    cmd.AddValue ("snapshot", "build the topology once and fork each job from it [default 0]", snapshot);
+    cmd.AddValue ("lazy", "create the applications of each flow just before it begins [default 0]", lazy);
+    cmd.AddValue ("staticgeometry", "cache the link budgets between all pairs of dongles [default 0]", staticGeometry);
+    cmd.Parse (argc, argv);
+
+    // Set various default values.
+    SetSimulationDefaults();
+
+    vector<Job> jobs;
+    if (!ReadManifest(jobs))
+        exit(-1);
+    if (workers < 1)
+        workers = 1;
+
+    if (snapshot)
+    {
+        if (!RunFromSnapshot(jobs))
+            exit(-1);
+        if (!MergeResults(jobs.size(), jobs.size()))
+            exit(-1);
+        return 0;
+    }
+
+    if (workers == 1)
+    {
+        /* Run in this process. */
+        RunWorker(0, -1, jobs);
+    }
+    else
+    {
+        /* The job queue: a pipe of job indices, each small enough to be
+         * read atomically by whichever worker is free. */
+        int queue[2];
+        if (pipe(queue) != 0)
+        {
+            perror("pipe");
+            exit(-1);
+        }
+        vector<pid_t> pids;
+        fflush(NULL);
+        for (uint32_t w = 0; w < workers; ++w)
+        {
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                perror("fork");
+                exit(-1);
+            }
+            if (pid == 0)
+            {
+                close(queue[1]);
+                RunWorker(w, queue[0], jobs);
+                /* RunWorker closed the part file; the static destructors
+                 * and atexit handlers belong to the parent. */
+                fflush(NULL);
+                _exit(0);
+            }
+            pids.push_back(pid);
+        }
+        close(queue[0]);
+        for (uint32_t i = 0; i < jobs.size(); ++i)
+        {
+            if (write(queue[1], &i, sizeof(i)) != sizeof(i))
+            {
+                perror("write");
+                exit(-1);
+            }
+        }
+        close(queue[1]);
+
+        bool ok = true;
+        for (uint32_t w = 0; w < pids.size(); ++w)
+        {
+            int status;
+            waitpid(pids[w], &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                printf("worker %u failed\n", w);
+                ok = false;
+            }
+        }
+        if (!ok)
+            exit(-1);
+    }
+
+    if (!MergeResults(jobs.size(), workers))
+        exit(-1);
+    return 0;
+}
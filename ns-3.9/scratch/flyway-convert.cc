@@ -0,0 +1,91 @@
+#define NAME "flyway-convert"
+
+/*
+ * Converts topology and flow files to the binary formats of
+ * FlywayTopoTable and FlywayFlowTable, which FlywaysTopoHelper and
+ * flyway-batch load without parsing any text:
+ *
+ *     flyway-convert --topo=scratch/topo-search.dat --out=topo-search.bin
+ *     flyway-convert --flows=flows__1.dat --out=flows__1.bin
+ *
+ * Binary flow files are read as well, and --text=1 turns them back into
+ * text.
+ */
+
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/flyway-tables.h"
+
+using namespace std;
+using namespace ns3;
+
+void WriteTextFlows(const FlywayFlowTable &table, FILE *out)
+{
+    fprintf(out, "# beginTime fromNode toNode proto transferSize dataRate linkType\n");
+    for (uint32_t i = 0; i < table.GetN(); ++i)
+    {
+        const FlywayFlow &f = table.Get(i);
+        fprintf(out, "%.9g %u %u %s %.9g %s %d\n", f.beginTime, f.fromNode, f.toNode,
+                f.proto, f.transferSize, f.dataRate, f.linkType);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    string topoFile;
+    string flowFile;
+    string outFile;
+    bool text = false;
+
+    CommandLine cmd;
+    cmd.AddValue ("topo", "topology file to convert", topoFile);
+    cmd.AddValue ("flows", "flow or allocation file to convert", flowFile);
+    cmd.AddValue ("out", "file to write", outFile);
+    cmd.AddValue ("text", "write flows as text rather than binary [default 0]", text);
+    cmd.Parse (argc, argv);
+
+    if (outFile.empty() || topoFile.empty() == flowFile.empty())
+    {
+        printf("usage: %s (--topo=file | --flows=file) --out=file [--text=1]\n", NAME);
+        return 1;
+    }
+
+    if (!topoFile.empty())
+    {
+        FlywayTopoTable table;
+        if (!table.Load(topoFile) || !table.WriteBinary(outFile))
+        {
+            printf("%s\n", table.GetError().c_str());
+            return 1;
+        }
+        printf("%s: topology written to %s\n", topoFile.c_str(), outFile.c_str());
+        return 0;
+    }
+
+    FlywayFlowTable table;
+    if (!table.Load(flowFile))
+    {
+        printf("%s\n", table.GetError().c_str());
+        return 1;
+    }
+    if (text)
+    {
+        FILE *out = fopen(outFile.c_str(), "w");
+        if (out == NULL)
+        {
+            printf("cannot write %s\n", outFile.c_str());
+            return 1;
+        }
+        WriteTextFlows(table, out);
+        fclose(out);
+    }
+    else if (!table.WriteBinary(outFile))
+    {
+        printf("%s\n", table.GetError().c_str());
+        return 1;
+    }
+    printf("%s: %u flows written to %s\n", flowFile.c_str(), table.GetN(), outFile.c_str());
+    return 0;
+}
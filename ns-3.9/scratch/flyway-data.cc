@@ -8,6 +8,7 @@
 #include "ns3/node-module.h"
 #include "ns3/helper-module.h"
 #include "ns3/flyways-topo-helper.h"
+#include "ns3/flyway-tables.h"
 #include "ns3/ipv4.h"
 #include "ns3/packet-sink.h"
 #include <time.h>
@@ -37,6 +38,10 @@ double maxDelay = 0;
 char topoFile[1000];
 char flowFile[1000];
 char outputFile[1000];
+char fctFile[1000];
+bool progress = false;
+bool eventStats = false;
+bool staticGeometry = false;
 double gain = 0;
 double maxTS = 0;
 
@@ -166,6 +171,9 @@ void SetSimulationDefaults()
     Config::SetDefault ("ns3::YansWifiPhy::RxNoiseFigure", DoubleValue(0.0));
     Config::SetDefault ("ns3::YansWifiPhy::EnergyDetectionThreshold", DoubleValue (-77));
     Config::SetDefault ("ns3::YansWifiPhy::CcaMode1Threshold", DoubleValue (80));
+    /* Racks do not move: the link budgets between dongles can be cached,
+     * at the cost of a dongles x dongles matrix per channel */
+    Config::SetDefault ("ns3::YansWifiChannel::StaticGeometry", BooleanValue (staticGeometry));
 
     /* On-off app is set to write infinite data, in 1MB chunks. Note that the rate of this app is the rate to 
      * socket writes. This should always be greater than the max rate TCP can
@@ -290,9 +298,17 @@ main (int argc, char **argv)
     cmd.AddValue ("topo", "topo file", topoFile);
     cmd.AddValue ("flow", "flow file", flowFile);
     cmd.AddValue ("gain", "gain", gain);
-    cmd.AddValue ("outfile", "outfile", outputFile);
+    cmd.AddValue ("fctfile", "file for the flow completion times, binary if it ends in .bin", fctFile);
+    cmd.AddValue ("progress", "print the bytes received by every flow each second [default 0, 1 with --outfile]", progress);
+    cmd.AddValue ("outfile", "file for the per-second progress, turns --progress on", outputFile);
+    cmd.AddValue ("eventstats", "print the counters of the event allocator at the end [default 0]", eventStats);
+    cmd.AddValue ("staticgeometry", "cache the link budgets between all pairs of dongles [default 0]", staticGeometry);
     cmd.Parse (argc, argv);
 
+    // Progress() is the only writer of the outfile.
+    if (outputFile[0] != '\0')
+        progress = true;
+
     // Set various default values.
     SetSimulationDefaults();
 
@@ -315,7 +331,8 @@ main (int argc, char **argv)
     ReadFlows(flowFile);
 
     // Measure throughput every 1 second.
-    Simulator::Schedule(Seconds(1), Progress);
+    if (progress)
+        Simulator::Schedule(Seconds(1), Progress);
 
     // Stop after all flows, plus 2 seconds. 
     Simulator::Stop(Seconds(maxTS + 2 + 0.001));
@@ -326,5 +343,22 @@ main (int argc, char **argv)
     start = epoch = time(NULL);
     Simulator::Run ();
 
+    if (fctFile[0] != 0)
+    {
+        FlywayCompletionTable &fct = fth->GetCompletions();
+        if (fct.Save(fctFile))
+            printf("%u of %u flows completed, written to %s\n", fct.GetNCompleted(), fct.GetN(), fctFile);
+        else
+            printf("%s\n", fct.GetError().c_str());
+    }
+
+    if (eventStats)
+    {
+        EventImpl::PoolCounters counters = EventImpl::GetPoolCounters();
+        printf("Events: %llu allocated, %llu recycled, %llu given back by other threads, %llu KB of pool\n",
+               (unsigned long long)counters.allocations, (unsigned long long)counters.recycled,
+               (unsigned long long)counters.returned, (unsigned long long)(counters.chunkBytes / 1024));
+    }
+
     Simulator::Destroy ();
 }
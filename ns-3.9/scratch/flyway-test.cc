@@ -8,6 +8,7 @@
 #include "ns3/node-module.h"
 #include "ns3/helper-module.h"
 #include "ns3/flyways-topo-helper.h"
+#include "ns3/flyway-tables.h"
 #include "ns3/ipv4.h"
 #include "ns3/packet-sink.h"
 #include <time.h>
@@ -33,6 +34,9 @@ time_t start;
 double maxDelay = 0;
 char topoFile[1000];
 char flowFile[1000];
+char fctFile[1000];
+bool progress = true;
+bool staticGeometry = false;
 double gain = 0;
 double maxTS = 0;
 
@@ -149,6 +153,9 @@ void SetSimulationDefaults()
     Config::SetDefault ("ns3::YansWifiPhy::RxNoiseFigure", DoubleValue(0.0));
     Config::SetDefault ("ns3::YansWifiPhy::EnergyDetectionThreshold", DoubleValue (-77));
     Config::SetDefault ("ns3::YansWifiPhy::CcaMode1Threshold", DoubleValue (80));
+    /* Racks do not move: the link budgets between dongles can be cached,
+     * at the cost of a dongles x dongles matrix per channel */
+    Config::SetDefault ("ns3::YansWifiChannel::StaticGeometry", BooleanValue (staticGeometry));
 
     /* On-off app is set to write infinite data, in 1MB chunks. Note that the rate of this app is the rate to 
      * socket writes. This should always be greater than the max rate TCP can
@@ -269,6 +276,9 @@ main (int argc, char **argv)
     cmd.AddValue ("topo", "topo file", topoFile);
     cmd.AddValue ("flow", "flow file", flowFile);
     cmd.AddValue ("gain", "gain", gain);
+    cmd.AddValue ("fctfile", "file for the flow completion times, binary if it ends in .bin", fctFile);
+    cmd.AddValue ("progress", "print the bytes received by every flow each second [default 1]", progress);
+    cmd.AddValue ("staticgeometry", "cache the link budgets between all pairs of dongles [default 0]", staticGeometry);
     cmd.Parse (argc, argv);
 
     // Set various default values.
@@ -292,7 +302,8 @@ main (int argc, char **argv)
     ReadFlows(flowFile);
 
     // Measure throughput every 1 second.
-    Simulator::Schedule(Seconds(1), Progress);
+    if (progress)
+        Simulator::Schedule(Seconds(1), Progress);
 
     // Stop after all flows, plus 2 seconds. 
     Simulator::Stop(Seconds(maxTS + 2 + 0.001));
@@ -301,5 +312,14 @@ main (int argc, char **argv)
     start = epoch = time(NULL);
     Simulator::Run ();
 
+    if (fctFile[0] != 0)
+    {
+        FlywayCompletionTable &fct = fth->GetCompletions();
+        if (fct.Save(fctFile))
+            printf("%u of %u flows completed, written to %s\n", fct.GetNCompleted(), fct.GetN(), fctFile);
+        else
+            printf("%s\n", fct.GetError().c_str());
+    }
+
     Simulator::Destroy ();
 }
@@ -0,0 +1,218 @@
+#define NAME "flyway-topo-bench"
+
+/*
+ * Measures how long FlywaysTopoHelper takes to build a data center, and
+ * how much memory it holds once built, for networks of growing numbers of
+ * racks:
+ *
+ *     flyway-topo-bench --topology=FatTree --racks=1000,2000,5000,10000
+ *
+ * The options not on the command line come from --topo, or are the
+ * defaults of FlywaysTopoHelper. A fat-tree gets the smallest even k with
+ * at least the racks asked for; the other topologies get exactly that
+ * many ToRs; a leaf-spine without Spines gets 16 of them.
+ *
+ * Each size is built in a child of its own, so that what one build has
+ * allocated does not hide the next one. The child writes one row to
+ * outfile:
+ *
+ *     topology,racks,nodes,links,build_s,us_per_rack,rss_mb,kb_per_rack
+ *
+ * where rss_mb is what the build added to the resident size of the
+ * process. With --routing=1, the global routes are computed as part of
+ * the build.
+ */
+
+#include <string>
+#include <sstream>
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/flyways-topo-helper.h"
+#include "ns3/flyway-tables.h"
+#include "ns3/flyway-topology-plan.h"
+#include <sys/time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace std;
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("flyway-topo-bench");
+
+/* The resident size of this process, in bytes. */
+double ResidentBytes()
+{
+    FILE *f = fopen("/proc/self/statm", "r");
+    long size = 0, resident = 0;
+    if (f == NULL)
+        return 0;
+    if (fscanf(f, "%ld %ld", &size, &resident) != 2)
+        resident = 0;
+    fclose(f);
+    return (double)resident * sysconf(_SC_PAGESIZE);
+}
+
+double WallClockSeconds()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+string TopologyName(FW_Topology topology)
+{
+    switch (topology)
+    {
+    case FW_Topo_FatTree:
+        return "FatTree";
+    case FW_Topo_VL2:
+        return "VL2";
+    case FW_Topo_LeafSpine:
+        return "LeafSpine";
+    default:
+        return "Classic";
+    }
+}
+
+bool ParseTopology(string name, FW_Topology *topology)
+{
+    if (name == "Classic")
+        *topology = FW_Topo_Classic;
+    else if (name == "FatTree")
+        *topology = FW_Topo_FatTree;
+    else if (name == "VL2")
+        *topology = FW_Topo_VL2;
+    else if (name == "LeafSpine")
+        *topology = FW_Topo_LeafSpine;
+    else
+        return false;
+    return true;
+}
+
+/* Build a data center of about racks racks, in this process, and append
+ * its row to outFile. */
+void Bench(GlobalOpt options, string name, uint32_t racks, bool routing, string outFile, bool quiet)
+{
+    if (options.topology == FW_Topo_FatTree)
+    {
+        uint32_t k = 2;
+        while (k * k / 2 < racks)
+            k += 2;
+        options.fatTreeK = k;
+    }
+    else
+        options.numTors = racks;
+    FlywayTopologyPlan plan = FlywayTopologyPlan::Generate(options);
+
+    ostringstream oss;
+    oss << "/tmp/" << NAME << "-" << getpid() << ".bin";
+    string topoFile = oss.str();
+    FlywayTopoTable table(options);
+    if (!table.WriteBinary(topoFile))
+    {
+        printf("%s\n", table.GetError().c_str());
+        exit(-1);
+    }
+
+    // the helper tells about every rack it places
+    fflush(NULL);
+    if (quiet && freopen("/dev/null", "w", stdout) == NULL)
+        exit(-1);
+
+    InternetStackHelper stack;
+    Ipv4AddressHelper address;
+    // a /30 per link: the /16s of the other drivers run out at 64k links
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    double rss = ResidentBytes();
+    double start = WallClockSeconds();
+    FlywaysTopoHelper *fth = new FlywaysTopoHelper(const_cast<char *>(topoFile.c_str()), stack, address);
+    if (routing)
+        Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    double seconds = WallClockSeconds() - start;
+    rss = ResidentBytes() - rss;
+    remove(topoFile.c_str());
+
+    uint32_t numRacks = fth->GetNumToRs();
+    FILE *out = fopen(outFile.c_str(), "a");
+    if (out == NULL)
+        exit(-1);
+    fprintf(out, "%s,%u,%d,%u,%.3f,%.1f,%.1f,%.2f\n", name.c_str(), numRacks, fth->GetNumNodes(),
+            plan.GetNLinks(), seconds, seconds * 1e6 / numRacks, rss / 1048576, rss / 1024 / numRacks);
+    fclose(out);
+    fprintf(stderr, "%s %u racks: %.3f s, %.1f MB\n", name.c_str(), numRacks, seconds, rss / 1048576);
+}
+
+int
+main (int argc, char **argv)
+{
+    string topoFile;
+    string topology;
+    string racks = "1000,2000,5000,10000";
+    string outFile = "topo-bench.csv";
+    bool routing = false;
+    bool quiet = true;
+
+    CommandLine cmd;
+    cmd.AddValue ("topo", "topo file with the options of the network [default none]", topoFile);
+    cmd.AddValue ("topology", "Classic, FatTree, VL2 or LeafSpine [default that of the topo file]", topology);
+    cmd.AddValue ("racks", "comma separated numbers of racks [default 1000,2000,5000,10000]", racks);
+    cmd.AddValue ("outfile", "csv file for the results [default topo-bench.csv]", outFile);
+    cmd.AddValue ("routing", "compute the global routes as part of the build [default 0]", routing);
+    cmd.AddValue ("quiet", "hide what the helper prints while building [default 1]", quiet);
+    cmd.Parse (argc, argv);
+
+    FlywayTopoTable table;
+    if (!topoFile.empty() && !table.Load(topoFile))
+    {
+        printf("%s\n", table.GetError().c_str());
+        exit(-1);
+    }
+    GlobalOpt options = table.Get();
+    if (!topology.empty() && !ParseTopology(topology, &options.topology))
+    {
+        printf("unknown topology %s\n", topology.c_str());
+        exit(-1);
+    }
+    topology = TopologyName(options.topology);
+    if (options.topology == FW_Topo_LeafSpine && options.numSpines <= 0)
+        options.numSpines = 16;
+
+    FILE *out = fopen(outFile.c_str(), "w");
+    if (out == NULL)
+    {
+        printf("cannot open results file: %s\n", outFile.c_str());
+        exit(-1);
+    }
+    fprintf(out, "topology,racks,nodes,links,build_s,us_per_rack,rss_mb,kb_per_rack\n");
+    fclose(out);
+
+    istringstream sizes(racks);
+    string size;
+    bool ok = true;
+    while (getline(sizes, size, ','))
+    {
+        fflush(NULL);
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            perror("fork");
+            exit(-1);
+        }
+        if (pid == 0)
+        {
+            Bench(options, topology, atoi(size.c_str()), routing, outFile, quiet);
+            exit(0);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            printf("building %s racks failed\n", size.c_str());
+            ok = false;
+        }
+    }
+    return ok ? 0 : -1;
+}
@@ -61,6 +61,10 @@ else:
 
 num_files = args['num_flows'] 
 
+# one flyway-batch job per (flow log, allocation) pair
+manifest_h = open('%s/manifest.txt' % (base_output_fn), 'w')
+manifest_h.write('# label flowFile allocationFile gain\n')
+
 for file_num in range(num_files):
 	output_fn_flows = '%s/flows__%d.dat' % (base_output_fn, file_num)
 
@@ -124,6 +128,7 @@ for file_num in range(num_files):
 			allocation_h.write('\n')
 
 		allocation_h.close()
+		manifest_h.write('%d_%d %s %s/alloc__%d_%d.dat 25\n' % (file_num, k, output_fn_flows, base_output_fn, file_num, k))
 
 		total_num_allocs += 1
 
@@ -132,3 +137,5 @@ for file_num in range(num_files):
 
 
 
+
+manifest_h.close()
@@ -8,6 +8,8 @@
 #include "ns3/node-module.h"
 #include "ns3/helper-module.h"
 #include "ns3/flyways-topo-helper.h"
+#include "ns3/flyway-feasibility-engine.h"
+#include "ns3/flyway-channel-assigner.h"
 #include "ns3/ipv4.h"
 #include "ns3/packet-sink.h"
 #include "ns3/measured-2d-antenna.h"
@@ -25,6 +27,8 @@ NS_LOG_COMPONENT_DEFINE ("flyway-sim-full");
 Ipv4AddressHelper address;
 InternetStackHelper stack;
 FlywaysTopoHelper *fth;
+FlywayFeasibilityEngine *engine;
+FlywayChannelAssigner *assigner;
 
 char topoFile[1000];
 char flywayFile[1000];
@@ -44,34 +48,12 @@ double gain = 23;
 double rssiThreshold = -62;
 uint numChannels = 3;
 
-struct Flyway 
-{
-    int from;
-    int dongleFrom;
-    int to;
-    int dongleTo;
-    int channel;
-};
-
-vector < Flyway > flyways;
+typedef FlywayChannelAssigner::Flyway Flyway;
+
 vector < Flyway > init_flyways;
 vector < double > flywayRates;
-vector < int  >::iterator nodesIT;
-map <int, bool> nodesWithFlyways[3];
 vector < vector<Flyway> > candidates;
-uint dongleCounts[1000];
-
 
-double FindRateForRSSI(double rssi)
-{
-    double rate = 0;
-    for (uint i = 0; i < num_rates; i++) 
-    {
-        if (rssi > mcsLimits[i]) 
-            rate = rates[i];
-    }
-    return rate;
-}
 
 void PointAllNowhere()
 {
@@ -124,127 +106,6 @@ void SetSimulationDefaults()
     Config::SetDefault ("ns3::TcpSocket::ConnTimeout", TimeValue(Seconds(0.01)));
 }
 
-double WorstCaseNoiseFromFlywayToNode(Flyway f, int b, int dongleId)
-{
-    double worstCaseNoise = 0;
-    double noiseFromSender =  fth->CalcSignalStrength(f.from, f.dongleFrom,
-            b, dongleId);
-    worstCaseNoise += pow(10, noiseFromSender/10);
-    double noiseFromReceiver = fth->CalcSignalStrength(f.to, f.dongleTo, 
-            b, dongleId);;
-    worstCaseNoise += pow(10, noiseFromReceiver/10);
-    double worstCaseNoisedBm = 10 * log10(worstCaseNoise);
-    return worstCaseNoisedBm;
-    
-}
-
-bool IsLinkFeasible(int index, double *rate)
-{
-    Flyway f = flyways[index];
-    *rate = 0; 
-
-    double rssi = fth->CalcSignalStrength(f.from, f.dongleFrom,
-            f.to, f.dongleTo);
-
-    // Check noise generated by other flyways.
-    // We will be super-conservative. We will assume
-    // that both *sender* and *receiver* of the other
-    // links are active *at the same time*. 
-   
-    double noiseAtSender = pow (10, baselineNoisedBm/10);
-    double noiseAtReceiver = pow (10, baselineNoisedBm/10);
-    double noise;
-    for (int i = 0; i < (int)flyways.size(); i++) 
-    {
-        if (i == index) 
-            continue;
-
-        if (f.channel != flyways[i].channel)
-            continue;
-        noise = WorstCaseNoiseFromFlywayToNode(flyways[i], f.from, f.dongleFrom);
-        noiseAtSender += pow(10, noise/10.0);
-        //printf ("noise from %d=>%d at %d is %f dbM. Total %g\n", flyways[i].from, flyways[i].to, f.from, noise, noiseAtSender);
-        noise = WorstCaseNoiseFromFlywayToNode(flyways[i], f.to, f.dongleTo);
-        noiseAtReceiver += pow(10, noise/10.0);
-        //printf ("noise from %d=>%d at %d is %f dbM. Total %g\n", flyways[i].from, flyways[i].to, f.to, noise, noiseAtReceiver);
-    }
-
-    if (noiseAtSender == 0 && noiseAtReceiver == 0)
-        return true;
-
-    // Check sender
-    if (noiseAtSender != 0) 
-    {
-        noiseAtSender = 10 * log10(noiseAtSender);
-        //printf ("ns=%g\n", noiseAtSender);
-        // CCA
-        //if (noiseAtSender > -77) 
-        //    return false;
-
-        // Can we receive acks?
-        double rssi_adjust = rssi - (-1 * baselineNoisedBm) + (-1 * noiseAtSender);
-        if (!(rssi_adjust - 3 > rssiThreshold)) {
-            return false;
-        }
-    }
-
-    // Check  receiver.
-    if (noiseAtReceiver != 0) 
-    {
-        noiseAtReceiver = 10 * log10(noiseAtReceiver);
-        //printf ("nr=%g\n", noiseAtReceiver);
-        // CCA
-        //if (noiseAtReceiver > -77) 
-        //    return false;
-        
-        // Check if we have enough margin  to do what we need to do.
-        double rssi_adjust = rssi - (-1 * baselineNoisedBm) + (-1 * noiseAtReceiver);
-        /*
-        printf ("%d=>%d rssiThresh=%f noiseAtReceiver=%f base=%f needed=%f rssi=%f\n",  
-                f.from, 
-                f.to, 
-                rssiThreshold, 
-                noiseAtReceiver, 
-                baselineNoisedBm, 
-                needed, 
-                rssi);
-        */
-        if (rssi_adjust - 3 > rssiThreshold) {
-            /*
-                printf ("%d=>%d rssiThresh=%f noiseAtReceiver=%f base=%f needed=%f rssi=%f\n",  
-                    f.from, 
-                    f.to, 
-                    rssiThreshold, 
-                    noiseAtReceiver, 
-                    baselineNoisedBm, 
-                    needed, 
-                    rssi);
-                    */
-            *rate = FindRateForRSSI(rssi_adjust-3);
-            return true;
-        }
-        else {
-            return false;
-        }
-    }
-    printf ("should never come here\n");
-    exit(-1);
-}
-
-bool IsFlywaySetFeasible ()
-{
-    flywayRates.clear();
-    for (int i = 0; i < (int)flyways.size(); i++) 
-    {
-        double rate = 0;
-        if (!IsLinkFeasible(i, &rate))
-            return false;
-        else 
-            flywayRates.push_back(rate);
-    }
-    return true;
-}
-
 void fPrintFlywayChan (FILE* fp, vector <Flyway> c)
 {
     for (unsigned int i=0; i < c.size(); ++i)
@@ -306,20 +167,8 @@ bool ReadFlyways()
             break;
 
         f.channel = -1;
-        f.dongleFrom = dongleCounts[f.from];
-        dongleCounts[f.from]++;
-        f.dongleTo = dongleCounts[f.to];
-        dongleCounts[f.to]++;
-
-        if (dongleCounts[f.from] > fth->GetNumDongles() ||
-            dongleCounts[f.to] > fth->GetNumDongles())
-        {
-            printf("%d %d %d\n", dongleCounts[f.from], dongleCounts[f.to], fth->GetNumDongles());
-            printf("Returning false 0\n");
-            ret = false;
-            goto out;
-        }
-
+        f.dongleFrom = -1;
+        f.dongleTo = -1;
 
         /* Add this flyway to list */
         init_flyways.push_back(f);
@@ -363,126 +212,26 @@ out:
     return ret;
 }
 
-bool CheckAddFlyways(vector<Flyway> flyList, bool pop_after)
-{
-    /* Can we assign channels to the flyways we have? */
-    static int cur_chan = 0;
-    int old_cur_chan = cur_chan;
-    bool ret;
-    unsigned int orig_len = flyways.size();
-    for (unsigned int i=0; i < flyList.size(); ++i)
-    {
-        /* Validate basic flyway stuff */
-        if (flyList[i].from == flyList[i].to)
-        {
-            ret = false;
-            goto out;
-        }
-
-        /* do we need to set dongle ids? */
-        if (pop_after)
-        {
-            assert((flyList[i].dongleFrom == -1) && (flyList[i].dongleTo == -1));
-
-            /* Are we out of dongles? */
-            if (dongleCounts[flyList[i].to] >= fth->GetNumDongles() ||
-                dongleCounts[flyList[i].from] >= fth->GetNumDongles())
-            {
-                ret = false;
-                goto out;
-            }
-
-            /* Set dongle IDs */
-            flyList[i].dongleFrom = dongleCounts[flyList[i].from];
-            dongleCounts[flyList[i].from]++;
-            flyList[i].dongleTo = dongleCounts[flyList[i].to];
-            dongleCounts[flyList[i].to]++;
-        }
-
-        flyList[i].channel = -1;
-        for (uint c=0; c < numChannels; ++c)
-        { 
-            unsigned int d = (c + cur_chan) % numChannels;
-
-            /* Are both nodes free on this channel? */
-            if (nodesWithFlyways[d].find(flyList[i].from) !=
-                    nodesWithFlyways[d].end())
-                continue;
-            if (nodesWithFlyways[d].find(flyList[i].to) !=
-                    nodesWithFlyways[d].end())
-                continue;
-
-            flyList[i].channel = d;
-            /* Is it strong enough on this channel? */
-            fth->PointAtEachOther(flyList[i].from, flyList[i].dongleFrom, flyList[i].to, flyList[i].dongleTo);
-            double rssi = fth->CalcSignalStrength(flyList[i].from, flyList[i].dongleFrom, flyList[i].to, flyList[i].dongleTo);
-            if (rssi < rssiThreshold + 3)
-            {
-                flyList[i].channel = -1;
-                continue;
-            }
-
-            /* Is it feasible on this channel? */
-            flyways.push_back(flyList[i]);
-            if (!IsFlywaySetFeasible())
-            {
-                flyways.pop_back();
-                flyList[i].channel = -1;
-                continue;
-            }
-
-            nodesWithFlyways[d][flyList[i].to] = true;
-            nodesWithFlyways[d][flyList[i].from] = true;
-            break;
-        }
-
-        if (flyList[i].channel == -1)
-        {
-            ret = false;
-            dongleCounts[flyList[i].from]--;
-            dongleCounts[flyList[i].to]--;
-            goto out;
-        }
-        cur_chan = (cur_chan+1) % numChannels;
-    }
-
-    /* If we get here, our flyway set is good */
-    ret = true;
-    PrintFlywayChan(flyways);
-    printf("\n");
-out:
-    /* Are we supposed to pop afterwards? */
-    if (pop_after)
-    {
-        cur_chan = old_cur_chan;
-        while (flyways.size() > orig_len)
-        {
-            Flyway f = flyways.back();
-            if (f.channel != -1)
-            {
-                nodesWithFlyways[f.channel].erase(f.to);
-                nodesWithFlyways[f.channel].erase(f.from);
-                f.channel = -1;
-            }
-            dongleCounts[f.from]--;
-            dongleCounts[f.to]--;
-            f.dongleFrom = -1;
-            f.dongleTo = -1;
-            flyways.pop_back();
-        }
-    }
-
-    return ret;
-}
-
 bool InitializeFlyways()
 {
-    return CheckAddFlyways(init_flyways, false);
+    if (!assigner->Add(init_flyways))
+        return false;
+    vector<Flyway> assigned;
+    for (uint i = 0; i < assigner->GetN(); ++i)
+        assigned.push_back(assigner->Get(i));
+    PrintFlywayChan(assigned);
+    printf("\n");
+    return true;
 }
 
 bool CheckCandidate(vector<Flyway> candidate)
 {
-    return CheckAddFlyways(candidate, true);
+    vector<Flyway> assigned;
+    if (!assigner->Check(candidate, &assigned, &flywayRates))
+        return false;
+    PrintFlywayChan(assigned);
+    printf("\n");
+    return true;
 }
     
 void CheckFeasibility()
@@ -542,12 +291,14 @@ main (int argc, char **argv)
     srand(time(NULL));
     //srand(0);
     bool use_ofdm = 1;
+    string strategy = "ns3::GreedyFlywayChannelStrategy";
     
     CommandLine cmd;
     cmd.AddValue ("topo", "topo file", topoFile);
     cmd.AddValue ("flyways", "flyway file", flywayFile);
     cmd.AddValue ("gain", "antenna gain", gain);
     cmd.AddValue ("min_rssi", "min rssi [default -62]", rssiThreshold);
+    cmd.AddValue ("strategy", "channel assignment strategy [default ns3::GreedyFlywayChannelStrategy]", strategy);
     cmd.AddValue ("numChannels", "num channels [default 3]", numChannels);
     cmd.AddValue ("use_ofdm", "use ofdm [default true]", use_ofdm);
     cmd.Parse (argc, argv);
@@ -562,9 +313,9 @@ main (int argc, char **argv)
     fth = new FlywaysTopoHelper(topoFile, stack, address);
 
     /* Verify parameters */
-    if (numChannels < 1 || numChannels > 3)
+    if (numChannels < 1)
     {
-        printf("Error: numChannels must be [1,3]\n");
+        printf("Error: numChannels must be at least 1\n");
         exit(0);
     }
     if (numChannels < fth->GetNumDongles())
@@ -585,6 +336,15 @@ main (int argc, char **argv)
         num_rates = 17;
     }
 
+    engine = new FlywayFeasibilityEngine(fth);
+    engine->SetBaselineNoise(baselineNoisedBm);
+    engine->SetRssiThreshold(rssiThreshold);
+    engine->SetRates(vector<double>(mcsLimits, mcsLimits + num_rates),
+                     vector<double>(rates, rates + num_rates));
+    assigner = new FlywayChannelAssigner(fth, engine);
+    assigner->SetNumChannels(numChannels);
+    assigner->SetStrategy(strategy);
+
     // Set up initial state. 
     PointAllNowhere();
     SetAllGain(gain);
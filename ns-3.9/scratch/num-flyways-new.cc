@@ -8,6 +8,8 @@
 #include "ns3/node-module.h"
 #include "ns3/helper-module.h"
 #include "ns3/flyways-topo-helper.h"
+#include "ns3/flyway-feasibility-engine.h"
+#include "ns3/flyway-channel-assigner.h"
 #include "ns3/ipv4.h"
 #include "ns3/packet-sink.h"
 #include "ns3/measured-2d-antenna.h"
@@ -26,6 +28,8 @@ NS_LOG_COMPONENT_DEFINE ("flyway-sim-full");
 Ipv4AddressHelper address;
 InternetStackHelper stack;
 FlywaysTopoHelper *fth;
+FlywayFeasibilityEngine *engine;
+FlywayChannelAssigner *assigner;
 
 char topoFile[1000];
 
@@ -45,35 +49,13 @@ double rssiThreshold = -68;
 uint numChannels = 3;
 bool cca = false;
 
-struct Flyway 
-{
-    int from;
-    int dongleFrom;
-    int to;
-    int dongleTo;
-    int channel;
-};
-
-vector < Flyway > flyways;
-vector < double > flywayRates;
+typedef FlywayChannelAssigner::Flyway Flyway;
+
 vector < double > lastFeasible;
 vector < int > nodes;
-map <int, bool> nodesWithFlyways[3];
 vector < vector<Flyway> > candidates;
-uint dongleCounts[1000];
 
 
-double FindRateForRSSI(double rssi)
-{
-    double rate = 0;
-    for (int i = 0; i < 17; i++) 
-    {
-        if (rssi > mcsAllThresholds[i]) 
-            rate = rates[i];
-    }
-    return rate;
-}
-
 void PointAllNowhere()
 {
     for (int i = 0; i < fth->GetNumFlyways(); ++i)
@@ -125,125 +107,6 @@ void SetSimulationDefaults()
     Config::SetDefault ("ns3::TcpSocket::ConnTimeout", TimeValue(Seconds(0.01)));
 }
 
-double WorstCaseNoiseFromFlywayToNode(Flyway f, int b, int dongleId)
-{
-    double worstCaseNoise = 0;
-    double noiseFromSender =  fth->CalcSignalStrength(f.from, f.dongleFrom,
-            b, dongleId);
-    worstCaseNoise += pow(10, noiseFromSender/10);
-    double noiseFromReceiver = fth->CalcSignalStrength(f.to, f.dongleTo, 
-            b, dongleId);;
-    worstCaseNoise += pow(10, noiseFromReceiver/10);
-    double worstCaseNoisedBm = 10 * log10(worstCaseNoise);
-    return worstCaseNoisedBm;
-    
-}
-
-bool IsLinkFeasible(int index, double *rate)
-{
-    Flyway f = flyways[index];
-    *rate = 0; 
-
-    double rssi = fth->CalcSignalStrength(f.from, f.dongleFrom,
-            f.to, f.dongleTo);
-
-    // Check noise generated by other flyways.
-    // We will be super-conservative. We will assume
-    // that both *sender* and *receiver* of the other
-    // links are active *at the same time*. 
-   
-    double noiseAtSender = pow (10, baselineNoisedBm/10);
-    double noiseAtReceiver = pow (10, baselineNoisedBm/10);
-    double noise;
-    for (int i = 0; i < (int)flyways.size(); i++) 
-    {
-        if (i == index) 
-            continue;
-
-        if (f.channel != flyways[i].channel)
-            continue;
-        noise = WorstCaseNoiseFromFlywayToNode(flyways[i], f.from, f.dongleFrom);
-        noiseAtSender += pow(10, noise/10.0);
-        //printf ("noise from %d=>%d at %d is %f dbM. Total %g\n", flyways[i].from, flyways[i].to, f.from, noise, noiseAtSender);
-        noise = WorstCaseNoiseFromFlywayToNode(flyways[i], f.to, f.dongleTo);
-        noiseAtReceiver += pow(10, noise/10.0);
-        //printf ("noise from %d=>%d at %d is %f dbM. Total %g\n", flyways[i].from, flyways[i].to, f.to, noise, noiseAtReceiver);
-    }
-
-    if (noiseAtSender == 0 && noiseAtReceiver == 0)
-        return true;
-
-    // Check sender
-    if (noiseAtSender != 0) 
-    {
-        noiseAtSender = 10 * log10(noiseAtSender);
-        //printf ("ns=%g\n", noiseAtSender);
-        if (cca && noiseAtSender > -77) 
-            return false;
-
-        // Can we receive acks?
-        double rssi_adjust = rssi - (-1 * baselineNoisedBm) + (-1 * noiseAtSender);
-        if (!(rssi_adjust - 3 > rssiThreshold)) {
-            return false;
-        }
-    }
-
-    // Check  receiver.
-    if (noiseAtReceiver != 0) 
-    {
-        noiseAtReceiver = 10 * log10(noiseAtReceiver);
-        //printf ("nr=%g\n", noiseAtReceiver);
-        if (cca && noiseAtReceiver > -77) 
-            return false;
-        
-        // Check if we have enough margin  to do what we need to do.
-        double rssi_adjust = rssi - (-1 * baselineNoisedBm) + (-1 * noiseAtReceiver);
-        /*
-        printf ("%d=>%d rssiThresh=%f noiseAtReceiver=%f base=%f needed=%f rssi=%f\n",  
-                f.from, 
-                f.to, 
-                rssiThreshold, 
-                noiseAtReceiver, 
-                baselineNoisedBm, 
-                needed, 
-                rssi);
-        */
-        if (rssi_adjust - 3 > rssiThreshold) {
-            /*
-                printf ("%d=>%d rssiThresh=%f noiseAtReceiver=%f base=%f needed=%f rssi=%f\n",  
-                    f.from, 
-                    f.to, 
-                    rssiThreshold, 
-                    noiseAtReceiver, 
-                    baselineNoisedBm, 
-                    needed, 
-                    rssi);
-                    */
-            *rate = FindRateForRSSI(rssi_adjust-3);
-            return true;
-        }
-        else {
-            return false;
-        }
-    }
-    printf ("should never come here\n");
-    exit(-1);
-}
-
-bool IsFlywaySetFeasible ()
-{
-    flywayRates.clear();
-    for (int i = 0; i < (int)flyways.size(); i++) 
-    {
-        double rate = 0;
-        if (!IsLinkFeasible(i, &rate))
-            return false;
-        else 
-            flywayRates.push_back(rate);
-    }
-    return true;
-}
-
 void fPrintFlywayChan (FILE* fp, vector <Flyway> c)
 {
     for (unsigned int i=0; i < c.size(); ++i)
@@ -274,42 +137,6 @@ void PrintFlyway (vector <Flyway> c)
     fPrintFlyway (stdout, c);
 }
 
-bool FindFlywayChannel(Flyway &f)
-{
-    static int cur_chan = 0;
-
-    for (uint c=0; c < numChannels; ++c)
-    { 
-        unsigned int d = (c + cur_chan) % numChannels;
-
-        /* Are both nodes free on this channel? */
-        if (nodesWithFlyways[d].find(f.from) != nodesWithFlyways[d].end())
-            continue;
-        if (nodesWithFlyways[d].find(f.to) != nodesWithFlyways[d].end())
-            continue;
-
-        f.channel = d;
-
-        /* Is it feasible on this channel? */
-        flyways.push_back(f);
-        if (!IsFlywaySetFeasible())
-        {
-            flyways.pop_back();
-            f.channel = -1;
-            continue;
-        }
-
-        nodesWithFlyways[d][f.to] = true;
-        nodesWithFlyways[d][f.from] = true;
-        break;
-    }
-
-    if (f.channel == -1)
-        return false;
-    cur_chan = (cur_chan+1) % numChannels;
-    return true;
-}
-
 void RandomizeNodeOrder()
 {
     nodes.clear();
@@ -325,13 +152,10 @@ void RandomizeNodeOrder()
 void RunTrial(int trial)
 {
     /* Reset all state */
-    flyways.clear();
-    flywayRates.clear();
+    assigner->Clear();
+    engine->SetRssiThreshold(rssiThreshold);
     PointAllNowhere();
     SetAllGain(gain);
-    for (uint c = 0; c < numChannels; ++c)
-        nodesWithFlyways[c].clear();
-    memset(dongleCounts, 0, sizeof(dongleCounts));
 
     /* Randomize things for this trial */
     srand(trial + time(NULL));
@@ -360,69 +184,33 @@ void RunTrial(int trial)
             /* Set up this flyway struct */
             Flyway f;
             f.from = nodes[s];
+            f.dongleFrom = -1;
             f.to = nodes[d];
+            f.dongleTo = -1;
             f.channel = -1;
 
-
-            /* Are there too many dongles already? */
-            if (dongleCounts[nodes[s]] >= fth->GetNumDongles() ||
-                dongleCounts[nodes[d]] >= fth->GetNumDongles())
+            if (assigner->Add(vector<Flyway>(1, f)))
             {
-                ++noFreeDongle;
+                ++numValid;
+                printf("trial=%d flyway=%d (%d=>%d)\n", trial, numValid,
+                        f.from, f.to);
+                assigner->GetRates(&lastFeasible);
                 continue;
             }
-            /* Set them otherwise */
-            f.dongleFrom = dongleCounts[f.from];
-            dongleCounts[f.from]++;
-            f.dongleTo = dongleCounts[f.to];
-            dongleCounts[f.to]++;
-
-
-            /* Are they free on the same channel? */
-            bool flag = false;
-            for (uint c = 0; c < numChannels; ++c)
+            switch (assigner->GetFailure())
             {
-                if (nodesWithFlyways[c].find(nodes[s]) !=
-                        nodesWithFlyways[c].end())
-                    continue;
-                if (nodesWithFlyways[c].find(nodes[d]) !=
-                        nodesWithFlyways[c].end())
-                    continue;
-                flag = true;
+            case FlywayChannelAssigner::NO_FREE_DONGLE:
+                ++noFreeDongle;
                 break;
-            }
-            if (!flag)
-            {
+            case FlywayChannelAssigner::NO_FREE_CHANNEL:
                 ++noFreeChannel;
-                dongleCounts[f.from]--;
-                dongleCounts[f.to]--;
-                continue;
-            }
-
-            /* Is it strong enough on this channel? */
-            fth->PointAtEachOther(f.from, f.dongleFrom, f.to, f.dongleTo);
-            double rssi = fth->CalcSignalStrength(f.from, f.dongleFrom, f.to, f.dongleTo);
-            if (rssi < rssiThreshold + 3)
-            {
-                f.channel = -1;
+                break;
+            case FlywayChannelAssigner::TOO_WEAK:
                 ++tooFar;
-                dongleCounts[f.from]--;
-                dongleCounts[f.to]--;
-                continue;
-            }
-
-            if (FindFlywayChannel(f))
-            {
-                ++numValid;
-                printf("trial=%d flyway=%d (%d=>%d)\n", trial, numValid,
-                        f.from, f.to);
-                lastFeasible = flywayRates;
-            }
-            else
-            {
-                hurtsOthers++;
-                dongleCounts[f.from]--;
-                dongleCounts[f.to]--;
+                break;
+            default:
+                ++hurtsOthers;
+                break;
             }
         }
     }
@@ -435,6 +223,9 @@ void RunTrial(int trial)
         capacity += lastFeasible[i];
     }
     printf("\n");
+    vector<Flyway> flyways;
+    for (uint i = 0; i < assigner->GetN(); ++i)
+        flyways.push_back(assigner->Get(i));
     PrintFlywayChan(flyways);
     printf("\n");
     printf("trial=%d gain=%d thresh=%d total=%d valid=%d sameEndPoint=%d noFreeDongle=%d noFreeChannel=%d tooFar=%d hurtsOthers=%d tot=%.1f",
@@ -471,9 +262,11 @@ main (int argc, char **argv)
     /* Initialize Randomness */
     srand(time(NULL));
     //srand(0);
+    string strategy = "ns3::GreedyFlywayChannelStrategy";
     
     CommandLine cmd;
     cmd.AddValue ("topo", "topo file", topoFile);
+    cmd.AddValue ("strategy", "channel assignment strategy [default ns3::GreedyFlywayChannelStrategy]", strategy);
     cmd.AddValue ("numChannels", "num channels", numChannels);
     cmd.AddValue ("cca", "do cca", cca);
     cmd.Parse (argc, argv);
@@ -488,9 +281,9 @@ main (int argc, char **argv)
     fth = new FlywaysTopoHelper(topoFile, stack, address);
 
     /* Verify parameters */
-    if (numChannels < 1 || numChannels > 3)
+    if (numChannels < 1)
     {
-        printf("Error: numChannels must be [1,3]\n");
+        printf("Error: numChannels must be at least 1\n");
         exit(0);
     }
     if (numChannels < fth->GetNumDongles())
@@ -498,6 +291,16 @@ main (int argc, char **argv)
         printf("Warning: numChannels %d < numDongles %d\n", numChannels, fth->GetNumDongles());
     }
 
+    engine = new FlywayFeasibilityEngine(fth);
+    engine->SetBaselineNoise(baselineNoisedBm);
+    engine->SetRates(vector<double>(mcsAllThresholds, mcsAllThresholds + 17),
+                     vector<double>(rates, rates + 17));
+    if (cca)
+        engine->SetCcaThreshold(-77);
+    assigner = new FlywayChannelAssigner(fth, engine);
+    assigner->SetNumChannels(numChannels);
+    assigner->SetStrategy(strategy);
+
     /* Calculate number of flyways! */
     CalcNumFlyways();
 
@@ -9,6 +9,7 @@ if __name__ == "__main__":
     parser.add_argument('-f','--flow_dir', help='flow log/allocations dir', required=True)
     parser.add_argument('-r','--results_dir', help='ns-3 simulation results directory', required=True)
     parser.add_argument('-g','--gain', help='Antenna Gain for each of the TOR antennas', type=float, default=25.0)
+    parser.add_argument('-w','--workers', help='number of simulations to run at once', type=int, default=1)
     args = vars(parser.parse_args())
 
     flow_dir = args['flow_dir'] 
@@ -27,18 +28,27 @@ if __name__ == "__main__":
     flow_files = glob.glob('%s/flows*.dat' % (flow_dir))
     gain = 25
 
+    # One job per (flow log, allocation) pair, all run by a single
+    # flyway-batch, which builds the topology once and forks every job
+    # from it instead of paying for waf, process start-up and topology
+    # set-up every time, and runs up to --workers jobs at once.
+    manifest_fn = "%s/manifest.txt" % (results_base)
+    manifest = open(manifest_fn, "w")
     for flow_log in flow_files:
         flow_log_id = int(flow_log.split("__")[1].split(".")[0])
         print flow_log_id
         link_configs = glob.glob("%s/alloc__%d_*" % (flow_dir, flow_log_id))
         for link_config in link_configs:
             link_config_id = int(link_config.split("_")[-1].split('.')[0])
-            output_fn = "%s/%d_%d.txt" % (results_base, flow_log_id, link_config_id)
-            cmd = "./waf --run \"flyway-data \
-                        --topo=scratch/topo-search.dat \
-                        --flow=scratch/%s \
-                        --outfile=scratch/%s \
-                        --gain=%02f\"" % (link_config, output_fn, gain)
-            print cmd
-            os.system("cd ~/Research/datacenter/mldc_ns3/ns-3.9/; " + cmd)
+            manifest.write("%d_%d scratch/%s - %02f\n" % (flow_log_id, link_config_id, link_config, gain))
+    manifest.close()
 
+    output_fn = "%s/results.csv" % (results_base)
+    cmd = "./waf --run \"flyway-batch \
+                --topo=scratch/topo-search.dat \
+                --manifest=scratch/%s \
+                --outfile=scratch/%s \
+                --snapshot=1 \
+                --workers=%d\"" % (manifest_fn, output_fn, args['workers'])
+    print cmd
+    os.system("cd ~/Research/datacenter/mldc_ns3/ns-3.9/; " + cmd)
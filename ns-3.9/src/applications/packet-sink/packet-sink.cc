@@ -54,6 +54,8 @@ PacketSink::GetTypeId (void)
                    MakeTypeIdChecker ())
     .AddTraceSource ("Rx", "A packet has been received",
                      MakeTraceSourceAccessor (&PacketSink::m_rxTrace))
+    .AddTraceSource ("Finished", "All the bytes expected have been received",
+                     MakeTraceSourceAccessor (&PacketSink::m_finishedTrace))
     ;
   return tid;
 }
@@ -188,6 +190,11 @@ void PacketSink::HandleRead (Ptr<Socket> socket)
               //std::cout << "==> stopping the receiver" <<  " " << m_expected << " " << m_totalRx << " " << packet->GetSize() << std::endl;
               m_whenFinished = Simulator::Now ();
               StopApplication();
+              // only for the packet which completed the transfer
+              if (m_totalRx - packet->GetSize () < m_expected)
+                {
+                  m_finishedTrace (m_totalRx);
+                }
           }
         }    
       m_rxTrace (packet, from);
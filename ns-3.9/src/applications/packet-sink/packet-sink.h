@@ -85,6 +85,9 @@ public:
 
   /**
    * \return whether the app has received all the bytes it expected to receive.
+   *
+   * The "Finished" trace source fires once, with the bytes received, when
+   * this becomes true.
    */
   bool IsFinished ();
 
@@ -118,6 +121,7 @@ private:
   uint64_t        m_expected;      // Total bytes expected;
   TypeId          m_tid;          // Protocol TypeId
   TracedCallback<Ptr<const Packet>, const Address &> m_rxTrace;
+  TracedCallback<uint64_t> m_finishedTrace;
   Time            m_whenStarted;
   Time            m_whenFinished;
 };
@@ -19,6 +19,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/trace-source-accessor.h"
 #include "antenna.h"
 
 NS_LOG_COMPONENT_DEFINE("Antenna");
@@ -32,6 +33,9 @@ Antenna::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::Antenna")
     .SetParent<Object> ()
+    .AddTraceSource ("PatternChange",
+                     "The orientation or the radiation pattern of the antenna changed",
+                     MakeTraceSourceAccessor (&Antenna::m_patternChangeTrace))
     ;
   return tid;
 }
@@ -39,4 +43,34 @@ Antenna::GetTypeId (void)
 Antenna::Antenna() {}
 Antenna::~Antenna() {}
 
+void
+Antenna::GetTxGainDbiBatch (const double *azimuth, const double *elevation,
+                            double *gainDbi, uint32_t n) const
+{
+  for (uint32_t k = 0; k < n; k++)
+    {
+      gainDbi[k] = GetTxGainDbi (azimuth[k], elevation[k]);
+    }
+}
+
+void
+Antenna::GetRxGainDbiBatch (const double *azimuth, const double *elevation,
+                            double *gainDbi, uint32_t n) const
+{
+  for (uint32_t k = 0; k < n; k++)
+    {
+      gainDbi[k] = GetRxGainDbi (azimuth[k], elevation[k]);
+    }
+}
+
+void
+Antenna::Steer (double azimuth, double elevation)
+{}
+
+void
+Antenna::NotifyPatternChange (void) const
+{
+  m_patternChangeTrace (this);
+}
+
 };
@@ -47,6 +47,7 @@ namespace ns3 {
 
 
 uint32_t Buffer::g_recommendedStart = 0;
+bool Buffer::g_concurrent = false;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -94,6 +95,11 @@ Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_ASSERT (data->m_count == 0);
   NS_ASSERT (!IS_UNINITIALIZED(g_freeList));
+  if (g_concurrent)
+    {
+      Buffer::Deallocate (data);
+      return;
+    }
   g_maxSize = std::max (g_maxSize, data->m_size);
   /* feed into free list */
   if (data->m_size < g_maxSize ||
@@ -113,6 +119,10 @@ Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   /* try to find a buffer correctly sized. */
+  if (g_concurrent)
+    {
+      return Buffer::Allocate (dataSize);
+    }
   if (IS_UNINITIALIZED(g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
@@ -150,6 +160,12 @@ Buffer::Create (uint32_t size)
 }
 #endif /* BUFFER_FREE_LIST */
 
+void
+Buffer::SetConcurrent (bool concurrent)
+{
+  g_concurrent = concurrent;
+}
+
 struct Buffer::Data *
 Buffer::Allocate (uint32_t reqSize)
 {
@@ -259,7 +275,10 @@ Buffer::operator = (Buffer const&o)
       m_data = o.m_data;
       m_data->m_count++;
     }
-  g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  if (!g_concurrent)
+    {
+      g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+    }
   m_maxZeroAreaStart = o.m_maxZeroAreaStart;
   m_zeroAreaStart = o.m_zeroAreaStart;
   m_zeroAreaEnd = o.m_zeroAreaEnd;
@@ -273,7 +292,10 @@ Buffer::~Buffer ()
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
-  g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  if (!g_concurrent)
+    {
+      g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+    }
   m_data->m_count--;
   if (m_data->m_count == 0) 
     {
@@ -527,6 +527,16 @@ private:
   Buffer (uint32_t dataSize);
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \param concurrent whether several threads create and destroy buffers
+   *        at once
+   *
+   * While they do, the buffers leave the heuristics on the position of
+   * the zero area and the free list, which only one thread may update,
+   * alone.
+   */
+  static void SetConcurrent (bool concurrent);
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -593,6 +603,7 @@ private:
    * value.
    */
   static uint32_t g_recommendedStart;
+  static bool g_concurrent;
 
   /* offset to the start of the virtual zero area from the start 
    * of m_data->m_data
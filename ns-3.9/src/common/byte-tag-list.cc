@@ -44,6 +44,7 @@ public:
   ~ByteTagListDataFreeList ();
 } g_freeList;
 static uint32_t g_maxSize = 0;
+static bool g_concurrent = false;
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList ()
 {
@@ -339,7 +340,7 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
+  while (!g_concurrent && !g_freeList.empty ())
     {
       struct ByteTagListData *data = g_freeList.back ();
       g_freeList.pop_back ();
@@ -369,11 +370,15 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
     {
       return;
     }
-  g_maxSize = std::max (g_maxSize, data->size);
+  if (!g_concurrent)
+    {
+      g_maxSize = std::max (g_maxSize, data->size);
+    }
   data->count--;
   if (data->count == 0)
     {
-      if (g_freeList.size () > FREE_LIST_SIZE ||
+      if (g_concurrent ||
+          g_freeList.size () > FREE_LIST_SIZE ||
           data->size < g_maxSize)
         {
           uint8_t *buffer = (uint8_t *)data;
@@ -418,5 +423,13 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
 
 #endif /* USE_FREE_LIST */
 
+void
+ByteTagList::SetConcurrent (bool concurrent)
+{
+#ifdef USE_FREE_LIST
+  g_concurrent = concurrent;
+#endif /* USE_FREE_LIST */
+}
+
 
 } // namespace ns3
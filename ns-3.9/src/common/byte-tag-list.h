@@ -153,6 +153,15 @@ private:
    */
   void AddAtStart (int32_t adjustment, int32_t prependOffset);
 
+  /**
+   * \param concurrent whether several threads create and destroy tag lists
+   *        at once
+   *
+   * While they do, the data of the lists is neither taken from nor
+   * returned to the free list, which only one thread may use.
+   */
+  static void SetConcurrent (bool concurrent);
+
 private:
   bool IsDirtyAtEnd (int32_t appendOffset);
   bool IsDirtyAtStart (int32_t prependOffset);
@@ -97,6 +97,29 @@ ConeAntenna::GetRxGainDbi(double azimuth, double elevation) const
 	return m_gainDbi;
 }
 
+void
+ConeAntenna::GetTxGainDbiBatch(const double *azimuth, const double *elevation,
+			       double *gainDbi, uint32_t n) const
+{
+	double half = m_beamwidth/2;
+	for (uint32_t k = 0; k < n; ++k)
+		gainDbi[k] = (getAngleDiff(azimuth[k],m_azimuth) > half ||
+			      getAngleDiff(elevation[k],m_elevation) > half) ? -1000000 : m_gainDbi;
+}
+void
+ConeAntenna::GetRxGainDbiBatch(const double *azimuth, const double *elevation,
+			       double *gainDbi, uint32_t n) const
+{
+	/* The pattern is reciprocal */
+	GetTxGainDbiBatch(azimuth, elevation, gainDbi, n);
+}
+
+double
+ConeAntenna::GetMaxGainDbi(void) const
+{
+	return m_gainDbi;
+}
+
 double
 ConeAntenna::GetGainDbi(void) const
 {
@@ -110,6 +133,7 @@ ConeAntenna::SetGainDbi(double gainDbi)
 	m_beamwidth = GainDbiToBeamwidth(gainDbi);
 	NS_LOG_FUNCTION("gainDbi" << m_gainDbi <<
 			" beamwidth" << m_beamwidth);
+	NotifyPatternChange();
 }
 
 double
@@ -125,6 +149,7 @@ ConeAntenna::SetBeamwidth(double beamwidth)
 	m_gainDbi = BeamwidthToGainDbi(beamwidth);
 	NS_LOG_FUNCTION("gainDbi" << m_gainDbi <<
 			" beamwidth" << m_beamwidth);
+	NotifyPatternChange();
 }
 double
 ConeAntenna::GetBeamwidthDegrees(void) const
@@ -150,6 +175,7 @@ ConeAntenna::SetAzimuthAngle(double azimuth)
 {
 	NS_LOG_FUNCTION(azimuth);
 	m_azimuth = azimuth;
+	NotifyPatternChange();
 }
 
 double
@@ -163,6 +189,16 @@ ConeAntenna::SetElevationAngle(double elevation)
 {
 	NS_LOG_FUNCTION(elevation);
 	m_elevation = elevation;
+	NotifyPatternChange();
+}
+
+void
+ConeAntenna::Steer(double azimuth, double elevation)
+{
+	NS_LOG_FUNCTION(azimuth << elevation);
+	m_azimuth = azimuth;
+	m_elevation = elevation;
+	NotifyPatternChange();
 }
 
 double
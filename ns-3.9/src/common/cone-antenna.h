@@ -40,6 +40,11 @@ public:
 
   double GetTxGainDbi (double azimuth, double elevation) const;
   double GetRxGainDbi (double azimuth, double elevation) const;
+  double GetMaxGainDbi (void) const;
+  void GetTxGainDbiBatch (const double *azimuth, const double *elevation,
+                          double *gainDbi, uint32_t n) const;
+  void GetRxGainDbiBatch (const double *azimuth, const double *elevation,
+                          double *gainDbi, uint32_t n) const;
 
   double GetGainDbi (void) const;
   void SetGainDbi (double gainDbi);
@@ -55,6 +60,8 @@ public:
   double GetElevationAngle (void) const;
   void SetElevationAngle (double elevation);
 
+  void Steer (double azimuth, double elevation);
+
   static double GainDbiToBeamwidth(double gainDbi);
   static double BeamwidthToGainDbi(double gainDbi);
 
@@ -52,4 +52,10 @@ IsotropicAntenna::GetRxGainDbi(double azimuth, double elevation) const
 	return GetTxGainDbi(azimuth, elevation);
 }
 
+double
+IsotropicAntenna::GetMaxGainDbi(void) const
+{
+	return 0;
+}
+
 };
@@ -40,6 +40,7 @@ public:
 
   double GetTxGainDbi (double azimuth, double elevation) const;
   double GetRxGainDbi (double azimuth, double elevation) const;
+  double GetMaxGainDbi (void) const;
 };
 
 } // namespace ns3
@@ -0,0 +1,159 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "measured-2d-antenna.h"
+
+#include <math.h>
+#include <fstream>
+
+namespace ns3 {
+
+// The measured points of the built-in patterns, as the hill climbing
+// lookup returned them: { angle in degrees, gain in dBi }.
+static const double g_knots23[][2] = {
+  {0, 29.1}, {15, 8.5}, {30, 1.4}, {60, -10.6}, {90, -14.2}, {120, -16.4},
+  {150, -14}, {180, -16.8}, {-150, -15.8}, {-120, -14.8}, {-90, -14}, {-60, -9.9},
+  {-30, -1.3}, {-15, 11.9},
+};
+static const double g_knots800[][2] = {
+  {-85, -28.08}, {-78.75, -17.08}, {-67.5, -13.08}, {-56.25, -5.08}, {-45, -0.08},
+  {-33.75, 4.92}, {-22.5, 5.92}, {-11.25, 6.92}, {0, 7.92}, {11.25, 6.92},
+  {22.5, 5.92}, {33.75, 4.92}, {45, -0.08}, {56.25, -5.08}, {67.5, -13.08},
+  {78.75, -17.08}, {85, -28.08}, {90, -16.08}, {101.25, -17.08}, {112.5, -28.08},
+  {123.75, -16.08}, {135, -14.08}, {146.25, -15.08}, {157.5, -28.08}, {168.75, -14.58},
+  {180, -14.08}, {191.25, -14.58}, {202.5, -28.08}, {213.75, -15.08}, {225, -14.08},
+  {236.25, -16.08}, {247.5, -28.08}, {258.75, -17.08}, {270, -16.08},
+};
+
+class Measured2DAntennaKnotsTest : public TestCase
+{
+public:
+  Measured2DAntennaKnotsTest ();
+  virtual ~Measured2DAntennaKnotsTest ();
+
+private:
+  virtual bool DoRun (void);
+  void CheckKnots (Ptr<Measured2DAntenna> antenna, const double knots[][2], uint32_t n,
+                   std::string pattern);
+};
+
+Measured2DAntennaKnotsTest::Measured2DAntennaKnotsTest ()
+  : TestCase ("The compiled patterns give the measured gains at the measured angles")
+{}
+
+Measured2DAntennaKnotsTest::~Measured2DAntennaKnotsTest ()
+{}
+
+void
+Measured2DAntennaKnotsTest::CheckKnots (Ptr<Measured2DAntenna> antenna, const double knots[][2],
+                                        uint32_t n, std::string pattern)
+{
+  double maxGain = knots[0][1];
+  for (double azimuth = 0; azimuth < 6; azimuth += 1.3)
+    {
+      antenna->SetAzimuthAngle (azimuth);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          double angle = azimuth + knots[i][0] * M_PI / 180;
+          NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetTxGainDbi (angle, 0), knots[i][1], 1e-9,
+                                     "Wrong gain of pattern " << pattern << " at " << knots[i][0] <<
+                                     " degrees, pointed at " << azimuth);
+          maxGain = std::max (maxGain, knots[i][1]);
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetMaxGainDbi (), maxGain, 1e-9, "Wrong peak gain of pattern " << pattern);
+}
+
+bool
+Measured2DAntennaKnotsTest::DoRun (void)
+{
+  Ptr<Measured2DAntenna> antenna = CreateObject<Measured2DAntenna> ();
+  antenna->SetMode (23);
+  CheckKnots (antenna, g_knots23, sizeof (g_knots23) / sizeof (g_knots23[0]), "23");
+  antenna->SetMode (800);
+  CheckKnots (antenna, g_knots800, sizeof (g_knots800) / sizeof (g_knots800[0]), "800");
+  return GetErrorStatus ();
+}
+
+
+class Measured2DAntennaPatternFileTest : public TestCase
+{
+public:
+  Measured2DAntennaPatternFileTest ();
+  virtual ~Measured2DAntennaPatternFileTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+Measured2DAntennaPatternFileTest::Measured2DAntennaPatternFileTest ()
+  : TestCase ("Patterns measured off the 0.1 degree grid are interpolated between their points")
+{}
+
+Measured2DAntennaPatternFileTest::~Measured2DAntennaPatternFileTest ()
+{}
+
+bool
+Measured2DAntennaPatternFileTest::DoRun (void)
+{
+  std::string filename = GetTempDir () + "measured-2d-antenna-pattern.txt";
+  std::ofstream out (filename.c_str ());
+  out << "# angle gain" << std::endl
+      << "0 10" << std::endl
+      << "7.33 0   # between two grid points" << std::endl
+      << "20.05 5" << std::endl
+      << "180 -10" << std::endl
+      << "-90.07 -3" << std::endl;
+  out.close ();
+
+  Ptr<Measured2DAntenna> antenna = CreateObject<Measured2DAntenna> ();
+  antenna->SetPatternFile (filename);
+  const double knots[][2] = {{0, 10}, {7.33, 0}, {20.05, 5}, {180, -10}, {-90.07, -3}};
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetTxGainDbi (knots[i][0] * M_PI / 180, 0), knots[i][1], 1e-9,
+                                 "Wrong gain at " << knots[i][0] << " degrees");
+    }
+  // straight lines between neighbouring points
+  NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetTxGainDbi (2 * M_PI / 180, 0), 10 - 10 * 2 / 7.33, 1e-9,
+                             "Wrong gain between the first points");
+  NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetTxGainDbi (14 * M_PI / 180, 0), 5 * 6.67 / 12.72, 1e-9,
+                             "Wrong gain between points off the grid");
+  NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetTxGainDbi (100 * M_PI / 180, 0), 5 - 15 * 79.95 / 159.95, 1e-9,
+                             "Wrong gain between far apart points");
+  NS_TEST_EXPECT_MSG_EQ_TOL (antenna->GetMaxGainDbi (), 10, 1e-9, "Wrong peak gain");
+  remove (filename.c_str ());
+  return GetErrorStatus ();
+}
+
+
+class Measured2DAntennaTestSuite : public TestSuite
+{
+public:
+  Measured2DAntennaTestSuite ();
+};
+
+Measured2DAntennaTestSuite::Measured2DAntennaTestSuite ()
+  : TestSuite ("measured-2d-antenna", UNIT)
+{
+  AddTestCase (new Measured2DAntennaKnotsTest);
+  AddTestCase (new Measured2DAntennaPatternFileTest);
+}
+
+Measured2DAntennaTestSuite g_measured2DAntennaTestSuite;
+
+} // namespace ns3
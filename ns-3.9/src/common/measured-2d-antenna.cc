@@ -19,10 +19,13 @@
  */
 
 #include "ns3/double.h"
+#include "ns3/string.h"
 #include "ns3/log.h"
-#include "ns3/object-vector.h"
 
 #include <math.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 #include "measured-2d-antenna.h"
 
@@ -32,9 +35,7 @@ NS_LOG_COMPONENT_DEFINE("Measured2DAntenna");
 static double
 getAngleDiff(double a, double b)
 {
-	double d = fabs(a-b);
-	while (d > 2*M_PI)
-		d -= 2*M_PI;
+	double d = fmod(fabs(a-b), 2*M_PI);
 	if (d > M_PI)
 		d = 2*M_PI - d;
 	return d;
@@ -48,51 +49,45 @@ static int wrap_index(int i, int n)
 	return i;
 }
 
-namespace ns3 {
+/* Built-in patterns: { angle in degrees, gain in dBi } */
+static const double g_pattern23[][2] = {
+	{0, 45.9}, {15, 25.3}, {30, 18.2}, {60, 6.2}, {90, 2.6}, {120, 0.4},
+	{150, 2.8}, {180, 0}, {-150, 1}, {-120, 2}, {-90, 2.8}, {-60, 6.9},
+	{-30, 15.5}, {-15, 28.7},
+};
+static const double g_pattern10[][2] = {
+	{0, 26.3}, {15, 25.8}, {30, 22.8}, {60, 12.6}, {90, 4.1}, {120, 3.4},
+	{150, 2.9}, {180, 0}, {-150, 1.3}, {-120, 2.6}, {-90, 5.3}, {-60, 13.9},
+	{-30, 23.2}, {-15, 26.8},
+};
+static const double g_pattern800[][2] = {
+	{-90+5, -28.08}, {-90+11.25, -17.08}, {-90+22.5, -13.08},
+	{-90+33.75, -5.08}, {-90+45, -0.08}, {-90+56.25, 4.92},
+	{-90+67.5, 5.92}, {-90+78.75, 6.92}, {0, 7.92}, {11.25, 6.92},
+	{22.5, 5.92}, {33.75, 4.92}, {45, -0.08}, {56.25, -5.08},
+	{67.5, -13.08}, {78.75, -17.08}, {85, -28.08}, {90, -16.08},
+	{90+11.25, -17.08}, {90+22.5, -28.08}, {90+33.75, -16.08},
+	{90+45, -14.08}, {90+56.25, -15.08}, {90+67.5, -28.08},
+	{90+78.75, -14.58}, {180, -14.08}, {180+11.25, -14.58},
+	{180+22.5, -28.08}, {180+33.75, -15.08}, {180+45, -14.08},
+	{180+56.25, -16.08}, {180+67.5, -28.08}, {180+78.75, -17.08},
+	{270, -16.08},
+};
 
-NS_OBJECT_ENSURE_REGISTERED (Measured2DAntenna);
+/* Resolution of the compiled gain table: 0.1 degrees */
+static const unsigned int TABLE_SIZE = 3600;
 
-TypeId
-M2D::GetTypeId(void)
+struct Breakpoint
 {
-  static TypeId tid = TypeId ("ns3::M2D")
-    .SetParent<Object> ()
-    .AddConstructor<M2D> ()
-  ;
-  return tid;
-}
+	double angle;
+	double gain;
+	bool measured;
+	bool operator < (const Breakpoint &o) const { return angle < o.angle; }
+};
 
-M2D::M2D()
-{
-}
-M2D::M2D(double angle, double gain)
-	: m_angle(angle),m_gain(gain)
-{
-}
-M2D::~M2D()
-{
-}
+namespace ns3 {
 
-double
-M2D::GetAngle (void) const
-{
-	return m_angle;
-}
-void
-M2D::SetAngle (double angle)
-{
-	m_angle = angle;
-}
-double
-M2D::GetGain (void) const
-{
-	return m_gain;
-}
-void
-M2D::SetGain (double gain)
-{
-	m_gain = gain;
-}
+NS_OBJECT_ENSURE_REGISTERED (Measured2DAntenna);
 
 TypeId
 Measured2DAntenna::GetTypeId (void)
@@ -103,29 +98,38 @@ Measured2DAntenna::GetTypeId (void)
     .AddAttribute ("Azimuth",
                    "The azimuth angle (XY-plane) in which this antenna is pointed in radians.",
                    DoubleValue (0),
-                   MakeDoubleAccessor (&Measured2DAntenna::m_azimuth),
+                   MakeDoubleAccessor (&Measured2DAntenna::SetAzimuthAngle,
+                                       &Measured2DAntenna::GetAzimuthAngle),
                    MakeDoubleChecker<double> ())
     .AddAttribute ("Elevation",
                    "The elevation angle (Z-plane) in which this antenna is pointed in radians.",
                    DoubleValue (0),
-                   MakeDoubleAccessor (&Measured2DAntenna::m_elevation),
+                   MakeDoubleAccessor (&Measured2DAntenna::SetElevationAngle,
+                                       &Measured2DAntenna::GetElevationAngle),
                    MakeDoubleChecker<double> ())
     .AddAttribute ("VerticalBeamwidth",
                    "The vertical beamwidth of this antenna in radians.",
                    DoubleValue (M_PI/18),	/* 10 degrees */
-                   MakeDoubleAccessor (&Measured2DAntenna::m_verticalBeamwidth),
+                   MakeDoubleAccessor (&Measured2DAntenna::SetBeamwidth,
+                                       &Measured2DAntenna::GetBeamwidth),
                    MakeDoubleChecker<double> ())
     .AddAttribute ("Mode",
-		   "23 or 10.",
+		   "Built-in measured pattern: 23, 10 or 800. Ignored once PatternFile is set.",
 		   DoubleValue (23),
 		   MakeDoubleAccessor (&Measured2DAntenna::GetMode, &Measured2DAntenna::SetMode),
 		   MakeDoubleChecker<double> ())
+    .AddAttribute ("PatternFile",
+		   "File holding a measured azimuth pattern, one \"<angle in degrees> <gain in dBi>\" "
+		   "pair per line; '#' starts a comment. Replaces the pattern selected by Mode.",
+		   StringValue (""),
+		   MakeStringAccessor (&Measured2DAntenna::GetPatternFile, &Measured2DAntenna::SetPatternFile),
+		   MakeStringChecker ())
     ;
   return tid;
 }
 
 Measured2DAntenna::Measured2DAntenna()
-	: m_verticalBeamwidth(M_PI/18)
+	: m_mode(23), m_maxGainDbi(0), m_verticalBeamwidth(M_PI/18)
 {
 }
 Measured2DAntenna::~Measured2DAntenna() { }
@@ -148,42 +152,89 @@ Measured2DAntenna::GetRxGainDbi(double azimuth, double elevation) const
 	return GetGain(azimuth);
 }
 
+void
+Measured2DAntenna::GetTxGainDbiBatch(const double *azimuth, const double *elevation,
+				     double *gainDbi, uint32_t n) const
+{
+	double half = m_verticalBeamwidth/2;
+	for (uint32_t k = 0; k < n; ++k)
+		gainDbi[k] = getAngleDiff(elevation[k],m_elevation) > half ? -10000 : GetGain(azimuth[k]);
+}
+
+void
+Measured2DAntenna::GetRxGainDbiBatch(const double *azimuth, const double *elevation,
+				     double *gainDbi, uint32_t n) const
+{
+	/* The pattern is reciprocal */
+	GetTxGainDbiBatch(azimuth, elevation, gainDbi, n);
+}
+
 double
 Measured2DAntenna::GetBeamwidth(void) const
 {
 	NS_LOG_FUNCTION(m_verticalBeamwidth);
 	return m_verticalBeamwidth;
 }
+void
+Measured2DAntenna::SetBeamwidth(double beamwidth)
+{
+	NS_LOG_FUNCTION(beamwidth);
+	m_verticalBeamwidth = beamwidth;
+	NotifyPatternChange();
+}
+
+double
+Measured2DAntenna::GetMaxGainDbi(void) const
+{
+	return m_maxGainDbi;
+}
 
 double
 Measured2DAntenna::GetGain(double angle) const
 {
 	NS_LOG_FUNCTION(angle);
 
-	if (m_measurements.size() == 0)
-		NS_FATAL_ERROR("trying to get gain with no measurements!"); 
+	if (m_cells.empty())
+		NS_FATAL_ERROR("trying to get gain with no measurements!");
+
+	/* Position of angle in the pattern, in [0, 2*pi) */
+	double x = fmod(angle - m_azimuth, 2*M_PI);
+	if (x < 0)
+		x += 2*M_PI;
+	if (x >= 2*M_PI)
+		x = 0;
+	unsigned int cell = (unsigned int)(x * (TABLE_SIZE / (2*M_PI)));
+	if (cell >= TABLE_SIZE)
+		cell = TABLE_SIZE - 1;
+	/* A cell only holds more than one breakpoint around measured points;
+	 * the last breakpoint is at 2*pi, so the walk always stops. */
+	unsigned int k = m_cells[cell];
+	while (m_breakAngles[k+1] <= x)
+		++k;
+	double ret = m_breakGains[k] + m_breakSlopes[k] * (x - m_breakAngles[k]);
+	NS_LOG(ns3::LOG_INFO, "returning " << ret);
+	return ret;
+}
 
-	if (m_measurements.size() == 1)
-		return m_measurements[0]->GetGain();
+double
+Measured2DAntenna::InterpolateMeasurements(double angle) const
+{
+	if (m_angles.size() == 1)
+		return m_gains[0];
 
 	int i = 0, i1, i2;
-	int S = m_measurements.size();
-	angle = angle - m_azimuth;
-	double diff = getAngleDiff(m_measurements[0]->GetAngle(), angle);
+	int S = m_angles.size();
+	double diff = getAngleDiff(m_angles[0], angle);
 	double diff1, diff2;
-	double ret;
 	while(true)
 	{
 		if (diff == 0)
-		{
-			ret = m_measurements[i]->GetGain();
-			goto out;
-		}
+			return m_gains[i];
 
 		i1 = wrap_index(i+1,S);
-		diff1 = getAngleDiff(m_measurements[i1]->GetAngle(), angle);
+		diff1 = getAngleDiff(m_angles[i1], angle);
 		i2 = wrap_index(i-1,S);
-		diff2 = getAngleDiff(m_measurements[i2]->GetAngle(), angle);
+		diff2 = getAngleDiff(m_angles[i2], angle);
 
 		if (diff1 < diff)
 		{
@@ -211,12 +262,85 @@ Measured2DAntenna::GetGain(double angle) const
 		break;
 	}
 	/* At this point, i should be the closest, and i1===i+1 the next closest */
-	NS_LOG(ns3::LOG_INFO, "i=" << i << " i1=" << i1 << " gain[i]=" << m_measurements[i]->GetGain() << " gain[i1]=" << m_measurements[i1]->GetGain() << " diff=" << diff << " diff1=" << diff1);
-	ret = m_measurements[i]->GetGain() * (diff1/(diff+diff1)) +
-	       m_measurements[i1]->GetGain() * (diff/(diff+diff1));
-out:
-	NS_LOG(ns3::LOG_INFO, "returning " << ret);
-	return ret;
+	return m_gains[i] * (diff1/(diff+diff1)) +
+	       m_gains[i1] * (diff/(diff+diff1));
+}
+
+void
+Measured2DAntenna::CompileTable(void)
+{
+	NS_LOG_FUNCTION_NOARGS();
+	if (m_angles.empty())
+		NS_FATAL_ERROR("antenna pattern has no measurements");
+
+	/* The measured points, and the 0.1 degree grid in between */
+	std::vector<Breakpoint> points;
+	points.reserve(TABLE_SIZE + m_angles.size());
+	for (unsigned int t = 0; t < m_angles.size(); ++t)
+	{
+		Breakpoint p;
+		p.angle = fmod(m_angles[t], 2*M_PI);
+		if (p.angle < 0)
+			p.angle += 2*M_PI;
+		if (p.angle >= 2*M_PI)
+			p.angle = 0;
+		p.gain = m_gains[t];
+		p.measured = true;
+		points.push_back(p);
+	}
+	for (unsigned int i = 0; i < TABLE_SIZE; ++i)
+	{
+		Breakpoint p;
+		p.angle = i * 2*M_PI / TABLE_SIZE;
+		p.gain = InterpolateMeasurements(p.angle);
+		p.measured = false;
+		points.push_back(p);
+	}
+	/* Measured points first among equal angles, so that they are kept */
+	std::stable_sort(points.begin(), points.end());
+
+	/* A grid point next to a measured one only adds rounding errors */
+	m_breakAngles.clear();
+	m_breakGains.clear();
+	bool lastMeasured = false;
+	for (unsigned int i = 0; i < points.size(); ++i)
+	{
+		if (!m_breakAngles.empty() && points[i].angle - m_breakAngles.back() < 1e-9)
+		{
+			if (points[i].measured && !lastMeasured)
+			{
+				m_breakAngles.back() = points[i].angle;
+				m_breakGains.back() = points[i].gain;
+				lastMeasured = true;
+			}
+			continue;
+		}
+		m_breakAngles.push_back(points[i].angle);
+		m_breakGains.push_back(points[i].gain);
+		lastMeasured = points[i].measured;
+	}
+	m_breakAngles.push_back(2*M_PI);
+	m_breakGains.push_back(m_breakGains[0]);
+	m_breakSlopes.resize(m_breakAngles.size() - 1);
+	for (unsigned int k = 0; k + 1 < m_breakAngles.size(); ++k)
+		m_breakSlopes[k] = (m_breakGains[k+1] - m_breakGains[k]) /
+			(m_breakAngles[k+1] - m_breakAngles[k]);
+
+	m_cells.resize(TABLE_SIZE);
+	unsigned int k = 0;
+	for (unsigned int i = 0; i < TABLE_SIZE; ++i)
+	{
+		double start = i * 2*M_PI / TABLE_SIZE;
+		while (m_breakAngles[k+1] <= start)
+			++k;
+		m_cells[i] = k;
+	}
+
+	m_maxGainDbi = m_gains[0];
+	for (unsigned int t = 1; t < m_gains.size(); ++t)
+		if (m_gains[t] > m_maxGainDbi)
+			m_maxGainDbi = m_gains[t];
+	NotifyPatternChange();
 }
 
 double
@@ -230,6 +354,7 @@ Measured2DAntenna::SetAzimuthAngle(double azimuth)
 {
 	NS_LOG_FUNCTION(azimuth);
 	m_azimuth = azimuth;
+	NotifyPatternChange();
 }
 
 double
@@ -243,6 +368,28 @@ Measured2DAntenna::SetElevationAngle(double elevation)
 {
 	NS_LOG_FUNCTION(elevation);
 	m_elevation = elevation;
+	NotifyPatternChange();
+}
+
+void
+Measured2DAntenna::Steer(double azimuth, double elevation)
+{
+	NS_LOG_FUNCTION(azimuth << elevation);
+	m_azimuth = azimuth;
+	m_elevation = elevation;
+	NotifyPatternChange();
+}
+
+void
+Measured2DAntenna::SetPattern(const double pattern[][2], unsigned int n, double offset)
+{
+	m_angles.resize(n);
+	m_gains.resize(n);
+	for (unsigned int t = 0; t < n; ++t)
+	{
+		m_angles[t] = pattern[t][0]*M_PI/180;
+		m_gains[t] = pattern[t][1] + offset;
+	}
 }
 
 void
@@ -253,87 +400,15 @@ Measured2DAntenna::SetMode(double mode)
 		NS_FATAL_ERROR("illegal mode " << mode << " != 10 or 23 or 800");
 
 	m_mode = mode;
-	m_measurements.clear();
+	if (!m_patternFile.empty())
+		return;
 	if (mode == 23)
-	{
-		m_measurements.push_back(CreateObject<M2D>(0,45.9));
-		m_measurements.push_back(CreateObject<M2D>(15,25.3));
-		m_measurements.push_back(CreateObject<M2D>(30,18.2));
-		m_measurements.push_back(CreateObject<M2D>(60,6.2));
-		m_measurements.push_back(CreateObject<M2D>(90,2.6));
-		m_measurements.push_back(CreateObject<M2D>(120,0.4));
-		m_measurements.push_back(CreateObject<M2D>(150,2.8));
-		m_measurements.push_back(CreateObject<M2D>(180,0));
-		m_measurements.push_back(CreateObject<M2D>(-150,1));
-		m_measurements.push_back(CreateObject<M2D>(-120,2));
-		m_measurements.push_back(CreateObject<M2D>(-90,2.8));
-		m_measurements.push_back(CreateObject<M2D>(-60,6.9));
-		m_measurements.push_back(CreateObject<M2D>(-30,15.5));
-		m_measurements.push_back(CreateObject<M2D>(-15,28.7));
-		for (unsigned int t = 0; t < m_measurements.size(); ++t)
-		{
-			m_measurements[t]->SetGain(m_measurements[t]->GetGain()-16.8);
-			m_measurements[t]->SetAngle(m_measurements[t]->GetAngle()*M_PI/180);
-		}
-	} else if (mode == 10) {
-		m_measurements.push_back(CreateObject<M2D>(0,26.3));
-		m_measurements.push_back(CreateObject<M2D>(15,25.8));
-		m_measurements.push_back(CreateObject<M2D>(30,22.8));
-		m_measurements.push_back(CreateObject<M2D>(60,12.6));
-		m_measurements.push_back(CreateObject<M2D>(90,4.1));
-		m_measurements.push_back(CreateObject<M2D>(120,3.4));
-		m_measurements.push_back(CreateObject<M2D>(150,2.9));
-		m_measurements.push_back(CreateObject<M2D>(180,0));
-		m_measurements.push_back(CreateObject<M2D>(-150,1.3));
-		m_measurements.push_back(CreateObject<M2D>(-120,2.6));
-		m_measurements.push_back(CreateObject<M2D>(-90,5.3));
-		m_measurements.push_back(CreateObject<M2D>(-60,13.9));
-		m_measurements.push_back(CreateObject<M2D>(-30,23.2));
-		m_measurements.push_back(CreateObject<M2D>(-15,26.8));
-		for (unsigned int t = 0; t < m_measurements.size(); ++t)
-		{
-			m_measurements[t]->SetGain(m_measurements[t]->GetGain()-16.8);
-			m_measurements[t]->SetAngle(m_measurements[t]->GetAngle()*M_PI/180);
-		}
-	} else if (mode == 800) {
-		m_measurements.push_back(CreateObject<M2D>(-90+5, -28.08));
-		m_measurements.push_back(CreateObject<M2D>(-90+11.25, -17.08));
-		m_measurements.push_back(CreateObject<M2D>(-90+22.5, -13.08));
-		m_measurements.push_back(CreateObject<M2D>(-90+33.75, -5.08));
-		m_measurements.push_back(CreateObject<M2D>(-90+45, -0.08));
-		m_measurements.push_back(CreateObject<M2D>(-90+56.25, 4.92));
-		m_measurements.push_back(CreateObject<M2D>(-90+67.5, 5.92));
-		m_measurements.push_back(CreateObject<M2D>(-90+78.75, 6.92));
-		m_measurements.push_back(CreateObject<M2D>(0, 7.92));
-		m_measurements.push_back(CreateObject<M2D>(11.25, 6.92));
-		m_measurements.push_back(CreateObject<M2D>(22.5, 5.92));
-		m_measurements.push_back(CreateObject<M2D>(33.75, 4.92));
-		m_measurements.push_back(CreateObject<M2D>(45, -0.08));
-		m_measurements.push_back(CreateObject<M2D>(56.25, -5.08));
-		m_measurements.push_back(CreateObject<M2D>(67.5, -13.08));
-		m_measurements.push_back(CreateObject<M2D>(78.75, -17.08));
-		m_measurements.push_back(CreateObject<M2D>(85, -28.08));
-		m_measurements.push_back(CreateObject<M2D>(90, -16.08));
-		m_measurements.push_back(CreateObject<M2D>(90+11.25, -17.08));
-		m_measurements.push_back(CreateObject<M2D>(90+22.5, -28.08));
-		m_measurements.push_back(CreateObject<M2D>(90+33.75, -16.08));
-		m_measurements.push_back(CreateObject<M2D>(90+45, -14.08));
-		m_measurements.push_back(CreateObject<M2D>(90+56.25, -15.08));
-		m_measurements.push_back(CreateObject<M2D>(90+67.5, -28.08));
-		m_measurements.push_back(CreateObject<M2D>(90+78.75, -14.58));
-		m_measurements.push_back(CreateObject<M2D>(180, -14.08));
-		m_measurements.push_back(CreateObject<M2D>(180+11.25, -14.58));
-		m_measurements.push_back(CreateObject<M2D>(180+22.5, -28.08));
-		m_measurements.push_back(CreateObject<M2D>(180+33.75, -15.08));
-		m_measurements.push_back(CreateObject<M2D>(180+45, -14.08));
-		m_measurements.push_back(CreateObject<M2D>(180+56.25, -16.08));
-		m_measurements.push_back(CreateObject<M2D>(180+67.5, -28.08));
-		m_measurements.push_back(CreateObject<M2D>(180+78.75, -17.08));
-		m_measurements.push_back(CreateObject<M2D>(270, -16.08));
-		for (unsigned int t = 0; t < m_measurements.size(); ++t) {
-			m_measurements[t]->SetAngle(m_measurements[t]->GetAngle()*M_PI/180);
-		}
-	}
+		SetPattern(g_pattern23, sizeof (g_pattern23) / sizeof (g_pattern23[0]), -16.8);
+	else if (mode == 10)
+		SetPattern(g_pattern10, sizeof (g_pattern10) / sizeof (g_pattern10[0]), -16.8);
+	else if (mode == 800)
+		SetPattern(g_pattern800, sizeof (g_pattern800) / sizeof (g_pattern800[0]), 0);
+	CompileTable();
 }
 
 double
@@ -342,5 +417,50 @@ Measured2DAntenna::GetMode(void) const
 	return m_mode;
 }
 
+void
+Measured2DAntenna::SetPatternFile(std::string filename)
+{
+	NS_LOG_FUNCTION(filename);
+	if (filename.empty())
+	{
+		/* Fall back to the built-in pattern selected by Mode */
+		bool hadFile = !m_patternFile.empty();
+		m_patternFile = filename;
+		if (hadFile)
+			SetMode(m_mode);
+		return;
+	}
+	m_patternFile = filename;
+
+	std::ifstream in(filename.c_str());
+	if (!in.is_open())
+		NS_FATAL_ERROR("cannot open antenna pattern file " << filename);
+
+	m_angles.clear();
+	m_gains.clear();
+	std::string line;
+	while (std::getline(in, line))
+	{
+		std::string::size_type comment = line.find('#');
+		if (comment != std::string::npos)
+			line.erase(comment);
+		std::istringstream iss(line);
+		double angle, gain;
+		if (!(iss >> angle))
+			continue;
+		if (!(iss >> gain))
+			NS_FATAL_ERROR("malformed line in antenna pattern file " << filename << ": " << line);
+		m_angles.push_back(angle*M_PI/180);
+		m_gains.push_back(gain);
+	}
+	CompileTable();
+}
+
+std::string
+Measured2DAntenna::GetPatternFile(void) const
+{
+	return m_patternFile;
+}
+
 };
 
@@ -23,33 +23,21 @@
 
 #include "ns3/antenna.h"
 #include "ns3/vector.h"
+#include <string>
+#include <vector>
 
 namespace ns3 {
 
-class M2D : public Object
-{
-public:
-  static TypeId GetTypeId (void);
-
-  M2D ();
-  M2D(double angle, double gain);
-  ~M2D ();
-
-  double GetGain (void) const;
-  void SetGain (double);
-  double GetAngle (void) const;
-  void SetAngle (double);
-
-private:
-  M2D (const M2D &o);
-  M2D & operator = (const M2D &o);
-  double m_angle;
-  double m_gain;
-};
-
 /**
  * \brief Antenna functionality for wireless devices
  *
+ * The azimuth pattern is given as a list of measured (angle, gain) points,
+ * either one of the built-in patterns selected by the Mode attribute or one
+ * read from the file named by the PatternFile attribute.  Whenever the
+ * pattern changes it is resampled every 0.1 degree, and the measured points
+ * are kept as breakpoints of their own so that the gain at each of them is
+ * the measured one.  A lookup indexes the 0.1 degree cell of the angle and
+ * interpolates linearly between the breakpoints around it.
  */
 class Measured2DAntenna : public Antenna
 {
@@ -62,6 +50,11 @@ public:
 
   double GetTxGainDbi (double azimuth, double elevation) const;
   double GetRxGainDbi (double azimuth, double elevation) const;
+  double GetMaxGainDbi (void) const;
+  void GetTxGainDbiBatch (const double *azimuth, const double *elevation,
+                          double *gainDbi, uint32_t n) const;
+  void GetRxGainDbiBatch (const double *azimuth, const double *elevation,
+                          double *gainDbi, uint32_t n) const;
 
   double GetAzimuthAngle (void) const;
   void SetAzimuthAngle (double azimuth);
@@ -69,22 +62,40 @@ public:
   double GetElevationAngle (void) const;
   void SetElevationAngle (double elevation);
 
+  void Steer (double azimuth, double elevation);
+
   double GetBeamwidth (void) const;
+  void SetBeamwidth (double beamwidth);
 
   double GetMode (void) const;
   void SetMode (double);
 
+  std::string GetPatternFile (void) const;
+  void SetPatternFile (std::string filename);
+
 private:
   Measured2DAntenna (const Measured2DAntenna &o);
   Measured2DAntenna & operator = (const Measured2DAntenna &o);
 
   double GetGain(double angle) const;
+  double InterpolateMeasurements(double angle) const;
+  void SetPattern(const double pattern[][2], unsigned int n, double offset);
+  void CompileTable(void);
 
   double m_mode;
+  std::string m_patternFile;
+  double m_maxGainDbi;
   double m_verticalBeamwidth;
   double m_elevation;
   double m_azimuth;
-  std::vector<Ptr<M2D> > m_measurements;
+  std::vector<double> m_angles;
+  std::vector<double> m_gains;
+  // breakpoints of the compiled pattern, over [0, 2*pi] radians
+  std::vector<double> m_breakAngles;
+  std::vector<double> m_breakGains;
+  std::vector<double> m_breakSlopes;
+  // the last breakpoint at or before the start of each 0.1 degree cell
+  std::vector<uint32_t> m_cells;
 };
 
 }; // namespace ns3
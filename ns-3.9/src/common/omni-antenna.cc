@@ -76,6 +76,12 @@ OmniAntenna::GetRxGainDbi(double azimuth, double elevation) const
 	return m_gainDbi;
 }
 
+double
+OmniAntenna::GetMaxGainDbi(void) const
+{
+	return m_gainDbi > 0 ? m_gainDbi : 0;
+}
+
 double
 OmniAntenna::GetGainDbi(void) const
 {
@@ -89,6 +95,7 @@ OmniAntenna::SetGainDbi(double gainDbi)
 	m_gainDbi = gainDbi;
 	m_beamwidth = GainDbiToBeamwidth(m_gainDbi);
 	NS_LOG_FUNCTION(gainDbi << m_beamwidth);
+	NotifyPatternChange();
 }
 
 double
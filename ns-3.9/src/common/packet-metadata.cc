@@ -19,6 +19,7 @@
  */
 #include <utility>
 #include <list>
+#include <algorithm>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
@@ -34,6 +35,7 @@ namespace ns3 {
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
+bool PacketMetadata::m_concurrent = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
@@ -60,6 +62,19 @@ PacketMetadata::Enable (void)
   m_enable = true;
 }
 
+void
+PacketMetadata::SetConcurrent (bool concurrent)
+{
+  // the threads will surely create packets: record that they skip the
+  // metadata before they start, so that they only store the value it
+  // already has
+  if (concurrent && !m_enable)
+    {
+      m_metadataSkipped = true;
+    }
+  m_concurrent = concurrent;
+}
+
 void 
 PacketMetadata::EnableChecking (void)
 {
@@ -521,6 +536,10 @@ struct PacketMetadata::Data *
 PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
+  if (m_concurrent)
+    {
+      return PacketMetadata::Allocate (std::max (size, m_maxSize));
+    }
   if (size > m_maxSize)
     {
       m_maxSize = size;
@@ -545,7 +564,7 @@ PacketMetadata::Create (uint32_t size)
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
-  if (!m_enable)
+  if (!m_enable || m_concurrent)
     {
       PacketMetadata::Deallocate (data);
       return;
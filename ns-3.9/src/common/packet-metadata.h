@@ -126,6 +126,14 @@ private:
 
   static void Enable (void);
   static void EnableChecking (void);
+  /**
+   * \param concurrent whether several threads create and destroy packets
+   *        at once
+   *
+   * While they do, the metadata is neither taken from nor returned to the
+   * free list, which only one thread may use.
+   */
+  static void SetConcurrent (bool concurrent);
 
   inline PacketMetadata (uint64_t uid, uint32_t size);
   inline PacketMetadata (PacketMetadata const &o);
@@ -327,6 +335,7 @@ public:
   static DataFreeList m_freeList;
   static bool m_enable;
   static bool m_enableChecking;
+  static bool m_concurrent;
 
   // set to true when adding metadata to a packet is skipped because
   // m_enable is false; used to detect enabling of metadata in the
@@ -30,6 +30,7 @@ NS_LOG_COMPONENT_DEFINE ("Packet");
 namespace ns3 {
 
 uint32_t Packet::m_globalUid = 0;
+bool Packet::m_concurrent = false;
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -136,10 +137,9 @@ Packet::Packet ()
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), 0),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
@@ -178,10 +178,9 @@ Packet::Packet (uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
@@ -204,10 +203,9 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -561,6 +559,26 @@ Packet::EnableChecking (void)
   PacketMetadata::EnableChecking ();
 }
 
+void
+Packet::SetConcurrent (bool concurrent)
+{
+  NS_LOG_FUNCTION (concurrent);
+  Buffer::SetConcurrent (concurrent);
+  ByteTagList::SetConcurrent (concurrent);
+  PacketMetadata::SetConcurrent (concurrent);
+  m_concurrent = concurrent;
+}
+
+uint32_t
+Packet::AllocateUid (void)
+{
+  if (m_concurrent)
+    {
+      return __sync_fetch_and_add (&m_globalUid, 1);
+    }
+  return m_globalUid++;
+}
+
 uint32_t Packet::GetSerializedSize (void) const
 {
   uint32_t size = 0;
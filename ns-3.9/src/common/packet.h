@@ -429,6 +429,17 @@ public:
    * errors will be detected and will abort the program.
    */
   static void EnableChecking (void);
+  /**
+   * \param concurrent whether several threads create and destroy packets
+   *        at once
+   *
+   * The packets keep caches of their memory and some heuristics in global
+   * variables, which a single thread may use. While several threads run,
+   * as the partitions of a MultithreadedSimulatorImpl do, the packets leave
+   * them alone and take their uids atomically. Threads may not share a
+   * packet.
+   */
+  static void SetConcurrent (bool concurrent);
 
   /**
    * For packet serializtion, the total size is checked 
@@ -566,7 +577,10 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector;
 
+  static uint32_t AllocateUid (void);
+
   static uint32_t m_globalUid;
+  static bool m_concurrent;
 };
 
 std::ostream& operator<< (std::ostream& os, const Packet &packet);
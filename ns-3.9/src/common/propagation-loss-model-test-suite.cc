@@ -141,6 +141,29 @@ FriisPropagationLossModelTestCase::DoRun (void)
       double resultdBm = lossModel->CalcRxPower (testVector.m_pt, a, b);
       double resultW =   pow (10.0, resultdBm/10.0)/1000;
       NS_TEST_EXPECT_MSG_EQ_TOL (resultW, testVector.m_pr, testVector.m_tolerance, "Got unexpected rcv power");
+      // The range bound must give back the distance at which this power is received
+      double range = lossModel->GetMaxRange (testVector.m_pt, resultdBm);
+      NS_TEST_EXPECT_MSG_EQ_TOL (range, testVector.m_position.x, 1e-6, "Got unexpected max range");
+    }
+
+  // The batch form must agree exactly with the scalar one, also when the
+  // model is chained to one without a batch implementation.
+  lossModel->SetNext (CreateObject<LogDistancePropagationLossModel> ());
+  std::vector<Ptr<MobilityModel> > receivers;
+  std::vector<double> distances;
+  for (uint32_t i = 0; i < m_testVectors.GetN (); ++i)
+    {
+      Ptr<MobilityModel> receiver = CreateObject<ConstantPositionMobilityModel> ();
+      receiver->SetPosition (m_testVectors.Get (i).m_position);
+      receivers.push_back (receiver);
+      distances.push_back (a->GetDistanceFrom (receiver));
+    }
+  std::vector<double> batch (receivers.size ());
+  lossModel->CalcRxPowerBatch (txPowerdBm, a, &receivers[0], &distances[0], &batch[0], receivers.size ());
+  for (uint32_t i = 0; i < receivers.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (batch[i], lossModel->CalcRxPower (txPowerdBm, a, receivers[i]),
+                             "Batch and scalar rcv power differ");
     }
 	
   return GetErrorStatus ();
@@ -457,6 +480,8 @@ RangePropagationLossModelTestCase::DoRun (void)
   b->SetPosition (Vector (127.25,0,0));  // beyond range
   resultdBm = lossModel->CalcRxPower (txPwrdBm, a, b);
   NS_TEST_EXPECT_MSG_EQ_TOL (resultdBm, -1000.0, tolerance, "Got unexpected rcv power");
+  NS_TEST_EXPECT_MSG_EQ_TOL (lossModel->GetMaxRange (txPwrdBm, -90.0), 127.2, tolerance, "Got unexpected max range");
+  NS_TEST_EXPECT_MSG_EQ_TOL (lossModel->GetMaxRange (txPwrdBm, -70.0), 0.0, tolerance, "Got unexpected max range");
   Simulator::Destroy ();
   
   return GetErrorStatus ();
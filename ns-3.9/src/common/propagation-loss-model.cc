@@ -27,6 +27,8 @@
 #include "ns3/boolean.h"
 #include "ns3/double.h"
 #include <math.h>
+#include <limits>
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("PropagationLossModel");
 
@@ -71,6 +73,58 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+double
+PropagationLossModel::GetMaxRange (double txPowerDbm, double rxPowerDbm) const
+{
+  if (m_next != 0)
+    {
+      return std::numeric_limits<double>::infinity ();
+    }
+  return DoGetMaxRange (txPowerDbm, rxPowerDbm);
+}
+
+double
+PropagationLossModel::DoGetMaxRange (double txPowerDbm, double rxPowerDbm) const
+{
+  return std::numeric_limits<double>::infinity ();
+}
+
+void
+PropagationLossModel::CalcRxPowerBatch (double txPowerDbm,
+                                        Ptr<MobilityModel> a,
+                                        const Ptr<MobilityModel> *b,
+                                        const double *distance,
+                                        double *rxPowerDbm,
+                                        uint32_t n) const
+{
+  std::fill (rxPowerDbm, rxPowerDbm + n, txPowerDbm);
+  ApplyBatch (a, b, distance, rxPowerDbm, n);
+}
+
+void
+PropagationLossModel::ApplyBatch (Ptr<MobilityModel> a, const Ptr<MobilityModel> *b,
+                                  const double *distance, double *powerDbm, uint32_t n) const
+{
+  DoCalcRxPowerBatch (a, b, distance, powerDbm, n);
+  if (m_next != 0)
+    {
+      m_next->ApplyBatch (a, b, distance, powerDbm, n);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                          const Ptr<MobilityModel> *b,
+                                          const double *distance,
+                                          double *powerDbm,
+                                          uint32_t n) const
+{
+  for (uint32_t k = 0; k < n; k++)
+    {
+      powerDbm[k] = DoCalcRxPower (powerDbm[k], a, b[k]);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationLossModel);
@@ -234,6 +288,46 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + pr;
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                               const Ptr<MobilityModel> *b,
+                                               const double *distance,
+                                               double *powerDbm,
+                                               uint32_t n) const
+{
+  // Same arithmetic as DoCalcRxPower, one destination after the other.
+  double numerator = m_lambda * m_lambda;
+  double factor = 16 * PI * PI;
+  for (uint32_t k = 0; k < n; k++)
+    {
+      if (distance[k] > m_minDistance)
+        {
+          double denominator = factor * distance[k] * distance[k] * m_systemLoss;
+          powerDbm[k] += 10 * log10 (numerator / denominator);
+        }
+    }
+}
+
+double
+FriisPropagationLossModel::DoGetMaxRange (double txPowerDbm, double rxPowerDbm) const
+{
+  /*
+   * Invert the equation above: the attenuation grows monotonically
+   * with the distance beyond MinDistance, below which the txpower is
+   * returned unmodified.
+   *
+   *           lambda
+   * d = ---------------- * 10^((tx - rx) / 20)
+   *      4 * pi * sqrt(L)
+   */
+  double distance = m_lambda / (4 * PI * sqrt (m_systemLoss)) * pow (10, (txPowerDbm - rxPowerDbm) / 20);
+  if (txPowerDbm >= rxPowerDbm && distance < m_minDistance)
+    {
+      return m_minDistance;
+    }
+  return distance;
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -827,6 +921,20 @@ RangePropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+double
+RangePropagationLossModel::DoGetMaxRange (double txPowerDbm, double rxPowerDbm) const
+{
+  if (rxPowerDbm <= -1000)
+    {
+      return std::numeric_limits<double>::infinity ();
+    }
+  if (txPowerDbm < rxPowerDbm)
+    {
+      return 0;
+    }
+  return m_range;
+}
+
 // ------------------------------------------------------------------------- //
 
 } // namespace ns3
@@ -59,12 +59,53 @@ public:
   double CalcRxPower (double txPowerDbm,
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
+  /**
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param rxPowerDbm the reception power of interest (in dBm)
+   * \returns a distance (m) beyond which the reception power is
+   *          guaranteed to be lower than rxPowerDbm.
+   *
+   * Models which cannot provide such a bound return infinity, as does
+   * a chain of models: the models following this one in the chain are
+   * not known to only attenuate the signal.
+   */
+  double GetMaxRange (double txPowerDbm, double rxPowerDbm) const;
+  /**
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param b the mobility models of n destinations
+   * \param distance the distances (m) from a to each of the destinations
+   * \param rxPowerDbm receives the n reception powers (in dBm)
+   * \param n the number of destinations
+   *
+   * Batch form of CalcRxPower, for a source reaching many destinations
+   * at once. Equivalent to n calls to CalcRxPower.
+   */
+  void CalcRxPowerBatch (double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         const Ptr<MobilityModel> *b,
+                         const double *distance,
+                         double *rxPowerDbm,
+                         uint32_t n) const;
 private:
   PropagationLossModel (const PropagationLossModel &o);
   PropagationLossModel &operator = (const PropagationLossModel &o);
+  void ApplyBatch (Ptr<MobilityModel> a, const Ptr<MobilityModel> *b,
+                   const double *distance, double *powerDbm, uint32_t n) const;
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
+  virtual double DoGetMaxRange (double txPowerDbm, double rxPowerDbm) const;
+  /**
+   * Replaces each powerDbm[k] by the power received at b[k] when
+   * transmitting powerDbm[k] from a. The default implementation invokes
+   * DoCalcRxPower for each destination.
+   */
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const Ptr<MobilityModel> *b,
+                                   const double *distance,
+                                   double *powerDbm,
+                                   uint32_t n) const;
 
   Ptr<PropagationLossModel> m_next;
 };
@@ -177,6 +218,12 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual double DoGetMaxRange (double txPowerDbm, double rxPowerDbm) const;
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const Ptr<MobilityModel> *b,
+                                   const double *distance,
+                                   double *powerDbm,
+                                   uint32_t n) const;
   double DbmToW (double dbm) const;
   double DbmFromW (double w) const;
 
@@ -522,6 +569,7 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual double DoGetMaxRange (double txPowerDbm, double rxPowerDbm) const;
 private:
   double m_range;
 };
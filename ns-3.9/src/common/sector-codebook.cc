@@ -0,0 +1,169 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "sector-codebook.h"
+#include "antenna.h"
+#include <math.h>
+
+NS_LOG_COMPONENT_DEFINE ("SectorCodebook");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SectorCodebook);
+
+TypeId
+SectorCodebook::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SectorCodebook")
+    .SetParent<Object> ()
+    .AddConstructor<SectorCodebook> ()
+    .AddAttribute ("Sectors",
+                   "The number of sectors, evenly spread over the azimuth plane.",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&SectorCodebook::SetNSectors,
+                                         &SectorCodebook::GetNSectors),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Offset",
+                   "The azimuth angle of the first evenly spread sector in radians. "
+                   "Does not apply to the sectors added with AddSector.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&SectorCodebook::SetOffset,
+                                       &SectorCodebook::GetOffset),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Elevation",
+                   "The elevation angle of the evenly spread sectors in radians. "
+                   "Does not apply to the sectors added with AddSector.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&SectorCodebook::SetElevation,
+                                       &SectorCodebook::GetDefaultElevation),
+                   MakeDoubleChecker<double> ())
+    ;
+  return tid;
+}
+
+SectorCodebook::SectorCodebook ()
+  : m_nSectors (32),
+    m_offset (0),
+    m_elevation (0)
+{
+  Build ();
+}
+
+SectorCodebook::~SectorCodebook ()
+{}
+
+void
+SectorCodebook::Build (void)
+{
+  m_sectors.resize (m_nSectors);
+  for (uint32_t s = 0; s < m_nSectors; s++)
+    {
+      m_sectors[s].azimuth = m_offset + 2 * M_PI * s / m_nSectors;
+      m_sectors[s].elevation = m_elevation;
+    }
+}
+
+void
+SectorCodebook::SetNSectors (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_nSectors = n;
+  Build ();
+}
+
+uint32_t
+SectorCodebook::GetNSectors (void) const
+{
+  return m_sectors.size ();
+}
+
+void
+SectorCodebook::SetOffset (double offset)
+{
+  m_offset = offset;
+  if (m_nSectors != 0)
+    {
+      // Sectors added with AddSector keep their own angles.
+      Build ();
+    }
+}
+
+double
+SectorCodebook::GetOffset (void) const
+{
+  return m_offset;
+}
+
+void
+SectorCodebook::SetElevation (double elevation)
+{
+  m_elevation = elevation;
+  if (m_nSectors != 0)
+    {
+      // Sectors added with AddSector keep their own angles.
+      Build ();
+    }
+}
+
+double
+SectorCodebook::GetDefaultElevation (void) const
+{
+  return m_elevation;
+}
+
+uint32_t
+SectorCodebook::AddSector (double azimuth, double elevation)
+{
+  NS_LOG_FUNCTION (this << azimuth << elevation);
+  if (m_nSectors != 0)
+    {
+      // The first explicit sector replaces the evenly spread ones.
+      m_nSectors = 0;
+      m_sectors.clear ();
+    }
+  struct Sector sector;
+  sector.azimuth = azimuth;
+  sector.elevation = elevation;
+  m_sectors.push_back (sector);
+  return m_sectors.size () - 1;
+}
+
+double
+SectorCodebook::GetAzimuth (uint32_t sector) const
+{
+  NS_ASSERT (sector < m_sectors.size ());
+  return m_sectors[sector].azimuth;
+}
+
+double
+SectorCodebook::GetElevation (uint32_t sector) const
+{
+  NS_ASSERT (sector < m_sectors.size ());
+  return m_sectors[sector].elevation;
+}
+
+void
+SectorCodebook::Steer (Ptr<Antenna> antenna, uint32_t sector) const
+{
+  NS_ASSERT (sector < m_sectors.size ());
+  antenna->Steer (m_sectors[sector].azimuth, m_sectors[sector].elevation);
+}
+
+} // namespace ns3
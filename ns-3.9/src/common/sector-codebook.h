@@ -0,0 +1,89 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SECTOR_CODEBOOK_H
+#define SECTOR_CODEBOOK_H
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include <vector>
+
+namespace ns3 {
+
+class Antenna;
+
+/**
+ * \brief The discrete set of directions a steerable antenna can be pointed at
+ *
+ * Sector s points the main lobe of the antenna at azimuth
+ * Offset + 2*pi*s/Sectors and at the configured elevation, unless the
+ * sectors were listed explicitly with AddSector. A codebook is usually
+ * aggregated to the Antenna it applies to.
+ */
+class SectorCodebook : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  SectorCodebook ();
+  virtual ~SectorCodebook ();
+
+  /**
+   * \param n the number of sectors, evenly spread over the azimuth plane
+   *
+   * Replaces any sector added with AddSector.
+   */
+  void SetNSectors (uint32_t n);
+  uint32_t GetNSectors (void) const;
+
+  /**
+   * \param azimuth the azimuth angle of the new sector, in radians
+   * \param elevation the elevation angle of the new sector, in radians
+   * \returns the id of the new sector
+   */
+  uint32_t AddSector (double azimuth, double elevation);
+
+  double GetAzimuth (uint32_t sector) const;
+  double GetElevation (uint32_t sector) const;
+
+  /**
+   * \param antenna the antenna to steer
+   * \param sector the sector to point it at
+   */
+  void Steer (Ptr<Antenna> antenna, uint32_t sector) const;
+
+private:
+  struct Sector
+  {
+    double azimuth;
+    double elevation;
+  };
+
+  void Build (void);
+  void SetOffset (double offset);
+  double GetOffset (void) const;
+  void SetElevation (double elevation);
+  double GetDefaultElevation (void) const;
+
+  uint32_t m_nSectors;
+  double m_offset;
+  double m_elevation;
+  std::vector<struct Sector> m_sectors;
+};
+
+} // namespace ns3
+
+#endif /* SECTOR_CODEBOOK_H */
@@ -23,6 +23,10 @@
 #include "rng-stream.h"
 #include "global-value.h"
 #include "integer.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "system-mutex.h"
+#endif
 using namespace std;
 
 namespace
@@ -211,6 +215,34 @@ static ns3::GlobalValue g_rngRun ("RngRun",
                                   ns3::IntegerValue (1),
                                   ns3::MakeIntegerChecker<uint32_t> ());
 
+// Holds the lock of the package seed, which the streams created on several
+// threads at once, as by the partitions of a MultithreadedSimulatorImpl,
+// advance.
+class SeedLock
+{
+public:
+  SeedLock ()
+  {
+#ifdef HAVE_PTHREAD_H
+    GetMutex ().Lock ();
+#endif
+  }
+  ~SeedLock ()
+  {
+#ifdef HAVE_PTHREAD_H
+    GetMutex ().Unlock ();
+#endif
+  }
+private:
+#ifdef HAVE_PTHREAD_H
+  static ns3::SystemMutex &GetMutex (void)
+  {
+    static ns3::SystemMutex mutex;
+    return mutex;
+  }
+#endif
+};
+
 } // end of anonymous namespace
 
 
@@ -304,8 +336,8 @@ bool RngStream::CheckSeed (const uint32_t seed[6])
 uint32_t
 RngStream::EnsureGlobalInitialized (void)
 {
+  // called under the seed lock
   static bool initialized = false;
-  static uint32_t run = 0;
   if (!initialized)
     {
       initialized = true;
@@ -313,11 +345,10 @@ RngStream::EnsureGlobalInitialized (void)
       IntegerValue value;
       g_rngSeed.GetValue (value);
       seed = value.Get ();
-      g_rngRun.GetValue (value);
-      run = value.Get ();
-      SetPackageSeed (seed);
+      uint32_t seeds[6] = {seed, seed, seed, seed, seed, seed};
+      DoSetPackageSeed (seeds);
     }
-  return run;
+  return packageRun;
 }
 
 //*************************************************************************
@@ -333,13 +364,18 @@ double RngStream::nextSeed[6] =
 {
   12345.0, 12345.0, 12345.0, 12345.0, 12345.0, 12345.0
 };
+uint32_t RngStream::packageRun = 0;
 
 //-------------------------------------------------------------------------
 // constructor
 //
 RngStream::RngStream ()
 {
-  uint32_t run = EnsureGlobalInitialized ();
+  uint32_t run;
+  {
+    SeedLock lock;
+    run = EnsureGlobalInitialized ();
+  }
   
   anti = false;
   incPrec = false;
@@ -372,6 +408,7 @@ void RngStream::InitializeStream()
      bits if machine follows IEEE 754 standard) if incPrec = true. nextSeed
      will be the seed of the next declared RngStream. */
 
+  SeedLock lock;
   for (int i = 0; i < 6; ++i) {
     Bg[i] = Cg[i] = Ig[i] = nextSeed[i];
   }
@@ -427,6 +464,12 @@ void RngStream::ResetNthSubstream (uint32_t N)
 
 //-------------------------------------------------------------------------
 bool RngStream::SetPackageSeed (const uint32_t seed[6])
+{
+  SeedLock lock;
+  return DoSetPackageSeed (seed);
+}
+bool
+RngStream::DoSetPackageSeed (const uint32_t seed[6])
 {
   if (!CheckSeed (seed))
     {
@@ -434,6 +477,10 @@ bool RngStream::SetPackageSeed (const uint32_t seed[6])
     }
   for (int i = 0; i < 6; ++i)
     nextSeed[i] = seed[i];
+  // the streams start over, in the run currently configured
+  IntegerValue value;
+  g_rngRun.GetValue (value);
+  packageRun = value.Get ();
   return true;
 }
 bool 
@@ -53,6 +53,15 @@ public:  //public api
   double RandU01 ();
   int32_t RandInt (int32_t i, int32_t j);
 public: //public static api
+  /**
+   * Restart the sequence of streams handed to new RngStream objects from
+   * this seed, in the run currently set by SeedManager::SetRun. Streams
+   * which already exist are not affected.
+   *
+   * The package seed is kept under a lock, so that streams may be created
+   * on several threads at once; they then take their seeds in the order in
+   * which the threads get there.
+   */
   static bool SetPackageSeed (uint32_t seed);
   static bool SetPackageSeed (const uint32_t seed[6]);
   static void GetPackageSeed (uint32_t seed[6]);
@@ -66,8 +75,10 @@ private: //members
   double U01 ();
   double U01d ();
   static uint32_t EnsureGlobalInitialized (void);
+  static bool DoSetPackageSeed (const uint32_t seed[6]);
 private: //static data
   static double nextSeed[6];
+  static uint32_t packageRun;
 };
 
 } //namespace ns3
@@ -46,13 +46,25 @@ PointToPointRemoteChannel::GetTypeId (void)
 }
 
 PointToPointRemoteChannel::PointToPointRemoteChannel ()
+  : m_nAttached (0)
 {
+  m_device[0] = 0;
+  m_device[1] = 0;
 }
 
 PointToPointRemoteChannel::~PointToPointRemoteChannel ()
 {
 }
 
+void
+PointToPointRemoteChannel::Attach (Ptr<PointToPointNetDevice> device)
+{
+  PointToPointChannel::Attach (device);
+  m_device[m_nAttached] = PeekPointer (device);
+  m_nodeId[m_nAttached] = device->GetNode ()->GetId ();
+  m_nAttached++;
+}
+
 bool
 PointToPointRemoteChannel::TransmitStart (
   Ptr<Packet> p,
@@ -64,16 +76,31 @@ PointToPointRemoteChannel::TransmitStart (
 
   IsInitialized ();
 
-  uint32_t wire = src == GetSource (0) ? 0 : 1;
-  Ptr<PointToPointNetDevice> dst = GetDestination (wire);
-
-  // Calculate the rxTime (absolute)
-  Time rxTime = Simulator::Now () + txTime + GetDelay ();
 #ifdef NS3_MPI
-  MpiInterface::SendPacket (p, rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
-#else
-  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+  if (MpiInterface::IsEnabled ())
+    {
+      uint32_t wire = src == GetSource (0) ? 0 : 1;
+      Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+
+      // Calculate the rxTime (absolute)
+      Time rxTime = Simulator::Now () + txTime + GetDelay ();
+      MpiInterface::SendPacket (p, rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
+      return true;
+    }
 #endif
+
+  // The other device runs in another thread of the
+  // MultithreadedSimulatorImpl. The packet shares its buffer with the
+  // copies kept on this side, so it gets a deep copy of its own, as if
+  // sent through MPI.
+  uint32_t wire = PeekPointer (src) == m_device[0] ? 0 : 1;
+  uint32_t size = p->GetSerializedSize ();
+  uint8_t *buffer = new uint8_t[size];
+  p->Serialize (buffer, size);
+  Ptr<Packet> copy = Create<Packet> (buffer, size, true);
+  delete [] buffer;
+  Simulator::ScheduleWithContext (m_nodeId[1 - wire], txTime + GetDelay (),
+                                  &PointToPointNetDevice::Receive, m_device[1 - wire], copy);
   return true;
 }
 
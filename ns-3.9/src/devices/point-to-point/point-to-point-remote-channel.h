@@ -20,7 +20,9 @@
 
 // This object connects two point-to-point net devices where at least one
 // is not local to this simulator object.  It simply over-rides the transmit
-// method and uses an MPI Send operation instead.
+// method and uses an MPI Send operation instead, or, for the
+// MultithreadedSimulatorImpl, schedules the reception in the partition of
+// the other device.
 
 #ifndef POINT_TO_POINT_REMOTE_CHANNEL_H
 #define POINT_TO_POINT_REMOTE_CHANNEL_H
@@ -35,7 +37,17 @@ public:
   static TypeId GetTypeId (void);
   PointToPointRemoteChannel ();
   ~PointToPointRemoteChannel ();
+  virtual void Attach (Ptr<PointToPointNetDevice> device);
   virtual bool TransmitStart (Ptr<Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
+
+private:
+  // The devices and the ids of their nodes, kept here for the threads of the
+  // MultithreadedSimulatorImpl: the reference counts of a device belong to
+  // the thread of its partition, which a Ptr to it would touch from the
+  // other one.
+  PointToPointNetDevice *m_device[2];
+  uint32_t m_nodeId[2];
+  uint32_t m_nAttached;
 };
 }
 
@@ -0,0 +1,325 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/measured-2d-antenna.h"
+#include "ns3/sector-codebook.h"
+#include "beamforming-training.h"
+#include "ctrl-headers.h"
+#include "wifi-mac-header.h"
+#include "yans-wifi-channel.h"
+#include "yans-wifi-phy.h"
+#include "sensitivity-model-60-ghz.h"
+#include <math.h>
+#include <algorithm>
+
+namespace ns3 {
+
+class CtrlDmgSswHeaderTest : public TestCase
+{
+public:
+  CtrlDmgSswHeaderTest ();
+  virtual ~CtrlDmgSswHeaderTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+CtrlDmgSswHeaderTest::CtrlDmgSswHeaderTest ()
+  : TestCase ("Sector sweep fields survive serialization")
+{}
+
+CtrlDmgSswHeaderTest::~CtrlDmgSswHeaderTest ()
+{}
+
+bool
+CtrlDmgSswHeaderTest::DoRun (void)
+{
+  CtrlDmgSswHeader ssw;
+  ssw.SetKind (CtrlDmgSswHeader::SSW_FEEDBACK);
+  ssw.SetDirection (true);
+  ssw.SetCountdown (300);
+  ssw.SetSectorId (45);
+  ssw.SetFeedbackSector (7);
+  ssw.SetSnrReport (12.25);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (ssw);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 7, "Unexpected SSW body size");
+  CtrlDmgSswHeader copy;
+  packet->RemoveHeader (copy);
+  NS_TEST_EXPECT_MSG_EQ (copy.GetKind (), CtrlDmgSswHeader::SSW_FEEDBACK, "Kind");
+  NS_TEST_EXPECT_MSG_EQ (copy.IsResponder (), true, "Direction");
+  NS_TEST_EXPECT_MSG_EQ (copy.GetCountdown (), 300, "CDOWN");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)copy.GetSectorId (), 45, "Sector id");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)copy.GetFeedbackSector (), 7, "Feedback sector");
+  NS_TEST_EXPECT_MSG_EQ (copy.GetSnrReport (), 12.25, "SNR report");
+  return GetErrorStatus ();
+}
+
+
+/**
+ * The Offset and Elevation attributes shape the evenly spread sectors
+ * and leave the sectors added with AddSector alone.
+ */
+class SectorCodebookTest : public TestCase
+{
+public:
+  SectorCodebookTest ();
+  virtual ~SectorCodebookTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+SectorCodebookTest::SectorCodebookTest ()
+  : TestCase ("Codebook attributes only apply to evenly spread sectors")
+{}
+
+SectorCodebookTest::~SectorCodebookTest ()
+{}
+
+bool
+SectorCodebookTest::DoRun (void)
+{
+  Ptr<SectorCodebook> even = CreateObject<SectorCodebook> ();
+  even->SetNSectors (4);
+  even->SetAttribute ("Offset", DoubleValue (0.1));
+  even->SetAttribute ("Elevation", DoubleValue (0.2));
+  NS_TEST_EXPECT_MSG_EQ (even->GetNSectors (), 4, "Offset changed the number of sectors");
+  NS_TEST_EXPECT_MSG_EQ_TOL (even->GetAzimuth (1), 0.1 + M_PI / 2, 1e-12, "Offset ignored");
+  NS_TEST_EXPECT_MSG_EQ_TOL (even->GetElevation (3), 0.2, 1e-12, "Elevation ignored");
+
+  Ptr<SectorCodebook> listed = CreateObject<SectorCodebook> ();
+  listed->AddSector (0.5, 0.1);
+  listed->AddSector (2.5, -0.1);
+  listed->SetAttribute ("Offset", DoubleValue (1));
+  listed->SetAttribute ("Elevation", DoubleValue (0.3));
+  NS_TEST_EXPECT_MSG_EQ (listed->GetNSectors (), 2, "Explicit sectors were replaced");
+  NS_TEST_EXPECT_MSG_EQ_TOL (listed->GetAzimuth (0), 0.5, 1e-12, "Explicit azimuth changed");
+  NS_TEST_EXPECT_MSG_EQ_TOL (listed->GetAzimuth (1), 2.5, 1e-12, "Explicit azimuth changed");
+  NS_TEST_EXPECT_MSG_EQ_TOL (listed->GetElevation (1), -0.1, 1e-12, "Explicit elevation changed");
+  listed->SetNSectors (8);
+  NS_TEST_EXPECT_MSG_EQ (listed->GetNSectors (), 8, "Sectors not spread again");
+  NS_TEST_EXPECT_MSG_EQ_TOL (listed->GetAzimuth (0), 1, 1e-12, "Offset not kept");
+  return GetErrorStatus ();
+}
+
+
+/**
+ * Two PHYs with measured antennas and 16 sector codebooks, 4 meters
+ * apart. The sweep must pick the sectors closest to the bearing of the
+ * peer, and a second training of the pair must come from the cache.
+ * The responder sweep must report the SNR of the best initiator sector
+ * and the feedback the SNR of the best responder sector.
+ */
+class BeamformingTrainingSweepTest : public TestCase
+{
+public:
+  BeamformingTrainingSweepTest ();
+  virtual ~BeamformingTrainingSweepTest ();
+
+private:
+  virtual bool DoRun (void);
+  Ptr<YansWifiPhy> CreatePhy (Ptr<YansWifiChannel> channel, Vector position);
+  void Trained (Ptr<const YansWifiPhy> initiator, Ptr<const YansWifiPhy> responder,
+                Time duration, bool success);
+  void Train (void);
+  void Done (bool success);
+  void Sniff (uint32_t phy, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+              uint16_t channelNumber, uint32_t rate, bool isShortPreamble,
+              double signalDbm, double noiseDbm);
+
+  Ptr<BeamformingTraining> m_training;
+  Ptr<YansWifiPhy> m_a;
+  Ptr<YansWifiPhy> m_b;
+  std::vector<Time> m_durations;
+  uint32_t m_successes;
+  double m_issSnrDb;
+  double m_rssSnrDb;
+  std::vector<double> m_rssReports;
+  std::vector<double> m_feedbackReports;
+};
+
+BeamformingTrainingSweepTest::BeamformingTrainingSweepTest ()
+  : TestCase ("Sector sweep finds the sectors facing the peer"),
+    m_successes (0),
+    m_issSnrDb (-1000),
+    m_rssSnrDb (-1000)
+{}
+
+BeamformingTrainingSweepTest::~BeamformingTrainingSweepTest ()
+{}
+
+Ptr<YansWifiPhy>
+BeamformingTrainingSweepTest::CreatePhy (Ptr<YansWifiChannel> channel, Vector position)
+{
+  Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (position);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ad_SC);
+  phy->SetErrorRateModel (CreateObject<SensitivityModel60GHz> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (mobility);
+  Ptr<Measured2DAntenna> antenna = CreateObject<Measured2DAntenna> ();
+  antenna->SetMode (23);
+  Ptr<SectorCodebook> codebook = CreateObject<SectorCodebook> ();
+  codebook->SetNSectors (16);
+  antenna->AggregateObject (codebook);
+  phy->SetAntenna (antenna);
+  return phy;
+}
+
+void
+BeamformingTrainingSweepTest::Trained (Ptr<const YansWifiPhy> initiator, Ptr<const YansWifiPhy> responder,
+                                       Time duration, bool success)
+{
+  m_durations.push_back (duration);
+}
+
+void
+BeamformingTrainingSweepTest::Train (void)
+{
+  m_training->Train (m_a, m_b, MakeCallback (&BeamformingTrainingSweepTest::Done, this));
+}
+
+void
+BeamformingTrainingSweepTest::Done (bool success)
+{
+  if (success)
+    {
+      m_successes++;
+    }
+}
+
+void
+BeamformingTrainingSweepTest::Sniff (uint32_t phy, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                                     uint16_t channelNumber, uint32_t rate, bool isShortPreamble,
+                                     double signalDbm, double noiseDbm)
+{
+  Ptr<Packet> copy = packet->Copy ();
+  WifiMacHeader hdr;
+  copy->RemoveHeader (hdr);
+  if (!hdr.IsSectorSweep ())
+    {
+      return;
+    }
+  CtrlDmgSswHeader ssw;
+  copy->RemoveHeader (ssw);
+  double snrDb = signalDbm - noiseDbm;
+  if (ssw.GetKind () == CtrlDmgSswHeader::SSW_FEEDBACK)
+    {
+      m_feedbackReports.push_back (ssw.GetSnrReport ());
+    }
+  else if (ssw.GetKind () == CtrlDmgSswHeader::SSW && !ssw.IsResponder () && phy == 1)
+    {
+      if (ssw.GetSectorId () == 0)
+        {
+          // The responder listens on its next sector.
+          m_issSnrDb = -1000;
+        }
+      m_issSnrDb = std::max (m_issSnrDb, snrDb);
+    }
+  else if (ssw.GetKind () == CtrlDmgSswHeader::SSW && ssw.IsResponder () && phy == 0)
+    {
+      m_rssReports.push_back (ssw.GetSnrReport ());
+      m_rssSnrDb = std::max (m_rssSnrDb, snrDb);
+    }
+}
+
+bool
+BeamformingTrainingSweepTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  Ptr<FriisPropagationLossModel> loss = CreateObject<FriisPropagationLossModel> ();
+  loss->SetLambda (3e8 / 60.48e9);
+  channel->SetPropagationLossModel (loss);
+  double bearing = 0.6;
+  m_a = CreatePhy (channel, Vector (0, 0, 0));
+  m_b = CreatePhy (channel, Vector (4 * cos (bearing), 4 * sin (bearing), 0));
+
+  m_a->TraceConnectWithoutContext ("PromiscSnifferRx",
+    MakeCallback (&BeamformingTrainingSweepTest::Sniff, this).Bind (0));
+  m_b->TraceConnectWithoutContext ("PromiscSnifferRx",
+    MakeCallback (&BeamformingTrainingSweepTest::Sniff, this).Bind (1));
+
+  m_training = CreateObject<BeamformingTraining> ();
+  m_training->TraceConnectWithoutContext ("Training",
+    MakeCallback (&BeamformingTrainingSweepTest::Trained, this));
+  Simulator::Schedule (Seconds (1), &BeamformingTrainingSweepTest::Train, this);
+  Simulator::Schedule (Seconds (2), &BeamformingTrainingSweepTest::Train, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_successes, 2, "Training failed");
+  NS_TEST_EXPECT_MSG_EQ (m_durations.size (), 2, "Missing training trace");
+  uint32_t sectorA = 0, sectorB = 0;
+  bool cached = m_training->Lookup (m_a, m_b, &sectorA, &sectorB);
+  NS_TEST_EXPECT_MSG_EQ (cached, true, "The trained pair is not cached");
+  // The sectors at 45 and 225 degrees are the closest to the bearings.
+  NS_TEST_EXPECT_MSG_EQ (sectorA, 2, "Wrong initiator sector");
+  NS_TEST_EXPECT_MSG_EQ (sectorB, 10, "Wrong responder sector");
+  if (m_durations.size () == 2)
+    {
+      // Two sweeps of 16 frames, then the feedback and the ack.
+      NS_TEST_EXPECT_MSG_EQ ((m_durations[0] > MicroSeconds (34)), true, "Training took no airtime");
+      NS_TEST_EXPECT_MSG_EQ (m_durations[1], Seconds (0), "Second training did not use the cache");
+    }
+  // The reports are quantized to 0.25 dB and saturate at 55.75 dB.
+  NS_TEST_EXPECT_MSG_EQ ((m_issSnrDb < 55 && m_rssSnrDb < 55), true, "SNR out of the report range");
+  NS_TEST_EXPECT_MSG_EQ (m_rssReports.size (), 16, "Responder sweep not heard");
+  for (uint32_t i = 0; i < m_rssReports.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_rssReports[i], m_issSnrDb, 0.125,
+                                 "Responder sector " << i << " reports another SNR");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_feedbackReports.size (), 1, "Feedback not heard");
+  if (m_feedbackReports.size () == 1)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_feedbackReports[0], m_rssSnrDb, 0.125,
+                                 "Feedback does not report the responder sweep");
+    }
+  m_training->Dispose ();
+  m_a = 0;
+  m_b = 0;
+  return GetErrorStatus ();
+}
+
+
+class BeamformingTrainingTestSuite : public TestSuite
+{
+public:
+  BeamformingTrainingTestSuite ();
+};
+
+BeamformingTrainingTestSuite::BeamformingTrainingTestSuite ()
+  : TestSuite ("devices-wifi-beamforming-training", UNIT)
+{
+  AddTestCase (new CtrlDmgSswHeaderTest);
+  AddTestCase (new SectorCodebookTest);
+  AddTestCase (new BeamformingTrainingSweepTest);
+}
+
+BeamformingTrainingTestSuite g_beamformingTrainingTestSuite;
+
+} // namespace ns3
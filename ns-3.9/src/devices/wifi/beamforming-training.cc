@@ -0,0 +1,471 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/net-device.h"
+#include "ns3/antenna.h"
+#include "ns3/sector-codebook.h"
+#include "beamforming-training.h"
+#include "yans-wifi-phy.h"
+#include "wifi-mac-header.h"
+#include "wifi-mac-trailer.h"
+#include "ctrl-headers.h"
+
+NS_LOG_COMPONENT_DEFINE ("BeamformingTraining");
+
+namespace ns3 {
+
+// The SSW field holds 6 bit sector ids.
+static const uint32_t MAX_SECTORS = 64;
+
+/**
+ * The state of one sector level sweep between two PHYs. Lives as long
+ * as the events and trace connections which refer to it.
+ */
+class BeamformingTraining::Session : public SimpleRefCount<BeamformingTraining::Session>
+{
+public:
+  Session (Ptr<BeamformingTraining> owner, Ptr<YansWifiPhy> initiator,
+           Ptr<YansWifiPhy> responder, DoneCallback done);
+  void Start (void);
+
+private:
+  enum Phase
+  {
+    ISS,
+    RSS,
+    FEEDBACK
+  };
+  void BeginIss (void);
+  void SendSweep (uint32_t sector);
+  void EndSweep (void);
+  void SendFeedback (void);
+  void SendAck (void);
+  Time Send (Ptr<YansWifiPhy> phy, Mac48Address to, Mac48Address from,
+             const CtrlDmgSswHeader &ssw);
+  void Receive (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber,
+                uint32_t rate, bool isShortPreamble, double signalDbm, double noiseDbm);
+  void Finish (bool success);
+  static Mac48Address GetPhyAddress (Ptr<YansWifiPhy> phy);
+
+  Ptr<BeamformingTraining> m_owner;
+  Ptr<YansWifiPhy> m_initiator;
+  Ptr<YansWifiPhy> m_responder;
+  Mac48Address m_initiatorAddress;
+  Mac48Address m_responderAddress;
+  Ptr<SectorCodebook> m_initiatorCodebook;
+  Ptr<SectorCodebook> m_responderCodebook;
+  DoneCallback m_done;
+  Time m_start;
+  enum Phase m_phase;
+  // the sector the responder listens on during the initiator sweep
+  uint32_t m_listen;
+  bool m_heard;
+  uint32_t m_bestSector;
+  // the SNR of the best initiator sector, as heard by the responder
+  double m_initiatorSnrDb;
+  // the SNR of the best responder sector, as heard by the initiator
+  double m_responderSnrDb;
+  uint32_t m_initiatorSector;
+  uint32_t m_responderSector;
+};
+
+BeamformingTraining::Session::Session (Ptr<BeamformingTraining> owner, Ptr<YansWifiPhy> initiator,
+                                       Ptr<YansWifiPhy> responder, DoneCallback done)
+  : m_owner (owner),
+    m_initiator (initiator),
+    m_responder (responder),
+    m_initiatorAddress (GetPhyAddress (initiator)),
+    m_responderAddress (GetPhyAddress (responder)),
+    m_initiatorCodebook (BeamformingTraining::GetCodebook (initiator)),
+    m_responderCodebook (BeamformingTraining::GetCodebook (responder)),
+    m_done (done),
+    m_listen (0),
+    m_heard (false),
+    m_bestSector (0),
+    m_initiatorSnrDb (0),
+    m_responderSnrDb (0),
+    m_initiatorSector (0),
+    m_responderSector (0)
+{
+  if (m_initiatorCodebook->GetNSectors () > MAX_SECTORS ||
+      m_responderCodebook->GetNSectors () > MAX_SECTORS)
+    {
+      NS_FATAL_ERROR ("sector sweeps cannot address more than " << MAX_SECTORS << " sectors");
+    }
+}
+
+Mac48Address
+BeamformingTraining::Session::GetPhyAddress (Ptr<YansWifiPhy> phy)
+{
+  Ptr<Object> device = phy->GetDevice ();
+  if (device == 0)
+    {
+      return Mac48Address::GetBroadcast ();
+    }
+  return Mac48Address::ConvertFrom (device->GetObject<NetDevice> ()->GetAddress ());
+}
+
+void
+BeamformingTraining::Session::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_start = Simulator::Now ();
+  m_initiator->TraceConnectWithoutContext ("PromiscSnifferRx",
+    MakeCallback (&BeamformingTraining::Session::Receive, Ptr<Session> (this)));
+  m_responder->TraceConnectWithoutContext ("PromiscSnifferRx",
+    MakeCallback (&BeamformingTraining::Session::Receive, Ptr<Session> (this)));
+  BeginIss ();
+}
+
+void
+BeamformingTraining::Session::BeginIss (void)
+{
+  NS_LOG_FUNCTION (this << m_listen);
+  m_phase = ISS;
+  m_heard = false;
+  m_responderCodebook->Steer (m_responder->GetAntenna (), m_listen);
+  SendSweep (0);
+}
+
+void
+BeamformingTraining::Session::SendSweep (uint32_t sector)
+{
+  bool responder = m_phase == RSS;
+  Ptr<YansWifiPhy> phy = responder ? m_responder : m_initiator;
+  if (phy->IsStateTx () || phy->IsStateSwitching ())
+    {
+      Simulator::Schedule (phy->GetDelayUntilIdle (), &BeamformingTraining::Session::SendSweep,
+                           Ptr<Session> (this), sector);
+      return;
+    }
+  Ptr<SectorCodebook> codebook = responder ? m_responderCodebook : m_initiatorCodebook;
+  uint32_t n = codebook->GetNSectors ();
+  codebook->Steer (phy->GetAntenna (), sector);
+  CtrlDmgSswHeader ssw;
+  ssw.SetKind (CtrlDmgSswHeader::SSW);
+  ssw.SetDirection (responder);
+  ssw.SetCountdown (n - 1 - sector);
+  ssw.SetSectorId (sector);
+  if (responder)
+    {
+      ssw.SetFeedbackSector (m_initiatorSector);
+      ssw.SetSnrReport (m_initiatorSnrDb);
+    }
+  Time duration = responder ?
+    Send (phy, m_initiatorAddress, m_responderAddress, ssw) :
+    Send (phy, m_responderAddress, m_initiatorAddress, ssw);
+  if (sector + 1 < n)
+    {
+      Simulator::Schedule (duration + m_owner->m_spacing, &BeamformingTraining::Session::SendSweep,
+                           Ptr<Session> (this), sector + 1);
+    }
+  else
+    {
+      Simulator::Schedule (duration + m_owner->m_spacing, &BeamformingTraining::Session::EndSweep,
+                           Ptr<Session> (this));
+    }
+}
+
+Time
+BeamformingTraining::Session::Send (Ptr<YansWifiPhy> phy, Mac48Address to, Mac48Address from,
+                                    const CtrlDmgSswHeader &ssw)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_CTL_DMG_SSW);
+  hdr.SetAddr1 (to);
+  hdr.SetAddr2 (from);
+  hdr.SetDsNotFrom ();
+  hdr.SetDsNotTo ();
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (ssw);
+  packet->AddHeader (hdr);
+  WifiMacTrailer fcs;
+  packet->AddTrailer (fcs);
+  phy->SendPacket (packet, m_owner->m_mode, WIFI_PREAMBLE_LONG, m_owner->m_txPowerLevel);
+  return phy->CalculateTxDuration (packet->GetSize (), m_owner->m_mode, WIFI_PREAMBLE_LONG);
+}
+
+void
+BeamformingTraining::Session::Receive (Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                                       uint16_t channelNumber, uint32_t rate, bool isShortPreamble,
+                                       double signalDbm, double noiseDbm)
+{
+  Ptr<Packet> copy = packet->Copy ();
+  WifiMacHeader hdr;
+  copy->RemoveHeader (hdr);
+  if (!hdr.IsSectorSweep ())
+    {
+      return;
+    }
+  CtrlDmgSswHeader ssw;
+  copy->RemoveHeader (ssw);
+  Mac48Address from = ssw.IsResponder () ? m_responderAddress : m_initiatorAddress;
+  if (hdr.GetAddr2 () != from)
+    {
+      // Part of the training of another pair.
+      return;
+    }
+  double snrDb = signalDbm - noiseDbm;
+  NS_LOG_DEBUG ("heard sector " << (uint32_t)ssw.GetSectorId () << " snr=" << snrDb);
+  if (ssw.GetKind () != CtrlDmgSswHeader::SSW ||
+      ssw.IsResponder () != (m_phase == RSS))
+    {
+      return;
+    }
+  double &bestSnrDb = m_phase == RSS ? m_responderSnrDb : m_initiatorSnrDb;
+  if (!m_heard || snrDb > bestSnrDb)
+    {
+      m_heard = true;
+      m_bestSector = ssw.GetSectorId ();
+      bestSnrDb = snrDb;
+    }
+}
+
+void
+BeamformingTraining::Session::EndSweep (void)
+{
+  NS_LOG_FUNCTION (this << m_phase << m_heard);
+  if (m_phase == ISS)
+    {
+      if (!m_heard)
+        {
+          if (++m_listen < m_responderCodebook->GetNSectors ())
+            {
+              BeginIss ();
+            }
+          else
+            {
+              Finish (false);
+            }
+          return;
+        }
+      // Gains are reciprocal: the best sector to send with is also
+      // the best one to listen with.
+      m_initiatorSector = m_bestSector;
+      m_initiatorCodebook->Steer (m_initiator->GetAntenna (), m_initiatorSector);
+      m_phase = RSS;
+      m_heard = false;
+      SendSweep (0);
+      return;
+    }
+  if (!m_heard)
+    {
+      Finish (false);
+      return;
+    }
+  m_responderSector = m_bestSector;
+  m_responderCodebook->Steer (m_responder->GetAntenna (), m_responderSector);
+  m_phase = FEEDBACK;
+  SendFeedback ();
+}
+
+void
+BeamformingTraining::Session::SendFeedback (void)
+{
+  if (m_initiator->IsStateTx () || m_initiator->IsStateSwitching ())
+    {
+      Simulator::Schedule (m_initiator->GetDelayUntilIdle (),
+                           &BeamformingTraining::Session::SendFeedback, Ptr<Session> (this));
+      return;
+    }
+  CtrlDmgSswHeader ssw;
+  ssw.SetKind (CtrlDmgSswHeader::SSW_FEEDBACK);
+  ssw.SetSectorId (m_initiatorSector);
+  ssw.SetFeedbackSector (m_responderSector);
+  ssw.SetSnrReport (m_responderSnrDb);
+  Time duration = Send (m_initiator, m_responderAddress, m_initiatorAddress, ssw);
+  Simulator::Schedule (duration + m_owner->m_spacing, &BeamformingTraining::Session::SendAck,
+                       Ptr<Session> (this));
+}
+
+void
+BeamformingTraining::Session::SendAck (void)
+{
+  if (m_responder->IsStateTx () || m_responder->IsStateSwitching ())
+    {
+      Simulator::Schedule (m_responder->GetDelayUntilIdle (),
+                           &BeamformingTraining::Session::SendAck, Ptr<Session> (this));
+      return;
+    }
+  CtrlDmgSswHeader ssw;
+  ssw.SetKind (CtrlDmgSswHeader::SSW_ACK);
+  ssw.SetDirection (true);
+  ssw.SetSectorId (m_responderSector);
+  ssw.SetFeedbackSector (m_initiatorSector);
+  Time duration = Send (m_responder, m_initiatorAddress, m_responderAddress, ssw);
+  Simulator::Schedule (duration, &BeamformingTraining::Session::Finish, Ptr<Session> (this), true);
+}
+
+void
+BeamformingTraining::Session::Finish (bool success)
+{
+  NS_LOG_FUNCTION (this << success);
+  m_initiator->TraceDisconnectWithoutContext ("PromiscSnifferRx",
+    MakeCallback (&BeamformingTraining::Session::Receive, Ptr<Session> (this)));
+  m_responder->TraceDisconnectWithoutContext ("PromiscSnifferRx",
+    MakeCallback (&BeamformingTraining::Session::Receive, Ptr<Session> (this)));
+  if (success)
+    {
+      m_owner->Learn (m_initiator, m_responder, m_initiatorSector, m_responderSector);
+    }
+  m_owner->NotifyDone (m_initiator, m_responder, Simulator::Now () - m_start, success, m_done);
+}
+
+
+NS_OBJECT_ENSURE_REGISTERED (BeamformingTraining);
+
+TypeId
+BeamformingTraining::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::BeamformingTraining")
+    .SetParent<Object> ()
+    .AddConstructor<BeamformingTraining> ()
+    .AddAttribute ("SweepMode", "The transmission mode of the sector sweep frames.",
+                   WifiModeValue (WifiMode ("VHTMCS1")),
+                   MakeWifiModeAccessor (&BeamformingTraining::m_mode),
+                   MakeWifiModeChecker ())
+    .AddAttribute ("SweepSpacing", "The time between two sector sweep frames (SBIFS).",
+                   TimeValue (MicroSeconds (1)),
+                   MakeTimeAccessor (&BeamformingTraining::m_spacing),
+                   MakeTimeChecker ())
+    .AddAttribute ("TxPowerLevel", "The power level the sector sweep frames are sent at.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&BeamformingTraining::m_txPowerLevel),
+                   MakeUintegerChecker<uint8_t> ())
+    .AddAttribute ("CacheTimeout",
+                   "How long the best sectors of a pair are reused without a new sweep. "
+                   "Zero keeps them until they are forgotten explicitly.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&BeamformingTraining::m_cacheTimeout),
+                   MakeTimeChecker ())
+    .AddTraceSource ("Training",
+                     "A training ended: initiator, responder, duration and success.",
+                     MakeTraceSourceAccessor (&BeamformingTraining::m_trainingTrace))
+    ;
+  return tid;
+}
+
+BeamformingTraining::BeamformingTraining ()
+  : m_txPowerLevel (0)
+{}
+
+BeamformingTraining::~BeamformingTraining ()
+{}
+
+void
+BeamformingTraining::DoDispose (void)
+{
+  m_cache.clear ();
+  Object::DoDispose ();
+}
+
+Ptr<SectorCodebook>
+BeamformingTraining::GetCodebook (Ptr<YansWifiPhy> phy)
+{
+  Ptr<Antenna> antenna = phy->GetAntenna ();
+  Ptr<SectorCodebook> codebook = antenna->GetObject<SectorCodebook> ();
+  if (codebook == 0)
+    {
+      codebook = CreateObject<SectorCodebook> ();
+      antenna->AggregateObject (codebook);
+    }
+  return codebook;
+}
+
+void
+BeamformingTraining::Train (Ptr<YansWifiPhy> initiator, Ptr<YansWifiPhy> responder, DoneCallback done)
+{
+  NS_LOG_FUNCTION (this << initiator << responder);
+  uint32_t initiatorSector, responderSector;
+  if (Lookup (initiator, responder, &initiatorSector, &responderSector))
+    {
+      GetCodebook (initiator)->Steer (initiator->GetAntenna (), initiatorSector);
+      GetCodebook (responder)->Steer (responder->GetAntenna (), responderSector);
+      Simulator::ScheduleNow (&BeamformingTraining::NotifyDone, this,
+                              initiator, responder, Seconds (0), true, done);
+      return;
+    }
+  Ptr<Session> session = Create<Session> (this, initiator, responder, done);
+  session->Start ();
+}
+
+bool
+BeamformingTraining::Lookup (Ptr<const YansWifiPhy> a, Ptr<const YansWifiPhy> b,
+                             uint32_t *sectorA, uint32_t *sectorB) const
+{
+  bool swapped = false;
+  Cache::const_iterator i = m_cache.find (std::make_pair (a, b));
+  if (i == m_cache.end ())
+    {
+      i = m_cache.find (std::make_pair (b, a));
+      swapped = true;
+    }
+  if (i == m_cache.end ())
+    {
+      return false;
+    }
+  if (!m_cacheTimeout.IsZero () && Simulator::Now () - i->second.learnt >= m_cacheTimeout)
+    {
+      return false;
+    }
+  *sectorA = swapped ? i->second.responderSector : i->second.initiatorSector;
+  *sectorB = swapped ? i->second.initiatorSector : i->second.responderSector;
+  return true;
+}
+
+void
+BeamformingTraining::Forget (Ptr<const YansWifiPhy> a, Ptr<const YansWifiPhy> b)
+{
+  m_cache.erase (std::make_pair (a, b));
+  m_cache.erase (std::make_pair (b, a));
+}
+
+void
+BeamformingTraining::ForgetAll (void)
+{
+  m_cache.clear ();
+}
+
+void
+BeamformingTraining::Learn (Ptr<const YansWifiPhy> initiator, Ptr<const YansWifiPhy> responder,
+                            uint32_t initiatorSector, uint32_t responderSector)
+{
+  Forget (initiator, responder);
+  struct CacheEntry entry;
+  entry.initiatorSector = initiatorSector;
+  entry.responderSector = responderSector;
+  entry.learnt = Simulator::Now ();
+  m_cache[std::make_pair (initiator, responder)] = entry;
+}
+
+void
+BeamformingTraining::NotifyDone (Ptr<const YansWifiPhy> initiator, Ptr<const YansWifiPhy> responder,
+                                 Time duration, bool success, DoneCallback done)
+{
+  NS_LOG_DEBUG ("training " << (success ? "succeeded" : "failed") << " in " << duration);
+  m_trainingTrace (initiator, responder, duration, success);
+  if (!done.IsNull ())
+    {
+      done (success);
+    }
+}
+
+} // namespace ns3
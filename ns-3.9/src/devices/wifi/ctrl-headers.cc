@@ -18,6 +18,9 @@
  * Author: Mirko Banchi <mk.banchi@gmail.com>
  */
 #include "ns3/fatal-error.h"
+#include "ns3/assert.h"
+#include <algorithm>
+#include <math.h>
 
 #include "ctrl-headers.h"
 
@@ -678,4 +681,160 @@ CtrlBAckResponseHeader::IndexInBitmap (uint16_t seq) const
     }
 }
 
+/***********************************
+ *       DMG sector sweep
+ ***********************************/
+
+NS_OBJECT_ENSURE_REGISTERED (CtrlDmgSswHeader);
+
+CtrlDmgSswHeader::CtrlDmgSswHeader ()
+  : m_kind (SSW),
+    m_responder (false),
+    m_cdown (0),
+    m_sectorId (0),
+    m_feedbackSector (0),
+    m_snrReport (0)
+{}
+
+CtrlDmgSswHeader::~CtrlDmgSswHeader ()
+{}
+
+TypeId
+CtrlDmgSswHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CtrlDmgSswHeader")
+    .SetParent<Header> ()
+    .AddConstructor<CtrlDmgSswHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+CtrlDmgSswHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+CtrlDmgSswHeader::Print (std::ostream &os) const
+{
+  os << "Kind=" << (uint32_t)m_kind << ", Direction=" << m_responder
+     << ", CDOWN=" << m_cdown << ", SectorId=" << (uint32_t)m_sectorId
+     << ", FeedbackSector=" << (uint32_t)m_feedbackSector << ", SNR=" << GetSnrReport ();
+}
+
+uint32_t
+CtrlDmgSswHeader::GetSerializedSize () const
+{
+  return 1 + 3 + 3; //Kind, SSW field, SSW feedback field
+}
+
+void
+CtrlDmgSswHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  i.WriteU8 (m_kind);
+  uint32_t ssw = (m_responder ? 1 : 0) | ((m_cdown & 0x1ff) << 1) | ((m_sectorId & 0x3f) << 10);
+  i.WriteU8 (ssw & 0xff);
+  i.WriteU8 ((ssw >> 8) & 0xff);
+  i.WriteU8 ((ssw >> 16) & 0xff);
+  i.WriteU8 (m_feedbackSector & 0x3f);
+  i.WriteU8 (m_snrReport);
+  i.WriteU8 (0);
+}
+
+uint32_t
+CtrlDmgSswHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  m_kind = i.ReadU8 ();
+  uint32_t ssw = i.ReadU8 ();
+  ssw |= i.ReadU8 () << 8;
+  ssw |= i.ReadU8 () << 16;
+  m_responder = (ssw & 0x1) != 0;
+  m_cdown = (ssw >> 1) & 0x1ff;
+  m_sectorId = (ssw >> 10) & 0x3f;
+  m_feedbackSector = i.ReadU8 () & 0x3f;
+  m_snrReport = i.ReadU8 ();
+  i.ReadU8 ();
+  return i.GetDistanceFrom (start);
+}
+
+void
+CtrlDmgSswHeader::SetKind (enum Kind kind)
+{
+  m_kind = kind;
+}
+
+void
+CtrlDmgSswHeader::SetDirection (bool responder)
+{
+  m_responder = responder;
+}
+
+void
+CtrlDmgSswHeader::SetCountdown (uint16_t cdown)
+{
+  NS_ASSERT (cdown < 512);
+  m_cdown = cdown;
+}
+
+void
+CtrlDmgSswHeader::SetSectorId (uint8_t sector)
+{
+  NS_ASSERT (sector < 64);
+  m_sectorId = sector;
+}
+
+void
+CtrlDmgSswHeader::SetFeedbackSector (uint8_t sector)
+{
+  NS_ASSERT (sector < 64);
+  m_feedbackSector = sector;
+}
+
+void
+CtrlDmgSswHeader::SetSnrReport (double snrDb)
+{
+  // From -8 dB to 55.75 dB, in steps of 0.25 dB.
+  double report = floor ((snrDb + 8) * 4 + 0.5);
+  m_snrReport = (uint8_t)std::max (0.0, std::min (255.0, report));
+}
+
+enum CtrlDmgSswHeader::Kind
+CtrlDmgSswHeader::GetKind (void) const
+{
+  return (enum Kind)m_kind;
+}
+
+bool
+CtrlDmgSswHeader::IsResponder (void) const
+{
+  return m_responder;
+}
+
+uint16_t
+CtrlDmgSswHeader::GetCountdown (void) const
+{
+  return m_cdown;
+}
+
+uint8_t
+CtrlDmgSswHeader::GetSectorId (void) const
+{
+  return m_sectorId;
+}
+
+uint8_t
+CtrlDmgSswHeader::GetFeedbackSector (void) const
+{
+  return m_feedbackSector;
+}
+
+double
+CtrlDmgSswHeader::GetSnrReport (void) const
+{
+  return m_snrReport / 4.0 - 8;
+}
+
 }  //namespace ns3
@@ -154,6 +154,59 @@ private:
   } bitmap;
 };
 
+/** Body of the 802.11ad sector sweep control frames.
+ *  The SSW, SSW-Feedback and SSW-Ack frames are told apart by the
+ *  control frame extension of their frame control field, which
+ *  WifiMacHeader does not model: it is carried by the Kind field
+ *  of this header instead. Then come the SSW field (direction,
+ *  countdown and sector id) and the SSW feedback field (best sector
+ *  and SNR report), see 8.4a.1 and 8.4a.2 in IEEE 802.11ad.
+ */
+class CtrlDmgSswHeader : public Header {
+public:
+  enum Kind
+  {
+    SSW,
+    SSW_FEEDBACK,
+    SSW_ACK
+  };
+
+  CtrlDmgSswHeader ();
+  ~CtrlDmgSswHeader ();
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+  void SetKind (enum Kind kind);
+  /**
+   * \param responder false if the frame is sent by the initiator
+   *        of the training.
+   */
+  void SetDirection (bool responder);
+  void SetCountdown (uint16_t cdown);
+  void SetSectorId (uint8_t sector);
+  void SetFeedbackSector (uint8_t sector);
+  void SetSnrReport (double snrDb);
+
+  enum Kind GetKind (void) const;
+  bool IsResponder (void) const;
+  uint16_t GetCountdown (void) const;
+  uint8_t GetSectorId (void) const;
+  uint8_t GetFeedbackSector (void) const;
+  double GetSnrReport (void) const;
+
+private:
+  uint8_t m_kind;
+  bool m_responder;
+  uint16_t m_cdown;
+  uint8_t m_sectorId;
+  uint8_t m_feedbackSector;
+  uint8_t m_snrReport;
+};
+
 } //namespace ns3
 
 #endif /* CTRL_HEADERS_H */
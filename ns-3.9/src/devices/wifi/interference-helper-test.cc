@@ -0,0 +1,784 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "ns3/double.h"
+#include "ns3/packet.h"
+#include "interference-helper.h"
+#include "yans-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "sensitivity-model-60-ghz.h"
+#include "yans-wifi-phy.h"
+#include "wifi-mac-header.h"
+#include "wifi-phy.h"
+
+NS_LOG_COMPONENT_DEFINE ("InterferenceHelperTest");
+
+namespace ns3 {
+
+/**
+ * The noise and interference bookkeeping InterferenceHelper used to do
+ * with a sorted vector, scanned from its start on every query. Kept here
+ * as the reference the incremental store must agree with exactly.
+ */
+class ReferenceNiChanges
+{
+public:
+  ReferenceNiChanges ();
+  void Append (Time start, Time end, double rxPowerW);
+  double GetFirstPower (void) const;
+  Time GetEnergyDuration (double energyW) const;
+  double CalculatePer (Ptr<const InterferenceHelper::Event> event, Ptr<ErrorRateModel> model,
+                       double noiseFigure) const;
+  void NotifyRxStart (void);
+  void NotifyRxEnd (void);
+private:
+  typedef std::vector<std::pair<Time, double> > Changes;
+  struct Later
+  {
+    bool operator () (Time t, const std::pair<Time, double> &c) const { return t < c.first; }
+  };
+  void Insert (Time time, double delta);
+  double CalculateChunkSuccessRate (Ptr<ErrorRateModel> model, double snir, Time duration,
+                                    WifiMode mode) const;
+  Changes m_changes;
+  double m_firstPower;
+  bool m_rxing;
+};
+
+ReferenceNiChanges::ReferenceNiChanges ()
+  : m_firstPower (0.0),
+    m_rxing (false)
+{}
+
+void
+ReferenceNiChanges::Insert (Time time, double delta)
+{
+  Changes::iterator i = std::upper_bound (m_changes.begin (), m_changes.end (), time, Later ());
+  m_changes.insert (i, std::make_pair (time, delta));
+}
+
+void
+ReferenceNiChanges::Append (Time start, Time end, double rxPowerW)
+{
+  Time now = Simulator::Now ();
+  if (!m_rxing)
+    {
+      Changes::iterator nowIterator = std::upper_bound (m_changes.begin (), m_changes.end (), now, Later ());
+      for (Changes::iterator i = m_changes.begin (); i != nowIterator; i++)
+        {
+          m_firstPower += i->second;
+        }
+      if (m_firstPower < 0)
+        {
+          m_firstPower = 0;
+        }
+      m_changes.erase (m_changes.begin (), nowIterator);
+      m_changes.insert (m_changes.begin (), std::make_pair (start, rxPowerW));
+    }
+  else
+    {
+      Insert (start, rxPowerW);
+    }
+  Insert (end, -rxPowerW);
+}
+
+double
+ReferenceNiChanges::GetFirstPower (void) const
+{
+  return m_firstPower;
+}
+
+Time
+ReferenceNiChanges::GetEnergyDuration (double energyW) const
+{
+  Time now = Simulator::Now ();
+  double noiseInterferenceW = m_firstPower;
+  Time end = now;
+  for (Changes::const_iterator i = m_changes.begin (); i != m_changes.end (); i++)
+    {
+      noiseInterferenceW += i->second;
+      end = i->first;
+      if (end < now)
+        {
+          continue;
+        }
+      if (noiseInterferenceW < energyW)
+        {
+          break;
+        }
+    }
+  return end > now ? end - now : MicroSeconds (0);
+}
+
+double
+ReferenceNiChanges::CalculateChunkSuccessRate (Ptr<ErrorRateModel> model, double snir, Time duration,
+                                               WifiMode mode) const
+{
+  if (duration == NanoSeconds (0))
+    {
+      return 1.0;
+    }
+  uint64_t nbits = mode.GetPhyRate () * duration.GetSeconds ();
+  return model->GetChunkSuccessRate (mode, snir, (uint32_t)nbits);
+}
+
+double
+ReferenceNiChanges::CalculatePer (Ptr<const InterferenceHelper::Event> event, Ptr<ErrorRateModel> model,
+                                  double noiseFigure) const
+{
+  // the changes over the event, as CalculateNoiseInterferenceW used to
+  // collect them
+  Changes ni;
+  for (Changes::const_iterator i = m_changes.begin () + 1; i != m_changes.end (); i++)
+    {
+      if (event->GetEndTime () == i->first && event->GetRxPowerW () == -i->second)
+        {
+          break;
+        }
+      ni.push_back (*i);
+    }
+  ni.insert (ni.begin (), std::make_pair (event->GetStartTime (), m_firstPower));
+  ni.push_back (std::make_pair (event->GetEndTime (), 0.0));
+
+  WifiMode payloadMode = event->GetPayloadMode ();
+  WifiPreamble preamble = event->GetPreambleType ();
+  WifiMode headerMode = InterferenceHelper::GetPlcpHeaderMode (payloadMode, preamble);
+  Time plcpHeaderStart = ni[0].first +
+    NanoSeconds (InterferenceHelper::GetPlcpPreambleDurationNanoSeconds (payloadMode, preamble));
+  Time plcpPayloadStart = plcpHeaderStart +
+    NanoSeconds (InterferenceHelper::GetPlcpHeaderDurationNanoSeconds (payloadMode, preamble));
+  double powerW = event->GetRxPowerW ();
+  double noiseInterferenceW = ni[0].second;
+  double floorW = noiseFigure * 1.3803e-23 * 290.0 * payloadMode.GetBandwidth ();
+  double headerFloorW = noiseFigure * 1.3803e-23 * 290.0 * headerMode.GetBandwidth ();
+  double psr = 1.0;
+  Time previous = ni[0].first;
+  for (uint32_t j = 1; j < ni.size (); j++)
+    {
+      Time current = ni[j].first;
+      double payloadSnr = powerW / (floorW + noiseInterferenceW);
+      double headerSnr = powerW / (headerFloorW + noiseInterferenceW);
+      if (previous >= plcpPayloadStart)
+        {
+          psr *= CalculateChunkSuccessRate (model, payloadSnr, current - previous, payloadMode);
+        }
+      else if (previous >= plcpHeaderStart)
+        {
+          if (current >= plcpPayloadStart)
+            {
+              psr *= CalculateChunkSuccessRate (model, headerSnr, plcpPayloadStart - previous, headerMode);
+              psr *= CalculateChunkSuccessRate (model, payloadSnr, current - plcpPayloadStart, payloadMode);
+            }
+          else
+            {
+              psr *= CalculateChunkSuccessRate (model, headerSnr, current - previous, headerMode);
+            }
+        }
+      else
+        {
+          if (current >= plcpPayloadStart)
+            {
+              psr *= CalculateChunkSuccessRate (model, headerSnr, plcpPayloadStart - plcpHeaderStart, headerMode);
+              psr *= CalculateChunkSuccessRate (model, payloadSnr, current - plcpPayloadStart, payloadMode);
+            }
+          else if (current >= plcpHeaderStart)
+            {
+              psr *= CalculateChunkSuccessRate (model, headerSnr, current - plcpHeaderStart, headerMode);
+            }
+        }
+      noiseInterferenceW += ni[j].second;
+      previous = current;
+    }
+  return 1 - psr;
+}
+
+void
+ReferenceNiChanges::NotifyRxStart (void)
+{
+  m_rxing = true;
+}
+
+void
+ReferenceNiChanges::NotifyRxEnd (void)
+{
+  m_rxing = false;
+}
+
+
+class InterferenceHelperSequenceTest : public TestCase
+{
+public:
+  InterferenceHelperSequenceTest ();
+  virtual ~InterferenceHelperSequenceTest ();
+
+private:
+  virtual bool DoRun (void);
+  uint32_t Random (uint32_t n);
+  void Arrival (void);
+  void EndRx (Ptr<InterferenceHelper::Event> event);
+
+  InterferenceHelper m_helper;
+  ReferenceNiChanges m_reference;
+  WifiMode m_mode;
+  uint32_t m_seed;
+  uint32_t m_arrivals;
+  bool m_rxing;
+  double m_lastPer;
+};
+
+InterferenceHelperSequenceTest::InterferenceHelperSequenceTest ()
+  : TestCase ("InterferenceHelper matches a full rescan of its interference events"),
+    m_seed (12345),
+    m_arrivals (0),
+    m_rxing (false),
+    m_lastPer (0)
+{}
+
+InterferenceHelperSequenceTest::~InterferenceHelperSequenceTest ()
+{}
+
+uint32_t
+InterferenceHelperSequenceTest::Random (uint32_t n)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return (m_seed >> 8) % n;
+}
+
+void
+InterferenceHelperSequenceTest::Arrival (void)
+{
+  // A mix of strong and weak signals, with many overlaps and ties.
+  double rxPowerW = 1e-12 * (1 + Random (1000));
+  Time duration = MicroSeconds (10 + 10 * Random (50));
+  Ptr<InterferenceHelper::Event> event = m_helper.Add (100, m_mode, WIFI_PREAMBLE_LONG, duration, rxPowerW);
+  m_reference.Append (event->GetStartTime (), event->GetEndTime (), rxPowerW);
+  if (!m_rxing && Random (3) == 0)
+    {
+      m_rxing = true;
+      m_helper.NotifyRxStart ();
+      m_reference.NotifyRxStart ();
+      NS_TEST_EXPECT_MSG_EQ ((m_helper.CalculateSnrPer (event).snr > 0), true, "Invalid snr");
+      Simulator::Schedule (duration, &InterferenceHelperSequenceTest::EndRx, this, event);
+    }
+  double thresholdW = 1e-12 * Random (3000);
+  NS_TEST_EXPECT_MSG_EQ (m_helper.GetEnergyDuration (thresholdW), m_reference.GetEnergyDuration (thresholdW),
+                         "Energy duration differs from a full rescan");
+  if (++m_arrivals < 2000)
+    {
+      Simulator::Schedule (MicroSeconds (Random (40)), &InterferenceHelperSequenceTest::Arrival, this);
+    }
+}
+
+void
+InterferenceHelperSequenceTest::EndRx (Ptr<InterferenceHelper::Event> event)
+{
+  struct InterferenceHelper::SnrPer snrPer = m_helper.CalculateSnrPer (event);
+  // Same formula as InterferenceHelper::CalculateSnr, from the reference noise.
+  double noiseFloor = m_helper.GetNoiseFigure () * (1.3803e-23 * 290.0 * m_mode.GetBandwidth ());
+  double snr = event->GetRxPowerW () / (noiseFloor + 0.0 + m_reference.GetFirstPower ());
+  NS_TEST_EXPECT_MSG_EQ (snrPer.snr, snr, "Snr differs from a full rescan");
+  NS_TEST_EXPECT_MSG_EQ ((snrPer.per >= 0 && snrPer.per <= 1), true, "Invalid per " << snrPer.per);
+  m_lastPer = snrPer.per;
+  m_rxing = false;
+  m_helper.NotifyRxEnd ();
+  m_reference.NotifyRxEnd ();
+}
+
+bool
+InterferenceHelperSequenceTest::DoRun (void)
+{
+  m_mode = WifiPhy::GetOfdmRate6Mbps ();
+  m_helper.SetNoiseFigure (5.01);
+  m_helper.SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  Simulator::Schedule (Seconds (0), &InterferenceHelperSequenceTest::Arrival, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_helper.EraseEvents ();
+  return GetErrorStatus ();
+}
+
+
+class InterferenceHelperPerTest : public TestCase
+{
+public:
+  InterferenceHelperPerTest ();
+  virtual ~InterferenceHelperPerTest ();
+
+private:
+  virtual bool DoRun (void);
+  void Receive (double interferenceW, double *per);
+};
+
+InterferenceHelperPerTest::InterferenceHelperPerTest ()
+  : TestCase ("InterferenceHelper PER grows with overlapping interference")
+{}
+
+InterferenceHelperPerTest::~InterferenceHelperPerTest ()
+{}
+
+void
+InterferenceHelperPerTest::Receive (double interferenceW, double *per)
+{
+  InterferenceHelper helper;
+  helper.SetNoiseFigure (5.01);
+  helper.SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  WifiMode mode = WifiPhy::GetOfdmRate54Mbps ();
+  Time duration = InterferenceHelper::CalculateTxDuration (1000, mode, WIFI_PREAMBLE_LONG);
+  Ptr<InterferenceHelper::Event> event = helper.Add (1000, mode, WIFI_PREAMBLE_LONG, duration, 1e-9);
+  helper.NotifyRxStart ();
+  if (interferenceW > 0)
+    {
+      // Overlaps the second half of the payload.
+      Simulator::Schedule (duration / Scalar (2), &InterferenceHelper::Add, &helper,
+                           1000, mode, WIFI_PREAMBLE_LONG, duration, interferenceW);
+    }
+  Simulator::Stop (duration);
+  Simulator::Run ();
+  *per = helper.CalculateSnrPer (event).per;
+  helper.NotifyRxEnd ();
+  Simulator::Destroy ();
+}
+
+bool
+InterferenceHelperPerTest::DoRun (void)
+{
+  double clean, weak, strong;
+  Receive (0, &clean);
+  Receive (1e-13, &weak);
+  Receive (1e-10, &strong);
+  NS_TEST_EXPECT_MSG_EQ ((clean <= weak), true, "Weak interference lowered the PER");
+  NS_TEST_EXPECT_MSG_EQ ((weak < strong), true, "Strong interference did not raise the PER");
+  NS_TEST_EXPECT_MSG_EQ ((strong > 0.5), true, "Strong interference should corrupt the frame");
+  return GetErrorStatus ();
+}
+
+/**
+ * The PER of a frame with interference starting before it, over its
+ * header and over its payload, against the PER the vector based
+ * bookkeeping gave, for a range of SNRs and modes.
+ */
+class InterferenceHelperPerTableTest : public TestCase
+{
+public:
+  InterferenceHelperPerTableTest ();
+  virtual ~InterferenceHelperPerTableTest ();
+
+private:
+  virtual bool DoRun (void);
+  void Add (Time duration, double rxPowerW);
+  void StartRx (Time duration, double rxPowerW);
+  void EndRx (void);
+  void Check (Ptr<ErrorRateModel> model, WifiMode mode, double snrDb);
+
+  InterferenceHelper *m_helper;
+  ReferenceNiChanges *m_reference;
+  Ptr<InterferenceHelper::Event> m_event;
+  Ptr<ErrorRateModel> m_model;
+  WifiMode m_mode;
+  double m_per;
+  double m_referencePer;
+  uint32_t m_partial;
+};
+
+InterferenceHelperPerTableTest::InterferenceHelperPerTableTest ()
+  : TestCase ("InterferenceHelper PER matches the vector based bookkeeping over SNRs and modes")
+{}
+
+InterferenceHelperPerTableTest::~InterferenceHelperPerTableTest ()
+{}
+
+void
+InterferenceHelperPerTableTest::Add (Time duration, double rxPowerW)
+{
+  Ptr<InterferenceHelper::Event> event = m_helper->Add (1500, m_mode, WIFI_PREAMBLE_LONG, duration, rxPowerW);
+  m_reference->Append (event->GetStartTime (), event->GetEndTime (), rxPowerW);
+}
+
+void
+InterferenceHelperPerTableTest::StartRx (Time duration, double rxPowerW)
+{
+  m_event = m_helper->Add (1500, m_mode, WIFI_PREAMBLE_LONG, duration, rxPowerW);
+  m_reference->Append (m_event->GetStartTime (), m_event->GetEndTime (), rxPowerW);
+  m_helper->NotifyRxStart ();
+  m_reference->NotifyRxStart ();
+}
+
+void
+InterferenceHelperPerTableTest::EndRx (void)
+{
+  m_per = m_helper->CalculateSnrPer (m_event).per;
+  m_referencePer = m_reference->CalculatePer (m_event, m_model, m_helper->GetNoiseFigure ());
+  m_helper->NotifyRxEnd ();
+  m_reference->NotifyRxEnd ();
+}
+
+void
+InterferenceHelperPerTableTest::Check (Ptr<ErrorRateModel> model, WifiMode mode, double snrDb)
+{
+  InterferenceHelper helper;
+  ReferenceNiChanges reference;
+  m_helper = &helper;
+  m_reference = &reference;
+  m_model = model;
+  m_mode = mode;
+  helper.SetNoiseFigure (5.01);
+  helper.SetErrorRateModel (model);
+  double noiseW = helper.GetNoiseFigure () * 1.3803e-23 * 290.0 * mode.GetBandwidth ();
+  double signalW = noiseW * pow (10.0, snrDb / 10.0);
+  Time duration = InterferenceHelper::CalculateTxDuration (1500, mode, WIFI_PREAMBLE_LONG);
+  Time preamble = NanoSeconds (InterferenceHelper::GetPlcpPreambleDurationNanoSeconds (mode, WIFI_PREAMBLE_LONG));
+  Time start = MicroSeconds (5);
+
+  // one signal already on the air, one over the preamble and header, and
+  // one from the middle of the payload to past its end
+  Simulator::Schedule (Seconds (0), &InterferenceHelperPerTableTest::Add, this, duration, 0.5 * noiseW);
+  Simulator::Schedule (start, &InterferenceHelperPerTableTest::StartRx, this, duration, signalW);
+  Simulator::Schedule (start + preamble / Scalar (2), &InterferenceHelperPerTableTest::Add, this,
+                       duration / Scalar (4), 2 * noiseW);
+  Simulator::Schedule (start + duration / Scalar (2), &InterferenceHelperPerTableTest::Add, this,
+                       duration, noiseW);
+  Simulator::Schedule (start + duration, &InterferenceHelperPerTableTest::EndRx, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  helper.EraseEvents ();
+  m_event = 0;
+
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_per, m_referencePer, 1e-12,
+                             "PER of " << mode << " at " << snrDb << "dB differs from the reference");
+  if (m_per > 1e-6 && m_per < 1 - 1e-6)
+    {
+      m_partial++;
+    }
+}
+
+bool
+InterferenceHelperPerTableTest::DoRun (void)
+{
+  static const double snrDb[] = {-5, -2, 0, 2, 4, 6, 8, 10, 12, 14, 17, 20, 25, 30};
+  Ptr<ErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+  Ptr<ErrorRateModel> sensitivity = CreateObject<SensitivityModel60GHz> ();
+  std::vector<std::pair<Ptr<ErrorRateModel>, WifiMode> > modes;
+  modes.push_back (std::make_pair (nist, WifiPhy::GetOfdmRate6Mbps ()));
+  modes.push_back (std::make_pair (nist, WifiPhy::GetOfdmRate12Mbps ()));
+  modes.push_back (std::make_pair (nist, WifiPhy::GetOfdmRate24Mbps ()));
+  modes.push_back (std::make_pair (nist, WifiPhy::GetOfdmRate36Mbps ()));
+  modes.push_back (std::make_pair (nist, WifiPhy::GetOfdmRate54Mbps ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS1 ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS4 ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS8 ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS12 ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS13a ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS18a ()));
+  modes.push_back (std::make_pair (sensitivity, WifiPhy::GetVHTMCS24a ()));
+  m_partial = 0;
+  for (uint32_t i = 0; i < modes.size (); i++)
+    {
+      for (uint32_t j = 0; j < sizeof (snrDb) / sizeof (snrDb[0]); j++)
+        {
+          Check (modes[i].first, modes[i].second, snrDb[j]);
+        }
+    }
+  // the table must cross the transition of the modes, not only their ends
+  NS_TEST_EXPECT_MSG_EQ ((m_partial > 10), true, "Too few PERs strictly between 0 and 1");
+  return GetErrorStatus ();
+}
+
+
+class InterferenceHelperPayloadDurationTest : public TestCase
+{
+public:
+  InterferenceHelperPayloadDurationTest ();
+  virtual ~InterferenceHelperPayloadDurationTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+InterferenceHelperPayloadDurationTest::InterferenceHelperPayloadDurationTest ()
+  : TestCase ("InterferenceHelper payload duration coefficients match the formula")
+{}
+
+InterferenceHelperPayloadDurationTest::~InterferenceHelperPayloadDurationTest ()
+{}
+
+bool
+InterferenceHelperPayloadDurationTest::DoRun (void)
+{
+  std::vector<WifiMode> modes;
+  modes.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate9Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate12Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate18Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate24Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate36Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate48Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate54Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate3MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate4_5MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate6MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate9MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate12MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate18MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate24MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate27MbpsBW10MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate1_5MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate2_25MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate3MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate4_5MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate6MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate9MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate12MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate13_5MbpsBW5MHz ());
+  modes.push_back (WifiPhy::GetVHTMCS0 ());
+  modes.push_back (WifiPhy::GetVHTMCS1 ());
+  modes.push_back (WifiPhy::GetVHTMCS2 ());
+  modes.push_back (WifiPhy::GetVHTMCS3 ());
+  modes.push_back (WifiPhy::GetVHTMCS4 ());
+  modes.push_back (WifiPhy::GetVHTMCS5 ());
+  modes.push_back (WifiPhy::GetVHTMCS6 ());
+  modes.push_back (WifiPhy::GetVHTMCS7 ());
+  modes.push_back (WifiPhy::GetVHTMCS8 ());
+  modes.push_back (WifiPhy::GetVHTMCS9 ());
+  modes.push_back (WifiPhy::GetVHTMCS10 ());
+  modes.push_back (WifiPhy::GetVHTMCS11 ());
+  modes.push_back (WifiPhy::GetVHTMCS12 ());
+  modes.push_back (WifiPhy::GetVHTMCS13 ());
+  modes.push_back (WifiPhy::GetVHTMCS14 ());
+  modes.push_back (WifiPhy::GetVHTMCS15 ());
+  modes.push_back (WifiPhy::GetVHTMCS16 ());
+  modes.push_back (WifiPhy::GetVHTMCS17 ());
+  modes.push_back (WifiPhy::GetVHTMCS18 ());
+  modes.push_back (WifiPhy::GetVHTMCS13a ());
+  modes.push_back (WifiPhy::GetVHTMCS14a ());
+  modes.push_back (WifiPhy::GetVHTMCS15a ());
+  modes.push_back (WifiPhy::GetVHTMCS16a ());
+  modes.push_back (WifiPhy::GetVHTMCS17a ());
+  modes.push_back (WifiPhy::GetVHTMCS18a ());
+  modes.push_back (WifiPhy::GetVHTMCS19a ());
+  modes.push_back (WifiPhy::GetVHTMCS20a ());
+  modes.push_back (WifiPhy::GetVHTMCS21a ());
+  modes.push_back (WifiPhy::GetVHTMCS22a ());
+  modes.push_back (WifiPhy::GetVHTMCS23a ());
+  modes.push_back (WifiPhy::GetVHTMCS24a ());
+
+  for (std::vector<WifiMode>::const_iterator i = modes.begin (); i != modes.end (); ++i)
+    {
+      // every size a VHT PSDU length field can hold
+      for (uint32_t size = 0; size <= 262143; size++)
+        {
+          uint32_t fast = InterferenceHelper::GetPayloadDurationNanoSeconds (size, *i);
+          uint32_t formula = InterferenceHelper::CalculatePayloadDurationNanoSeconds (size, *i);
+          if (fast != formula)
+            {
+              NS_TEST_EXPECT_MSG_EQ (fast, formula, "Payload duration of " << size
+                                     << " bytes with " << *i << " differs from the formula");
+              break;
+            }
+        }
+    }
+  return GetErrorStatus ();
+}
+
+class InterferenceHelperBackgroundTest : public TestCase
+{
+public:
+  InterferenceHelperBackgroundTest ();
+  virtual ~InterferenceHelperBackgroundTest ();
+
+private:
+  virtual bool DoRun (void);
+  void Start (void);
+  void CheckEnergyDuration (double energyW, Time expected);
+
+  InterferenceHelper m_helper;
+};
+
+InterferenceHelperBackgroundTest::InterferenceHelperBackgroundTest ()
+  : TestCase ("InterferenceHelper energy duration accounts for the end of the background signals")
+{}
+
+InterferenceHelperBackgroundTest::~InterferenceHelperBackgroundTest ()
+{}
+
+void
+InterferenceHelperBackgroundTest::CheckEnergyDuration (double energyW, Time expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_helper.GetEnergyDuration (energyW), expected,
+                         "Wrong energy duration above " << energyW << "W at " << Simulator::Now ());
+}
+
+void
+InterferenceHelperBackgroundTest::Start (void)
+{
+  WifiMode mode = WifiPhy::GetOfdmRate6Mbps ();
+  // the background alone is above the threshold until it ends
+  m_helper.AddBackgroundNoise (MicroSeconds (80), 5e-12);
+  CheckEnergyDuration (1e-12, MicroSeconds (80));
+  // an interference event on top of it
+  m_helper.Add (100, mode, WIFI_PREAMBLE_LONG, MicroSeconds (30), 2e-12);
+  CheckEnergyDuration (6e-12, MicroSeconds (30));
+  CheckEnergyDuration (4e-12, MicroSeconds (80));
+  // a shorter background signal, which ends in between
+  m_helper.AddBackgroundNoise (MicroSeconds (50), 1e-12);
+  CheckEnergyDuration (7.5e-12, MicroSeconds (30));
+  CheckEnergyDuration (5.5e-12, MicroSeconds (50));
+  CheckEnergyDuration (1e-12, MicroSeconds (80));
+  Simulator::Schedule (MicroSeconds (60), &InterferenceHelperBackgroundTest::CheckEnergyDuration, this,
+                       1e-12, MicroSeconds (20));
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperBackgroundTest::CheckEnergyDuration, this,
+                       1e-12, MicroSeconds (0));
+}
+
+bool
+InterferenceHelperBackgroundTest::DoRun (void)
+{
+  m_helper.SetNoiseFigure (5.01);
+  m_helper.SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  Simulator::Schedule (Seconds (1), &InterferenceHelperBackgroundTest::Start, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_helper.EraseEvents ();
+  return GetErrorStatus ();
+}
+
+
+/**
+ * A YansWifiPhy whose InterferenceFloor is above its CCA threshold: the
+ * signals below the floor keep the medium busy for as long as they last,
+ * but are neither received nor reported as dropped.
+ */
+class YansWifiPhyInterferenceFloorTest : public TestCase
+{
+public:
+  YansWifiPhyInterferenceFloorTest ();
+  virtual ~YansWifiPhyInterferenceFloorTest ();
+
+private:
+  virtual bool DoRun (void);
+  Ptr<Packet> CreateFrame (void);
+  void Receive (double rxPowerDbm);
+  void CheckState (bool busy);
+  void RxBegin (Ptr<const Packet> packet);
+  void RxDrop (Ptr<const Packet> packet);
+
+  Ptr<YansWifiPhy> m_phy;
+  uint32_t m_rxBegin;
+  uint32_t m_rxDrop;
+};
+
+YansWifiPhyInterferenceFloorTest::YansWifiPhyInterferenceFloorTest ()
+  : TestCase ("YansWifiPhy folds the signals below its interference floor into the background")
+{}
+
+YansWifiPhyInterferenceFloorTest::~YansWifiPhyInterferenceFloorTest ()
+{}
+
+Ptr<Packet>
+YansWifiPhyInterferenceFloorTest::CreateFrame (void)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+  Ptr<Packet> packet = Create<Packet> (1000);
+  packet->AddHeader (hdr);
+  return packet;
+}
+
+void
+YansWifiPhyInterferenceFloorTest::Receive (double rxPowerDbm)
+{
+  m_phy->StartReceivePacket (CreateFrame (), rxPowerDbm, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+}
+
+void
+YansWifiPhyInterferenceFloorTest::CheckState (bool busy)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_phy->IsStateCcaBusy (), busy, "Wrong CCA state at " << Simulator::Now ());
+  NS_TEST_EXPECT_MSG_EQ (m_phy->IsStateIdle (), !busy, "Wrong CCA state at " << Simulator::Now ());
+}
+
+void
+YansWifiPhyInterferenceFloorTest::RxBegin (Ptr<const Packet> packet)
+{
+  m_rxBegin++;
+}
+
+void
+YansWifiPhyInterferenceFloorTest::RxDrop (Ptr<const Packet> packet)
+{
+  m_rxDrop++;
+}
+
+bool
+YansWifiPhyInterferenceFloorTest::DoRun (void)
+{
+  m_rxBegin = 0;
+  m_rxDrop = 0;
+  m_phy = CreateObject<YansWifiPhy> ();
+  m_phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  m_phy->SetAttribute ("InterferenceFloor", DoubleValue (-60));
+  m_phy->SetAttribute ("CcaMode1Threshold", DoubleValue (-80));
+  m_phy->TraceConnectWithoutContext ("PhyRxBegin", MakeCallback (&YansWifiPhyInterferenceFloorTest::RxBegin, this));
+  m_phy->TraceConnectWithoutContext ("PhyRxDrop", MakeCallback (&YansWifiPhyInterferenceFloorTest::RxDrop, this));
+  Time duration = InterferenceHelper::CalculateTxDuration (CreateFrame ()->GetSize (),
+                                                           WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG);
+
+  // a folded signal keeps the medium busy until it ends, and not longer
+  Simulator::Schedule (Seconds (1), &YansWifiPhyInterferenceFloorTest::Receive, this, -70);
+  Simulator::Schedule (Seconds (1) + duration - MicroSeconds (1),
+                       &YansWifiPhyInterferenceFloorTest::CheckState, this, true);
+  Simulator::Schedule (Seconds (1) + duration + MicroSeconds (1),
+                       &YansWifiPhyInterferenceFloorTest::CheckState, this, false);
+  // a received frame, with one folded and one discrete signal over it:
+  // only the latter is a drop
+  Simulator::Schedule (Seconds (2), &YansWifiPhyInterferenceFloorTest::Receive, this, -40);
+  Simulator::Schedule (Seconds (2) + MicroSeconds (10), &YansWifiPhyInterferenceFloorTest::Receive, this, -70);
+  Simulator::Schedule (Seconds (2) + MicroSeconds (20), &YansWifiPhyInterferenceFloorTest::Receive, this, -55);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_rxBegin, 1, "Wrong number of receptions");
+  NS_TEST_EXPECT_MSG_EQ (m_rxDrop, 1, "Folded signals were reported as drops");
+  m_phy = 0;
+  return GetErrorStatus ();
+}
+
+
+class InterferenceHelperTestSuite : public TestSuite
+{
+public:
+  InterferenceHelperTestSuite ();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite ()
+  : TestSuite ("devices-wifi-interference-helper", UNIT)
+{
+  AddTestCase (new InterferenceHelperSequenceTest);
+  AddTestCase (new InterferenceHelperPerTest);
+  AddTestCase (new InterferenceHelperPerTableTest);
+  AddTestCase (new InterferenceHelperPayloadDurationTest);
+  AddTestCase (new InterferenceHelperBackgroundTest);
+  AddTestCase (new YansWifiPhyInterferenceFloorTest);
+}
+
+InterferenceHelperTestSuite g_interferenceHelperTestSuite;
+
+} // namespace ns3
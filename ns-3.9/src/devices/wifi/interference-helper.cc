@@ -114,8 +114,16 @@ double InterferenceHelper::SlowdownFactor = 1;
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_firstPower (0.0),
-    m_rxing (false)
-{}
+    m_rxing (false),
+    m_cursor (m_niChanges.end ()),
+    m_cursorPower (0.0),
+    m_backgroundW (0.0),
+    m_rxBackgroundW (0.0)
+{
+  // fill the table of the payload durations while the nodes are set up,
+  // before any partition of a parallel simulator runs
+  GetPayloadCoefficients (WifiMode ());
+}
 InterferenceHelper::~InterferenceHelper ()
 {
   EraseEvents ();
@@ -139,6 +147,29 @@ InterferenceHelper::Add (uint32_t size, WifiMode payloadMode,
   return event;
 }
 
+void
+InterferenceHelper::AddBackgroundNoise (Time duration, double rxPowerW)
+{
+  m_background.insert (std::make_pair (Simulator::Now () + duration, rxPowerW));
+  m_backgroundW += rxPowerW;
+}
+
+double
+InterferenceHelper::GetBackgroundNoiseW (void)
+{
+  Time now = Simulator::Now ();
+  while (!m_background.empty () && m_background.begin ()->first <= now)
+    {
+      m_backgroundW -= m_background.begin ()->second;
+      m_background.erase (m_background.begin ());
+    }
+  if (m_background.empty () || m_backgroundW < 0)
+    {
+      // do not let rounding errors accumulate
+      m_backgroundW = 0.0;
+    }
+  return m_backgroundW;
+}
 
 void 
 InterferenceHelper::SetNoiseFigure (double value)
@@ -170,19 +201,29 @@ InterferenceHelper::GetEnergyDuration (double energyW)
   Time now = Simulator::Now ();
   double noiseInterferenceW = 0.0;
   Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  MoveCursor (now);
+  noiseInterferenceW = m_cursorPower + GetBackgroundNoiseW ();
+  // Walk the changes and the ends of the background signals in time order.
+  NiChangeStore::const_iterator i = m_cursor;
+  BackgroundSignals::const_iterator j = m_background.begin ();
+  while (i != m_niChanges.end () || j != m_background.end ())
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
-      if (end < now)
+      if (j == m_background.end () || (i != m_niChanges.end () && i->first <= j->first))
+        {
+          noiseInterferenceW += i->second;
+          end = i->first;
+          i++;
+        }
+      else
         {
-          continue;
+          noiseInterferenceW -= j->second;
+          end = j->first;
+          j++;
         }
       if (noiseInterferenceW < energyW)
-              {
-                break;
-              }
+        {
+          break;
+        }
     }
   return end > now ? end - now : MicroSeconds (0);
 }
@@ -331,8 +372,160 @@ InterferenceHelper::GetPlcpPreambleDurationNanoSeconds (WifiMode payloadMode, Wi
     }
 }
 
+struct InterferenceHelper::PayloadCoefficients
+InterferenceHelper::ComputePayloadCoefficients (WifiMode payloadMode)
+{
+  struct PayloadCoefficients c;
+  c.extraBits = 0;
+  c.codeRateNum = 1;
+  c.codeRateDen = 1;
+  c.codewordBits = 1;
+  c.bitsPerBlock = 0;
+  c.blockNumNs = 1;
+  c.blockDenNs = 1;
+
+  switch (payloadMode.GetModulationClass ())
+    {
+    case WIFI_MOD_CLASS_OFDM:
+      {
+        // same as the formula below: the 16 service bits and 6 tail
+        // bits are coded in N_{DBPS} bits per T_{SYM}
+        switch (payloadMode.GetBandwidth ()) {
+        case 20000000:
+        default:
+          c.blockNumNs = 4000;
+          break;
+        case 10000000:
+          c.blockNumNs = 8000;
+          break;
+        case 5000000:
+          c.blockNumNs = 16000;
+          break;
+        }
+        uint64_t bits = payloadMode.GetDataRate () * c.blockNumNs;
+        if (bits % 1000000000 == 0)
+          {
+            c.extraBits = 16 + 6;
+            c.bitsPerBlock = bits / 1000000000;
+          }
+        break;
+      }
+
+    case WIFI_MOD_CLASS_VHT_SC:
+    case WIFI_MOD_CLASS_VHT_OFDM:
+      {
+        uint32_t bitsPerSymbol;
+        switch (payloadMode.GetConstellationSize ()) {
+        case 2:
+          bitsPerSymbol = 1;
+          break;
+        case 4:
+          bitsPerSymbol = 2;
+          break;
+        case 16:
+          bitsPerSymbol = 4;
+          break;
+        case 64:
+          bitsPerSymbol = 6;
+          break;
+        case 256:
+          bitsPerSymbol = 8;
+          break;
+        default:
+          return c;
+        }
+        switch (payloadMode.GetCodeRate ()) {
+        case WIFI_CODE_RATE_1_4:
+          c.codeRateNum = 4;
+          break;
+        case WIFI_CODE_RATE_1_2:
+          c.codeRateNum = 2;
+          break;
+        case WIFI_CODE_RATE_13_16:
+          c.codeRateNum = 16;
+          c.codeRateDen = 13;
+          break;
+        case WIFI_CODE_RATE_3_4:
+          c.codeRateNum = 4;
+          c.codeRateDen = 3;
+          break;
+        case WIFI_CODE_RATE_5_8:
+          c.codeRateNum = 8;
+          c.codeRateDen = 5;
+          break;
+        default:
+          return c;
+        }
+        c.codewordBits = 672;
+        if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_VHT_SC)
+          {
+            // 512 chips at 1760 MHz per block
+            c.bitsPerBlock = bitsPerSymbol * 448;
+            c.blockNumNs = 3200;
+            c.blockDenNs = 11;
+          }
+        else if (bitsPerSymbol <= 6)
+          {
+            c.bitsPerBlock = bitsPerSymbol * 336;
+            c.blockNumNs = 242;
+          }
+        break;
+      }
+
+    default:
+      // the DSSS formula divides by a rate which need not divide 8e9
+      break;
+    }
+  return c;
+}
+
+InterferenceHelper::PayloadCoefficientsList
+InterferenceHelper::ComputeAllPayloadCoefficients (void)
+{
+  PayloadCoefficientsList coefficients;
+  for (uint32_t uid = 0; uid < WifiModeFactory::GetNModes (); uid++)
+    {
+      coefficients.push_back (ComputePayloadCoefficients (WifiModeFactory::GetMode (uid)));
+    }
+  return coefficients;
+}
+
+struct InterferenceHelper::PayloadCoefficients
+InterferenceHelper::GetPayloadCoefficients (WifiMode payloadMode)
+{
+  // every mode made so far, which is every mode of WifiPhy: they are made
+  // when the module is loaded.  The table is filled once and only read
+  // afterwards, so the threads of a parallel simulator share it.
+  static const PayloadCoefficientsList coefficients = ComputeAllPayloadCoefficients ();
+  uint32_t uid = payloadMode.GetUid ();
+  if (uid < coefficients.size ())
+    {
+      return coefficients[uid];
+    }
+  // a mode made since
+  return ComputePayloadCoefficients (payloadMode);
+}
+
 uint32_t 
 InterferenceHelper::GetPayloadDurationNanoSeconds (uint32_t size, WifiMode payloadMode)
+{
+  if (SlowdownFactor == 1)
+    {
+      struct PayloadCoefficients c = GetPayloadCoefficients (payloadMode);
+      if (c.bitsPerBlock != 0)
+        {
+          uint64_t bits = (uint64_t)size * 8 + c.extraBits;
+          uint64_t codedBits = (bits * c.codeRateNum + c.codeRateDen - 1) / c.codeRateDen;
+          uint64_t codewords = (codedBits + c.codewordBits - 1) / c.codewordBits;
+          uint64_t blocks = (codewords * c.codewordBits + c.bitsPerBlock - 1) / c.bitsPerBlock;
+          return (blocks * c.blockNumNs + c.blockDenNs - 1) / c.blockDenNs;
+        }
+    }
+  return CalculatePayloadDurationNanoSeconds (size, payloadMode);
+}
+
+uint32_t 
+InterferenceHelper::CalculatePayloadDurationNanoSeconds (uint32_t size, WifiMode payloadMode)
 {
   NS_LOG_FUNCTION(size << payloadMode);
 
@@ -471,15 +664,17 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
+      NiChangeStore::iterator nowIterator = m_niChanges.upper_bound (now);
+      for (NiChangeStore::iterator i = m_niChanges.begin (); i != nowIterator; i++)
         {
-          m_firstPower += i->GetDelta ();
+          m_firstPower += i->second;
         }
       if (m_firstPower < 0)
         m_firstPower = 0;        /* DAN: this should be true, and fixed double precision errors */
       m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ())); 
+      // Nothing is left before now: the start of this event comes first.
+      m_cursor = m_niChanges.insert (std::make_pair (event->GetStartTime (), event->GetRxPowerW ()));
+      m_cursorPower = m_firstPower;
     }
   else
     {
@@ -499,7 +694,7 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, WifiM
   double Nt = BOLTZMANN * 290.0 * mode.GetBandwidth ();
   // receiver noise Floor (W) which accounts for thermal noise and non-idealities of the receiver
   double noiseFloor = m_noiseFigure * Nt;
-  double noise = noiseFloor + noiseInterference;
+  double noise = noiseFloor + m_rxBackgroundW + noiseInterference;
   double snr = signal / noise;
   return snr;
 }
@@ -509,15 +704,22 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
 {
   double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  // The changes are looked up by time: only those from the start to the
+  // end of the reception are visited, however many signals are stored.
+  // The start of the reception is the first change, since AppendEvent
+  // drops the past when a reception starts.
+  NiChangeStore::const_iterator i = m_niChanges.lower_bound (event->GetStartTime ());
+  NiChangeStore::const_iterator end = m_niChanges.upper_bound (event->GetEndTime ());
+  NS_ASSERT (i == m_niChanges.begin ());
+  ni->push_back (NiChange (event->GetStartTime (), noiseInterference));
+  for (i++; i != end; i++)
     {
-      if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
+      if ((event->GetEndTime () == i->first) && event->GetRxPowerW () == -i->second)
         {
           break;
         }
-      ni->push_back (*i);
+      ni->push_back (NiChange (i->first, i->second));
     }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
   ni->push_back (NiChange (event->GetEndTime (), 0));
   return noiseInterference;
 }
@@ -537,6 +739,8 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 double 
 InterferenceHelper::CalculatePer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
 {  
+  // ni holds the changes of the reception only, each of which ends a chunk
+  // with its own SNIR, and so its own factor of the success rate.
   double psr = 1.0; /* Packet Success Rate */
   NiChanges::iterator j = ni->begin ();
   Time previous = (*j).GetTime (); 
@@ -646,24 +850,41 @@ void
 InterferenceHelper::EraseEvents (void) 
 {  
   m_niChanges.clear ();
+  m_cursor = m_niChanges.end ();
+  m_cursorPower = 0.0;
   m_rxing = false;
   m_firstPower = 0.0;
+  m_background.clear ();
+  m_backgroundW = 0.0;
+  m_rxBackgroundW = 0.0;
 }
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetPosition (Time moment)
+void
+InterferenceHelper::AddNiChangeEvent (NiChange change)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
-
+  // Inserted after the changes already stored for the same time.
+  NiChangeStore::iterator i = m_niChanges.insert (std::make_pair (change.GetTime (), change.GetDelta ()));
+  NiChangeStore::iterator next = i;
+  next++;
+  if (next == m_cursor)
+    {
+      // Changes are never added in the past: this one belongs after the cursor.
+      m_cursor = i;
+    }
 }
 void
-InterferenceHelper::AddNiChangeEvent (NiChange change)
+InterferenceHelper::MoveCursor (Time moment)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  while (m_cursor != m_niChanges.end () && m_cursor->first < moment)
+    {
+      m_cursorPower += m_cursor->second;
+      m_cursor++;
+    }
 }
 void
 InterferenceHelper::NotifyRxStart ()
 {
   m_rxing = true;
+  m_rxBackgroundW = GetBackgroundNoiseW ();
 }
 void
 InterferenceHelper::NotifyRxEnd ()
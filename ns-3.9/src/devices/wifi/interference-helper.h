@@ -23,6 +23,8 @@
 #include <stdint.h>
 #include <vector>
 #include <list>
+#include <map>
+#include <utility>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -87,13 +89,42 @@ public:
   static WifiMode GetPlcpHeaderMode (WifiMode payloadMode, WifiPreamble preamble);
   static uint32_t GetPlcpHeaderDurationNanoSeconds (WifiMode payloadMode, WifiPreamble preamble);
   static uint32_t GetPlcpPreambleDurationNanoSeconds (WifiMode mode, WifiPreamble preamble);
+  /**
+   * \param size the size of the payload (bytes)
+   * \param payloadMode the mode used to transmit the payload
+   * \returns the duration of the payload (ns)
+   *
+   * Uses per-mode integer coefficients computed the first time a mode
+   * is seen, so that the duration is a handful of integer divisions.
+   * Falls back to CalculatePayloadDurationNanoSeconds for DSSS modes
+   * and whenever SlowdownFactor is not 1.
+   */
   static uint32_t GetPayloadDurationNanoSeconds (uint32_t size, WifiMode payloadMode);
+  /**
+   * \param size the size of the payload (bytes)
+   * \param payloadMode the mode used to transmit the payload
+   * \returns the duration of the payload (ns), evaluated with the
+   *          floating point formulas of the standard.
+   */
+  static uint32_t CalculatePayloadDurationNanoSeconds (uint32_t size, WifiMode payloadMode);
   static double SlowdownFactor;
   static Time CalculateTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamble preamble);
   Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiMode payloadMode, 
 				      enum WifiPreamble preamble,
 				      Time duration, double rxPower);
 
+  /**
+   * \param duration the duration of the signal
+   * \param rxPowerW the power of the signal (W)
+   *
+   * Adds the energy of a signal which will never be received to the
+   * background noise, rather than tracking it as an interference event.
+   * The background noise is sampled when a reception starts and is
+   * assumed constant until it ends, but GetEnergyDuration accounts for
+   * the end of each background signal.
+   */
+  void AddBackgroundNoise (Time duration, double rxPowerW);
+
   struct InterferenceHelper::SnrPer CalculateSnrPer (Ptr<InterferenceHelper::Event> event);
   void NotifyRxStart ();
   void NotifyRxEnd ();
@@ -110,7 +141,38 @@ private:
     double m_delta;
   };
   typedef std::vector <NiChange> NiChanges;
+  /**
+   * The pending noise and interference changes, by time. Changes at the
+   * same time keep their insertion order.
+   */
+  typedef std::multimap<Time, double> NiChangeStore;
   typedef std::list<Ptr<Event> > Events;
+  /// the power of the background signals, by end time
+  typedef std::multimap<Time, double> BackgroundSignals;
+
+  /**
+   * The payload duration of a mode, in integer form:
+   * codedBits = ceil ((8 * size + extraBits) * codeRateNum / codeRateDen),
+   * codewords = ceil (codedBits / codewordBits),
+   * blocks = ceil (codewords * codewordBits / bitsPerBlock) and
+   * duration = ceil (blocks * blockNumNs / blockDenNs).
+   * bitsPerBlock is zero when the mode has no integer form.
+   */
+  struct PayloadCoefficients
+  {
+    uint32_t extraBits;
+    uint32_t codeRateNum;
+    uint32_t codeRateDen;
+    uint32_t codewordBits;
+    uint32_t bitsPerBlock;
+    uint32_t blockNumNs;
+    uint32_t blockDenNs;
+  };
+  typedef std::vector<struct PayloadCoefficients> PayloadCoefficientsList;
+
+  static struct PayloadCoefficients GetPayloadCoefficients (WifiMode payloadMode);
+  static struct PayloadCoefficients ComputePayloadCoefficients (WifiMode payloadMode);
+  static PayloadCoefficientsList ComputeAllPayloadCoefficients (void);
 
   InterferenceHelper (const InterferenceHelper &o);
   InterferenceHelper &operator = (const InterferenceHelper &o);
@@ -119,16 +181,28 @@ private:
   double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
   double CalculateChunkSuccessRate (double snir, Time delay, WifiMode mode) const;
   double CalculatePer (Ptr<const Event> event, NiChanges *ni) const;
+  double GetBackgroundNoiseW (void);
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
   ///Experimental: needed for energy duration calculation
-  NiChanges m_niChanges;
+  NiChangeStore m_niChanges;
   double m_firstPower;
   bool m_rxing;
-  /// Returns an iterator to the first nichange, which is later than moment
-  NiChanges::iterator GetPosition (Time moment);
+  /**
+   * First change not earlier than the last time the cursor was moved to,
+   * and m_firstPower plus the changes before it. Time only moves forward,
+   * so the changes of the past are summed only once.
+   */
+  NiChangeStore::iterator m_cursor;
+  double m_cursorPower;
+  /// signals folded into the background noise, by end time
+  BackgroundSignals m_background;
+  double m_backgroundW;
+  /// background noise at the start of the current reception
+  double m_rxBackgroundW;
   void AddNiChangeEvent (NiChange change);
+  void MoveCursor (Time moment);
 };
 
 } // namespace ns3
@@ -30,7 +30,12 @@ RandomStream::~RandomStream ()
 
 RealRandomStream::RealRandomStream ()
   : m_stream (UniformVariable ())
-{}
+{
+  // take the stream now, in the order in which the streams are made,
+  // rather than on the first backoff, which a parallel simulator would
+  // reach in any order
+  m_stream.GetValue ();
+}
 uint32_t 
 RealRandomStream::GetNext (uint32_t min, uint32_t max)
 {
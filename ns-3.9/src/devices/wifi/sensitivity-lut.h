@@ -3,6 +3,9 @@
 
 namespace ns3 {
 
+/* Number of entries in the BER table: -12 dB to 6 dB in 0.1 dB steps */
+static const unsigned int SENSITIVITY_LUT_SIZE = 181;
+
 double sensitivity_ber(unsigned int index);
 
 }
@@ -23,10 +23,74 @@
 #include "ns3/interference-helper.h"
 #include "sensitivity-lut.h"
 
+#include <math.h>
+
 NS_LOG_COMPONENT_DEFINE ("SensitivityModel60GHz");
 
 namespace ns3 {
 
+struct SensitivityEntry
+{
+  const char *name;
+  double sensitivity;   /* dBm */
+};
+
+static const struct SensitivityEntry g_sensitivities[] = {
+	/**** Control PHY ****/
+	{ "VHTMCS0", -78 },
+	/**** SC PHY ****/
+	{ "VHTMCS1", -68 },
+	{ "VHTMCS2", -67 },
+	{ "VHTMCS3", -65 },
+	{ "VHTMCS4", -64 },
+	{ "VHTMCS5", -62 },
+	{ "VHTMCS6", -63 },
+	{ "VHTMCS7", -62 },
+	{ "VHTMCS8", -61 },
+	{ "VHTMCS9", -59 },
+	{ "VHTMCS10", -55 },
+	{ "VHTMCS11", -54 },
+	{ "VHTMCS12", -53 },
+	/**** Extrapolated SC PHY ****/
+	{ "VHTMCS13", -52 },	/* Basis: rel sens. for OFDM analog */
+	{ "VHTMCS14", -50 },	/* Basis: rel sens. for OFDM analog */
+	{ "VHTMCS15", -48 },	/* Basis: rel sens. for OFDM analog */
+	{ "VHTMCS16", -46 },	/* Basis: rel sens. for OFDM analog */
+	{ "VHTMCS17", -42 },	/* Basis: 256 is 6 dB worse than 64 */
+	{ "VHTMCS18", -40 },	/* Basis: 256 is 6 dB worse than 64 */
+	/**** OFDM PHY ****/
+	{ "VHTMCS13a", -66 },
+	{ "VHTMCS14a", -64 },
+	{ "VHTMCS15a", -63 },
+	{ "VHTMCS16a", -62 },
+	{ "VHTMCS17a", -60 },
+	{ "VHTMCS18a", -58 },
+	{ "VHTMCS19a", -56 },
+	{ "VHTMCS20a", -54 },
+	{ "VHTMCS21a", -53 },
+	{ "VHTMCS22a", -51 },
+	{ "VHTMCS23a", -49 },
+	{ "VHTMCS24a", -47 },
+	/**** Low power PHY ****/
+	{ "VHTMCS25a", -64 },
+	{ "VHTMCS26a", -60 },
+	{ "VHTMCS27a", -57 },
+};
+
+static const struct SensitivityEntry *
+FindSensitivity (std::string modename)
+{
+  uint32_t n = sizeof (g_sensitivities) / sizeof (g_sensitivities[0]);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (modename == g_sensitivities[i].name)
+        {
+          return &g_sensitivities[i];
+        }
+    }
+  return 0;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (SensitivityModel60GHz);
 
 TypeId 
@@ -40,109 +104,78 @@ SensitivityModel60GHz::GetTypeId (void)
 }
 
 SensitivityModel60GHz::SensitivityModel60GHz ()
-{}
+{
+  /* PER = 1 - (1-ber)^nbits, evaluated as exp (nbits * log1p (-ber)) */
+  m_logSuccess.resize (SENSITIVITY_LUT_SIZE);
+  for (uint32_t i = 0; i < SENSITIVITY_LUT_SIZE; i++)
+    {
+      m_logSuccess[i] = log1p (-sensitivity_ber (i));
+    }
+
+  /* the 60 GHz modes of WifiPhy, all made when the module is loaded */
+  m_rssOffsets.resize (WifiModeFactory::GetNModes ());
+  for (uint32_t uid = 0; uid < m_rssOffsets.size (); uid++)
+    {
+      WifiMode mode = WifiModeFactory::GetMode (uid);
+      if ((mode.GetModulationClass () == WIFI_MOD_CLASS_VHT_SC ||
+           mode.GetModulationClass () == WIFI_MOD_CLASS_VHT_OFDM) &&
+          FindSensitivity (mode.GetUniqueName ()) != 0)
+        {
+          m_rssOffsets[uid].offset = ComputeRssOffset (mode);
+          m_rssOffsets[uid].resolved = true;
+        }
+    }
+}
+
+double
+SensitivityModel60GHz::GetRssOffset (WifiMode mode) const
+{
+  uint32_t uid = mode.GetUid ();
+  if (uid < m_rssOffsets.size () && m_rssOffsets[uid].resolved)
+    {
+      return m_rssOffsets[uid].offset;
+    }
+  /* a mode made since the model, or one it does not know, which is fatal */
+  return ComputeRssOffset (mode);
+}
+
+double
+SensitivityModel60GHz::ComputeRssOffset (WifiMode mode)
+{
+  NS_ASSERT_MSG(mode.GetModulationClass() == WIFI_MOD_CLASS_VHT_SC ||
+                mode.GetModulationClass() == WIFI_MOD_CLASS_VHT_OFDM,
+                "Expecting 802.11ad VHT SC or OFDM modulation");
+  std::string modename = mode.GetUniqueName ();
+  const struct SensitivityEntry *entry = FindSensitivity (modename);
+  if (entry == 0)
+    {
+      NS_FATAL_ERROR("Unrecognized 60 GHz modulation " << modename);
+    }
+
+  /* this is kinda silly, but convert from SNR back to RSS: thermal noise
+   * in dBm, so add 30, and the sensitivity is subtracted once here. */
+  double noise = 1.3803e-23 * 290.0 * mode.GetBandwidth();
+  return 10*log10(noise) + 30 - entry->sensitivity;
+}
 
 double 
 SensitivityModel60GHz::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
 {
-	NS_ASSERT_MSG(mode.GetModulationClass() == WIFI_MOD_CLASS_VHT_SC ||
-	              mode.GetModulationClass() == WIFI_MOD_CLASS_VHT_OFDM,
-			"Expecting 802.11ad VHT SC or OFDM modulation");
-	std::string modename = mode.GetUniqueName();
-
-	/* this is kinda silly, but convert from SNR back to RSS */
-	double noise = 1.3803e-23 * 290.0 * mode.GetBandwidth();
-	/* Compute RSS in dBm, so add 30 from SNR */
-	double rss = 10*log10(snr * noise) + 30;
-	NS_LOG_FUNCTION(modename << "snr" << snr << "rss" << rss << "bits" << nbits);
-	double rss_delta;
-	double ber;
-	/**** Control PHY ****/
-	if (modename == "VHTMCS0")
-		rss_delta = rss - -78;
-	/**** SC PHY ****/
-	else if (modename == "VHTMCS1")
-		rss_delta = rss - -68;
-	else if (modename == "VHTMCS2")
-		rss_delta = rss - -67;
-	else if (modename == "VHTMCS3")
-		rss_delta = rss - -65;
-	else if (modename == "VHTMCS4")
-		rss_delta = rss - -64;
-	else if (modename == "VHTMCS5")
-		rss_delta = rss - -62;
-	else if (modename == "VHTMCS6")
-		rss_delta = rss - -63;
-	else if (modename == "VHTMCS7")
-		rss_delta = rss - -62;
-	else if (modename == "VHTMCS8")
-		rss_delta = rss - -61;
-	else if (modename == "VHTMCS9")
-		rss_delta = rss - -59;
-	else if (modename == "VHTMCS10")
-		rss_delta = rss - -55;
-	else if (modename == "VHTMCS11")
-		rss_delta = rss - -54;
-	else if (modename == "VHTMCS12")
-		rss_delta = rss - -53;
-	/**** Extrapolated SC PHY ****/
-	else if (modename == "VHTMCS13")
-		rss_delta = rss - -52;	/* Basis: rel sens. for OFDM analog */
-	else if (modename == "VHTMCS14")
-		rss_delta = rss - -50;	/* Basis: rel sens. for OFDM analog */
-	else if (modename == "VHTMCS15")
-		rss_delta = rss - -48;	/* Basis: rel sens. for OFDM analog */
-	else if (modename == "VHTMCS16")
-		rss_delta = rss - -46;	/* Basis: rel sens. for OFDM analog */
-	else if (modename == "VHTMCS17")
-		rss_delta = rss - -42;	/* Basis: 256 is 6 dB worse than 64 */
-	else if (modename == "VHTMCS18")
-		rss_delta = rss - -40;	/* Basis: 256 is 6 dB worse than 64 */
-	/**** OFDM PHY ****/
-	else if (modename == "VHTMCS13a")
-		rss_delta = rss - -66;
-	else if (modename == "VHTMCS14a")
-		rss_delta = rss - -64;
-	else if (modename == "VHTMCS15a")
-		rss_delta = rss - -63;
-	else if (modename == "VHTMCS16a")
-		rss_delta = rss - -62;
-	else if (modename == "VHTMCS17a")
-		rss_delta = rss - -60;
-	else if (modename == "VHTMCS18a")
-		rss_delta = rss - -58;
-	else if (modename == "VHTMCS19a")
-		rss_delta = rss - -56;
-	else if (modename == "VHTMCS20a")
-		rss_delta = rss - -54;
-	else if (modename == "VHTMCS21a")
-		rss_delta = rss - -53;
-	else if (modename == "VHTMCS22a")
-		rss_delta = rss - -51;
-	else if (modename == "VHTMCS23a")
-		rss_delta = rss - -49;
-	else if (modename == "VHTMCS24a")
-		rss_delta = rss - -47;
-	/**** Low power PHY ****/
-	else if (modename == "VHTMCS25a")
-		rss_delta = rss - -64;
-	else if (modename == "VHTMCS26a")
-		rss_delta = rss - -60;
-	else if (modename == "VHTMCS27a")
-		rss_delta = rss - -57;
-	else
-		NS_FATAL_ERROR("Unrecognized 60 GHz modulation");
+	/* RSS relative to the sensitivity of this mode, in dB */
+	double rss_delta = 10*log10(snr) + GetRssOffset(mode);
+	NS_LOG_FUNCTION(mode << "snr" << snr << "rss_delta" << rss_delta << "bits" << nbits);
 
 	/* Compute BER in lookup table */
+	uint32_t index;
 	if (rss_delta < -12.0)
-		ber = sensitivity_ber(0);
+		index = 0;
 	else if (rss_delta > 6.0)
-		ber = sensitivity_ber(180);
+		index = SENSITIVITY_LUT_SIZE - 1;
 	else
-		ber = sensitivity_ber((int)(10*(rss_delta+12)));
+		index = (uint32_t)(10*(rss_delta+12));
 
 	/* Compute PER from BER */
-	return pow(1-ber, nbits);
+	return exp(nbits * m_logSuccess[index]);
 }
 
 } // namespace ns3
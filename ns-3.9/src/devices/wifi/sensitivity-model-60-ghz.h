@@ -18,12 +18,23 @@
 #define SENSITIVITY_MODEL_60_GHZ
 
 #include <stdint.h>
+#include <vector>
 #include "wifi-mode.h"
 #include "error-rate-model.h"
 #include "dsss-error-rate-model.h"
 
 namespace ns3 {
 
+/**
+ * \brief error rate model for 802.11ad PHYs based on receiver sensitivity
+ *
+ * The SNR of a chunk is converted back to a received signal strength and
+ * compared against the sensitivity of the mode; the difference indexes a
+ * measured BER table.  The per-mode offsets of the modes known when the
+ * model is made are resolved then, and only read afterwards, so that the
+ * threads of a parallel simulator can share a model.  The table is kept as
+ * log(1-BER) so that the success rate of a chunk is a single exp().
+ */
 class SensitivityModel60GHz : public ErrorRateModel
 {
 public:
@@ -32,6 +43,20 @@ public:
   SensitivityModel60GHz ();
 
   virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
+
+private:
+  struct RssOffset
+  {
+    RssOffset () : resolved (false), offset (0) {}
+    bool resolved;
+    double offset;
+  };
+
+  double GetRssOffset (WifiMode mode) const;
+  static double ComputeRssOffset (WifiMode mode);
+
+  std::vector<RssOffset> m_rssOffsets;
+  std::vector<double> m_logSuccess;
 };
 
 } // namespace ns3
@@ -34,6 +34,7 @@ enum {
 };
 
 enum {
+  SUBTYPE_CTL_CTLEXT = 6,
   SUBTYPE_CTL_BACKREQ = 8,
   SUBTYPE_CTL_BACKRESP = 9,
   SUBTYPE_CTL_RTS = 11,
@@ -177,6 +178,10 @@ WifiMacHeader::SetType (enum WifiMacType type)
     m_ctrlType = TYPE_CTL;
     m_ctrlSubtype = SUBTYPE_CTL_ACK;
     break;
+  case WIFI_MAC_CTL_DMG_SSW:
+    m_ctrlType = TYPE_CTL;
+    m_ctrlSubtype = SUBTYPE_CTL_CTLEXT;
+    break;
   case WIFI_MAC_MGT_ASSOCIATION_REQUEST:
     m_ctrlType = TYPE_MGT;
     m_ctrlSubtype = 0;
@@ -475,6 +480,9 @@ WifiMacHeader::GetType (void) const
     case SUBTYPE_CTL_ACK:
       return WIFI_MAC_CTL_ACK;
       break;
+    case SUBTYPE_CTL_CTLEXT:
+      return WIFI_MAC_CTL_DMG_SSW;
+      break;
     }
     break;
   case TYPE_DATA:
@@ -669,6 +677,12 @@ WifiMacHeader::IsBlockAck (void) const
   return (GetType () == WIFI_MAC_CTL_BACKRESP)?true:false;
 }
 
+bool
+WifiMacHeader::IsSectorSweep (void) const
+{
+  return (GetType () == WIFI_MAC_CTL_DMG_SSW);
+}
+
 
 uint16_t 
 WifiMacHeader::GetRawDuration (void) const
@@ -846,6 +860,7 @@ WifiMacHeader::GetSize (void) const
       break;
     case SUBTYPE_CTL_BACKREQ:
     case SUBTYPE_CTL_BACKRESP:
+    case SUBTYPE_CTL_CTLEXT:
       size = 2+2+6+6;
       break;
     }
@@ -876,6 +891,7 @@ case WIFI_MAC_ ## x: \
     FOO (CTL_ACK);
     FOO (CTL_BACKREQ);
     FOO (CTL_BACKRESP);
+    FOO (CTL_DMG_SSW);
 
     FOO (MGT_BEACON);
     FOO (MGT_ASSOCIATION_REQUEST);
@@ -958,6 +974,10 @@ WifiMacHeader::Print (std::ostream &os) const
       break;
     case WIFI_MAC_CTL_BACKRESP:
       break;
+    case WIFI_MAC_CTL_DMG_SSW:
+      os << "Duration/ID=" << m_duration << "us"
+         << ", RA=" << m_addr1 << ", TA=" << m_addr2;
+      break;
 
     case WIFI_MAC_MGT_BEACON:
     case WIFI_MAC_MGT_ASSOCIATION_REQUEST:
@@ -1055,6 +1075,7 @@ WifiMacHeader::Serialize (Buffer::Iterator i) const
       break;
     case SUBTYPE_CTL_BACKREQ:
     case SUBTYPE_CTL_BACKRESP:
+    case SUBTYPE_CTL_CTLEXT:
       WriteTo (i, m_addr2);
       break;
     default:
@@ -1104,6 +1125,7 @@ WifiMacHeader::Deserialize (Buffer::Iterator start)
       break;
     case SUBTYPE_CTL_BACKREQ:
     case SUBTYPE_CTL_BACKRESP:
+    case SUBTYPE_CTL_CTLEXT:
       ReadFrom (i, m_addr2);
       break;
     }
@@ -35,6 +35,7 @@ enum WifiMacType {
   WIFI_MAC_CTL_ACK,
   WIFI_MAC_CTL_BACKREQ,
   WIFI_MAC_CTL_BACKRESP,
+  WIFI_MAC_CTL_DMG_SSW,
 
   WIFI_MAC_MGT_BEACON,
   WIFI_MAC_MGT_ASSOCIATION_REQUEST,
@@ -152,6 +153,7 @@ public:
   bool IsAck (void) const;
   bool IsBlockAckReq (void) const;
   bool IsBlockAck (void) const;
+  bool IsSectorSweep (void) const;
   bool IsAssocReq (void) const;
   bool IsAssocResp (void) const;
   bool IsReassocReq (void) const;
@@ -180,6 +180,19 @@ WifiModeFactory::CreateWifiMode (std::string uniqueName,
   return WifiMode (uid);
 }
 
+uint32_t
+WifiModeFactory::GetNModes (void)
+{
+  return GetFactory ()->m_itemList.size ();
+}
+
+WifiMode
+WifiModeFactory::GetMode (uint32_t uid)
+{
+  NS_ASSERT (uid < GetNModes ());
+  return WifiMode (uid);
+}
+
 WifiMode
 WifiModeFactory::Search (std::string name)
 {
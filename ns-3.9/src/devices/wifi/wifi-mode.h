@@ -216,6 +216,16 @@ public:
                                   uint64_t dataRate,
                                   enum WifiCodeRate codingRate,
                                   uint16_t constellationSize);
+  /**
+   * \returns the number of WifiModes created so far: their uids are the
+   *          integers below it.
+   */
+  static uint32_t GetNModes (void);
+  /**
+   * \param uid the uid of a WifiMode created so far
+   * \returns that WifiMode
+   */
+  static WifiMode GetMode (uint32_t uid);
 
 private:
   friend class WifiMode;  
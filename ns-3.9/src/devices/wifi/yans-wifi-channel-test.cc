@@ -0,0 +1,317 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/packet.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/cone-antenna.h"
+#include "ns3/measured-2d-antenna.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "yans-wifi-channel.h"
+#include "yans-wifi-phy.h"
+#include "yans-error-rate-model.h"
+#include "wifi-mac-header.h"
+
+#include <cmath>
+
+namespace ns3 {
+
+/**
+ * Three PHYs on channels 1, 2 and 3, one meter apart. The first one
+ * sends, and the others can only sense the energy which leaks out of
+ * channel 1. The last PHY then switches to channel 2.
+ */
+class YansWifiChannelRejectionTest : public TestCase
+{
+public:
+  YansWifiChannelRejectionTest (std::string mask, bool busy2, bool busy3);
+  virtual ~YansWifiChannelRejectionTest ();
+
+private:
+  virtual bool DoRun (void);
+  void Send (void);
+  void Check (bool busy2, bool busy3);
+
+  std::string m_mask;
+  bool m_busy2;
+  bool m_busy3;
+  Ptr<YansWifiPhy> m_phys[3];
+};
+
+YansWifiChannelRejectionTest::YansWifiChannelRejectionTest (std::string mask, bool busy2, bool busy3)
+  : TestCase ("Adjacent channel rejection \"" + mask + "\""),
+    m_mask (mask),
+    m_busy2 (busy2),
+    m_busy3 (busy3)
+{}
+
+YansWifiChannelRejectionTest::~YansWifiChannelRejectionTest ()
+{}
+
+void
+YansWifiChannelRejectionTest::Send (void)
+{
+  m_phys[0]->SendPacket (Create<Packet> (1000), WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+YansWifiChannelRejectionTest::Check (bool busy2, bool busy3)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_phys[1]->IsStateCcaBusy (), busy2, "Unexpected CCA state on channel 2");
+  NS_TEST_EXPECT_MSG_EQ (m_phys[2]->IsStateCcaBusy (), busy3, "Unexpected CCA state of the third PHY");
+}
+
+bool
+YansWifiChannelRejectionTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetAttribute ("AdjacentChannelRejection", StringValue (m_mask));
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (i, 0, 0));
+      m_phys[i] = CreateObject<YansWifiPhy> ();
+      m_phys[i]->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+      m_phys[i]->SetChannel (channel);
+      m_phys[i]->SetMobility (mobility);
+      m_phys[i]->SetAntenna (CreateObject<ConeAntenna> ());
+      m_phys[i]->SetChannelNumber (i + 1);
+    }
+  Simulator::Schedule (Seconds (1), &YansWifiChannelRejectionTest::Send, this);
+  Simulator::Schedule (Seconds (1) + MicroSeconds (10), &YansWifiChannelRejectionTest::Check, this,
+                       m_busy2, m_busy3);
+  Simulator::Schedule (Seconds (2), &YansWifiPhy::SetChannelNumber, m_phys[2], 2);
+  Simulator::Schedule (Seconds (3), &YansWifiChannelRejectionTest::Send, this);
+  Simulator::Schedule (Seconds (3) + MicroSeconds (10), &YansWifiChannelRejectionTest::Check, this,
+                       m_busy2, m_busy2);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      m_phys[i] = 0;
+    }
+  return GetErrorStatus ();
+}
+
+/**
+ * Two copies of the same three PHYs, one on a channel which caches the
+ * link budgets and one on a channel which does not. The first PHY sends
+ * while the others move, get their antenna re-pointed and switch channel,
+ * and both copies must see the same received powers throughout.
+ */
+class YansWifiChannelStaticGeometryTest : public TestCase
+{
+public:
+  YansWifiChannelStaticGeometryTest ();
+  virtual ~YansWifiChannelStaticGeometryTest ();
+
+private:
+  virtual bool DoRun (void);
+  void Send (void);
+  void Rx (uint32_t index, Ptr<const Packet> packet, uint16_t frequency,
+           uint16_t channel, uint32_t rate, bool isShortPreamble, double signalDbm,
+           double noiseDbm);
+  void Check (uint32_t step, bool received1, bool received2);
+  void Move (uint32_t phy, Vector position);
+  void Point (uint32_t phy, double azimuth);
+  void SwitchChannel (uint32_t phy, uint16_t channel);
+
+  Ptr<YansWifiPhy> m_phys[2][3];
+  Ptr<MobilityModel> m_mobility[2][3];
+  Ptr<Measured2DAntenna> m_antennas[2][3];
+  // the power (dbm) each PHY received the last frame with, NAN if it did not
+  double m_rxDbm[2][3];
+  // the powers received at each step, so that each change is seen to matter
+  double m_history[6][3];
+};
+
+YansWifiChannelStaticGeometryTest::YansWifiChannelStaticGeometryTest ()
+  : TestCase ("Cached link budgets follow moves, antenna changes and channel switches")
+{}
+
+YansWifiChannelStaticGeometryTest::~YansWifiChannelStaticGeometryTest ()
+{}
+
+void
+YansWifiChannelStaticGeometryTest::Send (void)
+{
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          m_rxDbm[c][j] = NAN;
+        }
+      // broadcast, so that the receivers lock onto it
+      WifiMacHeader hdr;
+      hdr.SetType (WIFI_MAC_DATA);
+      hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+      Ptr<Packet> packet = Create<Packet> (1000);
+      packet->AddHeader (hdr);
+      m_phys[c][0]->SendPacket (packet, WifiPhy::GetOfdmRate6Mbps (), WIFI_PREAMBLE_LONG, 0);
+    }
+}
+
+void
+YansWifiChannelStaticGeometryTest::Rx (uint32_t index, Ptr<const Packet> packet,
+                                        uint16_t frequency, uint16_t channel, uint32_t rate,
+                                        bool isShortPreamble, double signalDbm, double noiseDbm)
+{
+  m_rxDbm[index / 3][index % 3] = signalDbm;
+}
+
+void
+YansWifiChannelStaticGeometryTest::Check (uint32_t step, bool received1, bool received2)
+{
+  bool received[3] = {false, received1, received2};
+  for (uint32_t j = 1; j < 3; j++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (!isnan (m_rxDbm[1][j]), received[j],
+                             "Unexpected reception by PHY " << j << " at step " << step);
+      NS_TEST_EXPECT_MSG_EQ (!isnan (m_rxDbm[0][j]), received[j],
+                             "Unexpected cached reception by PHY " << j << " at step " << step);
+      if (!received[j])
+        {
+          continue;
+        }
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_rxDbm[0][j], m_rxDbm[1][j], 1e-9,
+                                 "Stale link budget to PHY " << j << " at step " << step);
+      m_history[step][j] = m_rxDbm[1][j];
+    }
+}
+
+void
+YansWifiChannelStaticGeometryTest::Move (uint32_t phy, Vector position)
+{
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      m_mobility[c][phy]->SetPosition (position);
+    }
+}
+
+void
+YansWifiChannelStaticGeometryTest::Point (uint32_t phy, double azimuth)
+{
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      m_antennas[c][phy]->SetAzimuthAngle (azimuth);
+    }
+}
+
+void
+YansWifiChannelStaticGeometryTest::SwitchChannel (uint32_t phy, uint16_t channel)
+{
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      m_phys[c][phy]->SetChannelNumber (channel);
+    }
+}
+
+bool
+YansWifiChannelStaticGeometryTest::DoRun (void)
+{
+  Vector positions[3] = {Vector (0, 0, 0), Vector (2, 0.5, 0), Vector (2, -1, 0)};
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+      channel->SetAttribute ("StaticGeometry", BooleanValue (c == 0));
+      channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+      channel->SetPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          m_mobility[c][j] = CreateObject<ConstantPositionMobilityModel> ();
+          m_mobility[c][j]->SetPosition (positions[j]);
+          m_antennas[c][j] = CreateObject<Measured2DAntenna> ();
+          m_antennas[c][j]->SetMode (23);
+          // the receivers look back at the sender
+          m_antennas[c][j]->SetAzimuthAngle (j == 0 ? 0 : atan2 (-positions[j].y, -positions[j].x));
+          m_phys[c][j] = CreateObject<YansWifiPhy> ();
+          m_phys[c][j]->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+          m_phys[c][j]->SetChannel (channel);
+          m_phys[c][j]->SetMobility (m_mobility[c][j]);
+          m_phys[c][j]->SetAntenna (m_antennas[c][j]);
+          m_phys[c][j]->SetChannelNumber (1);
+          m_phys[c][j]->TraceConnectWithoutContext ("PromiscSnifferRx",
+            MakeCallback (&YansWifiChannelStaticGeometryTest::Rx, this).Bind (3 * c + j));
+        }
+    }
+
+  // twice the same frame: the second one is served from the cache
+  Simulator::Schedule (Seconds (1), &YansWifiChannelStaticGeometryTest::Send, this);
+  Simulator::Schedule (Seconds (1.1), &YansWifiChannelStaticGeometryTest::Check, this, 0, true, true);
+  Simulator::Schedule (Seconds (1.5), &YansWifiChannelStaticGeometryTest::Send, this);
+  Simulator::Schedule (Seconds (1.6), &YansWifiChannelStaticGeometryTest::Check, this, 1, true, true);
+  // a receiver moves
+  Simulator::Schedule (Seconds (2), &YansWifiChannelStaticGeometryTest::Move, this, 1, Vector (3, 0.5, 0));
+  Simulator::Schedule (Seconds (2.5), &YansWifiChannelStaticGeometryTest::Send, this);
+  Simulator::Schedule (Seconds (2.6), &YansWifiChannelStaticGeometryTest::Check, this, 2, true, true);
+  // the sender re-points its antenna
+  Simulator::Schedule (Seconds (3), &YansWifiChannelStaticGeometryTest::Point, this, 0, -0.3);
+  Simulator::Schedule (Seconds (3.5), &YansWifiChannelStaticGeometryTest::Send, this);
+  Simulator::Schedule (Seconds (3.6), &YansWifiChannelStaticGeometryTest::Check, this, 3, true, true);
+  // a receiver leaves the channel, moves and comes back
+  Simulator::Schedule (Seconds (4), &YansWifiChannelStaticGeometryTest::SwitchChannel, this, 2, 6);
+  Simulator::Schedule (Seconds (4.5), &YansWifiChannelStaticGeometryTest::Send, this);
+  Simulator::Schedule (Seconds (4.6), &YansWifiChannelStaticGeometryTest::Check, this, 4, true, false);
+  Simulator::Schedule (Seconds (5), &YansWifiChannelStaticGeometryTest::Move, this, 2, Vector (1, -1, 0));
+  Simulator::Schedule (Seconds (5.2), &YansWifiChannelStaticGeometryTest::SwitchChannel, this, 2, 1);
+  Simulator::Schedule (Seconds (5.5), &YansWifiChannelStaticGeometryTest::Send, this);
+  Simulator::Schedule (Seconds (5.6), &YansWifiChannelStaticGeometryTest::Check, this, 5, true, true);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_history[1][1], m_history[0][1], "The same frame was received differently");
+  NS_TEST_EXPECT_MSG_NE (m_history[2][1], m_history[1][1], "The move did not change the received power");
+  NS_TEST_EXPECT_MSG_NE (m_history[3][1], m_history[2][1], "The re-pointing did not change the received power");
+  NS_TEST_EXPECT_MSG_NE (m_history[3][2], m_history[2][2], "The re-pointing did not change the received power");
+  NS_TEST_EXPECT_MSG_NE (m_history[5][2], m_history[3][2], "The move did not change the received power");
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          m_phys[c][j] = 0;
+          m_mobility[c][j] = 0;
+          m_antennas[c][j] = 0;
+        }
+    }
+  return GetErrorStatus ();
+}
+
+
+class YansWifiChannelTestSuite : public TestSuite
+{
+public:
+  YansWifiChannelTestSuite ();
+};
+
+YansWifiChannelTestSuite::YansWifiChannelTestSuite ()
+  : TestSuite ("devices-wifi-yans-channel", UNIT)
+{
+  AddTestCase (new YansWifiChannelRejectionTest ("", false, false));
+  AddTestCase (new YansWifiChannelRejectionTest ("20", true, false));
+  AddTestCase (new YansWifiChannelRejectionTest ("20 30", true, true));
+  AddTestCase (new YansWifiChannelStaticGeometryTest);
+}
+
+YansWifiChannelTestSuite g_yansWifiChannelTestSuite;
+
+} // namespace ns3
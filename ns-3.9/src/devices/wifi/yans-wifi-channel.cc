@@ -24,11 +24,18 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
+#include "ns3/antenna.h"
+#include <algorithm>
+#include <sstream>
+#include <math.h>
 
 NS_LOG_COMPONENT_DEFINE ("YansWifiChannel");
 
@@ -36,6 +43,9 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (YansWifiChannel);
 
+// Sender index passed to Propagate when no link budget is to be cached
+static const uint32_t NO_PHY = 0xffffffff;
+
 TypeId 
 YansWifiChannel::GetTypeId (void)
 {
@@ -50,11 +60,41 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MinRxPower",
+                   "Frames which would be received below this power (dbm) are not "
+                   "delivered to the receiving PHY at all.",
+                   DoubleValue (-77.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_minRxPowerDbm),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("IndexCellSize",
+                   "The size (m) of the cells of the grid used to find the PHYs "
+                   "within reception range of a sender.",
+                   DoubleValue (5.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_cellSize),
+                   MakeDoubleChecker<double> (0.01))
+    .AddAttribute ("StaticGeometry",
+                   "If true, cache the received power and the propagation delay of each "
+                   "sender/receiver pair until either end moves or is reconfigured. "
+                   "Only valid with deterministic propagation models.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiChannel::m_staticGeometry),
+                   MakeBooleanChecker ())
+    .AddAttribute ("AdjacentChannelRejection",
+                   "The rejection (dB) of the channels 1, 2, ... channel numbers away from the "
+                   "one a frame is sent on, separated by spaces. The frame is added to the "
+                   "interference of the PHYs on these channels, attenuated by their rejection. "
+                   "Empty to ignore inter-channel interference.",
+                   StringValue (""),
+                   MakeStringAccessor (&YansWifiChannel::GetAdjacentChannelRejection,
+                                       &YansWifiChannel::SetAdjacentChannelRejection),
+                   MakeStringChecker ())
     ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_staticGeometry (false),
+    m_indexValid (false)
 {}
 YansWifiChannel::~YansWifiChannel ()
 {
@@ -62,6 +102,32 @@ YansWifiChannel::~YansWifiChannel ()
   m_phyList.clear ();
 }
 
+void
+YansWifiChannel::DoDispose (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  for (uint32_t j = 0; j < m_phyStates.size (); j++)
+    {
+      if (m_phyStates[j].mobility != 0)
+        {
+          m_phyStates[j].mobility->TraceDisconnectWithoutContext ("CourseChange",
+            MakeCallback (&YansWifiChannel::NotifyCourseChange, this));
+        }
+      if (m_phyStates[j].antenna != 0)
+        {
+          m_phyStates[j].antenna->TraceDisconnectWithoutContext ("PatternChange",
+            MakeCallback (&YansWifiChannel::NotifyPatternChange, this));
+        }
+    }
+  m_phyStates.clear ();
+  m_buckets.clear ();
+  m_links.clear ();
+  m_phyIndexes.clear ();
+  m_batch.Clear ();
+  m_indexValid = false;
+  WifiChannel::DoDispose ();
+}
+
 void 
 YansWifiChannel::SetPropagationLossModel (Ptr<PropagationLossModel> loss)
 {
@@ -78,60 +144,565 @@ YansWifiChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
   m_delay = delay;
 }
 
+void
+YansWifiChannel::SetAdjacentChannelRejection (std::string mask)
+{
+  NS_LOG_FUNCTION (this << mask);
+  std::vector<double> rejectionDb;
+  std::istringstream in (mask);
+  double db;
+  while (in >> db)
+    {
+      if (db <= 0)
+        {
+          NS_FATAL_ERROR ("adjacent channel rejection must be positive: " << mask);
+        }
+      rejectionDb.push_back (db);
+    }
+  if (!in.eof ())
+    {
+      NS_FATAL_ERROR ("invalid adjacent channel rejection mask: " << mask);
+    }
+  m_rejectionMask = mask;
+  m_rejectionDb = rejectionDb;
+}
+
+std::string
+YansWifiChannel::GetAdjacentChannelRejection (void) const
+{
+  return m_rejectionMask;
+}
+
 void 
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
                        WifiMode wifiMode, WifiPreamble preamble) const
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
   uint32_t sender_chan = sender->GetChannelNumber();
-  Vector sender_pos = senderMobility->GetPosition();
   Ptr<Antenna> sender_ant = sender->GetAntenna();
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
-    { 
-      if (sender != (*i))
+  Vector sender_pos = senderMobility->GetPosition();
+  if (!m_indexValid)
+    {
+      UpdateIndex ();
+    }
+  if (!m_indexValid)
+    {
+      // Some PHYs cannot be located yet: visit all of them.
+      CollectAll (sender, sender_chan, 0.0);
+      for (uint32_t d = 1; d <= m_rejectionDb.size (); d++)
+        {
+          if (sender_chan >= d)
+            {
+              CollectAll (sender, sender_chan - d, m_rejectionDb[d - 1]);
+            }
+          CollectAll (sender, sender_chan + d, m_rejectionDb[d - 1]);
+        }
+      Propagate (NO_PHY, senderMobility, sender_pos, sender_ant,
+                 packet, txPowerDbm, wifiMode, preamble);
+      return;
+    }
+
+  PhyBuckets::const_iterator b = m_buckets.find (sender_chan);
+  if (b == m_buckets.end ())
+    {
+      return;
+    }
+  // No receiver can hear this frame farther away than this.
+  double peakDbm = txPowerDbm + sender_ant->GetMaxGainDbi ();
+  double range = m_loss->GetMaxRange (peakDbm + b->second.maxRxGainDbi, m_minRxPowerDbm);
+  CollectBucket (b->second, sender, sender_pos, range, 0.0);
+  for (uint32_t d = 1; d <= m_rejectionDb.size (); d++)
+    {
+      double rejectionDb = m_rejectionDb[d - 1];
+      for (int side = -1; side <= 1; side += 2)
         {
-          // For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber() != sender_chan)
+          if (side < 0 && sender_chan < d)
+            {
               continue;
-          
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-	  double azimuth = CalculateAzimuthAngle(
-			  sender_pos,
-			  receiverMobility->GetPosition());
-	  double elevation = CalculateElevationAngle(
-			  sender_pos,
-			  receiverMobility->GetPosition());
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm =
-		  m_loss->CalcRxPower (txPowerDbm, senderMobility,
-				  receiverMobility) +
-		  sender_ant->GetTxGainDbi(azimuth, elevation) +
-		  (*i)->GetAntenna()->GetRxGainDbi(azimuth+M_PI, -elevation);
-	  /* DAN: Don't copy packets if below noise floor */
-	  if (rxPowerDbm < -77)
-		  continue;
-          NS_LOG_DEBUG ("propagation: txPower="<<txPowerDbm<<"dbm, rxPower="<<rxPowerDbm<<"dbm, "<<
-                        "distance="<<senderMobility->GetDistanceFrom (receiverMobility)<<"m, delay="<<delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+            }
+          b = m_buckets.find (sender_chan + side * (int32_t)d);
+          if (b == m_buckets.end ())
             {
-              dstNode = 0xffffffff;
+              continue;
             }
-          else
+          range = m_loss->GetMaxRange (peakDbm + b->second.maxRxGainDbi - rejectionDb,
+                                       m_minRxPowerDbm);
+          CollectBucket (b->second, sender, sender_pos, range, rejectionDb);
+        }
+    }
+  uint32_t senderIndex = NO_PHY;
+  if (m_staticGeometry)
+    {
+      senderIndex = m_phyIndexes.find (sender)->second;
+      if (!m_phyStates[senderIndex].isStatic)
+        {
+          senderIndex = NO_PHY;
+        }
+    }
+  Propagate (senderIndex, senderMobility, sender_pos, sender_ant,
+             packet, txPowerDbm, wifiMode, preamble);
+}
+
+void
+YansWifiChannel::CollectAll (Ptr<YansWifiPhy> sender, uint16_t channel, double rejectionDb) const
+{
+  uint32_t j = 0;
+  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+    {
+      if (sender == (*i) || (*i)->GetChannelNumber() != channel)
+        {
+          continue;
+        }
+      Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
+      m_batch.Add (j, receiverMobility, receiverMobility->GetPosition ());
+      m_batch.rejectionDb.push_back (rejectionDb);
+    }
+}
+
+void
+YansWifiChannel::CollectBucket (const PhyBucket &bucket, Ptr<YansWifiPhy> sender, const Vector &sender_pos,
+                                double range, double rejectionDb) const
+{
+  // Leave some slack for rounding errors in the range computation.
+  range *= 1.000001;
+  const std::vector<uint32_t> *candidates = &bucket.phys;
+  if (bucket.isStatic)
+    {
+      double x0 = floor ((sender_pos.x - range - bucket.xMin) / bucket.cellSize);
+      double x1 = floor ((sender_pos.x + range - bucket.xMin) / bucket.cellSize);
+      double y0 = floor ((sender_pos.y - range - bucket.yMin) / bucket.cellSize);
+      double y1 = floor ((sender_pos.y + range - bucket.yMin) / bucket.cellSize);
+      uint32_t cx0 = x0 <= 0 ? 0 : (uint32_t) std::min (x0, (double)bucket.nx);
+      uint32_t cx1 = x1 >= bucket.nx - 1 ? bucket.nx - 1 : (x1 < 0 ? 0 : (uint32_t)x1);
+      uint32_t cy0 = y0 <= 0 ? 0 : (uint32_t) std::min (y0, (double)bucket.ny);
+      uint32_t cy1 = y1 >= bucket.ny - 1 ? bucket.ny - 1 : (y1 < 0 ? 0 : (uint32_t)y1);
+      if (cx0 != 0 || cy0 != 0 || cx1 != bucket.nx - 1 || cy1 != bucket.ny - 1)
+        {
+          m_candidates.clear ();
+          for (uint32_t cx = cx0; cx <= cx1; cx++)
+            {
+              for (uint32_t cy = cy0; cy <= cy1; cy++)
+                {
+                  const std::vector<uint32_t> &cell = bucket.cells[cx * bucket.ny + cy];
+                  m_candidates.insert (m_candidates.end (), cell.begin (), cell.end ());
+                }
+            }
+          // Deliver in the same order as a full scan would.
+          std::sort (m_candidates.begin (), m_candidates.end ());
+          candidates = &m_candidates;
+        }
+    }
+  for (std::vector<uint32_t>::const_iterator i = candidates->begin (); i != candidates->end (); i++)
+    {
+      uint32_t j = *i;
+      if (sender == m_phyList[j])
+        {
+          continue;
+        }
+      const PhyState &state = m_phyStates[j];
+      if (!bucket.isStatic)
+        {
+          m_batch.Add (j, state.mobility, state.mobility->GetPosition ());
+          m_batch.rejectionDb.push_back (rejectionDb);
+        }
+      else if (CalculateDistance (sender_pos, state.position) <= range)
+        {
+          m_batch.Add (j, state.mobility, state.position);
+          m_batch.rejectionDb.push_back (rejectionDb);
+        }
+    }
+}
+
+void
+YansWifiChannel::Propagate (uint32_t i, Ptr<MobilityModel> senderMobility, const Vector &sender_pos,
+                            Ptr<Antenna> senderAntenna, Ptr<const Packet> packet,
+                            double txPowerDbm, WifiMode wifiMode, WifiPreamble preamble) const
+{
+  ReceiverBatch &batch = m_batch;
+  uint32_t n = batch.phys.size ();
+  if (n == 0)
+    {
+      return;
+    }
+  batch.rxPowerDbm.resize (n);
+  batch.delay.resize (n);
+
+  // Pick the cached link budgets, and queue the others for evaluation.
+  for (uint32_t k = 0; k < n; k++)
+    {
+      uint32_t j = batch.phys[k];
+      if (i != NO_PHY && m_phyStates[j].isStatic)
+        {
+          const LinkBudget &link = m_links[i * m_phyList.size () + j];
+          if (link.senderEpoch == m_phyStates[i].epoch &&
+              link.receiverEpoch == m_phyStates[j].epoch &&
+              link.txPowerDbm == txPowerDbm)
+            {
+              batch.rxPowerDbm[k] = link.rxPowerDbm;
+              batch.delay[k] = link.delay;
+              continue;
+            }
+        }
+      double dx = batch.x[k] - sender_pos.x;
+      double dy = batch.y[k] - sender_pos.y;
+      double dz = batch.z[k] - sender_pos.z;
+      double dxy = sqrt (dx * dx + dy * dy);
+      batch.pending.push_back (k);
+      batch.pendingMobility.push_back (batch.mobility[k]);
+      batch.distance.push_back (sqrt (dx * dx + dy * dy + dz * dz));
+      batch.azimuth.push_back (atan2 (dy, dx));
+      batch.elevation.push_back (atan2 (dz, dxy));
+    }
+
+  uint32_t m = batch.pending.size ();
+  if (m != 0)
+    {
+      batch.lossDbm.resize (m);
+      batch.txGainDbi.resize (m);
+      m_loss->CalcRxPowerBatch (txPowerDbm, senderMobility, &batch.pendingMobility[0],
+                                &batch.distance[0], &batch.lossDbm[0], m);
+      senderAntenna->GetTxGainDbiBatch (&batch.azimuth[0], &batch.elevation[0],
+                                        &batch.txGainDbi[0], m);
+      for (uint32_t p = 0; p < m; p++)
+        {
+          uint32_t k = batch.pending[p];
+          uint32_t j = batch.phys[k];
+          double rxPowerDbm = batch.lossDbm[p] + batch.txGainDbi[p] +
+            m_phyList[j]->GetAntenna ()->GetRxGainDbi (batch.azimuth[p] + M_PI, -batch.elevation[p]);
+          Time delay = m_delay->GetDelay (senderMobility, batch.mobility[k]);
+          batch.rxPowerDbm[k] = rxPowerDbm;
+          batch.delay[k] = delay;
+          if (i != NO_PHY && m_phyStates[j].isStatic)
             {
-              dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+              LinkBudget &link = m_links[i * m_phyList.size () + j];
+              link.txPowerDbm = txPowerDbm;
+              link.rxPowerDbm = rxPowerDbm;
+              link.delay = delay;
+              link.senderEpoch = m_phyStates[i].epoch;
+              link.receiverEpoch = m_phyStates[j].epoch;
             }
+        }
+    }
+
+  for (uint32_t k = 0; k < n; k++)
+    {
+      uint32_t j = batch.phys[k];
+      double rxPowerDbm = batch.rxPowerDbm[k] - batch.rejectionDb[k];
+      /* DAN: Don't copy packets if below noise floor */
+      if (rxPowerDbm < m_minRxPowerDbm)
+        {
+          continue;
+        }
+      Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
+      uint32_t dstNode;
+      if (dstNetDevice == 0)
+        {
+          dstNode = 0xffffffff;
+        }
+      else
+        {
+          dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+        }
+      if (batch.rejectionDb[k] != 0)
+        {
+          // Leaks from another channel: only its energy matters.
           Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive, this, 
-                                          j, copy, rxPowerDbm, wifiMode, preamble);
+                                          batch.delay[k], &YansWifiChannel::ReceiveInterference, this,
+                                          j, packet->GetSize (), rxPowerDbm, wifiMode, preamble);
+          continue;
+        }
+      NS_LOG_DEBUG ("propagation: txPower="<<txPowerDbm<<"dbm, rxPower="<<rxPowerDbm<<"dbm, "<<
+                    "distance="<<senderMobility->GetDistanceFrom (batch.mobility[k])<<"m, delay="<<batch.delay[k]);
+      Ptr<Packet> copy = packet->Copy ();
+      Simulator::ScheduleWithContext (dstNode,
+                                      batch.delay[k], &YansWifiChannel::Receive, this, 
+                                      j, copy, rxPowerDbm, wifiMode, preamble);
+    }
+  batch.Clear ();
+}
+
+void
+YansWifiChannel::ReceiverBatch::Clear (void)
+{
+  phys.clear ();
+  rejectionDb.clear ();
+  mobility.clear ();
+  x.clear ();
+  y.clear ();
+  z.clear ();
+  pending.clear ();
+  pendingMobility.clear ();
+  distance.clear ();
+  azimuth.clear ();
+  elevation.clear ();
+}
+
+void
+YansWifiChannel::ReceiverBatch::Add (uint32_t phy, Ptr<MobilityModel> mobility, const Vector &position)
+{
+  phys.push_back (phy);
+  this->mobility.push_back (mobility);
+  x.push_back (position.x);
+  y.push_back (position.y);
+  z.push_back (position.z);
+}
+
+void
+YansWifiChannel::UpdateIndex (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_buckets.clear ();
+  m_phyStates.resize (m_phyList.size ());
+  if (m_staticGeometry && m_links.size () != m_phyList.size () * m_phyList.size ())
+    {
+      m_links.assign (m_phyList.size () * m_phyList.size (), LinkBudget ());
+    }
+  bool located = true;
+  for (uint32_t j = 0; j < m_phyList.size (); j++)
+    {
+      Ptr<YansWifiPhy> phy = m_phyList[j];
+      PhyState &state = m_phyStates[j];
+      Ptr<MobilityModel> mobility = 0;
+      if (phy->GetMobility () != 0)
+        {
+          mobility = phy->GetMobility ()->GetObject<MobilityModel> ();
+        }
+      if (mobility != state.mobility)
+        {
+          if (state.mobility != 0)
+            {
+              state.mobility->TraceDisconnectWithoutContext ("CourseChange",
+                MakeCallback (&YansWifiChannel::NotifyCourseChange, this));
+            }
+          if (mobility != 0)
+            {
+              mobility->TraceConnectWithoutContext ("CourseChange",
+                MakeCallback (&YansWifiChannel::NotifyCourseChange, this));
+            }
+          state.mobility = mobility;
+        }
+      Ptr<Antenna> antenna = phy->GetAntenna ();
+      if (antenna != state.antenna)
+        {
+          if (state.antenna != 0)
+            {
+              state.antenna->TraceDisconnectWithoutContext ("PatternChange",
+                MakeCallback (&YansWifiChannel::NotifyPatternChange, this));
+            }
+          if (antenna != 0)
+            {
+              antenna->TraceConnectWithoutContext ("PatternChange",
+                MakeCallback (&YansWifiChannel::NotifyPatternChange, this));
+            }
+          state.antenna = antenna;
+        }
+      if (mobility == 0 || antenna == 0)
+        {
+          located = false;
+          continue;
+        }
+      state.position = mobility->GetPosition ();
+      Vector velocity = mobility->GetVelocity ();
+      // The position moves without notifying us: no grid for this bucket.
+      state.isStatic = velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+
+      std::pair<PhyBuckets::iterator, bool> ins =
+        m_buckets.insert (std::make_pair (phy->GetChannelNumber (), PhyBucket ()));
+      PhyBucket &bucket = ins.first->second;
+      if (ins.second)
+        {
+          bucket.maxRxGainDbi = antenna->GetMaxGainDbi ();
+          bucket.isStatic = true;
+          bucket.xMin = state.position.x;
+          bucket.yMin = state.position.y;
+        }
+      bucket.phys.push_back (j);
+      bucket.maxRxGainDbi = std::max (bucket.maxRxGainDbi, antenna->GetMaxGainDbi ());
+      bucket.xMin = std::min (bucket.xMin, state.position.x);
+      bucket.yMin = std::min (bucket.yMin, state.position.y);
+      bucket.isStatic = bucket.isStatic && state.isStatic;
+    }
+  if (!located)
+    {
+      m_buckets.clear ();
+      return;
+    }
+
+  for (PhyBuckets::iterator b = m_buckets.begin (); b != m_buckets.end (); b++)
+    {
+      PhyBucket &bucket = b->second;
+      if (!bucket.isStatic)
+        {
+          continue;
+        }
+      double xMax = bucket.xMin;
+      double yMax = bucket.yMin;
+      for (std::vector<uint32_t>::const_iterator i = bucket.phys.begin (); i != bucket.phys.end (); i++)
+        {
+          xMax = std::max (xMax, m_phyStates[*i].position.x);
+          yMax = std::max (yMax, m_phyStates[*i].position.y);
+        }
+      // Grow the cells until the grid is no larger than a few cells per PHY.
+      bucket.cellSize = m_cellSize;
+      while (true)
+        {
+          bucket.nx = (uint32_t)floor ((xMax - bucket.xMin) / bucket.cellSize) + 1;
+          bucket.ny = (uint32_t)floor ((yMax - bucket.yMin) / bucket.cellSize) + 1;
+          if ((double)bucket.nx * bucket.ny <= 4.0 * bucket.phys.size () + 16)
+            {
+              break;
+            }
+          bucket.cellSize *= 2;
+        }
+      bucket.cells.assign (bucket.nx * bucket.ny, std::vector<uint32_t> ());
+      for (std::vector<uint32_t>::const_iterator i = bucket.phys.begin (); i != bucket.phys.end (); i++)
+        {
+          const Vector &position = m_phyStates[*i].position;
+          uint32_t cx = (uint32_t)floor ((position.x - bucket.xMin) / bucket.cellSize);
+          uint32_t cy = (uint32_t)floor ((position.y - bucket.yMin) / bucket.cellSize);
+          bucket.cells[cx * bucket.ny + cy].push_back (*i);
+        }
+    }
+  m_indexValid = true;
+}
+
+bool
+YansWifiChannel::RemoveFromBucket (uint32_t j, uint16_t channel)
+{
+  PhyBuckets::iterator b = m_buckets.find (channel);
+  if (b == m_buckets.end ())
+    {
+      return false;
+    }
+  PhyBucket &bucket = b->second;
+  std::vector<uint32_t>::iterator k = std::lower_bound (bucket.phys.begin (), bucket.phys.end (), j);
+  if (k == bucket.phys.end () || *k != j)
+    {
+      return false;
+    }
+  bucket.phys.erase (k);
+  if (bucket.phys.empty ())
+    {
+      m_buckets.erase (b);
+      return true;
+    }
+  // maxRxGainDbi and isStatic are left as they are: they remain valid bounds.
+  if (bucket.isStatic)
+    {
+      const Vector &position = m_phyStates[j].position;
+      uint32_t cx = (uint32_t)floor ((position.x - bucket.xMin) / bucket.cellSize);
+      uint32_t cy = (uint32_t)floor ((position.y - bucket.yMin) / bucket.cellSize);
+      std::vector<uint32_t> &cell = bucket.cells[cx * bucket.ny + cy];
+      cell.erase (std::lower_bound (cell.begin (), cell.end (), j));
+    }
+  return true;
+}
+
+bool
+YansWifiChannel::AddToBucket (uint32_t j, uint16_t channel)
+{
+  const PhyState &state = m_phyStates[j];
+  std::pair<PhyBuckets::iterator, bool> ins =
+    m_buckets.insert (std::make_pair (channel, PhyBucket ()));
+  PhyBucket &bucket = ins.first->second;
+  if (ins.second)
+    {
+      bucket.maxRxGainDbi = state.antenna->GetMaxGainDbi ();
+      bucket.isStatic = state.isStatic;
+      bucket.xMin = state.position.x;
+      bucket.yMin = state.position.y;
+      bucket.cellSize = m_cellSize;
+      bucket.nx = 1;
+      bucket.ny = 1;
+      bucket.cells.assign (1, std::vector<uint32_t> ());
+    }
+  bucket.phys.insert (std::upper_bound (bucket.phys.begin (), bucket.phys.end (), j), j);
+  bucket.maxRxGainDbi = std::max (bucket.maxRxGainDbi, state.antenna->GetMaxGainDbi ());
+  if (!bucket.isStatic)
+    {
+      return true;
+    }
+  if (!state.isStatic)
+    {
+      bucket.isStatic = false;
+      bucket.cells.clear ();
+      return true;
+    }
+  double x = floor ((state.position.x - bucket.xMin) / bucket.cellSize);
+  double y = floor ((state.position.y - bucket.yMin) / bucket.cellSize);
+  if (x < 0 || x >= bucket.nx || y < 0 || y >= bucket.ny)
+    {
+      // Outside of the grid of this bucket: rebuild it.
+      return false;
+    }
+  std::vector<uint32_t> &cell = bucket.cells[(uint32_t)x * bucket.ny + (uint32_t)y];
+  cell.insert (std::upper_bound (cell.begin (), cell.end (), j), j);
+  return true;
+}
+
+void
+YansWifiChannel::InvalidateLinks (uint32_t j) const
+{
+  if (j < m_phyStates.size ())
+    {
+      m_phyStates[j].epoch++;
+    }
+}
+
+void
+YansWifiChannel::NotifyCourseChange (Ptr<const MobilityModel> mobility) const
+{
+  m_indexValid = false;
+  for (uint32_t j = 0; j < m_phyStates.size (); j++)
+    {
+      if (m_phyStates[j].mobility == mobility)
+        {
+          InvalidateLinks (j);
+        }
+    }
+}
+
+void
+YansWifiChannel::NotifyPatternChange (Ptr<const Antenna> antenna) const
+{
+  m_indexValid = false;
+  for (uint32_t j = 0; j < m_phyStates.size (); j++)
+    {
+      if (m_phyStates[j].antenna == antenna)
+        {
+          InvalidateLinks (j);
         }
     }
 }
 
+void
+YansWifiChannel::NotifyPhyChange (Ptr<const YansWifiPhy> phy)
+{
+  m_indexValid = false;
+  PhyIndexes::const_iterator i = m_phyIndexes.find (phy);
+  if (i != m_phyIndexes.end ())
+    {
+      InvalidateLinks (i->second);
+    }
+}
+
+void
+YansWifiChannel::NotifyChannelSwitch (Ptr<const YansWifiPhy> phy, uint16_t previous)
+{
+  PhyIndexes::const_iterator i = m_phyIndexes.find (phy);
+  if (!m_indexValid || i == m_phyIndexes.end () || previous == phy->GetChannelNumber ())
+    {
+      return;
+    }
+  // The link budgets do not depend on the channel number: keep them.
+  if (!RemoveFromBucket (i->second, previous) ||
+      !AddToBucket (i->second, phy->GetChannelNumber ()))
+    {
+      m_indexValid = false;
+    }
+}
+
 void
 YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
                           WifiMode txMode, WifiPreamble preamble) const
@@ -139,6 +710,13 @@ YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
   m_phyList[i]->StartReceivePacket (packet, rxPowerDbm, txMode, preamble);
 }
 
+void
+YansWifiChannel::ReceiveInterference (uint32_t i, uint32_t size, double rxPowerDbm,
+                                      WifiMode txMode, WifiPreamble preamble) const
+{
+  m_phyList[i]->StartReceiveInterference (size, rxPowerDbm, txMode, preamble);
+}
+
 uint32_t 
 YansWifiChannel::GetNDevices (void) const
 {
@@ -153,7 +731,9 @@ YansWifiChannel::GetDevice (uint32_t i) const
 void 
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
+  m_phyIndexes[phy] = m_phyList.size ();
   m_phyList.push_back (phy);
+  m_indexValid = false;
 }
 
 } // namespace ns3
@@ -66,6 +66,14 @@ YansWifiPhy::GetTypeId (void)
                    MakeDoubleAccessor (&YansWifiPhy::SetCcaMode1Threshold,
                                        &YansWifiPhy::GetCcaMode1Threshold),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("InterferenceFloor",
+                   "Signals received below this power (dbm) are never locked onto "
+                   "and only add to an aggregate background noise, instead of being "
+                   "tracked as individual interference events. They do not fire PhyRxDrop.",
+                   DoubleValue (-1000.0),
+                   MakeDoubleAccessor (&YansWifiPhy::SetInterferenceFloor,
+                                       &YansWifiPhy::GetInterferenceFloor),
+                   MakeDoubleChecker<double> ())
     .AddAttribute ("TxPowerLevels",
                    "Number of transmission power levels available between "
                    "TxPowerBase and TxPowerEnd included.",
@@ -126,10 +134,15 @@ YansWifiPhy::YansWifiPhy ()
   :  m_channelNumber (1),
      m_endRxEvent (),
      m_random (0.0, 1.0),
-     m_channelStartingFrequency (0)
+     m_channelStartingFrequency (0),
+     m_addressValid (false)
 {
   NS_LOG_FUNCTION (this);
   m_state = CreateObject<WifiPhyStateHelper> ();
+  // take the stream of the variable now, in the order in which the phys
+  // are made, rather than on the first reception, which a parallel
+  // simulator would reach in any order
+  m_random.GetValue ();
 }
 
 YansWifiPhy::~YansWifiPhy ()
@@ -233,11 +246,16 @@ void
 YansWifiPhy::SetDevice (Ptr<Object> device)
 {
   m_device = device;
+  m_addressValid = false;
 }
 void 
 YansWifiPhy::SetMobility (Ptr<Object> mobility)
 {
   m_mobility = mobility;
+  if (m_channel != 0)
+    {
+      m_channel->NotifyPhyChange (this);
+    }
 }
 
 double 
@@ -284,6 +302,38 @@ YansWifiPhy::GetMobility (void)
   return m_mobility;
 }
 
+void
+YansWifiPhy::SetInterferenceFloor (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_interferenceFloorW = DbmToW (threshold);
+}
+double
+YansWifiPhy::GetInterferenceFloor (void) const
+{
+  return WToDbm (m_interferenceFloorW);
+}
+
+Mac48Address
+YansWifiPhy::GetAddress (void)
+{
+  if (!m_addressValid)
+    {
+      Ptr<WifiNetDevice> wdev = DynamicCast<WifiNetDevice> (m_device);
+      m_address = Mac48Address::ConvertFrom (wdev->GetAddress ());
+      m_addressValid = true;
+    }
+  return m_address;
+}
+
+bool
+YansWifiPhy::IsAddressedToMe (Ptr<const Packet> packet)
+{
+  WifiMacHeader hdr;
+  packet->PeekHeader (hdr);
+  return hdr.GetAddr1 ().IsBroadcast () || hdr.GetAddr1 () == GetAddress ();
+}
+
 double 
 YansWifiPhy::CalculateSnr (WifiMode txMode, double ber) const
 {
@@ -311,6 +361,10 @@ void
 YansWifiPhy::SetAntenna (Ptr<Antenna> antenna)
 {
   m_antenna = antenna;
+  if (m_channel != 0)
+    {
+      m_channel->NotifyPhyChange (this);
+    }
 }
 
 void 
@@ -320,7 +374,12 @@ YansWifiPhy::SetChannelNumber (uint16_t nch)
     {
       // this is not channel switch, this is initialization 
       NS_LOG_DEBUG("start at channel " << nch);
+      uint16_t previous = m_channelNumber;
       m_channelNumber = nch;
+      if (m_channel != 0)
+        {
+          m_channel->NotifyChannelSwitch (this, previous);
+        }
       return;
     }
 
@@ -358,7 +417,9 @@ YansWifiPhy::SetChannelNumber (uint16_t nch)
    * state are added to the event list and are employed later to figure
    * out the state of the medium after the switching.
    */
+  uint16_t previous = m_channelNumber;
   m_channelNumber = nch;
+  m_channel->NotifyChannelSwitch (this, previous);
 }
 
 uint16_t 
@@ -397,17 +458,19 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
   Time endRx = Simulator::Now () + rxDuration;
 
   Ptr<InterferenceHelper::Event> event;
+  if (rxPowerW < m_interferenceFloorW)
+    {
+      // Far too weak to be received: only account for its energy. The
+      // frame never reached the PHY as a frame, so it is not a drop either.
+      NS_LOG_DEBUG ("fold packet into background noise (power="<<rxPowerW<<"W)");
+      m_interference.AddBackgroundNoise (rxDuration, rxPowerW);
+      goto maybeCcaBusy;
+    }
   event = m_interference.Add (packet->GetSize (), 
                               txMode,
                               preamble,
                               rxDuration,
                               rxPowerW);
-  /* Figure out this node's MAC address */
-  Ptr<WifiNetDevice> wdev = DynamicCast<WifiNetDevice>(m_device);
-  Mac48Address myAddr = Mac48Address::ConvertFrom(wdev->GetAddress());
-  /* Figure out the wifi Header */
-  WifiMacHeader hdr;
-  packet->PeekHeader(hdr);
 
   switch (m_state->GetState ()) {
   case YansWifiPhy::SWITCHING: 
@@ -455,11 +518,10 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
     break;
   case YansWifiPhy::CCA_BUSY:
   case YansWifiPhy::IDLE:
-    /* Is this packet to me? */
-////    std::cout << myAddr << " " << hdr.GetAddr1() << std::endl;
-    if ((hdr.GetAddr1() == myAddr || hdr.GetAddr1().IsBroadcast()) && rxPowerW > m_edThresholdW) 
+    /* Is this packet to me? Only look at its header if we can lock onto it. */
+    if (rxPowerW > m_edThresholdW && IsAddressedToMe (packet)) 
       {
-	//std::cout << myAddr << " starting to receive packet to " << hdr.GetAddr1() << std::endl;
+	//std::cout << GetAddress () << " starting to receive packet" << std::endl;
         NS_LOG_DEBUG ("sync to signal (power="<<rxPowerW<<"W)");
         // sync to signal
         m_state->SwitchToRx (rxDuration);
@@ -491,7 +553,7 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
 
   Time delayUntilCcaEnd = m_interference.GetEnergyDuration (m_ccaMode1ThresholdW);
   if (packet->GetSize() > 100)
-      //std::cout << myAddr << " " << hdr.GetAddr2() << " ************ SHOULD BE HERE ******************\n";
+      //std::cout << GetAddress () << " " << " ************ SHOULD BE HERE ******************\n";
   if (!delayUntilCcaEnd.IsZero ())
     {
       //std::cout << "************ SHOULD NOT BE HERE ******************\n";
@@ -499,14 +561,35 @@ YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
     }
 }
 
+void
+YansWifiPhy::StartReceiveInterference (uint32_t size,
+                                       double rxPowerDbm,
+                                       WifiMode txMode,
+                                       enum WifiPreamble preamble)
+{
+  NS_LOG_FUNCTION (this << size << rxPowerDbm << txMode << preamble);
+  double rxPowerW = DbmToW (rxPowerDbm);
+  Time rxDuration = CalculateTxDuration (size, txMode, preamble);
+  if (rxPowerW < m_interferenceFloorW)
+    {
+      m_interference.AddBackgroundNoise (rxDuration, rxPowerW);
+    }
+  else
+    {
+      m_interference.Add (size, txMode, preamble, rxDuration, rxPowerW);
+    }
+  Time delayUntilCcaEnd = m_interference.GetEnergyDuration (m_ccaMode1ThresholdW);
+  if (!delayUntilCcaEnd.IsZero ())
+    {
+      m_state->SwitchMaybeToCcaBusy (delayUntilCcaEnd);
+    }
+}
+
 void 
 YansWifiPhy::SendPacket (Ptr<const Packet> packet, WifiMode txMode, WifiPreamble preamble, uint8_t txPower)
 {
   NS_LOG_FUNCTION (this << packet << txMode << preamble << (uint32_t)txPower);
-  /* Figure out this node's MAC address */
-  Ptr<WifiNetDevice> wdev = DynamicCast<WifiNetDevice>(m_device);
-  Mac48Address myAddr = Mac48Address::ConvertFrom(wdev->GetAddress());
-  //std::cout << myAddr << ": sending packet of length " << packet->GetSize() << std::endl;
+  //std::cout << GetAddress () << ": sending packet of length " << packet->GetSize() << std::endl;
   /* Transmission can happen if:
    *  - we are syncing on a packet. It is the responsability of the
    *    MAC layer to avoid doing this but the PHY does nothing to 
@@ -823,12 +906,9 @@ YansWifiPhy::EndReceive (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> even
 
   NS_LOG_DEBUG ("mode="<<(event->GetPayloadMode ().GetDataRate ())<<
                 ", snr="<<snrPer.snr<<", per="<<snrPer.per<<", size="<<packet->GetSize ());
-  /* Figure out this node's MAC address */
-  Ptr<WifiNetDevice> wdev = DynamicCast<WifiNetDevice>(m_device);
-  Mac48Address myAddr = Mac48Address::ConvertFrom(wdev->GetAddress());
   if (m_random.GetValue () > snrPer.per) 
     {
-	    //std::cout << myAddr << " received successfully.\n";
+	    //std::cout << GetAddress () << " received successfully.\n";
       NotifyRxEnd (packet); 
       uint32_t dataRate500KbpsUnits = event->GetPayloadMode ().GetDataRate () / 500000;   
       bool isShortPreamble = (WIFI_PREAMBLE_SHORT == event->GetPreambleType ());  
@@ -839,7 +919,7 @@ YansWifiPhy::EndReceive (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> even
     } 
   else 
     {
-	    //std::cout << myAddr << " failed.\n";
+	    //std::cout << GetAddress () << " failed.\n";
       /* failure. */
       NotifyRxDrop (packet);
       m_state->SwitchFromRxEndError (packet, snrPer.snr);
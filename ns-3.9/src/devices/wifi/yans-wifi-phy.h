@@ -35,6 +35,7 @@
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
+#include "ns3/mac48-address.h"
 
 
 namespace ns3 {
@@ -99,6 +100,19 @@ public:
                            double rxPowerDbm,
                            WifiMode mode,
                            WifiPreamble preamble);
+  /**
+   * \param size the size of the interfering frame
+   * \param rxPowerDbm the power received from it
+   * \param mode the mode it is sent with
+   * \param preamble its preamble
+   *
+   * Account for the energy of a frame which this PHY cannot receive,
+   * such as a frame sent on an adjacent channel.
+   */
+  void StartReceiveInterference (uint32_t size,
+                                 double rxPowerDbm,
+                                 WifiMode mode,
+                                 WifiPreamble preamble);
 
   void SetRxNoiseFigure (double noiseFigureDb);
   void SetTxPowerStart (double start);
@@ -106,12 +120,22 @@ public:
   void SetNTxPower (uint32_t n);
   void SetEdThreshold (double threshold);
   void SetCcaMode1Threshold (double threshold);
+  /**
+   * \param threshold the power (dbm) below which incoming signals are
+   *        folded into the background noise of the receiver
+   *
+   * Such signals are never locked onto, and are not tracked as distinct
+   * interference events. Their energy adds to a background noise which
+   * is assumed constant during the reception of a frame.
+   */
+  void SetInterferenceFloor (double threshold);
   void SetErrorRateModel (Ptr<ErrorRateModel> rate);
   void SetDevice (Ptr<Object> device);
   void SetMobility (Ptr<Object> mobility);
   double GetRxNoiseFigure (void) const;
   double GetEdThreshold (void) const;
   double GetCcaMode1Threshold (void) const;
+  double GetInterferenceFloor (void) const;
   Ptr<ErrorRateModel> GetErrorRateModel (void) const;
   Ptr<Object> GetDevice (void) const;
   Ptr<Object> GetMobility (void);
@@ -162,11 +186,14 @@ private:
   double RatioToDb (double ratio) const;
   double GetPowerDbm (uint8_t power) const;
   void EndReceive (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> event);
+  Mac48Address GetAddress (void);
+  bool IsAddressedToMe (Ptr<const Packet> packet);
 
 private:
   uint16_t m_ExtendedRateMode;
   double   m_edThresholdW;
   double   m_ccaMode1ThresholdW;
+  double   m_interferenceFloorW;
   double   m_txPowerBaseDbm;
   double   m_txPowerEndDbm;
   uint32_t m_nTxPower;
@@ -223,6 +250,9 @@ private:
   Ptr<WifiPhyStateHelper> m_state;
   InterferenceHelper m_interference;
   Time m_channelSwitchDelay;
+  // address of m_device, looked up on the first reception
+  Mac48Address m_address;
+  bool m_addressValid;
 
 };
 
@@ -0,0 +1,470 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "flyway-channel-assigner.h"
+#include "flyway-feasibility-engine.h"
+#include "flyways-topo-helper.h"
+#include <cstdio>
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE ("FlywayChannelAssignerTest");
+
+namespace ns3 {
+
+static const double g_rssiLimitsDbm[] = {-66, -64, -63, -62, -60, -58, -56, -54, -53, -51, -49, -47};
+static const double g_rates[] = {.693, .86625, 1.386, 1.73250, 2.079, 2.772, 3.465, 4.158, 4.5045, 5.1975, 6.237, 6.75675};
+static const uint32_t g_nRates = 12;
+
+typedef FlywayChannelAssigner::Flyway Flyway;
+
+static FlywaysTopoHelper *
+CreateTopology (std::string dir, uint32_t dongles)
+{
+  std::string name = dir + "flyway-channel-assigner-topo.dat";
+  FILE *f = fopen (name.c_str (), "w");
+  NS_ASSERT (f != 0);
+  fprintf (f, "NUM-TORS: 40\n"
+           "Agg2L3_Bandwidth:40Gbps\n"
+           "Tor2Agg_Bandwidth:10Gbps\n"
+           "AggFanOut: 40\n"
+           "L3FanOut:2\n"
+           "DonglesPerTor: %u\n"
+           "DonglesPerAgg: 0\n"
+           "DonglesPerL3: 0\n"
+           "FlywayBandwidth: 1Gbps\n"
+           "Antenna: 1\n"
+           "ScaleDownBy: 1\n"
+           "RackWidth: 0.57\n"
+           "RackHeight: 0.78\n"
+           "ClumpNumRacks: 10\n"
+           "ClumpSpaceLeft: 3\n"
+           "ClumpSpaceBelow: 1.8\n"
+           "Arrangement: Square\n", dongles);
+  fclose (f);
+
+  InternetStackHelper stack;
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  FlywaysTopoHelper *topo = new FlywaysTopoHelper (const_cast<char *> (name.c_str ()), stack, address);
+  remove (name.c_str ());
+  for (int i = 0; i < topo->GetNumFlyways (); ++i)
+    {
+      for (uint32_t j = 0; j < topo->GetNumDongles (); ++j)
+        {
+          topo->PointNowhere (i, j);
+          topo->SetAntennaGain (i, j, 23);
+        }
+    }
+  return topo;
+}
+
+static void
+SetRates (FlywayFeasibilityEngine *engine)
+{
+  engine->SetRates (std::vector<double> (g_rssiLimitsDbm, g_rssiLimitsDbm + g_nRates),
+                    std::vector<double> (g_rates, g_rates + g_nRates));
+}
+
+static Flyway
+MakeFlyway (uint32_t from, uint32_t to)
+{
+  Flyway f;
+  f.from = from;
+  f.dongleFrom = -1;
+  f.to = to;
+  f.dongleTo = -1;
+  f.channel = -1;
+  return f;
+}
+
+static uint32_t
+NextNode (uint32_t *seed, uint32_t n)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 8) % n;
+}
+
+
+class FlywayChannelAssignerGreedyTest : public TestCase
+{
+public:
+  FlywayChannelAssignerGreedyTest ();
+  virtual ~FlywayChannelAssignerGreedyTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywayChannelAssignerGreedyTest::FlywayChannelAssignerGreedyTest ()
+  : TestCase ("Greedy assignment matches the round robin of num-flyways-new")
+{}
+
+FlywayChannelAssignerGreedyTest::~FlywayChannelAssignerGreedyTest ()
+{}
+
+bool
+FlywayChannelAssignerGreedyTest::DoRun (void)
+{
+  FlywaysTopoHelper *topo = CreateTopology (GetTempDir (), 2);
+  double rssiThreshold = -62;
+  uint32_t numChannels = 3;
+
+  FlywayFeasibilityEngine engine (topo);
+  engine.SetRssiThreshold (rssiThreshold);
+  SetRates (&engine);
+  FlywayChannelAssigner assigner (topo, &engine);
+  assigner.SetNumChannels (numChannels);
+
+  // The reference keeps its own flyways in a second engine, giving a
+  // dongle by count and trying the channels from a cursor which moves on
+  // with every flyway kept.
+  FlywayFeasibilityEngine reference (topo);
+  reference.SetRssiThreshold (rssiThreshold);
+  SetRates (&reference);
+  std::vector<uint32_t> dongles (topo->GetNumToRs (), 0);
+  std::vector<std::set<uint32_t> > busy (numChannels);
+  uint32_t cursor = 0;
+  uint32_t seed = 4321;
+  uint32_t kept = 0;
+  uint32_t failures[FlywayChannelAssigner::INFEASIBLE + 1] = {0};
+
+  for (uint32_t k = 0; k < 600; k++)
+    {
+      uint32_t from = NextNode (&seed, topo->GetNumToRs ());
+      uint32_t to = NextNode (&seed, topo->GetNumToRs ());
+      enum FlywayChannelAssigner::Failure expected = FlywayChannelAssigner::NONE;
+      int32_t channel = -1;
+      if (from == to)
+        {
+          expected = FlywayChannelAssigner::SAME_ENDPOINTS;
+        }
+      else if (dongles[from] >= topo->GetNumDongles () || dongles[to] >= topo->GetNumDongles ())
+        {
+          expected = FlywayChannelAssigner::NO_FREE_DONGLE;
+        }
+      else
+        {
+          bool free = false;
+          for (uint32_t c = 0; c < numChannels && !free; c++)
+            {
+              free = busy[c].count (from) == 0 && busy[c].count (to) == 0;
+            }
+          topo->PointAtEachOther (from, dongles[from], to, dongles[to]);
+          if (!free)
+            {
+              expected = FlywayChannelAssigner::NO_FREE_CHANNEL;
+            }
+          else if (topo->CalcSignalStrength (from, dongles[from], to, dongles[to]) < rssiThreshold + 3)
+            {
+              expected = FlywayChannelAssigner::TOO_WEAK;
+            }
+          else
+            {
+              std::vector<double> rates;
+              for (uint32_t c = 0; c < numChannels && channel < 0; c++)
+                {
+                  uint32_t d = (c + cursor) % numChannels;
+                  if (busy[d].count (from) != 0 || busy[d].count (to) != 0)
+                    {
+                      continue;
+                    }
+                  reference.Add (from, dongles[from], to, dongles[to], d);
+                  if (reference.IsFeasible (&rates))
+                    {
+                      channel = d;
+                    }
+                  else
+                    {
+                      reference.Remove (reference.GetN () - 1);
+                    }
+                }
+              expected = channel < 0 ? FlywayChannelAssigner::INFEASIBLE : FlywayChannelAssigner::NONE;
+            }
+        }
+
+      bool added = assigner.Add (std::vector<Flyway> (1, MakeFlyway (from, to)));
+      NS_TEST_EXPECT_MSG_EQ (added, (expected == FlywayChannelAssigner::NONE), "Flyway " << k << " decided differently");
+      if (!added)
+        {
+          NS_TEST_EXPECT_MSG_EQ (assigner.GetFailure (), expected, "Wrong reason for flyway " << k);
+          failures[assigner.GetFailure ()]++;
+          continue;
+        }
+      NS_TEST_EXPECT_MSG_EQ (assigner.GetN (), kept + 1, "Wrong number of flyways");
+      const Flyway &f = assigner.Get (kept);
+      NS_TEST_EXPECT_MSG_EQ (f.channel, channel, "Flyway " << k << " is on another channel");
+      NS_TEST_EXPECT_MSG_EQ (f.dongleFrom, (int32_t)dongles[from], "Wrong dongle at " << from);
+      NS_TEST_EXPECT_MSG_EQ (f.dongleTo, (int32_t)dongles[to], "Wrong dongle at " << to);
+      busy[channel].insert (from);
+      busy[channel].insert (to);
+      dongles[from]++;
+      dongles[to]++;
+      cursor = (cursor + 1) % numChannels;
+      kept++;
+    }
+  NS_TEST_EXPECT_MSG_EQ ((kept > 10), true, "Too few flyways to exercise the assigner");
+  NS_TEST_EXPECT_MSG_EQ ((failures[FlywayChannelAssigner::NO_FREE_DONGLE] > 0), true, "No flyway ran out of dongles");
+  NS_TEST_EXPECT_MSG_EQ ((failures[FlywayChannelAssigner::INFEASIBLE] > 0), true, "No flyway hurt the others");
+
+  std::vector<double> rates, expectedRates;
+  NS_TEST_EXPECT_MSG_EQ (assigner.GetRates (&rates), true, "The flyways kept are not feasible");
+  reference.IsFeasible (&expectedRates);
+  NS_TEST_EXPECT_MSG_EQ ((rates == expectedRates), true, "Rates differ from the reference");
+
+  delete topo;
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+
+
+class FlywayChannelAssignerStrategyTest : public TestCase
+{
+public:
+  FlywayChannelAssignerStrategyTest (std::string strategy);
+  virtual ~FlywayChannelAssignerStrategyTest ();
+
+private:
+  virtual bool DoRun (void);
+  void CheckAssignment (const FlywayChannelAssigner &assigner);
+  void CheckOrder (FlywaysTopoHelper *topo, const std::vector<Flyway> &kept,
+                   const std::vector<Flyway> &batch, const std::vector<Flyway> &assignment,
+                   const std::vector<double> &rates);
+
+  std::string m_strategy;
+};
+
+FlywayChannelAssignerStrategyTest::FlywayChannelAssignerStrategyTest (std::string strategy)
+  : TestCase (strategy + " gives five channels and four dongles per node to batches of flyways"),
+    m_strategy (strategy)
+{}
+
+FlywayChannelAssignerStrategyTest::~FlywayChannelAssignerStrategyTest ()
+{}
+
+void
+FlywayChannelAssignerStrategyTest::CheckAssignment (const FlywayChannelAssigner &assigner)
+{
+  std::set<std::pair<uint32_t, int32_t> > channels, dongles;
+  for (uint32_t i = 0; i < assigner.GetN (); i++)
+    {
+      const Flyway &f = assigner.Get (i);
+      NS_TEST_EXPECT_MSG_EQ ((f.channel >= 0 && (uint32_t)f.channel < assigner.GetNumChannels ()), true,
+                             "Flyway " << i << " has no channel");
+      NS_TEST_EXPECT_MSG_EQ (channels.insert (std::make_pair (f.from, f.channel)).second, true,
+                             "Node " << f.from << " uses channel " << f.channel << " twice");
+      NS_TEST_EXPECT_MSG_EQ (channels.insert (std::make_pair (f.to, f.channel)).second, true,
+                             "Node " << f.to << " uses channel " << f.channel << " twice");
+      NS_TEST_EXPECT_MSG_EQ (dongles.insert (std::make_pair (f.from, f.dongleFrom)).second, true,
+                             "Node " << f.from << " uses dongle " << f.dongleFrom << " twice");
+      NS_TEST_EXPECT_MSG_EQ (dongles.insert (std::make_pair (f.to, f.dongleTo)).second, true,
+                             "Node " << f.to << " uses dongle " << f.dongleTo << " twice");
+    }
+  std::vector<double> rates;
+  NS_TEST_EXPECT_MSG_EQ (assigner.GetRates (&rates), true, "The flyways kept are not feasible");
+}
+
+void
+FlywayChannelAssignerStrategyTest::CheckOrder (FlywaysTopoHelper *topo, const std::vector<Flyway> &kept,
+                                               const std::vector<Flyway> &batch,
+                                               const std::vector<Flyway> &assignment,
+                                               const std::vector<double> &rates)
+{
+  // The assignment lists the batch in its own order, whatever order the
+  // strategy placed it in, and the rates follow the assignment.
+  FlywayFeasibilityEngine reference (topo);
+  reference.SetRssiThreshold (-62);
+  SetRates (&reference);
+  for (uint32_t i = 0; i < assignment.size (); i++)
+    {
+      const Flyway &f = assignment[i];
+      const Flyway &expected = i < kept.size () ? kept[i] : batch[i - kept.size ()];
+      NS_TEST_EXPECT_MSG_EQ (f.from, expected.from, "Flyway " << i << " of the assignment is out of order");
+      NS_TEST_EXPECT_MSG_EQ (f.to, expected.to, "Flyway " << i << " of the assignment is out of order");
+      reference.Add (f.from, f.dongleFrom, f.to, f.dongleTo, f.channel);
+    }
+  std::vector<double> expectedRates;
+  NS_TEST_EXPECT_MSG_EQ (reference.IsFeasible (&expectedRates), true, "The assignment is not feasible");
+  NS_TEST_EXPECT_MSG_EQ ((rates == expectedRates), true, "The rates are not those of the assignment");
+}
+
+bool
+FlywayChannelAssignerStrategyTest::DoRun (void)
+{
+  FlywaysTopoHelper *topo = CreateTopology (GetTempDir (), 4);
+  FlywayFeasibilityEngine engine (topo);
+  engine.SetRssiThreshold (-62);
+  SetRates (&engine);
+  FlywayChannelAssigner assigner (topo, &engine);
+  assigner.SetNumChannels (5);
+  assigner.SetStrategy (m_strategy);
+
+  uint32_t seed = 98765;
+  uint32_t added = 0;
+  uint32_t checked = 0;
+  for (uint32_t k = 0; k < 60; k++)
+    {
+      // batches of three flyways which share a node, so that they
+      // conflict with each other as well as with those kept
+      uint32_t hub = NextNode (&seed, topo->GetNumToRs ());
+      std::vector<Flyway> batch;
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          batch.push_back (MakeFlyway (hub, NextNode (&seed, topo->GetNumToRs ())));
+        }
+
+      std::vector<Flyway> before;
+      for (uint32_t i = 0; i < assigner.GetN (); i++)
+        {
+          before.push_back (assigner.Get (i));
+        }
+      std::vector<Flyway> assignment;
+      std::vector<double> rates;
+      bool feasible = assigner.Check (batch, &assignment, &rates);
+      NS_TEST_EXPECT_MSG_EQ (assigner.GetN (), before.size (), "Check kept flyways");
+      for (uint32_t i = 0; i < before.size () && i < assigner.GetN (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (assigner.Get (i).channel, before[i].channel, "Check moved flyway " << i);
+        }
+      NS_TEST_EXPECT_MSG_EQ (engine.GetN (), before.size (), "Check left flyways in the engine");
+      if (feasible)
+        {
+          checked++;
+          NS_TEST_EXPECT_MSG_EQ (assignment.size (), before.size () + batch.size (), "Wrong assignment size");
+          NS_TEST_EXPECT_MSG_EQ (rates.size (), assignment.size (), "Wrong number of rates");
+          CheckOrder (topo, before, batch, assignment, rates);
+        }
+
+      if (assigner.Add (batch))
+        {
+          added++;
+          NS_TEST_EXPECT_MSG_EQ (assigner.GetN (), before.size () + batch.size (), "Batch not kept");
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_EQ ((assigner.GetFailure () != FlywayChannelAssigner::NONE), true, "No reason given");
+          NS_TEST_EXPECT_MSG_EQ (assigner.GetN (), before.size (), "Part of a failed batch was kept");
+        }
+      CheckAssignment (assigner);
+    }
+  NS_TEST_EXPECT_MSG_EQ ((added > 3), true, "Too few batches added");
+  NS_TEST_EXPECT_MSG_EQ ((checked > 3), true, "Too few batches checked");
+
+  std::vector<Flyway> same (1, MakeFlyway (1, 1));
+  NS_TEST_EXPECT_MSG_EQ (assigner.Add (same), false, "A flyway needs two nodes");
+  NS_TEST_EXPECT_MSG_EQ (assigner.GetFailure (), FlywayChannelAssigner::SAME_ENDPOINTS, "Wrong reason");
+
+  delete topo;
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+
+
+/**
+ * DSatur places first the flyways which conflict with the most others,
+ * so a batch whose first flyway conflicts with none is placed out of
+ * order. Check must still report it, and its rates, in batch order.
+ */
+class FlywayChannelAssignerOrderTest : public TestCase
+{
+public:
+  FlywayChannelAssignerOrderTest ();
+  virtual ~FlywayChannelAssignerOrderTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywayChannelAssignerOrderTest::FlywayChannelAssignerOrderTest ()
+  : TestCase ("Check reports a batch placed out of order in batch order")
+{}
+
+FlywayChannelAssignerOrderTest::~FlywayChannelAssignerOrderTest ()
+{}
+
+bool
+FlywayChannelAssignerOrderTest::DoRun (void)
+{
+  FlywaysTopoHelper *topo = CreateTopology (GetTempDir (), 2);
+  FlywayFeasibilityEngine engine (topo);
+  engine.SetRssiThreshold (-62);
+  // Coarse rates, so that short and long flyways get different ones.
+  double limits[] = {-20, -5, 5};
+  double coarse[] = {1, 2, 3};
+  engine.SetRates (std::vector<double> (limits, limits + 3), std::vector<double> (coarse, coarse + 3));
+  FlywayChannelAssigner assigner (topo, &engine);
+  assigner.SetNumChannels (3);
+  assigner.SetStrategy ("ns3::DsaturFlywayChannelStrategy");
+
+  std::vector<Flyway> batch;
+  batch.push_back (MakeFlyway (0, 39));
+  batch.push_back (MakeFlyway (10, 11));
+  batch.push_back (MakeFlyway (10, 21));
+  std::vector<Flyway> assignment;
+  std::vector<double> rates;
+  NS_TEST_ASSERT_MSG_EQ (assigner.Check (batch, &assignment, &rates), true, "The batch is not feasible");
+  NS_TEST_ASSERT_MSG_EQ (assignment.size (), batch.size (), "Wrong assignment size");
+  NS_TEST_ASSERT_MSG_EQ (rates.size (), batch.size (), "Wrong number of rates");
+  for (uint32_t j = 0; j < batch.size (); j++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (assignment[j].from, batch[j].from, "Flyway " << j << " is out of order");
+      NS_TEST_EXPECT_MSG_EQ (assignment[j].to, batch[j].to, "Flyway " << j << " is out of order");
+    }
+
+  // Once kept, the flyways are in the order they were placed.
+  NS_TEST_ASSERT_MSG_EQ (assigner.Add (batch), true, "The batch was not added");
+  uint32_t placed[] = {1, 2, 0};
+  std::vector<double> placedRates;
+  assigner.GetRates (&placedRates);
+  for (uint32_t i = 0; i < batch.size (); i++)
+    {
+      const Flyway &f = assigner.Get (i);
+      uint32_t j = placed[i];
+      NS_TEST_EXPECT_MSG_EQ (f.from, batch[j].from, "Flyway " << j << " was not placed " << i << "th");
+      NS_TEST_EXPECT_MSG_EQ (f.to, batch[j].to, "Flyway " << j << " was not placed " << i << "th");
+      NS_TEST_EXPECT_MSG_EQ (f.channel, assignment[j].channel, "Flyway " << j << " moved");
+      NS_TEST_EXPECT_MSG_EQ (placedRates[i], rates[j], "Rate of flyway " << j << " was reported for another");
+    }
+  // The rates differ, or the test could not tell them apart.
+  NS_TEST_EXPECT_MSG_EQ ((rates[0] != rates[1] || rates[0] != rates[2]), true, "All the rates are the same");
+
+  delete topo;
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+
+
+class FlywayChannelAssignerTestSuite : public TestSuite
+{
+public:
+  FlywayChannelAssignerTestSuite ();
+};
+
+FlywayChannelAssignerTestSuite::FlywayChannelAssignerTestSuite ()
+  : TestSuite ("helper-flyway-channel-assigner", UNIT)
+{
+  AddTestCase (new FlywayChannelAssignerGreedyTest);
+  AddTestCase (new FlywayChannelAssignerStrategyTest ("ns3::GreedyFlywayChannelStrategy"));
+  AddTestCase (new FlywayChannelAssignerStrategyTest ("ns3::DsaturFlywayChannelStrategy"));
+  AddTestCase (new FlywayChannelAssignerStrategyTest ("ns3::AnnealingFlywayChannelStrategy"));
+  AddTestCase (new FlywayChannelAssignerOrderTest);
+}
+
+FlywayChannelAssignerTestSuite g_flywayChannelAssignerTestSuite;
+
+} // namespace ns3
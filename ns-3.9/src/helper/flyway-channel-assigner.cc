@@ -0,0 +1,636 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "flyway-channel-assigner.h"
+#include "flyway-feasibility-engine.h"
+#include "flyways-topo-helper.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("FlywayChannelAssigner");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (FlywayChannelStrategy);
+NS_OBJECT_ENSURE_REGISTERED (GreedyFlywayChannelStrategy);
+NS_OBJECT_ENSURE_REGISTERED (DsaturFlywayChannelStrategy);
+NS_OBJECT_ENSURE_REGISTERED (AnnealingFlywayChannelStrategy);
+
+TypeId
+FlywayChannelStrategy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FlywayChannelStrategy")
+    .SetParent<Object> ()
+    ;
+  return tid;
+}
+
+FlywayChannelStrategy::~FlywayChannelStrategy ()
+{}
+
+TypeId
+GreedyFlywayChannelStrategy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::GreedyFlywayChannelStrategy")
+    .SetParent<FlywayChannelStrategy> ()
+    .AddConstructor<GreedyFlywayChannelStrategy> ()
+    ;
+  return tid;
+}
+
+GreedyFlywayChannelStrategy::GreedyFlywayChannelStrategy ()
+  : m_next (0)
+{}
+
+bool
+GreedyFlywayChannelStrategy::Assign (FlywayChannelAssigner *assigner, bool commit)
+{
+  uint32_t n = assigner->GetNumChannels ();
+  uint32_t next = m_next;
+  for (uint32_t j = 0; j < assigner->GetNPending (); j++)
+    {
+      bool placed = false;
+      for (uint32_t c = 0; c < n && !placed; c++)
+        {
+          uint32_t channel = (c + next) % n;
+          if (!assigner->IsFree (j, channel))
+            {
+              continue;
+            }
+          assigner->Place (j, channel);
+          placed = assigner->IsFeasible ();
+          if (!placed)
+            {
+              assigner->Unplace (j);
+            }
+        }
+      if (!placed)
+        {
+          return false;
+        }
+      next = (next + 1) % n;
+    }
+  if (commit)
+    {
+      m_next = next;
+    }
+  return true;
+}
+
+TypeId
+DsaturFlywayChannelStrategy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DsaturFlywayChannelStrategy")
+    .SetParent<FlywayChannelStrategy> ()
+    .AddConstructor<DsaturFlywayChannelStrategy> ()
+    ;
+  return tid;
+}
+
+bool
+DsaturFlywayChannelStrategy::Assign (FlywayChannelAssigner *assigner, bool commit)
+{
+  uint32_t n = assigner->GetNumChannels ();
+  uint32_t k = assigner->GetNPending ();
+  for (uint32_t placed = 0; placed < k; placed++)
+    {
+      int32_t next = -1;
+      uint32_t nextSaturation = 0;
+      uint32_t nextDegree = 0;
+      for (uint32_t j = 0; j < k; j++)
+        {
+          const FlywayChannelAssigner::Flyway &f = assigner->GetPending (j);
+          if (f.channel >= 0)
+            {
+              continue;
+            }
+          uint32_t saturation = 0;
+          for (uint32_t c = 0; c < n; c++)
+            {
+              if (!assigner->IsFree (j, c))
+                {
+                  saturation++;
+                }
+            }
+          uint32_t degree = 0;
+          for (uint32_t i = 0; i < k; i++)
+            {
+              const FlywayChannelAssigner::Flyway &g = assigner->GetPending (i);
+              if (i != j && g.channel < 0
+                  && (g.from == f.from || g.from == f.to || g.to == f.from || g.to == f.to))
+                {
+                  degree++;
+                }
+            }
+          if (next < 0 || saturation > nextSaturation
+              || (saturation == nextSaturation && degree > nextDegree))
+            {
+              next = j;
+              nextSaturation = saturation;
+              nextDegree = degree;
+            }
+        }
+
+      int32_t channel = -1;
+      double channelRate = 0;
+      for (uint32_t c = 0; c < n; c++)
+        {
+          if (!assigner->IsFree (next, c))
+            {
+              continue;
+            }
+          assigner->Place (next, c);
+          uint32_t infeasible;
+          double rate = assigner->Evaluate (&infeasible);
+          assigner->Unplace (next);
+          if (infeasible == 0 && (channel < 0 || rate > channelRate))
+            {
+              channel = c;
+              channelRate = rate;
+            }
+        }
+      if (channel < 0)
+        {
+          return false;
+        }
+      assigner->Place (next, channel);
+    }
+  return true;
+}
+
+TypeId
+AnnealingFlywayChannelStrategy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AnnealingFlywayChannelStrategy")
+    .SetParent<FlywayChannelStrategy> ()
+    .AddConstructor<AnnealingFlywayChannelStrategy> ()
+    .AddAttribute ("Iterations",
+                   "The number of moves tried for each batch of flyways.",
+                   UintegerValue (1000),
+                   MakeUintegerAccessor (&AnnealingFlywayChannelStrategy::m_iterations),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("InitialTemperature",
+                   "The temperature of the first move, in units of rate.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&AnnealingFlywayChannelStrategy::m_initialTemperature),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("Cooling",
+                   "The factor applied to the temperature after each move.",
+                   DoubleValue (0.995),
+                   MakeDoubleAccessor (&AnnealingFlywayChannelStrategy::m_cooling),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("InfeasiblePenalty",
+                   "The cost of each infeasible flyway, in units of rate.",
+                   DoubleValue (100.0),
+                   MakeDoubleAccessor (&AnnealingFlywayChannelStrategy::m_infeasiblePenalty),
+                   MakeDoubleChecker<double> (0))
+    ;
+  return tid;
+}
+
+AnnealingFlywayChannelStrategy::AnnealingFlywayChannelStrategy ()
+  : m_random (0, 1)
+{}
+
+double
+AnnealingFlywayChannelStrategy::Cost (FlywayChannelAssigner *assigner) const
+{
+  uint32_t infeasible;
+  double rate = assigner->Evaluate (&infeasible);
+  return infeasible * m_infeasiblePenalty - rate;
+}
+
+bool
+AnnealingFlywayChannelStrategy::Assign (FlywayChannelAssigner *assigner, bool commit)
+{
+  uint32_t n = assigner->GetNumChannels ();
+  uint32_t k = assigner->GetNPending ();
+  if (k == 0)
+    {
+      return true;
+    }
+  for (uint32_t j = 0; j < k; j++)
+    {
+      uint32_t c = 0;
+      while (c < n && !assigner->IsFree (j, c))
+        {
+          c++;
+        }
+      if (c == n)
+        {
+          return false;
+        }
+      assigner->Place (j, c);
+    }
+
+  std::vector<uint32_t> best (k);
+  for (uint32_t j = 0; j < k; j++)
+    {
+      best[j] = assigner->GetPending (j).channel;
+    }
+  double cost = Cost (assigner);
+  double bestCost = cost;
+  double temperature = m_initialTemperature;
+  std::vector<uint32_t> options;
+  for (uint32_t i = 0; i < m_iterations; i++, temperature *= m_cooling)
+    {
+      uint32_t j = m_random.GetInteger (0, k - 1);
+      uint32_t current = assigner->GetPending (j).channel;
+      options.clear ();
+      for (uint32_t c = 0; c < n; c++)
+        {
+          if (c != current && assigner->IsFree (j, c))
+            {
+              options.push_back (c);
+            }
+        }
+      if (options.empty ())
+        {
+          continue;
+        }
+      assigner->Unplace (j);
+      assigner->Place (j, options[m_random.GetInteger (0, options.size () - 1)]);
+      double moved = Cost (assigner);
+      double delta = moved - cost;
+      if (delta <= 0 || (temperature > 0 && m_random.GetValue () < std::exp (-delta / temperature)))
+        {
+          cost = moved;
+          if (cost < bestCost)
+            {
+              bestCost = cost;
+              for (uint32_t l = 0; l < k; l++)
+                {
+                  best[l] = assigner->GetPending (l).channel;
+                }
+            }
+        }
+      else
+        {
+          assigner->Unplace (j);
+          assigner->Place (j, current);
+        }
+    }
+
+  for (uint32_t j = 0; j < k; j++)
+    {
+      assigner->Unplace (j);
+    }
+  for (uint32_t j = 0; j < k; j++)
+    {
+      assigner->Place (j, best[j]);
+    }
+  uint32_t infeasible;
+  assigner->Evaluate (&infeasible);
+  return infeasible == 0;
+}
+
+
+FlywayChannelAssigner::FlywayChannelAssigner (FlywaysTopoHelper *topo, FlywayFeasibilityEngine *engine)
+  : m_topo (topo),
+    m_engine (engine),
+    m_numChannels (3),
+    m_failure (NONE)
+{
+  NS_ASSERT (m_engine->GetN () == 0);
+  SetStrategy ("ns3::GreedyFlywayChannelStrategy");
+}
+
+void
+FlywayChannelAssigner::SetNumChannels (uint32_t n)
+{
+  NS_ASSERT (n > 0 && m_flyways.empty ());
+  m_numChannels = n;
+  m_busyChannels.clear ();
+}
+
+uint32_t
+FlywayChannelAssigner::GetNumChannels (void) const
+{
+  return m_numChannels;
+}
+
+void
+FlywayChannelAssigner::SetStrategy (std::string type,
+                                    std::string n0, const AttributeValue &v0,
+                                    std::string n1, const AttributeValue &v1,
+                                    std::string n2, const AttributeValue &v2,
+                                    std::string n3, const AttributeValue &v3)
+{
+  m_strategyFactory = ObjectFactory ();
+  m_strategyFactory.SetTypeId (type);
+  m_strategyFactory.Set (n0, v0);
+  m_strategyFactory.Set (n1, v1);
+  m_strategyFactory.Set (n2, v2);
+  m_strategyFactory.Set (n3, v3);
+  m_strategy = m_strategyFactory.Create<FlywayChannelStrategy> ();
+}
+
+Ptr<FlywayChannelStrategy>
+FlywayChannelAssigner::GetStrategy (void) const
+{
+  return m_strategy;
+}
+
+bool
+FlywayChannelAssigner::Add (const std::vector<struct Flyway> &batch)
+{
+  return Run (batch, true, 0, 0);
+}
+
+bool
+FlywayChannelAssigner::Check (const std::vector<struct Flyway> &batch,
+                              std::vector<struct Flyway> *assignment, std::vector<double> *rates)
+{
+  return Run (batch, false, assignment, rates);
+}
+
+enum FlywayChannelAssigner::Failure
+FlywayChannelAssigner::GetFailure (void) const
+{
+  return m_failure;
+}
+
+void
+FlywayChannelAssigner::Clear (void)
+{
+  m_engine->Clear ();
+  m_flyways.clear ();
+  m_busyChannels.clear ();
+  m_busyDongles.clear ();
+}
+
+uint32_t
+FlywayChannelAssigner::GetN (void) const
+{
+  return m_flyways.size ();
+}
+
+const struct FlywayChannelAssigner::Flyway &
+FlywayChannelAssigner::Get (uint32_t i) const
+{
+  return m_flyways[i];
+}
+
+bool
+FlywayChannelAssigner::GetRates (std::vector<double> *rates) const
+{
+  return m_engine->IsFeasible (rates);
+}
+
+bool
+FlywayChannelAssigner::Run (const std::vector<struct Flyway> &batch, bool commit,
+                            std::vector<struct Flyway> *assignment, std::vector<double> *rates)
+{
+  NS_LOG_FUNCTION (this << batch.size () << commit);
+  m_pending = batch;
+  uint32_t kept = m_flyways.size ();
+  bool assigned = Prepare ();
+  if (assigned)
+    {
+      assigned = m_strategy->Assign (this, commit);
+      if (!assigned)
+        {
+          m_failure = INFEASIBLE;
+        }
+    }
+  if (assigned && (assignment != 0 || rates != 0))
+    {
+      // The strategy may have placed the batch in any order, while the
+      // caller expects it in its own.
+      std::vector<double> placedRates;
+      m_engine->IsFeasible (&placedRates);
+      std::vector<struct Flyway> ordered (m_flyways.begin (), m_flyways.begin () + kept);
+      std::vector<double> orderedRates (placedRates.begin (), placedRates.begin () + kept);
+      for (uint32_t j = 0; j < m_pending.size (); j++)
+        {
+          uint32_t i = FindPlaced (j);
+          ordered.push_back (m_flyways[i]);
+          orderedRates.push_back (placedRates[i]);
+        }
+      if (assignment != 0)
+        {
+          *assignment = ordered;
+        }
+      if (rates != 0)
+        {
+          *rates = orderedRates;
+        }
+    }
+  if (!assigned || !commit)
+    {
+      for (uint32_t j = m_pending.size (); j-- > 0; )
+        {
+          if (m_pending[j].channel >= 0)
+            {
+              Unplace (j);
+            }
+        }
+      Release ();
+    }
+  m_pending.clear ();
+  m_allocated.clear ();
+  return assigned;
+}
+
+int32_t
+FlywayChannelAssigner::FindFreeDongle (uint32_t node) const
+{
+  for (uint32_t d = 0; d < m_topo->GetNumDongles (); d++)
+    {
+      if (node >= m_busyDongles.size () || d >= m_busyDongles[node].size ()
+          || !m_busyDongles[node][d])
+        {
+          return d;
+        }
+    }
+  return -1;
+}
+
+bool
+FlywayChannelAssigner::Prepare (void)
+{
+  m_failure = NONE;
+  m_busyDongles.resize (std::max<uint32_t> (m_busyDongles.size (), m_topo->GetNumNodes ()));
+  m_busyChannels.resize (std::max<uint32_t> (m_busyChannels.size (), m_topo->GetNumNodes ()));
+  for (uint32_t j = 0; j < m_pending.size (); j++)
+    {
+      struct Flyway &f = m_pending[j];
+      f.channel = -1;
+      if (f.from == f.to)
+        {
+          m_failure = SAME_ENDPOINTS;
+          return false;
+        }
+      uint32_t node[2] = {f.from, f.to};
+      int32_t *dongle[2] = {&f.dongleFrom, &f.dongleTo};
+      for (uint32_t e = 0; e < 2; e++)
+        {
+          std::vector<bool> &busy = m_busyDongles[node[e]];
+          if (*dongle[e] < 0)
+            {
+              *dongle[e] = FindFreeDongle (node[e]);
+            }
+          else if ((uint32_t)*dongle[e] >= m_topo->GetNumDongles ()
+                   || ((uint32_t)*dongle[e] < busy.size () && busy[*dongle[e]]))
+            {
+              *dongle[e] = -1;
+            }
+          if (*dongle[e] < 0)
+            {
+              m_failure = NO_FREE_DONGLE;
+              return false;
+            }
+          if (busy.size () <= (uint32_t)*dongle[e])
+            {
+              busy.resize (*dongle[e] + 1, false);
+            }
+          busy[*dongle[e]] = true;
+          m_allocated.push_back (std::make_pair (node[e], *dongle[e]));
+        }
+    }
+  for (uint32_t j = 0; j < m_pending.size (); j++)
+    {
+      bool free = false;
+      for (uint32_t c = 0; c < m_numChannels && !free; c++)
+        {
+          free = IsFree (j, c);
+        }
+      if (!free)
+        {
+          m_failure = NO_FREE_CHANNEL;
+          return false;
+        }
+    }
+  double weakest = m_engine->GetRssiThreshold () + m_engine->GetMargin ();
+  for (uint32_t j = 0; j < m_pending.size (); j++)
+    {
+      const struct Flyway &f = m_pending[j];
+      m_topo->PointAtEachOther (f.from, f.dongleFrom, f.to, f.dongleTo);
+      if (m_topo->CalcSignalStrength (f.from, f.dongleFrom, f.to, f.dongleTo) < weakest)
+        {
+          m_failure = TOO_WEAK;
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+FlywayChannelAssigner::Release (void)
+{
+  for (uint32_t i = 0; i < m_allocated.size (); i++)
+    {
+      m_busyDongles[m_allocated[i].first][m_allocated[i].second] = false;
+    }
+}
+
+uint32_t
+FlywayChannelAssigner::GetNPending (void) const
+{
+  return m_pending.size ();
+}
+
+const struct FlywayChannelAssigner::Flyway &
+FlywayChannelAssigner::GetPending (uint32_t j) const
+{
+  return m_pending[j];
+}
+
+bool
+FlywayChannelAssigner::IsFree (uint32_t j, uint32_t channel) const
+{
+  const struct Flyway &f = m_pending[j];
+  const std::vector<bool> &from = m_busyChannels[f.from];
+  const std::vector<bool> &to = m_busyChannels[f.to];
+  return (channel >= from.size () || !from[channel])
+    && (channel >= to.size () || !to[channel]);
+}
+
+void
+FlywayChannelAssigner::Place (uint32_t j, uint32_t channel)
+{
+  NS_ASSERT (IsFree (j, channel) && m_pending[j].channel < 0);
+  struct Flyway &f = m_pending[j];
+  f.channel = channel;
+  m_busyChannels[f.from].resize (m_numChannels, false);
+  m_busyChannels[f.to].resize (m_numChannels, false);
+  m_busyChannels[f.from][channel] = true;
+  m_busyChannels[f.to][channel] = true;
+  m_engine->Add (f.from, f.dongleFrom, f.to, f.dongleTo, f.channel);
+  m_flyways.push_back (f);
+}
+
+uint32_t
+FlywayChannelAssigner::FindPlaced (uint32_t j) const
+{
+  const struct Flyway &f = m_pending[j];
+  NS_ASSERT (f.channel >= 0);
+  // the dongle at the start of a flyway is not shared with any other
+  uint32_t i = m_flyways.size ();
+  while (i-- > 0)
+    {
+      if (m_flyways[i].from == f.from && m_flyways[i].dongleFrom == f.dongleFrom)
+        {
+          break;
+        }
+    }
+  NS_ASSERT (i < m_flyways.size ());
+  return i;
+}
+
+void
+FlywayChannelAssigner::Unplace (uint32_t j)
+{
+  struct Flyway &f = m_pending[j];
+  uint32_t i = FindPlaced (j);
+  m_engine->Remove (i);
+  m_flyways.erase (m_flyways.begin () + i);
+  m_busyChannels[f.from][f.channel] = false;
+  m_busyChannels[f.to][f.channel] = false;
+  f.channel = -1;
+}
+
+bool
+FlywayChannelAssigner::IsFeasible (void) const
+{
+  std::vector<double> rates;
+  return m_engine->IsFeasible (&rates);
+}
+
+double
+FlywayChannelAssigner::Evaluate (uint32_t *infeasible) const
+{
+  double total = 0;
+  *infeasible = 0;
+  for (uint32_t i = 0; i < m_engine->GetN (); i++)
+    {
+      double rate;
+      if (m_engine->IsLinkFeasible (i, &rate))
+        {
+          total += rate;
+        }
+      else
+        {
+          (*infeasible)++;
+        }
+    }
+  return total;
+}
+
+} // namespace ns3
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "flyway-feasibility-engine.h"
+#include "flyways-topo-helper.h"
+#include <cstdio>
+#include <fstream>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("FlywayFeasibilityEngineTest");
+
+namespace ns3 {
+
+static const double g_baselineNoiseDbm = -81;
+static const double g_rssiLimitsDbm[] = {-66, -64, -63, -62, -60, -58, -56, -54, -53, -51, -49, -47};
+static const double g_rates[] = {.693, .86625, 1.386, 1.73250, 2.079, 2.772, 3.465, 4.158, 4.5045, 5.1975, 6.237, 6.75675};
+static const uint32_t g_nRates = 12;
+
+// Set to true to rewrite the golden file instead of checking against it.
+const bool WRITE_VECTORS = false;
+
+/**
+ * Greedily adds flyways between pseudo random pairs of racks, as
+ * num-flyways-new does, then removes them from the middle of the set.
+ * The outcome of every check is written in the format of the out.dat of
+ * isFeasibleNew and compared with flyway-feasibility-engine-out.dat,
+ * which was written by the check of isFeasibleNew that evaluates every
+ * signal strength again on every call.
+ */
+class FlywayFeasibilityEngineTest : public TestCase
+{
+public:
+  FlywayFeasibilityEngineTest ();
+  virtual ~FlywayFeasibilityEngineTest ();
+
+private:
+  virtual bool DoRun (void);
+  bool Check (FILE *out, const FlywayFeasibilityEngine &engine);
+  std::string WriteTopology (void);
+  bool CheckResults (std::string name);
+
+  static const char * const PREFIX;
+};
+
+const char * const FlywayFeasibilityEngineTest::PREFIX = "flyway-feasibility-engine-out.dat";
+
+FlywayFeasibilityEngineTest::FlywayFeasibilityEngineTest ()
+  : TestCase ("FlywayFeasibilityEngine agrees with the isFeasibleNew check during a greedy search")
+{}
+
+FlywayFeasibilityEngineTest::~FlywayFeasibilityEngineTest ()
+{}
+
+std::string
+FlywayFeasibilityEngineTest::WriteTopology (void)
+{
+  std::string name = GetTempDir () + "flyway-feasibility-engine-topo.dat";
+  FILE *f = fopen (name.c_str (), "w");
+  NS_ASSERT (f != 0);
+  fprintf (f, "NUM-TORS: 40\n"
+           "Agg2L3_Bandwidth:40Gbps\n"
+           "Tor2Agg_Bandwidth:10Gbps\n"
+           "AggFanOut: 40\n"
+           "L3FanOut:2\n"
+           "DonglesPerTor: 2\n"
+           "DonglesPerAgg: 0\n"
+           "DonglesPerL3: 0\n"
+           "FlywayBandwidth: 1Gbps\n"
+           "Antenna: 1\n"
+           "ScaleDownBy: 1\n"
+           "RackWidth: 0.57\n"
+           "RackHeight: 0.78\n"
+           "ClumpNumRacks: 10\n"
+           "ClumpSpaceLeft: 3\n"
+           "ClumpSpaceBelow: 1.8\n"
+           "Arrangement: Square\n");
+  fclose (f);
+  return name;
+}
+
+bool
+FlywayFeasibilityEngineTest::Check (FILE *out, const FlywayFeasibilityEngine &engine)
+{
+  std::vector<double> rates;
+  bool feasible = engine.IsFeasible (&rates);
+  if (feasible)
+    {
+      fprintf (out, "true Rates ");
+      for (uint32_t i = 0; i < rates.size (); i++)
+        {
+          fprintf (out, " %.3f ", rates[i]);
+        }
+      fprintf (out, "\n");
+    }
+  else
+    {
+      fprintf (out, "false\n");
+    }
+  return feasible;
+}
+
+bool
+FlywayFeasibilityEngineTest::CheckResults (std::string name)
+{
+  std::ifstream expected ((NS_TEST_SOURCEDIR + PREFIX).c_str ());
+  std::ifstream actual (name.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (expected.good (), true, "Cannot read " << PREFIX);
+  NS_TEST_ASSERT_MSG_EQ (actual.good (), true, "Cannot read " << name);
+  std::string want, got;
+  uint32_t line = 0;
+  while (std::getline (expected, want))
+    {
+      line++;
+      if (!std::getline (actual, got))
+        {
+          got = "<end of file>";
+        }
+      // the golden file may have been checked out with CRLF line endings
+      if (!want.empty () && want[want.size () - 1] == '\r')
+        {
+          want.erase (want.size () - 1);
+        }
+      NS_TEST_ASSERT_MSG_EQ (got, want, "Line " << line << " of " << PREFIX << " differs");
+    }
+  NS_TEST_EXPECT_MSG_EQ (std::getline (actual, got).good (), false, "Lines after the end of " << PREFIX);
+  return GetErrorStatus ();
+}
+
+bool
+FlywayFeasibilityEngineTest::DoRun (void)
+{
+  std::string topoFile = WriteTopology ();
+  InternetStackHelper stack;
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  FlywaysTopoHelper *topo = new FlywaysTopoHelper (const_cast<char *> (topoFile.c_str ()), stack, address);
+  remove (topoFile.c_str ());
+
+  double rssiThreshold = -62;
+  uint32_t numChannels = 3;
+  for (int i = 0; i < topo->GetNumFlyways (); ++i)
+    {
+      for (uint32_t j = 0; j < topo->GetNumDongles (); ++j)
+        {
+          topo->PointNowhere (i, j);
+          topo->SetAntennaGain (i, j, 23);
+        }
+    }
+
+  FlywayFeasibilityEngine engine (topo);
+  engine.SetBaselineNoise (g_baselineNoiseDbm);
+  engine.SetRssiThreshold (rssiThreshold);
+  engine.SetRates (std::vector<double> (g_rssiLimitsDbm, g_rssiLimitsDbm + g_nRates),
+                   std::vector<double> (g_rates, g_rates + g_nRates));
+
+  std::string name = (WRITE_VECTORS ? NS_TEST_SOURCEDIR : GetTempDir ()) + PREFIX;
+  FILE *out = fopen (name.c_str (), "w");
+  NS_ASSERT (out != 0);
+
+  // Check every tentative set of the greedy search.
+  uint32_t nFlyways = 0;
+  std::vector<uint32_t> dongles (topo->GetNumToRs (), 0);
+  uint32_t seed = 12345;
+  uint32_t infeasible = 0;
+  for (uint32_t k = 0; k < 400; k++)
+    {
+      seed = seed * 1103515245 + 12345;
+      uint32_t from = (seed >> 8) % topo->GetNumToRs ();
+      seed = seed * 1103515245 + 12345;
+      uint32_t to = (seed >> 8) % topo->GetNumToRs ();
+      if (from == to || dongles[from] >= topo->GetNumDongles () || dongles[to] >= topo->GetNumDongles ())
+        {
+          continue;
+        }
+      int channel = k % numChannels;
+      topo->PointAtEachOther (from, dongles[from], to, dongles[to]);
+      uint32_t index = engine.Add (from, dongles[from], to, dongles[to], channel);
+      NS_TEST_EXPECT_MSG_EQ (index, nFlyways, "Flyways are indexed in the order they are added");
+      NS_TEST_EXPECT_MSG_EQ (engine.GetRssi (index),
+                             topo->CalcSignalStrength (from, dongles[from], to, dongles[to]),
+                             "Wrong signal strength");
+      fprintf (out, "BEGIN CANDIDATE %d-%d.%d-%d.[%d]\n", from, dongles[from], to, dongles[to], channel);
+      if (Check (out, engine))
+        {
+          dongles[from]++;
+          dongles[to]++;
+          nFlyways++;
+        }
+      else
+        {
+          engine.Remove (engine.GetN () - 1);
+          infeasible++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ ((nFlyways > 10), true, "Too few flyways to exercise the engine");
+  NS_TEST_EXPECT_MSG_EQ ((infeasible > 0), true, "No tentative flyway was rejected");
+
+  // Removing flyways from the middle of the set and tightening the
+  // threshold must give the same answers too.
+  while (nFlyways > 1)
+    {
+      uint32_t index = nFlyways / 2;
+      engine.Remove (index);
+      nFlyways--;
+      NS_TEST_EXPECT_MSG_EQ (engine.GetN (), nFlyways, "Wrong number of flyways");
+      fprintf (out, "REMOVE %u\n", index);
+      Check (out, engine);
+      engine.SetRssiThreshold (-56);
+      Check (out, engine);
+      engine.SetRssiThreshold (rssiThreshold);
+    }
+  fprintf (out, "FINISH\n");
+  fclose (out);
+
+  delete topo;
+  Simulator::Destroy ();
+  if (!WRITE_VECTORS)
+    {
+      CheckResults (name);
+    }
+  return GetErrorStatus ();
+}
+
+
+class FlywayFeasibilityEngineTestSuite : public TestSuite
+{
+public:
+  FlywayFeasibilityEngineTestSuite ();
+};
+
+FlywayFeasibilityEngineTestSuite::FlywayFeasibilityEngineTestSuite ()
+  : TestSuite ("helper-flyway-feasibility-engine", UNIT)
+{
+  AddTestCase (new FlywayFeasibilityEngineTest);
+}
+
+FlywayFeasibilityEngineTestSuite g_flywayFeasibilityEngineTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "flyway-feasibility-engine.h"
+#include "flyways-topo-helper.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <limits>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("FlywayFeasibilityEngine");
+
+namespace ns3 {
+
+FlywayFeasibilityEngine::FlywayFeasibilityEngine (FlywaysTopoHelper *topo)
+  : m_topo (topo),
+    m_baselineNoiseDbm (-81),
+    m_rssiThresholdDbm (-62),
+    m_marginDb (3),
+    m_ccaThresholdDbm (std::numeric_limits<double>::infinity ())
+{}
+
+void
+FlywayFeasibilityEngine::SetBaselineNoise (double noiseDbm)
+{
+  m_baselineNoiseDbm = noiseDbm;
+  for (uint32_t i = 0; i < m_order.size (); i++)
+    {
+      SumNoise (m_links[m_order[i]], m_order[i]);
+    }
+}
+void
+FlywayFeasibilityEngine::SetRssiThreshold (double rssiDbm)
+{
+  m_rssiThresholdDbm = rssiDbm;
+}
+double
+FlywayFeasibilityEngine::GetRssiThreshold (void) const
+{
+  return m_rssiThresholdDbm;
+}
+void
+FlywayFeasibilityEngine::SetMargin (double marginDb)
+{
+  m_marginDb = marginDb;
+}
+double
+FlywayFeasibilityEngine::GetMargin (void) const
+{
+  return m_marginDb;
+}
+void
+FlywayFeasibilityEngine::SetCcaThreshold (double noiseDbm)
+{
+  m_ccaThresholdDbm = noiseDbm;
+}
+void
+FlywayFeasibilityEngine::SetRates (const std::vector<double> &rssiLimitsDbm, const std::vector<double> &rates)
+{
+  NS_ASSERT (rssiLimitsDbm.size () == rates.size ());
+  m_rssiLimitsDbm = rssiLimitsDbm;
+  m_rates = rates;
+}
+
+double
+FlywayFeasibilityEngine::CalcInterference (const struct Link &source, uint32_t node, uint32_t dongle) const
+{
+  double fromSender = m_topo->CalcSignalStrength (source.from, source.dongleFrom, node, dongle);
+  double fromReceiver = m_topo->CalcSignalStrength (source.to, source.dongleTo, node, dongle);
+  double worstCaseDbm = 10 * std::log10 (std::pow (10, fromSender / 10) + std::pow (10, fromReceiver / 10));
+  return std::pow (10, worstCaseDbm / 10.0);
+}
+
+void
+FlywayFeasibilityEngine::SumNoise (struct Link &link, uint32_t slot) const
+{
+  link.noiseAtSender = std::pow (10, m_baselineNoiseDbm / 10);
+  link.noiseAtReceiver = std::pow (10, m_baselineNoiseDbm / 10);
+  link.interferers = 0;
+  for (uint32_t i = 0; i < m_order.size (); i++)
+    {
+      uint32_t other = m_order[i];
+      if (other == slot || m_links[other].channel != link.channel)
+        {
+          continue;
+        }
+      link.noiseAtSender += link.interference[other].atSender;
+      link.noiseAtReceiver += link.interference[other].atReceiver;
+      link.interferers++;
+    }
+}
+
+uint32_t
+FlywayFeasibilityEngine::Add (uint32_t from, uint32_t dongleFrom, uint32_t to, uint32_t dongleTo, int channel)
+{
+  NS_LOG_FUNCTION (this << from << dongleFrom << to << dongleTo << channel);
+  uint32_t slot;
+  if (m_freeSlots.empty ())
+    {
+      slot = m_links.size ();
+      m_links.push_back (Link ());
+    }
+  else
+    {
+      slot = m_freeSlots.back ();
+      m_freeSlots.pop_back ();
+    }
+  struct Link &link = m_links[slot];
+  link.from = from;
+  link.dongleFrom = dongleFrom;
+  link.to = to;
+  link.dongleTo = dongleTo;
+  link.channel = channel;
+  link.rssiDbm = m_topo->CalcSignalStrength (from, dongleFrom, to, dongleTo);
+  struct Interference none = {0, 0};
+  link.interference.assign (m_links.size (), none);
+
+  for (uint32_t i = 0; i < m_order.size (); i++)
+    {
+      struct Link &other = m_links[m_order[i]];
+      if (other.interference.size () < m_links.size ())
+        {
+          other.interference.resize (m_links.size (), none);
+        }
+      if (other.channel != channel)
+        {
+          other.interference[slot] = none;
+          continue;
+        }
+      link.interference[m_order[i]].atSender = CalcInterference (other, from, dongleFrom);
+      link.interference[m_order[i]].atReceiver = CalcInterference (other, to, dongleTo);
+      struct Interference caused;
+      caused.atSender = CalcInterference (link, other.from, other.dongleFrom);
+      caused.atReceiver = CalcInterference (link, other.to, other.dongleTo);
+      other.interference[slot] = caused;
+      other.noiseAtSender += caused.atSender;
+      other.noiseAtReceiver += caused.atReceiver;
+      other.interferers++;
+    }
+  m_order.push_back (slot);
+  SumNoise (link, slot);
+  return m_order.size () - 1;
+}
+
+void
+FlywayFeasibilityEngine::Remove (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT (index < m_order.size ());
+  uint32_t slot = m_order[index];
+  struct Link &removed = m_links[slot];
+  m_order.erase (m_order.begin () + index);
+  m_freeSlots.push_back (slot);
+  for (uint32_t i = 0; i < m_order.size (); i++)
+    {
+      struct Link &link = m_links[m_order[i]];
+      if (link.channel != removed.channel)
+        {
+          continue;
+        }
+      if (--link.interferers == 0)
+        {
+          // exactly the baseline, without what the subtractions left over
+          link.noiseAtSender = std::pow (10, m_baselineNoiseDbm / 10);
+          link.noiseAtReceiver = std::pow (10, m_baselineNoiseDbm / 10);
+          continue;
+        }
+      link.noiseAtSender -= link.interference[slot].atSender;
+      link.noiseAtReceiver -= link.interference[slot].atReceiver;
+    }
+}
+
+void
+FlywayFeasibilityEngine::Clear (void)
+{
+  m_links.clear ();
+  m_freeSlots.clear ();
+  m_order.clear ();
+}
+
+uint32_t
+FlywayFeasibilityEngine::GetN (void) const
+{
+  return m_order.size ();
+}
+
+double
+FlywayFeasibilityEngine::GetRssi (uint32_t index) const
+{
+  return m_links[m_order[index]].rssiDbm;
+}
+
+double
+FlywayFeasibilityEngine::FindRate (double rssiDbm) const
+{
+  double rate = 0;
+  for (uint32_t i = 0; i < m_rates.size (); i++)
+    {
+      if (rssiDbm > m_rssiLimitsDbm[i])
+        {
+          rate = m_rates[i];
+        }
+    }
+  return rate;
+}
+
+bool
+FlywayFeasibilityEngine::IsLinkFeasible (uint32_t index, double *rate) const
+{
+  const struct Link &link = m_links[m_order[index]];
+  *rate = 0;
+
+  // Can the sender receive acks?
+  double noiseAtSender = 10 * std::log10 (link.noiseAtSender);
+  if (noiseAtSender > m_ccaThresholdDbm)
+    {
+      return false;
+    }
+  double rssiAdjust = link.rssiDbm - (-1 * m_baselineNoiseDbm) + (-1 * noiseAtSender);
+  if (!(rssiAdjust - m_marginDb > m_rssiThresholdDbm))
+    {
+      return false;
+    }
+
+  // Is there enough margin at the receiver?
+  double noiseAtReceiver = 10 * std::log10 (link.noiseAtReceiver);
+  if (noiseAtReceiver > m_ccaThresholdDbm)
+    {
+      return false;
+    }
+  rssiAdjust = link.rssiDbm - (-1 * m_baselineNoiseDbm) + (-1 * noiseAtReceiver);
+  if (!(rssiAdjust - m_marginDb > m_rssiThresholdDbm))
+    {
+      return false;
+    }
+  *rate = FindRate (rssiAdjust - m_marginDb);
+  return true;
+}
+
+bool
+FlywayFeasibilityEngine::IsFeasible (std::vector<double> *rates) const
+{
+  rates->clear ();
+  for (uint32_t i = 0; i < m_order.size (); i++)
+    {
+      double rate;
+      if (!IsLinkFeasible (i, &rate))
+        {
+          return false;
+        }
+      rates->push_back (rate);
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef FLYWAY_FEASIBILITY_ENGINE_H
+#define FLYWAY_FEASIBILITY_ENGINE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+class FlywaysTopoHelper;
+
+/**
+ * \brief decide whether a set of flyways can be active at the same time.
+ *
+ * A flyway is feasible when, with every other flyway on its channel
+ * active, the margin of its signal strength over the noise at both of
+ * its ends is still above the rssi threshold. Interference is worst
+ * case: both ends of an interfering flyway are assumed to transmit at
+ * the same time.
+ *
+ * The engine keeps the interference every flyway causes at both ends of
+ * every other flyway, and the resulting noise sums. Adding a flyway
+ * evaluates signal strengths only between its dongles and those of the
+ * flyways already on its channel; removing one evaluates none and takes
+ * its interference off the sums of the others. Adding, removing and
+ * checking one flyway are then linear in the number of flyways.
+ *
+ * The signal strengths depend on where the antennas point, so the two
+ * dongles of a flyway must be steered before the flyway is added and
+ * must not be steered again while it is in the engine.
+ */
+class FlywayFeasibilityEngine
+{
+public:
+  /**
+   * \param topo the topology whose dongles carry the flyways
+   */
+  FlywayFeasibilityEngine (FlywaysTopoHelper *topo);
+
+  /**
+   * \param noiseDbm the noise at every dongle when no flyway is active
+   */
+  void SetBaselineNoise (double noiseDbm);
+  /**
+   * \param rssiDbm the signal strength a flyway needs, once its margin
+   *        and the noise above the baseline are taken off
+   */
+  void SetRssiThreshold (double rssiDbm);
+  double GetRssiThreshold (void) const;
+  /**
+   * \param marginDb the margin taken off the signal strength of every
+   *        flyway before it is compared to the rssi threshold
+   */
+  void SetMargin (double marginDb);
+  double GetMargin (void) const;
+  /**
+   * \param noiseDbm flyways with more noise than this at either end are
+   *        infeasible, as their carrier sense would never find the
+   *        medium idle. Not checked unless set.
+   */
+  void SetCcaThreshold (double noiseDbm);
+  /**
+   * \param rssiLimitsDbm the signal strength each rate needs
+   * \param rates the rate a flyway gets when its signal strength, less
+   *        its margin, is above the matching limit
+   *
+   * The rate of a feasible flyway is that of the last limit it exceeds.
+   */
+  void SetRates (const std::vector<double> &rssiLimitsDbm, const std::vector<double> &rates);
+
+  /**
+   * \param from the node the flyway starts at
+   * \param dongleFrom the dongle of from
+   * \param to the node the flyway ends at
+   * \param dongleTo the dongle of to
+   * \param channel the channel the flyway uses
+   * \returns the index of the new flyway
+   */
+  uint32_t Add (uint32_t from, uint32_t dongleFrom, uint32_t to, uint32_t dongleTo, int channel);
+  /**
+   * \param index the flyway to remove. Flyways added after it move
+   *        down by one.
+   */
+  void Remove (uint32_t index);
+  void Clear (void);
+  uint32_t GetN (void) const;
+  /**
+   * \param index a flyway
+   * \returns the signal strength (dBm) between its ends
+   */
+  double GetRssi (uint32_t index) const;
+
+  /**
+   * \param index a flyway
+   * \param rate the rate of the flyway if it is feasible, 0 otherwise
+   * \returns true if the flyway is feasible with all the others active
+   */
+  bool IsLinkFeasible (uint32_t index, double *rate) const;
+  /**
+   * \param rates the rates of the flyways, up to the first infeasible one
+   * \returns true if every flyway is feasible
+   */
+  bool IsFeasible (std::vector<double> *rates) const;
+
+private:
+  /**
+   * The worst case interference one flyway causes at the two ends of
+   * another (mW).
+   */
+  struct Interference
+  {
+    double atSender;
+    double atReceiver;
+  };
+  struct Link
+  {
+    uint32_t from;
+    uint32_t dongleFrom;
+    uint32_t to;
+    uint32_t dongleTo;
+    int channel;
+    double rssiDbm;
+    // baseline noise plus the interference of the other flyways on the
+    // channel (mW)
+    double noiseAtSender;
+    double noiseAtReceiver;
+    // the number of other flyways on the channel
+    uint32_t interferers;
+    // from the flyway in each slot
+    std::vector<struct Interference> interference;
+  };
+
+  double CalcInterference (const struct Link &source, uint32_t node, uint32_t dongle) const;
+  void SumNoise (struct Link &link, uint32_t slot) const;
+  double FindRate (double rssiDbm) const;
+
+  FlywaysTopoHelper *m_topo;
+  double m_baselineNoiseDbm;
+  double m_rssiThresholdDbm;
+  double m_marginDb;
+  double m_ccaThresholdDbm;
+  std::vector<double> m_rssiLimitsDbm;
+  std::vector<double> m_rates;
+  // a removed flyway leaves its slot free for the next one added, so
+  // that the others keep the interference they have from each slot
+  std::vector<struct Link> m_links;
+  std::vector<uint32_t> m_freeSlots;
+  // the slots of the flyways, in the order they were added
+  std::vector<uint32_t> m_order;
+};
+
+} // namespace ns3
+
+#endif /* FLYWAY_FEASIBILITY_ENGINE_H */
@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "flyway-tables.h"
+#include <cstdio>
+#include <cstring>
+
+namespace ns3 {
+
+static void
+WriteFile (std::string name, const char *text)
+{
+  FILE *f = fopen (name.c_str (), "w");
+  NS_ASSERT (f != 0);
+  fputs (text, f);
+  fclose (f);
+}
+
+/* Overwrites the number of records of a binary table, which follows its
+ * magic, version and record size. */
+static void
+SetCount (std::string name, uint32_t n)
+{
+  FILE *f = fopen (name.c_str (), "r+b");
+  NS_ASSERT (f != 0);
+  fseek (f, 12, SEEK_SET);
+  fwrite (&n, sizeof (n), 1, f);
+  fclose (f);
+}
+
+
+class FlywayFlowTableTest : public TestCase
+{
+public:
+  FlywayFlowTableTest ();
+  virtual ~FlywayFlowTableTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywayFlowTableTest::FlywayFlowTableTest ()
+  : TestCase ("Flow tables read the same from text and binary files")
+{}
+
+FlywayFlowTableTest::~FlywayFlowTableTest ()
+{}
+
+bool
+FlywayFlowTableTest::DoRun (void)
+{
+  std::string text = GetTempDir () + "flyway-tables-flows.dat";
+  std::string binary = GetTempDir () + "flyway-tables-flows.bin";
+  WriteFile (text, "# time from to proto size rate link_type\n"
+             "0.5 1 2 Tcp 1000000 1Gbps 1\n"
+             "\n"
+             "  1.25 3 0 Udp 2.5e6 500Mbps 2\n");
+
+  FlywayFlowTable table;
+  NS_TEST_ASSERT_MSG_EQ (table.Load (text), true, table.GetError ());
+  NS_TEST_ASSERT_MSG_EQ (table.GetN (), 2, "Comments and empty lines are not flows");
+  const FlywayFlow &first = table.Get (0);
+  NS_TEST_EXPECT_MSG_EQ (first.beginTime, 0.5, "Wrong begin time");
+  NS_TEST_EXPECT_MSG_EQ (first.fromNode, 1, "Wrong source");
+  NS_TEST_EXPECT_MSG_EQ (first.toNode, 2, "Wrong destination");
+  NS_TEST_EXPECT_MSG_EQ (std::string (first.proto), "Tcp", "Wrong protocol");
+  NS_TEST_EXPECT_MSG_EQ (first.transferSize, 1000000, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (std::string (first.dataRate), "1Gbps", "Wrong rate");
+  NS_TEST_EXPECT_MSG_EQ (first.linkType, 1, "Wrong link type");
+  NS_TEST_EXPECT_MSG_EQ (table.Get (1).transferSize, 2.5e6, "Wrong size");
+  NS_TEST_EXPECT_MSG_EQ (table.Get (1).linkType, 2, "Wrong link type");
+
+  NS_TEST_ASSERT_MSG_EQ (table.WriteBinary (binary), true, table.GetError ());
+  FlywayFlowTable loaded;
+  NS_TEST_ASSERT_MSG_EQ (loaded.Load (binary), true, loaded.GetError ());
+  NS_TEST_ASSERT_MSG_EQ (loaded.GetN (), table.GetN (), "Binary file lost flows");
+  for (uint32_t i = 0; i < table.GetN (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (memcmp (&loaded.Get (i), &table.Get (i), sizeof (FlywayFlow)), 0,
+                             "Flow " << i << " differs once written");
+    }
+
+  // A count of flows larger than the file must not be believed.
+  SetCount (binary, 0x7fffffff);
+  NS_TEST_EXPECT_MSG_EQ (loaded.Load (binary), false, "A file with too few flows was read");
+  NS_TEST_EXPECT_MSG_EQ (loaded.GetN (), table.GetN (), "A failed load changed the table");
+  SetCount (binary, 3);
+  NS_TEST_EXPECT_MSG_EQ (loaded.Load (binary), false, "A file with a missing flow was read");
+  NS_TEST_EXPECT_MSG_EQ (loaded.GetN (), table.GetN (), "A failed load changed the table");
+
+  WriteFile (text, "0.5 1 2 Tcp 1000000 1Gbps 1\n"
+             "# the next flow has no link type\n"
+             "0.5 1 2 Tcp 1000000 1Gbps\n");
+  FlywayFlowTable bad;
+  NS_TEST_EXPECT_MSG_EQ (bad.Load (text), false, "A flow with six fields was accepted");
+  NS_TEST_EXPECT_MSG_EQ ((bad.GetError ().find (text + ":3:") == 0), true,
+                         "The error does not name the line: " << bad.GetError ());
+  NS_TEST_EXPECT_MSG_EQ (bad.Load (GetTempDir () + "flyway-tables-none.dat"), false, "A missing file was read");
+
+  remove (text.c_str ());
+  remove (binary.c_str ());
+  return GetErrorStatus ();
+}
+
+
+class FlywayTopoTableTest : public TestCase
+{
+public:
+  FlywayTopoTableTest ();
+  virtual ~FlywayTopoTableTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywayTopoTableTest::FlywayTopoTableTest ()
+  : TestCase ("Topology tables read the same from text and binary files")
+{}
+
+FlywayTopoTableTest::~FlywayTopoTableTest ()
+{}
+
+bool
+FlywayTopoTableTest::DoRun (void)
+{
+  std::string text = GetTempDir () + "flyway-tables-topo.dat";
+  std::string binary = GetTempDir () + "flyway-tables-topo.bin";
+  WriteFile (text, "# ToRs\n"
+             "NUM-TORS: 40\n"
+             "Tor2Agg_Bandwidth:20Gbps\n"
+             "DonglesPerTor: 2\n"
+             "Antenna: 1\n"
+             "RackHeight: 0.78\n"
+             "ClumpNumRacks: 10\n"
+             "Standard:SC\n"
+             "ReplayFlowFile: scratch/flow.dat\n"
+             "Topology: FatTree\n"
+             "FatTreeK: 8\n"
+             "Spines: 3\n"
+             "Oversubscription: 2.5\n"
+             "RackBandwidth: 40Gbps\n"
+             "Arrangement: Rows\n"
+             "RacksPerRow: 12\n"
+             "AisleWidth: 1.5\n");
+
+  GlobalOpt defaults;
+  FlywayTopoTable table (defaults);
+  NS_TEST_ASSERT_MSG_EQ (table.Load (text), true, table.GetError ());
+  const GlobalOpt &o = table.Get ();
+  NS_TEST_EXPECT_MSG_EQ (o.numTors, 40, "Wrong number of ToRs");
+  NS_TEST_EXPECT_MSG_EQ (o.tor2Agg_Bandwidth.GetBitRate (), 20000000000ULL, "Wrong bandwidth");
+  NS_TEST_EXPECT_MSG_EQ (o.agg2L3_Bandwidth.GetBitRate (), defaults.agg2L3_Bandwidth.GetBitRate (),
+                         "A missing key lost its default");
+  NS_TEST_EXPECT_MSG_EQ (o.donglesPerTor, 2, "Wrong number of dongles");
+  NS_TEST_EXPECT_MSG_EQ (o.antenna, FW_Antenna_Measured, "Wrong antenna");
+  NS_TEST_EXPECT_MSG_EQ (o.rackHeight_meter, 0.78f, "Wrong rack height");
+  NS_TEST_EXPECT_MSG_EQ (o.clumpNumRacks, 10, "Wrong clump size");
+  NS_TEST_EXPECT_MSG_EQ (o.standard, FW_Standard_SC, "Wrong standard");
+  NS_TEST_EXPECT_MSG_EQ (o.trafficType, FW_TT_ReplayFlows, "Wrong traffic");
+  NS_TEST_EXPECT_MSG_EQ (std::string (o.replayFlowFileName), "scratch/flow.dat", "Wrong flow file");
+  NS_TEST_EXPECT_MSG_EQ (o.topology, FW_Topo_FatTree, "Wrong topology");
+  NS_TEST_EXPECT_MSG_EQ (o.fatTreeK, 8, "Wrong fat-tree");
+  NS_TEST_EXPECT_MSG_EQ (o.numSpines, 3, "Wrong number of spines");
+  NS_TEST_EXPECT_MSG_EQ (o.oversubscription, 2.5, "Wrong oversubscription");
+  NS_TEST_EXPECT_MSG_EQ (o.rackBandwidth.GetBitRate (), 40000000000ULL, "Wrong rack bandwidth");
+  NS_TEST_EXPECT_MSG_EQ (o.arrangeType, FW_ToA_Rows, "Wrong arrangement");
+  NS_TEST_EXPECT_MSG_EQ (o.racksPerRow, 12, "Wrong row");
+  NS_TEST_EXPECT_MSG_EQ (o.aisleWidth_meter, 1.5, "Wrong aisle");
+
+  NS_TEST_ASSERT_MSG_EQ (table.WriteBinary (binary), true, table.GetError ());
+  FlywayTopoTable loaded;
+  NS_TEST_ASSERT_MSG_EQ (loaded.Load (binary), true, loaded.GetError ());
+  const GlobalOpt &l = loaded.Get ();
+  NS_TEST_EXPECT_MSG_EQ (l.numTors, o.numTors, "Wrong number of ToRs once written");
+  NS_TEST_EXPECT_MSG_EQ (l.aggFanOut, o.aggFanOut, "Wrong fan out once written");
+  NS_TEST_EXPECT_MSG_EQ (l.tor2Agg_Bandwidth.GetBitRate (), o.tor2Agg_Bandwidth.GetBitRate (),
+                         "Wrong bandwidth once written");
+  NS_TEST_EXPECT_MSG_EQ (l.donglesPerTor, o.donglesPerTor, "Wrong number of dongles once written");
+  NS_TEST_EXPECT_MSG_EQ (l.antenna, o.antenna, "Wrong antenna once written");
+  NS_TEST_EXPECT_MSG_EQ (l.rackHeight_meter, o.rackHeight_meter, "Wrong rack height once written");
+  NS_TEST_EXPECT_MSG_EQ (l.clumpSpaceLeft_meter, o.clumpSpaceLeft_meter, "Wrong clump space once written");
+  NS_TEST_EXPECT_MSG_EQ (l.standard, o.standard, "Wrong standard once written");
+  NS_TEST_EXPECT_MSG_EQ (std::string (l.replayFlowFileName), std::string (o.replayFlowFileName),
+                         "Wrong flow file once written");
+  NS_TEST_EXPECT_MSG_EQ (l.topology, o.topology, "Wrong topology once written");
+  NS_TEST_EXPECT_MSG_EQ (l.fatTreeK, o.fatTreeK, "Wrong fat-tree once written");
+  NS_TEST_EXPECT_MSG_EQ (l.numSpines, o.numSpines, "Wrong number of spines once written");
+  NS_TEST_EXPECT_MSG_EQ (l.oversubscription, o.oversubscription, "Wrong oversubscription once written");
+  NS_TEST_EXPECT_MSG_EQ (l.rackBandwidth.GetBitRate (), o.rackBandwidth.GetBitRate (),
+                         "Wrong rack bandwidth once written");
+  NS_TEST_EXPECT_MSG_EQ (l.arrangeType, o.arrangeType, "Wrong arrangement once written");
+  NS_TEST_EXPECT_MSG_EQ (l.racksPerRow, o.racksPerRow, "Wrong row once written");
+  NS_TEST_EXPECT_MSG_EQ (l.aisleWidth_meter, o.aisleWidth_meter, "Wrong aisle once written");
+
+  WriteFile (text, "NUM-TORS: 40\n"
+             "DonglesPerTor: some\n");
+  FlywayTopoTable bad;
+  NS_TEST_EXPECT_MSG_EQ (bad.Load (text), false, "A bad number of dongles was accepted");
+  NS_TEST_EXPECT_MSG_EQ ((bad.GetError ().find (text + ":2:") == 0), true,
+                         "The error does not name the line: " << bad.GetError ());
+
+  remove (text.c_str ());
+  remove (binary.c_str ());
+  return GetErrorStatus ();
+}
+
+
+class FlywayCompletionTableTest : public TestCase
+{
+public:
+  FlywayCompletionTableTest ();
+  virtual ~FlywayCompletionTableTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywayCompletionTableTest::FlywayCompletionTableTest ()
+  : TestCase ("Completion tables are written as CSV and binary files")
+{}
+
+FlywayCompletionTableTest::~FlywayCompletionTableTest ()
+{}
+
+bool
+FlywayCompletionTableTest::DoRun (void)
+{
+  std::string csv = GetTempDir () + "flyway-tables-fct.csv";
+  std::string binary = GetTempDir () + "flyway-tables-fct.bin";
+
+  FlywayCompletionTable table;
+  table.Reserve (3);
+  NS_TEST_ASSERT_MSG_EQ (table.Add (0.5, 1, 2, 1), 0, "Wrong first row");
+  NS_TEST_ASSERT_MSG_EQ (table.Add (1.25, 3, 0, 2), 1, "Wrong second row");
+  NS_TEST_ASSERT_MSG_EQ (table.Add (2, 4, 5, 2), 2, "Wrong third row");
+  NS_TEST_EXPECT_MSG_EQ (table.GetNCompleted (), 0, "Rows completed when added");
+  table.Complete (1, 2500000, 0.125);
+  table.SetRxBytes (2, 1000);
+  NS_TEST_EXPECT_MSG_EQ (table.GetNCompleted (), 1, "Wrong number of completed rows");
+  NS_TEST_EXPECT_MSG_EQ (table.IsCompleted (0), false, "Row 0 has not completed");
+  NS_TEST_EXPECT_MSG_EQ (table.IsCompleted (1), true, "Row 1 has completed");
+  NS_TEST_EXPECT_MSG_EQ (table.Get (1).rxBytes, 2500000, "Wrong bytes of a completed row");
+  NS_TEST_EXPECT_MSG_EQ (table.Get (2).rxBytes, 1000, "Wrong bytes of a row which has not completed");
+
+  NS_TEST_ASSERT_MSG_EQ (table.Save (csv), true, table.GetError ());
+  FILE *f = fopen (csv.c_str (), "r");
+  NS_TEST_ASSERT_MSG_EQ ((f != 0), true, "CSV file not written");
+  char text[1000];
+  size_t n = fread (text, 1, sizeof (text) - 1, f);
+  text[n] = 0;
+  fclose (f);
+  NS_TEST_EXPECT_MSG_EQ (std::string (text),
+                         "flow,begin_time,from,to,link_type,rx_bytes,fct\n"
+                         "0,0.5,1,2,1,0,\n"
+                         "1,1.25,3,0,2,2500000,0.125000000\n"
+                         "2,2,4,5,2,1000,\n", "Wrong CSV file");
+
+  NS_TEST_ASSERT_MSG_EQ (table.Save (binary), true, table.GetError ());
+  FlywayCompletionTable loaded;
+  NS_TEST_ASSERT_MSG_EQ (loaded.Load (binary), true, loaded.GetError ());
+  NS_TEST_ASSERT_MSG_EQ (loaded.GetN (), table.GetN (), "Binary file lost rows");
+  NS_TEST_EXPECT_MSG_EQ (loaded.GetNCompleted (), table.GetNCompleted (), "Wrong number of completed rows once written");
+  for (uint32_t i = 0; i < table.GetN (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (memcmp (&loaded.Get (i), &table.Get (i), sizeof (FlywayCompletion)), 0,
+                             "Row " << i << " differs once written");
+    }
+  NS_TEST_EXPECT_MSG_EQ (loaded.Load (csv), false, "A CSV file was read as a binary one");
+  SetCount (binary, 0x7fffffff);
+  NS_TEST_EXPECT_MSG_EQ (loaded.Load (binary), false, "A file with too few rows was read");
+  NS_TEST_EXPECT_MSG_EQ (loaded.GetN (), table.GetN (), "A failed load changed the table");
+
+  remove (csv.c_str ());
+  remove (binary.c_str ());
+  return GetErrorStatus ();
+}
+
+
+class FlywayTablesTestSuite : public TestSuite
+{
+public:
+  FlywayTablesTestSuite ();
+};
+
+FlywayTablesTestSuite::FlywayTablesTestSuite ()
+  : TestSuite ("helper-flyway-tables", UNIT)
+{
+  AddTestCase (new FlywayFlowTableTest);
+  AddTestCase (new FlywayTopoTableTest);
+  AddTestCase (new FlywayCompletionTableTest);
+}
+
+FlywayTablesTestSuite g_flywayTablesTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,907 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "flyway-tables.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <cstring>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("FlywayTables");
+
+namespace ns3 {
+
+// the records are read and written as they are in memory
+typedef char FlywayFlowSizeCheck[sizeof (struct FlywayFlow) == 60 ? 1 : -1];
+typedef char FlywayCompletionSizeCheck[sizeof (struct FlywayCompletion) == 32 ? 1 : -1];
+
+static const char g_flowMagic[4] = {'F', 'W', 'F', 'L'};
+static const char g_topoMagic[4] = {'F', 'W', 'T', 'P'};
+static const char g_completionMagic[4] = {'F', 'W', 'C', 'T'};
+static const uint32_t g_flowVersion = 1;
+static const uint32_t g_topoVersion = 2;
+static const uint32_t g_completionVersion = 1;
+
+/* A line of any length, without its newline. */
+static bool
+ReadLine (FILE *f, std::string *line)
+{
+  char buffer[256];
+  line->clear ();
+  while (fgets (buffer, sizeof (buffer), f) != 0)
+    {
+      line->append (buffer);
+      if ((*line)[line->size () - 1] == '\n')
+        {
+          line->erase (line->size () - 1);
+          return true;
+        }
+    }
+  return !line->empty ();
+}
+
+static bool
+IsBlank (const std::string &line)
+{
+  return line.find_first_not_of (" \t\r") == std::string::npos;
+}
+
+/* Opens filename and tells whether it starts with magic. Otherwise the
+ * file is left at its start. */
+static FILE *
+OpenTable (std::string filename, const char magic[4], bool *binary)
+{
+  FILE *f = fopen (filename.c_str (), "rb");
+  if (f == 0)
+    {
+      return 0;
+    }
+  char start[4];
+  *binary = fread (start, 1, 4, f) == 4 && memcmp (start, magic, 4) == 0;
+  if (!*binary)
+    {
+      rewind (f);
+    }
+  return f;
+}
+
+template <typename T>
+static bool
+Write (FILE *f, T value)
+{
+  return fwrite (&value, sizeof (value), 1, f) == 1;
+}
+
+template <typename T>
+static bool
+Read (FILE *f, T *value)
+{
+  return fread (value, sizeof (*value), 1, f) == 1;
+}
+
+/* Tells whether the rest of f is long enough for n records of size
+ * bytes, so that a corrupt count is not trusted with an allocation. */
+static bool
+HasRecords (FILE *f, uint32_t n, size_t size)
+{
+  long here = ftell (f);
+  if (here < 0 || fseek (f, 0, SEEK_END) != 0)
+    {
+      return false;
+    }
+  long end = ftell (f);
+  if (fseek (f, here, SEEK_SET) != 0 || end < here)
+    {
+      return false;
+    }
+  return (uint64_t)n * size <= (uint64_t)(end - here);
+}
+
+bool
+FlywayFlowTable::Fail (std::string name, uint32_t line, std::string what)
+{
+  std::ostringstream oss;
+  oss << name << ":";
+  if (line > 0)
+    {
+      oss << line << ":";
+    }
+  oss << " " << what;
+  m_error = oss.str ();
+  NS_LOG_WARN (m_error);
+  return false;
+}
+
+bool
+FlywayFlowTable::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  bool binary;
+  FILE *f = OpenTable (filename, g_flowMagic, &binary);
+  if (f == 0)
+    {
+      return Fail (filename, 0, "cannot read flow file");
+    }
+  bool ok = binary ? ReadBinary (f, filename) : ReadText (f, filename);
+  fclose (f);
+  return ok;
+}
+
+bool
+FlywayFlowTable::ReadText (FILE *f, std::string name)
+{
+  std::string line;
+  uint32_t n = 0;
+  while (ReadLine (f, &line))
+    {
+      n++;
+      if (line[0] == '#' || IsBlank (line))
+        {
+          continue;
+        }
+      // the strings may be as long as the line, so that sscanf cannot
+      // overflow them
+      std::vector<char> proto (line.size () + 1);
+      std::vector<char> dataRate (line.size () + 1);
+      int from, to;
+      struct FlywayFlow flow;
+      memset (&flow, 0, sizeof (flow));
+      if (sscanf (line.c_str (), " %f %d %d %s %f %s %d",
+                  &flow.beginTime, &from, &to, &proto[0],
+                  &flow.transferSize, &dataRate[0], &flow.linkType) != 7)
+        {
+          return Fail (name, n, "expected 'beginTime fromNode toNode proto transferSize dataRate linkType'");
+        }
+      if (from < 0 || to < 0)
+        {
+          return Fail (name, n, "negative node");
+        }
+      if (strlen (&proto[0]) >= sizeof (flow.proto) || strlen (&dataRate[0]) >= sizeof (flow.dataRate))
+        {
+          return Fail (name, n, "too long protocol or dataRate string");
+        }
+      flow.fromNode = from;
+      flow.toNode = to;
+      strcpy (flow.proto, &proto[0]);
+      strcpy (flow.dataRate, &dataRate[0]);
+      m_flows.push_back (flow);
+    }
+  return true;
+}
+
+bool
+FlywayFlowTable::ReadBinary (FILE *f, std::string name)
+{
+  uint32_t version, recordSize, n;
+  if (!Read (f, &version) || !Read (f, &recordSize) || !Read (f, &n))
+    {
+      return Fail (name, 0, "truncated header");
+    }
+  if (version != g_flowVersion || recordSize != sizeof (struct FlywayFlow))
+    {
+      std::ostringstream oss;
+      oss << "unsupported version " << version << " with records of " << recordSize << " bytes";
+      return Fail (name, 0, oss.str ());
+    }
+  if (!HasRecords (f, n, sizeof (struct FlywayFlow)))
+    {
+      return Fail (name, 0, "truncated flows");
+    }
+  uint32_t start = m_flows.size ();
+  m_flows.resize (start + n);
+  if (n > 0 && fread (&m_flows[start], sizeof (struct FlywayFlow), n, f) != n)
+    {
+      m_flows.resize (start);
+      return Fail (name, 0, "truncated flows");
+    }
+  for (uint32_t i = start; i < m_flows.size (); i++)
+    {
+      const struct FlywayFlow &flow = m_flows[i];
+      if (memchr (flow.proto, 0, sizeof (flow.proto)) == 0 || memchr (flow.dataRate, 0, sizeof (flow.dataRate)) == 0)
+        {
+          m_flows.resize (start);
+          std::ostringstream oss;
+          oss << "flow " << i - start << " has an unterminated string";
+          return Fail (name, 0, oss.str ());
+        }
+    }
+  return true;
+}
+
+bool
+FlywayFlowTable::WriteBinary (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  FILE *f = fopen (filename.c_str (), "wb");
+  if (f == 0)
+    {
+      return Fail (filename, 0, "cannot write flow file");
+    }
+  bool ok = fwrite (g_flowMagic, 1, 4, f) == 4
+    && Write (f, g_flowVersion)
+    && Write<uint32_t> (f, sizeof (struct FlywayFlow))
+    && Write<uint32_t> (f, m_flows.size ())
+    && (m_flows.empty () || fwrite (&m_flows[0], sizeof (struct FlywayFlow), m_flows.size (), f) == m_flows.size ());
+  ok = fclose (f) == 0 && ok;
+  if (!ok)
+    {
+      return Fail (filename, 0, "cannot write flow file");
+    }
+  return true;
+}
+
+std::string
+FlywayFlowTable::GetError (void) const
+{
+  return m_error;
+}
+
+uint32_t
+FlywayFlowTable::GetN (void) const
+{
+  return m_flows.size ();
+}
+
+const struct FlywayFlow &
+FlywayFlowTable::Get (uint32_t i) const
+{
+  NS_ASSERT (i < m_flows.size ());
+  return m_flows[i];
+}
+
+void
+FlywayFlowTable::Add (const struct FlywayFlow &flow)
+{
+  m_flows.push_back (flow);
+}
+
+void
+FlywayFlowTable::Clear (void)
+{
+  m_flows.clear ();
+}
+
+
+FlywayCompletionTable::FlywayCompletionTable ()
+  : m_completed (0)
+{}
+
+bool
+FlywayCompletionTable::Fail (std::string name, std::string what)
+{
+  m_error = name + ": " + what;
+  NS_LOG_WARN (m_error);
+  return false;
+}
+
+void
+FlywayCompletionTable::Reserve (uint32_t n)
+{
+  m_rows.reserve (n);
+}
+
+uint32_t
+FlywayCompletionTable::Add (float beginTime, uint32_t fromNode, uint32_t toNode, int32_t linkType)
+{
+  struct FlywayCompletion row;
+  memset (&row, 0, sizeof (row));
+  row.beginTime = beginTime;
+  row.fromNode = fromNode;
+  row.toNode = toNode;
+  row.linkType = linkType;
+  row.completionTime = -1;
+  m_rows.push_back (row);
+  return m_rows.size () - 1;
+}
+
+void
+FlywayCompletionTable::Complete (uint32_t i, uint64_t rxBytes, double completionTime)
+{
+  NS_ASSERT (i < m_rows.size () && completionTime >= 0);
+  if (!IsCompleted (i))
+    {
+      m_completed++;
+    }
+  m_rows[i].rxBytes = rxBytes;
+  m_rows[i].completionTime = completionTime;
+}
+
+void
+FlywayCompletionTable::SetRxBytes (uint32_t i, uint64_t rxBytes)
+{
+  NS_ASSERT (i < m_rows.size () && !IsCompleted (i));
+  m_rows[i].rxBytes = rxBytes;
+}
+
+uint32_t
+FlywayCompletionTable::GetN (void) const
+{
+  return m_rows.size ();
+}
+
+uint32_t
+FlywayCompletionTable::GetNCompleted (void) const
+{
+  return m_completed;
+}
+
+bool
+FlywayCompletionTable::IsCompleted (uint32_t i) const
+{
+  NS_ASSERT (i < m_rows.size ());
+  return m_rows[i].completionTime >= 0;
+}
+
+const struct FlywayCompletion &
+FlywayCompletionTable::Get (uint32_t i) const
+{
+  NS_ASSERT (i < m_rows.size ());
+  return m_rows[i];
+}
+
+void
+FlywayCompletionTable::Clear (void)
+{
+  m_rows.clear ();
+  m_completed = 0;
+}
+
+bool
+FlywayCompletionTable::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  bool binary;
+  FILE *f = OpenTable (filename, g_completionMagic, &binary);
+  if (f == 0)
+    {
+      return Fail (filename, "cannot read completion file");
+    }
+  uint32_t version, recordSize, n;
+  bool ok = binary && Read (f, &version) && Read (f, &recordSize) && Read (f, &n);
+  if (ok && (version != g_completionVersion || recordSize != sizeof (struct FlywayCompletion)))
+    {
+      fclose (f);
+      std::ostringstream oss;
+      oss << "unsupported version " << version << " with records of " << recordSize << " bytes";
+      return Fail (filename, oss.str ());
+    }
+  ok = ok && HasRecords (f, n, sizeof (struct FlywayCompletion));
+  std::vector<struct FlywayCompletion> rows (ok ? n : 0);
+  ok = ok && (n == 0 || fread (&rows[0], sizeof (struct FlywayCompletion), n, f) == n);
+  fclose (f);
+  if (!ok)
+    {
+      return Fail (filename, "not a complete binary completion file");
+    }
+  Clear ();
+  m_rows.swap (rows);
+  for (uint32_t i = 0; i < m_rows.size (); i++)
+    {
+      m_completed += IsCompleted (i);
+    }
+  return true;
+}
+
+bool
+FlywayCompletionTable::WriteCsv (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  FILE *f = fopen (filename.c_str (), "w");
+  if (f == 0)
+    {
+      return Fail (filename, "cannot write completion file");
+    }
+  fprintf (f, "flow,begin_time,from,to,link_type,rx_bytes,fct\n");
+  for (uint32_t i = 0; i < m_rows.size (); i++)
+    {
+      const struct FlywayCompletion &row = m_rows[i];
+      fprintf (f, "%u,%.9g,%u,%u,%d,%llu,", i, row.beginTime, row.fromNode, row.toNode,
+               row.linkType, (unsigned long long)row.rxBytes);
+      if (IsCompleted (i))
+        {
+          fprintf (f, "%.9f", row.completionTime);
+        }
+      fputc ('\n', f);
+    }
+  bool ok = !ferror (f);
+  ok = fclose (f) == 0 && ok;
+  if (!ok)
+    {
+      return Fail (filename, "cannot write completion file");
+    }
+  return true;
+}
+
+bool
+FlywayCompletionTable::WriteBinary (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  FILE *f = fopen (filename.c_str (), "wb");
+  if (f == 0)
+    {
+      return Fail (filename, "cannot write completion file");
+    }
+  bool ok = fwrite (g_completionMagic, 1, 4, f) == 4
+    && Write (f, g_completionVersion)
+    && Write<uint32_t> (f, sizeof (struct FlywayCompletion))
+    && Write<uint32_t> (f, m_rows.size ())
+    && (m_rows.empty () || fwrite (&m_rows[0], sizeof (struct FlywayCompletion), m_rows.size (), f) == m_rows.size ());
+  ok = fclose (f) == 0 && ok;
+  if (!ok)
+    {
+      return Fail (filename, "cannot write completion file");
+    }
+  return true;
+}
+
+bool
+FlywayCompletionTable::Save (std::string filename)
+{
+  std::string::size_type len = filename.size ();
+  if (len > 4 && filename.compare (len - 4, 4, ".bin") == 0)
+    {
+      return WriteBinary (filename);
+    }
+  return WriteCsv (filename);
+}
+
+std::string
+FlywayCompletionTable::GetError (void) const
+{
+  return m_error;
+}
+
+
+FlywayTopoTable::FlywayTopoTable ()
+{}
+
+FlywayTopoTable::FlywayTopoTable (const GlobalOpt &options)
+  : m_options (options)
+{}
+
+bool
+FlywayTopoTable::Fail (std::string name, uint32_t line, std::string what)
+{
+  std::ostringstream oss;
+  oss << name << ":";
+  if (line > 0)
+    {
+      oss << line << ":";
+    }
+  oss << " " << what;
+  m_error = oss.str ();
+  NS_LOG_WARN (m_error);
+  return false;
+}
+
+bool
+FlywayTopoTable::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  bool binary;
+  FILE *f = OpenTable (filename, g_topoMagic, &binary);
+  if (f == 0)
+    {
+      return Fail (filename, 0, "cannot read topo");
+    }
+  bool ok = binary ? ReadBinary (f, filename) : ReadText (f, filename);
+  fclose (f);
+  return ok;
+}
+
+/* The value of a "Key: value" line, or 0 if line is not about key. */
+static const char *
+Value (const std::string &line, const char *key)
+{
+  if (line.compare (0, strlen (key), key) != 0)
+    {
+      return 0;
+    }
+  std::string::size_type colon = line.find (':');
+  return colon == std::string::npos ? "" : line.c_str () + colon + 1;
+}
+
+bool
+FlywayTopoTable::ReadText (FILE *f, std::string name)
+{
+  std::string line;
+  uint32_t n = 0;
+  while (ReadLine (f, &line))
+    {
+      n++;
+      if (line[0] == '#')
+        {
+          continue;
+        }
+      const char *value;
+      int i;
+      float x;
+      std::vector<char> s (line.size () + 1);
+      if ((value = Value (line, "DonglesPerTor:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'DonglesPerTor: int'");
+            }
+          m_options.donglesPerTor = i;
+        }
+      else if ((value = Value (line, "Antenna:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'Antenna: int'");
+            }
+          if (i == 0)
+            {
+              printf ("setting cone antenna\n");
+              m_options.antenna = FW_Antenna_Cone;
+            }
+          else if (i == 1)
+            {
+              printf ("setting measured antenna\n");
+              m_options.antenna = FW_Antenna_Measured;
+            }
+          else
+            {
+              return Fail (name, n, "only valid antenna types are 0 or 1");
+            }
+        }
+      else if ((value = Value (line, "DonglesPerAgg:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'DonglesPerAgg: int'");
+            }
+          m_options.donglesPerAgg = i;
+        }
+      else if ((value = Value (line, "DonglesPerL3:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'DonglesPerL3: int'");
+            }
+          m_options.donglesPerL3 = i;
+        }
+      else if ((value = Value (line, "FlywayBandwidth:")) != 0)
+        {
+          if (sscanf (value, " %s", &s[0]) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'FlywayBandwidth: bandwidth'");
+            }
+          m_options.flywayBandwidth = DataRate (&s[0]);
+        }
+      else if ((value = Value (line, "NUM-TORS:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'NUM-TORS: int'");
+            }
+          m_options.numTors = i;
+        }
+      else if ((value = Value (line, "Agg2L3_Bandwidth:")) != 0)
+        {
+          if (sscanf (value, " %s", &s[0]) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'Agg2L3_Bandwidth: bandwidth'");
+            }
+          m_options.agg2L3_Bandwidth = DataRate (&s[0]);
+        }
+      else if ((value = Value (line, "Tor2Agg_Bandwidth:")) != 0)
+        {
+          if (sscanf (value, " %s", &s[0]) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'Tor2Agg_Bandwidth: bandwidth'");
+            }
+          m_options.tor2Agg_Bandwidth = DataRate (&s[0]);
+        }
+      else if ((value = Value (line, "ReplayFlowFile:")) != 0)
+        {
+          if (sscanf (value, " %s", &s[0]) != 1 || strlen (&s[0]) > GO_MAX_FILENAMELEN - 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'ReplayFlowFile: fileName'");
+            }
+          strcpy (m_options.replayFlowFileName, &s[0]);
+          m_options.trafficType = FW_TT_ReplayFlows;
+        }
+      else if ((value = Value (line, "AggFanOut:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'AggFanOut: int'");
+            }
+          m_options.aggFanOut = i;
+        }
+      else if ((value = Value (line, "L3FanOut:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'L3FanOut: int'");
+            }
+          m_options.l3FanOut = i;
+        }
+      // the values are read as floats, as they always have been
+      else if ((value = Value (line, "RackWidth")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'RackWidth: float'");
+            }
+          m_options.rackWidth_meter = x;
+        }
+      else if ((value = Value (line, "RackHeight")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'RackHeight: float'");
+            }
+          m_options.rackHeight_meter = x;
+        }
+      else if ((value = Value (line, "ClumpNumRacks")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'ClumpNumRacks: int'");
+            }
+          m_options.clumpNumRacks = (uint)i;
+        }
+      else if ((value = Value (line, "ClumpSpaceLeft")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'ClumpSpaceLeft: float'");
+            }
+          m_options.clumpSpaceLeft_meter = x;
+        }
+      else if ((value = Value (line, "ClumpSpaceBelow")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'ClumpSpaceBelow: float'");
+            }
+          m_options.clumpSpaceBelow_meter = x;
+        }
+      else if ((value = Value (line, "ScaleDownBy")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'ScaleDownBy: float'");
+            }
+          m_options.scaleDownBy = x;
+        }
+      else if ((value = Value (line, "Arrangement")) != 0)
+        {
+          if (strcmp (value, "Square") == 0)
+            {
+              m_options.arrangeType = FW_ToA_Square;
+            }
+          else if (sscanf (value, " %s", &s[0]) == 1 && strcmp (&s[0], "Rows") == 0)
+            {
+              m_options.arrangeType = FW_ToA_Rows;
+            }
+          else
+            {
+              m_options.arrangeType = FW_ToA_Unknown;
+            }
+        }
+      else if ((value = Value (line, "Topology:")) != 0)
+        {
+          if (sscanf (value, " %s", &s[0]) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'Topology: Classic|FatTree|VL2|LeafSpine'");
+            }
+          if (strcmp (&s[0], "Classic") == 0)
+            {
+              m_options.topology = FW_Topo_Classic;
+            }
+          else if (strcmp (&s[0], "FatTree") == 0)
+            {
+              m_options.topology = FW_Topo_FatTree;
+            }
+          else if (strcmp (&s[0], "VL2") == 0)
+            {
+              m_options.topology = FW_Topo_VL2;
+            }
+          else if (strcmp (&s[0], "LeafSpine") == 0)
+            {
+              m_options.topology = FW_Topo_LeafSpine;
+            }
+          else
+            {
+              return Fail (name, n, "unknown topology " + std::string (&s[0]));
+            }
+        }
+      else if ((value = Value (line, "FatTreeK:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'FatTreeK: int'");
+            }
+          m_options.fatTreeK = i;
+        }
+      else if ((value = Value (line, "Spines:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'Spines: int'");
+            }
+          m_options.numSpines = i;
+        }
+      else if ((value = Value (line, "Oversubscription:")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'Oversubscription: float'");
+            }
+          m_options.oversubscription = x;
+        }
+      else if ((value = Value (line, "RackBandwidth:")) != 0)
+        {
+          if (sscanf (value, " %s", &s[0]) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'RackBandwidth: bandwidth'");
+            }
+          m_options.rackBandwidth = DataRate (&s[0]);
+        }
+      else if ((value = Value (line, "RacksPerRow:")) != 0)
+        {
+          if (sscanf (value, " %d", &i) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'RacksPerRow: int'");
+            }
+          m_options.racksPerRow = i;
+        }
+      else if ((value = Value (line, "AisleWidth:")) != 0)
+        {
+          if (sscanf (value, " %f", &x) != 1)
+            {
+              return Fail (name, n, "bad line [" + line + "] shld be 'AisleWidth: float'");
+            }
+          m_options.aisleWidth_meter = x;
+        }
+      else if ((value = Value (line, "Standard")) != 0)
+        {
+          m_options.standard = strcmp (value, "SC") == 0 ? FW_Standard_SC : FW_Standard_OFDM;
+        }
+      else
+        {
+          printf ("%s: Ignoring %d:[%s]\n", "flyways-topo-helper", n, line.c_str ());
+        }
+    }
+  return true;
+}
+
+bool
+FlywayTopoTable::ReadBinary (FILE *f, std::string name)
+{
+  uint32_t version;
+  if (!Read (f, &version))
+    {
+      return Fail (name, 0, "truncated header");
+    }
+  if (version == 0 || version > g_topoVersion)
+    {
+      std::ostringstream oss;
+      oss << "unsupported version " << version;
+      return Fail (name, 0, oss.str ());
+    }
+  int32_t numTors, aggFanOut, l3FanOut, donglesPerTor, donglesPerAgg, donglesPerL3;
+  int32_t antenna, standard, arrangeType, trafficType;
+  uint32_t clumpNumRacks;
+  double rackWidth, rackHeight, clumpSpaceLeft, clumpSpaceBelow, scaleDownBy;
+  uint64_t agg2L3, tor2Agg, flyway;
+  GlobalOpt &o = m_options;
+  if (!Read (f, &numTors) || !Read (f, &aggFanOut) || !Read (f, &l3FanOut)
+      || !Read (f, &donglesPerTor) || !Read (f, &donglesPerAgg) || !Read (f, &donglesPerL3)
+      || !Read (f, &rackWidth) || !Read (f, &rackHeight) || !Read (f, &clumpNumRacks)
+      || !Read (f, &clumpSpaceLeft) || !Read (f, &clumpSpaceBelow) || !Read (f, &scaleDownBy)
+      || !Read (f, &antenna) || !Read (f, &standard) || !Read (f, &arrangeType)
+      || !Read (f, &agg2L3) || !Read (f, &tor2Agg) || !Read (f, &flyway)
+      || !Read (f, &trafficType)
+      || fread (o.replayFlowFileName, 1, GO_MAX_FILENAMELEN, f) != GO_MAX_FILENAMELEN)
+    {
+      return Fail (name, 0, "truncated options");
+    }
+  o.replayFlowFileName[GO_MAX_FILENAMELEN - 1] = 0;
+  o.numTors = numTors;
+  o.aggFanOut = aggFanOut;
+  o.l3FanOut = l3FanOut;
+  o.donglesPerTor = donglesPerTor;
+  o.donglesPerAgg = donglesPerAgg;
+  o.donglesPerL3 = donglesPerL3;
+  o.rackWidth_meter = rackWidth;
+  o.rackHeight_meter = rackHeight;
+  o.clumpNumRacks = clumpNumRacks;
+  o.clumpSpaceLeft_meter = clumpSpaceLeft;
+  o.clumpSpaceBelow_meter = clumpSpaceBelow;
+  o.scaleDownBy = scaleDownBy;
+  o.antenna = (FW_AntennaType)antenna;
+  o.standard = (FW_StandardType)standard;
+  o.arrangeType = (FW_TypeOfArrangement)arrangeType;
+  o.agg2L3_Bandwidth = DataRate (agg2L3);
+  o.tor2Agg_Bandwidth = DataRate (tor2Agg);
+  o.flywayBandwidth = DataRate (flyway);
+  o.trafficType = (FW_TrafficType)trafficType;
+  if (version < 2)
+    {
+      return true;
+    }
+
+  int32_t topology, fatTreeK, numSpines, racksPerRow;
+  double oversubscription, aisleWidth;
+  uint64_t rack;
+  if (!Read (f, &topology) || !Read (f, &fatTreeK) || !Read (f, &numSpines)
+      || !Read (f, &oversubscription) || !Read (f, &rack)
+      || !Read (f, &racksPerRow) || !Read (f, &aisleWidth))
+    {
+      return Fail (name, 0, "truncated options");
+    }
+  o.topology = (FW_Topology)topology;
+  o.fatTreeK = fatTreeK;
+  o.numSpines = numSpines;
+  o.oversubscription = oversubscription;
+  o.rackBandwidth = DataRate (rack);
+  o.racksPerRow = racksPerRow;
+  o.aisleWidth_meter = aisleWidth;
+  return true;
+}
+
+bool
+FlywayTopoTable::WriteBinary (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  FILE *f = fopen (filename.c_str (), "wb");
+  if (f == 0)
+    {
+      return Fail (filename, 0, "cannot write topo");
+    }
+  const GlobalOpt &o = m_options;
+  bool ok = fwrite (g_topoMagic, 1, 4, f) == 4
+    && Write (f, g_topoVersion)
+    && Write<int32_t> (f, o.numTors) && Write<int32_t> (f, o.aggFanOut) && Write<int32_t> (f, o.l3FanOut)
+    && Write<int32_t> (f, o.donglesPerTor) && Write<int32_t> (f, o.donglesPerAgg) && Write<int32_t> (f, o.donglesPerL3)
+    && Write<double> (f, o.rackWidth_meter) && Write<double> (f, o.rackHeight_meter)
+    && Write<uint32_t> (f, o.clumpNumRacks)
+    && Write<double> (f, o.clumpSpaceLeft_meter) && Write<double> (f, o.clumpSpaceBelow_meter)
+    && Write<double> (f, o.scaleDownBy)
+    && Write<int32_t> (f, o.antenna) && Write<int32_t> (f, o.standard) && Write<int32_t> (f, o.arrangeType)
+    && Write<uint64_t> (f, o.agg2L3_Bandwidth.GetBitRate ())
+    && Write<uint64_t> (f, o.tor2Agg_Bandwidth.GetBitRate ())
+    && Write<uint64_t> (f, o.flywayBandwidth.GetBitRate ())
+    && Write<int32_t> (f, o.trafficType)
+    && fwrite (o.replayFlowFileName, 1, GO_MAX_FILENAMELEN, f) == GO_MAX_FILENAMELEN
+    && Write<int32_t> (f, o.topology) && Write<int32_t> (f, o.fatTreeK) && Write<int32_t> (f, o.numSpines)
+    && Write<double> (f, o.oversubscription) && Write<uint64_t> (f, o.rackBandwidth.GetBitRate ())
+    && Write<int32_t> (f, o.racksPerRow) && Write<double> (f, o.aisleWidth_meter);
+  ok = fclose (f) == 0 && ok;
+  if (!ok)
+    {
+      return Fail (filename, 0, "cannot write topo");
+    }
+  return true;
+}
+
+std::string
+FlywayTopoTable::GetError (void) const
+{
+  return m_error;
+}
+
+const GlobalOpt &
+FlywayTopoTable::Get (void) const
+{
+  return m_options;
+}
+
+} // namespace ns3
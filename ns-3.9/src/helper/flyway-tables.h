@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef FLYWAY_TABLES_H
+#define FLYWAY_TABLES_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "flyways-topo-helper.h"
+
+namespace ns3 {
+
+/**
+ * \brief one flow of a flow table.
+ *
+ * This is also the layout of a record of the binary format: 60 bytes,
+ * without padding, in the byte order of the machine.
+ */
+struct FlywayFlow
+{
+  float beginTime;
+  uint32_t fromNode;
+  uint32_t toNode;
+  float transferSize;
+  // 1 for a flyway, 2 for the wired network, as in the allocation files
+  int32_t linkType;
+  char proto[10];
+  char dataRate[30];
+};
+
+/**
+ * \brief the flows replayed by FlywaysTopoHelper, read from a text or a
+ *        binary file.
+ *
+ * A line of the text format is
+ *
+ *     beginTime fromNode toNode proto transferSize dataRate linkType
+ *
+ * Lines starting with '#' and empty lines are skipped. The binary format
+ * is a header, the magic "FWFL", the version, the size of a record and
+ * the number of flows, all uint32_t but the magic, followed by the flows
+ * as they are in memory, so that they are read in a single call.
+ */
+class FlywayFlowTable
+{
+public:
+  /**
+   * \param filename a flow file, in the binary or the text format
+   * \returns false, with the reason in GetError, if the file cannot be
+   *          read. The flows read so far are kept.
+   */
+  bool Load (std::string filename);
+  /**
+   * \param f the text to read the flows from
+   * \param name the name of the file, for the errors
+   */
+  bool ReadText (FILE *f, std::string name);
+  bool WriteBinary (std::string filename);
+  std::string GetError (void) const;
+
+  uint32_t GetN (void) const;
+  const struct FlywayFlow &Get (uint32_t i) const;
+  void Add (const struct FlywayFlow &flow);
+  void Clear (void);
+
+private:
+  bool ReadBinary (FILE *f, std::string name);
+  bool Fail (std::string name, uint32_t line, std::string what);
+
+  std::vector<struct FlywayFlow> m_flows;
+  std::string m_error;
+};
+
+/**
+ * \brief how one flow replayed by FlywaysTopoHelper completed.
+ *
+ * This is also the layout of a record of the binary format: 32 bytes,
+ * without padding, in the byte order of the machine.
+ */
+struct FlywayCompletion
+{
+  float beginTime;
+  uint32_t fromNode;
+  uint32_t toNode;
+  // the path of the flow: 1 for a flyway, 2 for the wired network
+  int32_t linkType;
+  uint64_t rxBytes;
+  // seconds from beginTime until the last byte was received, negative
+  // while the flow has not completed
+  double completionTime;
+};
+
+/**
+ * \brief the flow completion times of a simulation, one row per flow.
+ *
+ * The rows are added as the flows are set up, and filled in when their
+ * sinks have received everything; nothing polls them in between. The CSV
+ * format has a header line and one line per flow:
+ *
+ *     flow,begin_time,from,to,link_type,rx_bytes,fct
+ *
+ * with an empty fct for the flows which have not completed. The binary
+ * format is the magic "FWCT", the version, the size of a record and the
+ * number of rows, all uint32_t but the magic, followed by the rows.
+ */
+class FlywayCompletionTable
+{
+public:
+  FlywayCompletionTable ();
+
+  void Reserve (uint32_t n);
+  /**
+   * \returns the index of the row of the flow, which has not completed
+   */
+  uint32_t Add (float beginTime, uint32_t fromNode, uint32_t toNode, int32_t linkType);
+  void Complete (uint32_t i, uint64_t rxBytes, double completionTime);
+  /**
+   * Record the bytes received by a flow which has not completed.
+   */
+  void SetRxBytes (uint32_t i, uint64_t rxBytes);
+
+  uint32_t GetN (void) const;
+  uint32_t GetNCompleted (void) const;
+  bool IsCompleted (uint32_t i) const;
+  const struct FlywayCompletion &Get (uint32_t i) const;
+  void Clear (void);
+
+  /**
+   * \param filename a table written by WriteBinary
+   */
+  bool Load (std::string filename);
+  bool WriteCsv (std::string filename);
+  bool WriteBinary (std::string filename);
+  /**
+   * Write the table in the binary format if filename ends in ".bin",
+   * and as CSV otherwise.
+   */
+  bool Save (std::string filename);
+  std::string GetError (void) const;
+
+private:
+  bool Fail (std::string name, std::string what);
+
+  std::vector<struct FlywayCompletion> m_rows;
+  uint32_t m_completed;
+  std::string m_error;
+};
+
+/**
+ * \brief the options of a FlywaysTopoHelper, read from a text or a binary
+ *        topology file.
+ *
+ * A line of the text format is "Key: value"; lines starting with '#' are
+ * skipped and unknown keys are ignored. Keys missing from the file keep
+ * the values the table started with. The binary format is the magic
+ * "FWTP" and the version, followed by every option. Files of version 1
+ * end before the options of the generated topologies and of the rows,
+ * which then keep the values the table started with.
+ *
+ * The options are those written in the file: ScaleDownBy is not applied
+ * to the bandwidths yet.
+ */
+class FlywayTopoTable
+{
+public:
+  FlywayTopoTable ();
+  /**
+   * \param options the values of the keys missing from the file
+   */
+  FlywayTopoTable (const GlobalOpt &options);
+
+  bool Load (std::string filename);
+  bool ReadText (FILE *f, std::string name);
+  bool WriteBinary (std::string filename);
+  std::string GetError (void) const;
+
+  const GlobalOpt &Get (void) const;
+
+private:
+  bool ReadBinary (FILE *f, std::string name);
+  bool Fail (std::string name, uint32_t line, std::string what);
+
+  GlobalOpt m_options;
+  std::string m_error;
+};
+
+} // namespace ns3
+
+#endif /* FLYWAY_TABLES_H */
@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "flyway-topology-plan.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("FlywayTopologyPlan");
+
+namespace ns3 {
+
+FlywayTopologyPlan::FlywayTopologyPlan (uint32_t numTors, uint32_t numMiddle, uint32_t numTop)
+  : m_numTors (numTors),
+    m_numMiddle (numMiddle),
+    m_numTop (numTop)
+{}
+
+FlywayTopologyPlan
+FlywayTopologyPlan::Generate (const GlobalOpt &options)
+{
+  switch (options.topology)
+    {
+    case FW_Topo_FatTree:
+      return FatTree (options.fatTreeK, options.rackBandwidth, options.oversubscription);
+    case FW_Topo_VL2:
+      // as many intermediates as a pair of aggregation switches has ToRs,
+      // unless told otherwise: the aggregation switches are then balanced
+      return Vl2 (options.numTors, options.aggFanOut,
+                  options.numSpines > 0 ? options.numSpines : options.aggFanOut,
+                  options.rackBandwidth, options.oversubscription);
+    case FW_Topo_LeafSpine:
+      return LeafSpine (options.numTors, options.numSpines, options.rackBandwidth, options.oversubscription);
+    case FW_Topo_Classic:
+    default:
+      return Classic (options.numTors, options.aggFanOut, options.l3FanOut,
+                      options.tor2Agg_Bandwidth, options.agg2L3_Bandwidth);
+    }
+}
+
+FlywayTopologyPlan
+FlywayTopologyPlan::Classic (uint32_t numTors, uint32_t aggFanOut, uint32_t l3FanOut,
+                             DataRate tor2Agg, DataRate agg2L3)
+{
+  if (numTors == 0 || aggFanOut == 0 || l3FanOut == 0)
+    {
+      NS_FATAL_ERROR ("classic topology needs ToRs, AggFanOut and L3FanOut");
+    }
+  uint32_t numAggs = 2 * ((numTors + aggFanOut - 1) / aggFanOut);
+  uint32_t numL3s = 2 * ((numAggs + l3FanOut - 1) / l3FanOut);
+  FlywayTopologyPlan plan (numTors, numAggs, numL3s);
+  plan.m_links.reserve (2 * (numTors + numAggs));
+
+  uint32_t agg = numTors;
+  for (uint32_t tor = 0; tor < numTors; tor++)
+    {
+      plan.AddLink (tor, agg, tor2Agg);
+      plan.AddLink (tor, agg + 1, tor2Agg);
+      if (tor != numTors - 1 && (tor + 1) % aggFanOut == 0)
+        {
+          agg += 2;
+        }
+    }
+  uint32_t l3 = numTors + numAggs;
+  for (uint32_t i = 0; i < numAggs; i++)
+    {
+      plan.AddLink (numTors + i, l3, agg2L3);
+      plan.AddLink (numTors + i, l3 + 1, agg2L3);
+      if (i != numAggs - 1 && (i + 1) % l3FanOut == 0)
+        {
+          l3 += 2;
+        }
+    }
+  return plan;
+}
+
+FlywayTopologyPlan
+FlywayTopologyPlan::FatTree (uint32_t k, DataRate rackBandwidth, double oversubscription)
+{
+  if (k < 2 || k % 2 != 0)
+    {
+      NS_FATAL_ERROR ("fat-tree needs an even FatTreeK, not " << k);
+    }
+  uint32_t half = k / 2;
+  uint32_t numTors = k * half;
+  uint32_t numAggs = k * half;
+  FlywayTopologyPlan plan (numTors, numAggs, half * half);
+  plan.m_links.reserve (numTors * half + numAggs * half);
+
+  DataRate rate = UplinkRate (rackBandwidth, half, oversubscription);
+  for (uint32_t tor = 0; tor < numTors; tor++)
+    {
+      uint32_t pod = tor / half;
+      for (uint32_t j = 0; j < half; j++)
+        {
+          plan.AddLink (tor, numTors + pod * half + j, rate);
+        }
+    }
+  // as many links up as down at an aggregation switch, at the same rate
+  uint32_t core = numTors + numAggs;
+  for (uint32_t agg = 0; agg < numAggs; agg++)
+    {
+      uint32_t j = agg % half;
+      for (uint32_t m = 0; m < half; m++)
+        {
+          plan.AddLink (numTors + agg, core + j * half + m, rate);
+        }
+    }
+  return plan;
+}
+
+FlywayTopologyPlan
+FlywayTopologyPlan::Vl2 (uint32_t numTors, uint32_t aggFanOut, uint32_t numIntermediates,
+                         DataRate rackBandwidth, double oversubscription)
+{
+  if (numTors == 0 || aggFanOut == 0 || numIntermediates == 0)
+    {
+      NS_FATAL_ERROR ("VL2 topology needs ToRs, AggFanOut and intermediate switches");
+    }
+  uint32_t numAggs = 2 * ((numTors + aggFanOut - 1) / aggFanOut);
+  FlywayTopologyPlan plan (numTors, numAggs, numIntermediates);
+  plan.m_links.reserve (2 * numTors + numAggs * numIntermediates);
+
+  DataRate torRate = UplinkRate (rackBandwidth, 2, oversubscription);
+  for (uint32_t tor = 0; tor < numTors; tor++)
+    {
+      uint32_t agg = numTors + 2 * (tor / aggFanOut);
+      plan.AddLink (tor, agg, torRate);
+      plan.AddLink (tor, agg + 1, torRate);
+    }
+  // an aggregation switch of a full pair has aggFanOut ToRs below
+  DataRate aggRate = DataRate (torRate.GetBitRate () * aggFanOut / numIntermediates);
+  uint32_t intermediate = numTors + numAggs;
+  for (uint32_t agg = 0; agg < numAggs; agg++)
+    {
+      for (uint32_t i = 0; i < numIntermediates; i++)
+        {
+          plan.AddLink (numTors + agg, intermediate + i, aggRate);
+        }
+    }
+  return plan;
+}
+
+FlywayTopologyPlan
+FlywayTopologyPlan::LeafSpine (uint32_t numLeaves, uint32_t numSpines,
+                               DataRate rackBandwidth, double oversubscription)
+{
+  if (numLeaves == 0 || numSpines == 0)
+    {
+      NS_FATAL_ERROR ("leaf-spine topology needs ToRs and Spines");
+    }
+  FlywayTopologyPlan plan (numLeaves, numSpines, 0);
+  plan.m_links.reserve (numLeaves * numSpines);
+
+  DataRate rate = UplinkRate (rackBandwidth, numSpines, oversubscription);
+  for (uint32_t leaf = 0; leaf < numLeaves; leaf++)
+    {
+      for (uint32_t spine = 0; spine < numSpines; spine++)
+        {
+          plan.AddLink (leaf, numLeaves + spine, rate);
+        }
+    }
+  return plan;
+}
+
+DataRate
+FlywayTopologyPlan::UplinkRate (DataRate rackBandwidth, uint32_t uplinks, double oversubscription)
+{
+  if (oversubscription <= 0)
+    {
+      NS_FATAL_ERROR ("oversubscription must be positive, not " << oversubscription);
+    }
+  return DataRate ((uint64_t)(rackBandwidth.GetBitRate () / (uplinks * oversubscription)));
+}
+
+void
+FlywayTopologyPlan::AddLink (uint32_t lower, uint32_t upper, DataRate rate)
+{
+  NS_ASSERT (lower < upper && upper < GetNumNodes ());
+  Link link;
+  link.lower = lower;
+  link.upper = upper;
+  link.rate = rate;
+  m_links.push_back (link);
+}
+
+uint32_t
+FlywayTopologyPlan::GetNumTors (void) const
+{
+  return m_numTors;
+}
+
+uint32_t
+FlywayTopologyPlan::GetNumMiddle (void) const
+{
+  return m_numMiddle;
+}
+
+uint32_t
+FlywayTopologyPlan::GetNumTop (void) const
+{
+  return m_numTop;
+}
+
+uint32_t
+FlywayTopologyPlan::GetNumNodes (void) const
+{
+  return m_numTors + m_numMiddle + m_numTop;
+}
+
+uint32_t
+FlywayTopologyPlan::GetNLinks (void) const
+{
+  return m_links.size ();
+}
+
+const FlywayTopologyPlan::Link &
+FlywayTopologyPlan::GetLink (uint32_t i) const
+{
+  NS_ASSERT (i < m_links.size ());
+  return m_links[i];
+}
+
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef FLYWAY_TOPOLOGY_PLAN_H
+#define FLYWAY_TOPOLOGY_PLAN_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/data-rate.h"
+#include "flyways-topo-helper.h"
+
+namespace ns3 {
+
+/**
+ * \brief the wired network of a data center, as the list of its links.
+ *
+ * The nodes are numbered tier by tier: the ToRs first, then the switches
+ * of the middle tier (aggregation switches, or the spines of a
+ * leaf-spine network), then those of the top tier (L3, core or
+ * intermediate switches), if any. A generator only decides which nodes
+ * are linked and at which rate; FlywaysTopoHelper builds the links, and
+ * gives them their addresses, in the order in which they were added.
+ *
+ * The oversubscription of a generated network is that of its ToRs: the
+ * bandwidth of the servers of a rack over that of the uplinks of the
+ * rack. The tiers above the ToRs are non-blocking.
+ */
+class FlywayTopologyPlan
+{
+public:
+  struct Link
+  {
+    uint32_t lower;
+    uint32_t upper;
+    DataRate rate;
+  };
+
+  /**
+   * \returns the network which options.topology asks for
+   */
+  static FlywayTopologyPlan Generate (const GlobalOpt &options);
+  /**
+   * ToRs under pairs of aggregation switches, aggFanOut ToRs per pair,
+   * and the aggregation switches under pairs of L3 switches, l3FanOut
+   * per pair: the network FlywaysTopoHelper has always built.
+   */
+  static FlywayTopologyPlan Classic (uint32_t numTors, uint32_t aggFanOut, uint32_t l3FanOut,
+                                     DataRate tor2Agg, DataRate agg2L3);
+  /**
+   * The k-ary fat-tree: k pods of k/2 ToRs and k/2 aggregation switches,
+   * every ToR of a pod under every aggregation switch of the pod, and
+   * (k/2)^2 core switches, the j-th aggregation switch of every pod under
+   * the j-th group of k/2 of them.
+   */
+  static FlywayTopologyPlan FatTree (uint32_t k, DataRate rackBandwidth, double oversubscription);
+  /**
+   * VL2: ToRs under pairs of aggregation switches, aggFanOut ToRs per
+   * pair, and every aggregation switch under each of numIntermediates
+   * intermediate switches.
+   */
+  static FlywayTopologyPlan Vl2 (uint32_t numTors, uint32_t aggFanOut, uint32_t numIntermediates,
+                                 DataRate rackBandwidth, double oversubscription);
+  /**
+   * Every one of numLeaves ToRs under each of numSpines spines, with no
+   * tier above.
+   */
+  static FlywayTopologyPlan LeafSpine (uint32_t numLeaves, uint32_t numSpines,
+                                       DataRate rackBandwidth, double oversubscription);
+
+  uint32_t GetNumTors (void) const;
+  uint32_t GetNumMiddle (void) const;
+  uint32_t GetNumTop (void) const;
+  uint32_t GetNumNodes (void) const;
+  uint32_t GetNLinks (void) const;
+  const Link &GetLink (uint32_t i) const;
+
+private:
+  FlywayTopologyPlan (uint32_t numTors, uint32_t numMiddle, uint32_t numTop);
+  void AddLink (uint32_t lower, uint32_t upper, DataRate rate);
+  // the rate of each of the uplinks of a rack
+  static DataRate UplinkRate (DataRate rackBandwidth, uint32_t uplinks, double oversubscription);
+
+  uint32_t m_numTors;
+  uint32_t m_numMiddle;
+  uint32_t m_numTop;
+  std::vector<Link> m_links;
+};
+
+} // namespace ns3
+
+#endif /* FLYWAY_TOPOLOGY_PLAN_H */
@@ -0,0 +1,471 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4.h"
+#include "ns3/channel.h"
+#include "ns3/data-rate.h"
+#include "ns3/object-vector.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "flyways-topo-helper.h"
+#include "flyway-tables.h"
+#include "flyway-topology-plan.h"
+#include "ipv4-global-routing-helper.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+namespace ns3 {
+
+// options are appended to the topology, and override it
+static FlywaysTopoHelper *
+CreateTopology (std::string dir, std::string options = "")
+{
+  std::string name = dir + "flyways-topo-helper-topo.dat";
+  FILE *f = fopen (name.c_str (), "w");
+  NS_ASSERT (f != 0);
+  fprintf (f, "NUM-TORS: 6\n"
+           "AggFanOut: 6\n"
+           "L3FanOut:2\n"
+           "DonglesPerTor: 1\n"
+           "DonglesPerAgg: 0\n"
+           "DonglesPerL3: 0\n"
+           "RackWidth: 1\n"
+           "RackHeight: 1.3\n"
+           "ClumpNumRacks: 3\n"
+           "ClumpSpaceLeft: 3\n"
+           "ClumpSpaceBelow: 2\n"
+           "%s", options.c_str ());
+  fclose (f);
+
+  InternetStackHelper stack;
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  FlywaysTopoHelper *topo = new FlywaysTopoHelper (const_cast<char *> (name.c_str ()), stack, address);
+  remove (name.c_str ());
+  for (int i = 0; i < topo->GetNumFlyways (); ++i)
+    {
+      topo->PointNowhere (i, 0);
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+  return topo;
+}
+
+static FlywayFlowTable
+CreateFlows (void)
+{
+  // out of order, two of them to the same node at the same time
+  static const float begin[] = {0.5, 0.1, 1.0, 0.5, 0.3};
+  static const uint32_t from[] = {0, 1, 2, 3, 4};
+  static const uint32_t to[] = {5, 3, 0, 5, 1};
+  FlywayFlowTable flows;
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      FlywayFlow flow;
+      memset (&flow, 0, sizeof (flow));
+      flow.beginTime = begin[i];
+      flow.fromNode = from[i];
+      flow.toNode = to[i];
+      flow.transferSize = 20000 * (i + 1);
+      flow.linkType = 2;
+      strcpy (flow.proto, "Tcp");
+      strcpy (flow.dataRate, "1Gbps");
+      flows.Add (flow);
+    }
+  return flows;
+}
+
+
+class FlywaysLazyFlowsTest : public TestCase
+{
+public:
+  FlywaysLazyFlowsTest ();
+  virtual ~FlywaysLazyFlowsTest ();
+
+private:
+  virtual bool DoRun (void);
+  void CountApplications (void);
+  uint32_t CountSockets (void);
+  void SampleSockets (void);
+  void CountLive (void);
+
+  FlywaysTopoHelper *m_topo;
+  // the applications on each node when checked
+  std::vector<uint32_t> m_applications;
+  // every socket seen by SampleSockets
+  std::vector<Ptr<Object> > m_sockets;
+  // the applications and the sockets left once all flows are over
+  uint32_t m_liveApplications;
+  uint32_t m_liveSockets;
+};
+
+FlywaysLazyFlowsTest::FlywaysLazyFlowsTest ()
+  : TestCase ("Lazily replayed flows match flows set up in advance")
+{}
+
+FlywaysLazyFlowsTest::~FlywaysLazyFlowsTest ()
+{}
+
+void
+FlywaysLazyFlowsTest::CountApplications (void)
+{
+  m_applications.clear ();
+  for (int i = 0; i < m_topo->GetNumNodes (); i++)
+    {
+      m_applications.push_back (m_topo->GetNode (i)->GetNApplications ());
+    }
+}
+
+// the sockets which the TCP and UDP protocols of all nodes hold, which
+// are added to m_sockets if they are new
+uint32_t
+FlywaysLazyFlowsTest::CountSockets (void)
+{
+  uint32_t n = 0;
+  for (int i = 0; i < m_topo->GetNumNodes (); i++)
+    {
+      ObjectVectorValue lists[2];
+      m_topo->GetNode (i)->GetObject<TcpL4Protocol> ()->GetAttribute ("SocketList", lists[0]);
+      m_topo->GetNode (i)->GetObject<UdpL4Protocol> ()->GetAttribute ("SocketList", lists[1]);
+      for (uint32_t j = 0; j < 2; j++)
+        {
+          for (uint32_t k = 0; k < lists[j].GetN (); k++)
+            {
+              Ptr<Object> socket = lists[j].Get (k);
+              if (std::find (m_sockets.begin (), m_sockets.end (), socket) == m_sockets.end ())
+                {
+                  m_sockets.push_back (socket);
+                }
+              n++;
+            }
+        }
+    }
+  return n;
+}
+
+void
+FlywaysLazyFlowsTest::SampleSockets (void)
+{
+  CountSockets ();
+  // shorter than any of the flows
+  if (Simulator::Now () < Seconds (2.3))
+    {
+      Simulator::Schedule (MicroSeconds (50), &FlywaysLazyFlowsTest::SampleSockets, this);
+    }
+}
+
+void
+FlywaysLazyFlowsTest::CountLive (void)
+{
+  m_liveApplications = 0;
+  for (int i = 0; i < m_topo->GetNumNodes (); i++)
+    {
+      m_liveApplications += m_topo->GetNode (i)->GetNApplications ();
+    }
+  m_liveSockets = CountSockets ();
+}
+
+bool
+FlywaysLazyFlowsTest::DoRun (void)
+{
+  FlywayFlowTable flows = CreateFlows ();
+
+  m_topo = CreateTopology (GetTempDir ());
+  m_topo->SetupFlows (flows);
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  std::vector<uint64_t> rx;
+  std::vector<Time> finished;
+  FlywayCompletionTable completions = m_topo->GetCompletions ();
+  NS_TEST_ASSERT_MSG_EQ (completions.GetN (), flows.GetN (), "Every flow has a completion");
+  NS_TEST_EXPECT_MSG_EQ (completions.GetNCompleted (), flows.GetN (), "Every flow completed");
+  for (int i = 0; i < m_topo->GetNumApps (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_topo->IsFinished (i), true, "Flow " << i << " did not finish in advance");
+      NS_TEST_EXPECT_MSG_EQ (completions.Get (i).rxBytes, m_topo->GetTotalRx (i), "Flow " << i << " completed with other bytes");
+      NS_TEST_EXPECT_MSG_EQ_TOL (completions.Get (i).completionTime,
+                                 m_topo->WhenFinished (i).GetSeconds () - flows.Get (i).beginTime, 1e-9,
+                                 "Flow " << i << " completed at another time");
+      NS_TEST_EXPECT_MSG_EQ (completions.Get (i).linkType, 2, "Flow " << i << " completed on another path");
+      rx.push_back (m_topo->GetTotalRx (i));
+      finished.push_back (m_topo->WhenFinished (i));
+    }
+  Simulator::Destroy ();
+  delete m_topo;
+  Ipv4AddressGenerator::Reset ();
+
+  m_topo = CreateTopology (GetTempDir ());
+  m_topo->SetupFlowsLazily (flows, MilliSeconds (10));
+  NS_TEST_ASSERT_MSG_EQ (m_topo->GetNumApps (), (int)flows.GetN (), "Every flow counts as an app");
+  // flow 1 is created at 0.09s and flow 4 at 0.29s
+  Simulator::Schedule (Seconds (0.095), &FlywaysLazyFlowsTest::CountApplications, this);
+  Simulator::ScheduleNow (&FlywaysLazyFlowsTest::SampleSockets, this);
+  // the last flow is over at 2.2s, and its sockets close right after
+  m_liveApplications = m_liveSockets = 1000;
+  Simulator::Schedule (Seconds (3.9), &FlywaysLazyFlowsTest::CountLive, this);
+  Simulator::Stop (Seconds (4));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_applications.size (), (uint32_t)m_topo->GetNumNodes (), "Applications not counted");
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < m_applications.size (); i++)
+    {
+      total += m_applications[i];
+    }
+  NS_TEST_EXPECT_MSG_EQ (total, 2, "Only the sink and the source of the first flow should exist at 0.095s");
+  NS_TEST_EXPECT_MSG_EQ (m_applications[1], 1, "Wrong source of the first flow");
+  NS_TEST_EXPECT_MSG_EQ (m_applications[3], 1, "Wrong sink of the first flow");
+  FlywayCompletionTable &lazyCompletions = m_topo->GetCompletions ();
+  NS_TEST_ASSERT_MSG_EQ (lazyCompletions.GetN (), flows.GetN (), "Every lazy flow has a completion");
+  for (int i = 0; i < m_topo->GetNumApps (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_topo->IsFinished (i), true, "Flow " << i << " did not finish lazily");
+      NS_TEST_EXPECT_MSG_EQ (memcmp (&lazyCompletions.Get (i), &completions.Get (i), sizeof (FlywayCompletion)), 0,
+                             "Flow " << i << " completed differently");
+      NS_TEST_EXPECT_MSG_EQ (m_topo->GetTotalRx (i), rx[i], "Flow " << i << " received differently");
+      NS_TEST_EXPECT_MSG_EQ (m_topo->WhenFinished (i), finished[i], "Flow " << i << " finished at another time");
+      NS_TEST_EXPECT_MSG_EQ ((m_topo->m_v_apps[i]->sourceApp == 0), true, "Flow " << i << " was not torn down");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_liveApplications, 0, "The nodes kept applications of flows which are over");
+  NS_TEST_EXPECT_MSG_EQ (m_liveSockets, 0, "The protocols kept sockets of flows which are over");
+  // a listening, a connecting and an accepted socket for each flow
+  NS_TEST_EXPECT_MSG_EQ (m_sockets.size (), 3 * flows.GetN (), "Wrong number of sockets seen");
+  for (uint32_t i = 0; i < m_sockets.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_sockets[i]->GetReferenceCount (), 1, "Socket " << i << " is still referenced");
+    }
+  m_sockets.clear ();
+  Simulator::Destroy ();
+  delete m_topo;
+  Ipv4AddressGenerator::Reset ();
+  return GetErrorStatus ();
+}
+
+
+class FlywaysAdjacencyTest : public TestCase
+{
+public:
+  FlywaysAdjacencyTest ();
+  virtual ~FlywaysAdjacencyTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywaysAdjacencyTest::FlywaysAdjacencyTest ()
+  : TestCase ("Neighbors, devices and addresses of the wired topology")
+{}
+
+FlywaysAdjacencyTest::~FlywaysAdjacencyTest ()
+{}
+
+bool
+FlywaysAdjacencyTest::DoRun (void)
+{
+  FlywaysTopoHelper *topo = CreateTopology (GetTempDir ());
+  // 6 ToRs under aggregation switches 6 and 7, both under L3 switches 8 and 9
+  NS_TEST_ASSERT_MSG_EQ (topo->GetNumNodes (), 10, "Wrong number of nodes");
+  for (uint32_t tor = 0; tor < 6; tor++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (topo->GetNumNbrs (tor), 2, "Wrong neighbors of ToR " << tor);
+      NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (tor, 0), 6, "Wrong first neighbor of ToR " << tor);
+      NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (tor, 1), 7, "Wrong second neighbor of ToR " << tor);
+    }
+  NS_TEST_ASSERT_MSG_EQ (topo->GetNumNbrs (6), 8, "Wrong neighbors of an aggregation switch");
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (6, i), (i < 6 ? i : i + 2), "Neighbors out of order");
+    }
+  NS_TEST_EXPECT_MSG_EQ (topo->GetNumNbrs (9), 2, "Wrong neighbors of an L3 switch");
+
+  for (uint32_t n = 0; n < 10; n++)
+    {
+      for (uint32_t i = 0; i < topo->GetNumNbrs (n); i++)
+        {
+          uint32_t nbr = topo->GetNbr (n, i);
+          Ptr<NetDevice> device = topo->GetDevice (n, nbr);
+          NS_TEST_EXPECT_MSG_EQ (device->GetNode (), topo->GetNode (n), "Device of " << n << " on another node");
+          Ptr<Channel> channel = device->GetChannel ();
+          NS_TEST_EXPECT_MSG_EQ ((channel->GetDevice (0)->GetNode () == topo->GetNode (nbr)
+                                  || channel->GetDevice (1)->GetNode () == topo->GetNode (nbr)), true,
+                                 "Device of " << n << " does not lead to " << nbr);
+          Ptr<Ipv4> ipv4 = topo->GetNode (n)->GetObject<Ipv4> ();
+          Ipv4Address address = ipv4->GetAddress (ipv4->GetInterfaceForDevice (device), 0).GetLocal ();
+          NS_TEST_EXPECT_MSG_EQ (topo->GetIpv4Address (n, nbr), address, "Wrong address of " << n << " towards " << nbr);
+        }
+      NS_TEST_EXPECT_MSG_EQ (topo->GetIpv4Address (n), topo->GetIpv4Address (n, topo->GetNbr (n, 0)),
+                             "The address of " << n << " is not that of its first link");
+      NS_TEST_EXPECT_MSG_EQ (topo->GetDevice (n, -1), topo->GetDevice (n, topo->GetNbr (n, 0)),
+                             "The device of " << n << " is not that of its first link");
+    }
+
+  Simulator::Destroy ();
+  delete topo;
+  Ipv4AddressGenerator::Reset ();
+  return GetErrorStatus ();
+}
+
+
+class FlywaysTopologyPlanTest : public TestCase
+{
+public:
+  FlywaysTopologyPlanTest ();
+  virtual ~FlywaysTopologyPlanTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywaysTopologyPlanTest::FlywaysTopologyPlanTest ()
+  : TestCase ("Tiers, links and rates of the generated topologies")
+{}
+
+FlywaysTopologyPlanTest::~FlywaysTopologyPlanTest ()
+{}
+
+bool
+FlywaysTopologyPlanTest::DoRun (void)
+{
+  FlywayTopologyPlan classic = FlywayTopologyPlan::Classic (6, 6, 2, DataRate ("10Gbps"), DataRate ("40Gbps"));
+  NS_TEST_EXPECT_MSG_EQ (classic.GetNumNodes (), 10, "Wrong classic topology");
+  NS_TEST_ASSERT_MSG_EQ (classic.GetNLinks (), 16, "Wrong classic links");
+  NS_TEST_EXPECT_MSG_EQ (classic.GetLink (11).upper, 7, "Wrong ToR link");
+  NS_TEST_EXPECT_MSG_EQ (classic.GetLink (12).lower, 6, "Links out of order");
+  NS_TEST_EXPECT_MSG_EQ (classic.GetLink (15).upper, 9, "Wrong agg link");
+  NS_TEST_EXPECT_MSG_EQ (classic.GetLink (15).rate, DataRate ("40Gbps"), "Wrong agg rate");
+
+  FlywayTopologyPlan fatTree = FlywayTopologyPlan::FatTree (4, DataRate ("4Gbps"), 2);
+  NS_TEST_EXPECT_MSG_EQ (fatTree.GetNumTors (), 8, "Wrong fat-tree ToRs");
+  NS_TEST_EXPECT_MSG_EQ (fatTree.GetNumMiddle (), 8, "Wrong fat-tree aggs");
+  NS_TEST_EXPECT_MSG_EQ (fatTree.GetNumTop (), 4, "Wrong fat-tree cores");
+  NS_TEST_ASSERT_MSG_EQ (fatTree.GetNLinks (), 32, "Wrong fat-tree links");
+  for (uint32_t i = 0; i < fatTree.GetNLinks (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (fatTree.GetLink (i).rate, DataRate ("1Gbps"), "Wrong fat-tree rate");
+    }
+
+  FlywayTopologyPlan vl2 = FlywayTopologyPlan::Vl2 (5, 3, 2, DataRate ("4Gbps"), 1);
+  NS_TEST_EXPECT_MSG_EQ (vl2.GetNumMiddle (), 4, "Wrong VL2 aggs");
+  NS_TEST_EXPECT_MSG_EQ (vl2.GetNumTop (), 2, "Wrong VL2 intermediates");
+  NS_TEST_ASSERT_MSG_EQ (vl2.GetNLinks (), 18, "Wrong VL2 links");
+  NS_TEST_EXPECT_MSG_EQ (vl2.GetLink (8).upper, 7, "Wrong aggs of the last ToR");
+  NS_TEST_EXPECT_MSG_EQ (vl2.GetLink (9).upper, 8, "Wrong aggs of the last ToR");
+  NS_TEST_EXPECT_MSG_EQ (vl2.GetLink (0).rate, DataRate ("2Gbps"), "Wrong VL2 ToR rate");
+  NS_TEST_EXPECT_MSG_EQ (vl2.GetLink (17).rate, DataRate ("3Gbps"), "Wrong VL2 agg rate");
+
+  FlywayTopologyPlan leafSpine = FlywayTopologyPlan::LeafSpine (4, 2, DataRate ("4Gbps"), 1);
+  NS_TEST_EXPECT_MSG_EQ (leafSpine.GetNumNodes (), 6, "Wrong leaf-spine");
+  NS_TEST_EXPECT_MSG_EQ (leafSpine.GetNumTop (), 0, "A leaf-spine has two tiers");
+  NS_TEST_ASSERT_MSG_EQ (leafSpine.GetNLinks (), 8, "Wrong leaf-spine links");
+  NS_TEST_EXPECT_MSG_EQ (leafSpine.GetLink (7).lower, 3, "Wrong leaf");
+  NS_TEST_EXPECT_MSG_EQ (leafSpine.GetLink (7).upper, 5, "Wrong spine");
+  NS_TEST_EXPECT_MSG_EQ (leafSpine.GetLink (7).rate, DataRate ("2Gbps"), "Wrong leaf-spine rate");
+  return GetErrorStatus ();
+}
+
+
+class FlywaysFatTreeTest : public TestCase
+{
+public:
+  FlywaysFatTreeTest ();
+  virtual ~FlywaysFatTreeTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+FlywaysFatTreeTest::FlywaysFatTreeTest ()
+  : TestCase ("A fat-tree in rows carries flows between pods")
+{}
+
+FlywaysFatTreeTest::~FlywaysFatTreeTest ()
+{}
+
+bool
+FlywaysFatTreeTest::DoRun (void)
+{
+  FlywaysTopoHelper *topo = CreateTopology (GetTempDir (),
+                                            "Topology: FatTree\n"
+                                            "FatTreeK: 4\n"
+                                            "RackBandwidth: 4Gbps\n"
+                                            "Oversubscription: 2\n"
+                                            "Arrangement: Rows\n"
+                                            "RacksPerRow: 3\n"
+                                            "AisleWidth: 2\n");
+  // ToRs 0-7 in pods of 2, aggs 8-15, cores 16-19
+  NS_TEST_ASSERT_MSG_EQ (topo->GetNumNodes (), 20, "Wrong number of nodes");
+  NS_TEST_ASSERT_MSG_EQ (topo->GetNumNbrs (2), 2, "Wrong neighbors of a ToR");
+  NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (2, 0), 10, "ToR 2 is not in the second pod");
+  NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (2, 1), 11, "ToR 2 is not in the second pod");
+  NS_TEST_ASSERT_MSG_EQ (topo->GetNumNbrs (9), 4, "Wrong neighbors of an agg");
+  static const uint32_t agg9[] = {0, 1, 18, 19};
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (9, i), agg9[i], "Wrong neighbor " << i << " of agg 9");
+    }
+  NS_TEST_ASSERT_MSG_EQ (topo->GetNumNbrs (16), 4, "Wrong neighbors of a core");
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (topo->GetNbr (16, i), 8 + 2 * i, "Wrong pod under core 16");
+    }
+  DataRateValue rate;
+  topo->GetDevice (0, 8)->GetAttribute ("DataRate", rate);
+  NS_TEST_EXPECT_MSG_EQ (rate.Get (), DataRate ("1Gbps"), "Wrong oversubscribed uplink");
+
+  // three racks a row, each 1.3m deep (read as a float), with 2m aisles
+  NS_TEST_EXPECT_MSG_EQ_TOL (topo->m_v_nodeXYLocations_meter[4].first, 1, 1e-6, "Wrong rack of ToR 4");
+  NS_TEST_EXPECT_MSG_EQ_TOL (topo->m_v_nodeXYLocations_meter[4].second, 3.3, 1e-6, "Wrong row of ToR 4");
+  // the aggs of the second pod stand in the first of its racks, ToR 2
+  NS_TEST_EXPECT_MSG_EQ ((topo->m_v_nodeXYLocations_meter[10] == topo->m_v_nodeXYLocations_meter[2]), true,
+                         "Wrong place of agg 10");
+  NS_TEST_EXPECT_MSG_EQ ((topo->m_v_nodeXYLocations_meter[11] == topo->m_v_nodeXYLocations_meter[2]), true,
+                         "Wrong place of agg 11");
+
+  FlywayFlowTable flows = CreateFlows ();
+  topo->SetupFlows (flows);
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  for (int i = 0; i < topo->GetNumApps (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (topo->IsFinished (i), true, "Flow " << i << " did not finish");
+    }
+  Simulator::Destroy ();
+  delete topo;
+  Ipv4AddressGenerator::Reset ();
+  return GetErrorStatus ();
+}
+
+
+class FlywaysTopoHelperTestSuite : public TestSuite
+{
+public:
+  FlywaysTopoHelperTestSuite ();
+};
+
+FlywaysTopoHelperTestSuite::FlywaysTopoHelperTestSuite ()
+  : TestSuite ("helper-flyways-topo-helper", UNIT)
+{
+  AddTestCase (new FlywaysLazyFlowsTest);
+  AddTestCase (new FlywaysAdjacencyTest);
+  AddTestCase (new FlywaysTopologyPlanTest);
+  AddTestCase (new FlywaysFatTreeTest);
+}
+
+FlywaysTopoHelperTestSuite g_flywaysTopoHelperTestSuite;
+
+} // namespace ns3
@@ -1,4 +1,7 @@
 #include "ns3/flyways-topo-helper.h"
+#include "flyway-tables.h"
+#include "flyway-topology-plan.h"
+#include "node-partitioner.h"
 #include "ns3/animation-interface.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/canvas-location.h"
@@ -6,6 +9,7 @@
 #include "ns3/vector.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
+#include "ns3/global-value.h"
 #include "ns3/names.h"
 #include "ns3/uinteger.h"
 #include "ns3/boolean.h"
@@ -16,16 +20,31 @@
 #include "ns3/packet-sink-helper.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/on-off-helper.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
 #include <string.h>
 #include "ns3/point-to-point-net-device.h"
 #include <stdio.h>
 #include "ns3/mac48-address.h"
 #include "ns3/wifi-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable.h"
+#include "ns3/rng-stream.h"
+#include "ns3/abort.h"
+#include "ns3/callback.h"
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE("FlywaysTopoHelper");
 using namespace std;
 
 namespace ns3 {
+
+    // The number of partitions of a parallel run, for the system ids of
+    // the nodes; 1 leaves them all at 0.
+    static GlobalValue g_flywaysPartitions = GlobalValue("FlywaysPartitions",
+        "The number of partitions FlywaysTopoHelper splits its nodes into, by their system id",
+        UintegerValue(1),
+        MakeUintegerChecker<uint32_t>(1));
     GlobalOpt g_Options;
 
     GlobalOpt::GlobalOpt()
@@ -54,233 +73,46 @@ namespace ns3 {
         donglesPerTor = donglesPerAgg = donglesPerL3 = 0;
 
         standard = FW_Standard_OFDM;
+
+        topology = FW_Topo_Classic;
+        fatTreeK = 4;
+        numSpines = 0;
+        oversubscription = 1;
+        rackBandwidth = DataRate(DataRate("20Gbps").GetBitRate()/ scaleDownBy);
+
+        racksPerRow = 20;
+        aisleWidth_meter = 2;
+        bzero(replayFlowFileName, GO_MAX_FILENAMELEN);
     }
 
-    void   
-    FlywaysTopoHelper::ReadTopo
-    ( FILE* fin )
-    {
-        #define FTH_readtopo_MAXLINELEN 100
-        char line[FTH_readtopo_MAXLINELEN];
-        int linelen=0;
-        int linenum = 0;
-        /* read the topo in */
-        while(fgets(line, FTH_readtopo_MAXLINELEN, fin) != NULL ) {
-
-            linenum++;
-            linelen = strlen(line); 
-
-	        if(linelen == FTH_readtopo_MAXLINELEN) {
-	            printf("%s: Too long a line: %d\n", "flyways-topo-helper", linelen); 
-	            abort();
-	        }
-	        else 
-	            line[--linelen]=0;
-	
-	        if(line[0] == '#') 
-	            continue;
-	
-	        if (strstr(line, "DonglesPerTor:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'DonglesPerTor: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.donglesPerTor = _int1;
-	        } 
-            else if (strstr(line, "Antenna:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'DonglesPerTor: int'\n", line);
-	                exit(-1);
-	            }
-                if (_int1 == 0)
-                {
-                    printf("setting cone antenna\n");
-                    g_Options.antenna = FW_Antenna_Cone;
-                }
-                else if (_int1 == 1)
-                {
-                    printf("setting measured antenna\n");
-                    g_Options.antenna = FW_Antenna_Measured;
-                }
-                else 
-                {
-                    printf("only vali antenna types are 0 or 1\n");
-	                exit(-1);
-                }
-	        } 
-	        else if (strstr(line, "DonglesPerAgg:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){ 
-	                printf("bad line in topo file: [%s] shld be 'DonglesPerAgg: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.donglesPerAgg = _int1;
-	    
-	        } 
-	        else if (strstr(line, "DonglesPerL3:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'DonglesPerL3: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.donglesPerL3 = _int1;
-	        } 
-	        else if (strstr(line, "FlywayBandwidth:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            char _bandwidth[10];
-	            if ( sscanf(ctmp, " %s", _bandwidth) != 1){ 
-	                printf("bad line in topo file: [%s] shld be 'FlywayBandwidth: bandwidth'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.flywayBandwidth = DataRate(_bandwidth);
-	        } 
-	        else if (strstr(line, "NUM-TORS:") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'NUM-TORS: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.numTors = _int1;
-	        }
-	        else if (strstr(line, "Agg2L3_Bandwidth:") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            char _bandwidth[10];
-	            if ( sscanf(ctmp, " %s", _bandwidth) != 1){
-	                printf("bad line in topo file: [%s] shld be 'Agg2L3_Bandwidth: bandwidth'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.agg2L3_Bandwidth = DataRate(_bandwidth);
-	        }
-	        else if (strstr(line, "Tor2Agg_Bandwidth:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            char _bandwidth[10];
-	            if ( sscanf(ctmp, " %s", _bandwidth) != 1){
-	                printf("bad line in topo file: [%s] shld be 'Tor2Agg_Bandwidth: bandwidth'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.tor2Agg_Bandwidth = DataRate(_bandwidth);
-	        }
-	        else if (strstr(line, "ReplayFlowFile:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            if (sscanf(ctmp, " %s", g_Options.replayFlowFileName) != 1 || strlen(g_Options.replayFlowFileName) > GO_MAX_FILENAMELEN-1){
-	                printf("bad line in topo file: [%s] shld be 'ReplayFlowFile: fileName'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.trafficType = FW_TT_ReplayFlows;
-	        }
-	        else if (strstr(line, "AggFanOut:") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'AggFanOut: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.aggFanOut = _int1;
-	
-	        }
-	        else if (strstr(line, "L3FanOut:") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'L3FanOut: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.l3FanOut = _int1;
-	
-	        }
-	        else if (strstr(line, "RackWidth") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            float _float1;
-	            if ( sscanf(ctmp, " %f", &_float1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'RackWidth: float'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.rackWidth_meter = _float1;
-	        }
-	        else if (strstr(line, "RackHeight") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            float _float1;
-	            if ( sscanf(ctmp, " %f", &_float1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'RackHeight: float'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.rackHeight_meter = _float1;
-	
-	        }
-	        else if (strstr(line, "ClumpNumRacks") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            int _int1;
-	            if ( sscanf(ctmp, " %d", &_int1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'ClumpNumRacks: int'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.clumpNumRacks =(uint)(_int1);
-	        }
-	        else if (strstr(line, "ClumpSpaceLeft") == line){
-	            char* ctmp = strchr(line, ':')+1;
-	            float _float1;
-	            if ( sscanf(ctmp, " %f", &_float1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'ClumpSpaceLeft: float'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.clumpSpaceLeft_meter = _float1;
-	        }
-	        else if (strstr(line, "ClumpSpaceBelow") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            float _float1;
-	            if ( sscanf(ctmp, " %f", &_float1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'ClumpSpaceBelow: float'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.clumpSpaceBelow_meter = _float1;
-	
-	        }
-	        else if (strstr(line, "ScaleDownBy") == line){
-	
-	            char* ctmp = strchr(line, ':')+1;
-	            float _float1;
-	            if ( sscanf(ctmp, " %f", &_float1) != 1){
-	                printf("bad line in topo file: [%s] shld be 'ScaleDownBy: float'\n", line);
-	                exit(-1);
-	            }
-	            g_Options.scaleDownBy = _float1;
-	        }
-	        else if (strstr(line, "Arrangement") == line){
-	            char *ctmp = strchr(line, ':') + 1;
-	            if ( strcmp(ctmp, "Square")==0 )
-	                g_Options.arrangeType = FW_ToA_Square;
-	            else
-	                g_Options.arrangeType = FW_ToA_Unknown;
-	
-	        }
-	        else if (strstr(line, "Standard") == line){
-	            char *ctmp = strchr(line, ':') + 1;
-	            if ( strcmp(ctmp, "SC")==0 )
-	                g_Options.standard = FW_Standard_SC;
-	            else
-	                g_Options.standard = FW_Standard_OFDM;
-	
-	        }
-	        else
-	            printf("%s: Ignoring %d:[%s]\n", "flyways-topo-helper", linenum, line);
+    void FlywaysTopoHelper::ReadTopo(FILE* fin)
+    {
+        FlywayTopoTable table(g_Options);
+        if (!table.ReadText(fin, "topo")) {
+            NS_FATAL_ERROR(table.GetError());
         }
+        UseOptions(table.Get());
+    }
 
+    void FlywaysTopoHelper::ReadTopo(const char *topoFile)
+    {
+        FlywayTopoTable table(g_Options);
+        if (topoFile == NULL) {
+            NS_FATAL_ERROR("no topo file");
+        }
+        if (!table.Load(topoFile)) {
+            NS_FATAL_ERROR(table.GetError());
+        }
+        UseOptions(table.Get());
+    }
+
+    void FlywaysTopoHelper::UseOptions(const GlobalOpt &options)
+    {
+        g_Options = options;
         if ( g_Options.scaleDownBy != 1){
             g_Options.agg2L3_Bandwidth = DataRate( g_Options.agg2L3_Bandwidth.GetBitRate() / g_Options.scaleDownBy );
             g_Options.tor2Agg_Bandwidth = DataRate( g_Options.tor2Agg_Bandwidth.GetBitRate() / g_Options.scaleDownBy );
+            g_Options.rackBandwidth = DataRate( g_Options.rackBandwidth.GetBitRate() / g_Options.scaleDownBy );
         }
     }
 
@@ -288,6 +120,7 @@ namespace ns3 {
     {
         m_finishedX = m_finishedY = 0;
         m_currClumpX = m_currClumpY = m_currClumpNumRacksReady = 0;
+        m_racksPlaced = 0;
     }
 
 
@@ -319,54 +152,183 @@ namespace ns3 {
 
     void FlywaysTopoHelper::SetupFlows(FILE* fin)
     {
-        #define FTH_setupflows_MAXLINELEN 1000
-        char line[FTH_setupflows_MAXLINELEN];
-        int linelen=0;
+        FlywayFlowTable table;
+        if (!table.ReadText(fin, "flow file")) {
+            NS_FATAL_ERROR(table.GetError());
+        }
+        SetupFlows(table);
+    }
 
-        /* read the flow file in */
-        TrafficApp *_next_app = NULL;
-        int i = 0;
-        while(fgets(line, FTH_setupflows_MAXLINELEN, fin) != NULL ) {
+    void FlywaysTopoHelper::SetupFlows(const char *flowFile)
+    {
+        FlywayFlowTable table;
+        if (!table.Load(flowFile)) {
+            NS_FATAL_ERROR(table.GetError());
+        }
+        SetupFlows(table);
+    }
+
+    static TrafficApp *NewTrafficApp(const FlywayFlow &flow)
+    {
+        TrafficApp *app = new TrafficApp();
+        app->beginTime = flow.beginTime;
+        app->fromNode = flow.fromNode;
+        app->toNode = flow.toNode;
+        app->transferSize = flow.transferSize;
+        app->linkType = flow.linkType;
+        strcpy(app->proto, flow.proto);
+        strcpy(app->dataRateString, flow.dataRate);
+        return app;
+    }
 
-            linelen = strlen(line); 
+    void FlywaysTopoHelper::SetupFlows(const FlywayFlowTable &table)
+    {
+        m_v_apps.reserve(m_v_apps.size() + table.GetN());
+        m_completions->Reserve(m_v_apps.size() + table.GetN());
+        for (uint32_t i = 0; i < table.GetN(); i++) {
+            SetupFlow(NewTrafficApp(table.Get(i)), i);
+            if ((i + 1) % 1000 == 0) { cout << "set up " << i + 1 << "flows" << endl;}
+        }
+    }
 
-            if(linelen == FTH_setupflows_MAXLINELEN) {
-                printf("%s: Too long a line: %d\n", "flyways-topo-helper", linelen); 
-                abort();
+    struct FlowBeginsEarlier
+    {
+        const FlywayFlowTable *flows;
+        bool operator() (uint32_t a, uint32_t b) const
+        {
+            return flows->Get(a).beginTime < flows->Get(b).beginTime;
+        }
+    };
+
+    void FlywaysTopoHelper::SetupFlowsLazily(const FlywayFlowTable &table, Time lead)
+    {
+        NS_ASSERT_MSG(m_lazyFlows == NULL, "flows are already replayed lazily");
+        m_lazyFlows = new FlywayFlowTable(table);
+        m_lazyLead = lead;
+        m_lazyNext = 0;
+        m_lazyBase = m_v_apps.size();
+        m_v_apps.resize(m_lazyBase + table.GetN(), NULL);
+        m_completions->Reserve(m_lazyBase + table.GetN());
+
+        // The ports are given in the order of the file, as SetupFlows does.
+        m_lazyPorts.resize(table.GetN());
+        m_lazyOrder.resize(table.GetN());
+        for (uint32_t i = 0; i < table.GetN(); i++) {
+            if (table.Get(i).fromNode >= m_numnodes || table.Get(i).toNode >= m_numnodes) {
+                NS_FATAL_ERROR("flow " << i << " is between nodes which do not exist");
             }
-            else 
-                line[--linelen]=0;
+            m_lazyPorts[i] = m_v_node2NextPort[table.Get(i).toNode]++;
+            m_lazyOrder[i] = i;
+            const FlywayFlow &flow = table.Get(i);
+            m_completions->Add(flow.beginTime, flow.fromNode, flow.toNode, flow.linkType);
+        }
+        FlowBeginsEarlier earlier;
+        earlier.flows = m_lazyFlows;
+        stable_sort(m_lazyOrder.begin(), m_lazyOrder.end(), earlier);
 
-            if(line[0] == '#') 
-                continue;
-            int _dummy_ = 0;
-            if ( _next_app == NULL )
-                _next_app = new TrafficApp();
-            if (sscanf(line, " %f %d %d %s %f %s %d", 
-                        &(_next_app->beginTime), 
-                        &(_next_app->fromNode), 
-                        &(_next_app->toNode),
-                        (_next_app->proto),
-                        &(_next_app->transferSize),
-                        (_next_app->dataRateString), 
-                        &_dummy_
-                ) != 7) {
-                printf("%s: not seven fields: %d\n", "flyways-topo-helper", linelen); 
-                printf("This is a branch from original flyway, make sure that you add 1/2\n");
-                abort();
+        if (!m_lazyOrder.empty()) {
+            Time at = Seconds(m_lazyFlows->Get(m_lazyOrder[0]).beginTime) - m_lazyLead - Simulator::Now();
+            Simulator::Schedule(at.IsStrictlyPositive() ? at : Seconds(0), &FlywaysTopoHelper::InstantiateFlows, this);
+        }
+    }
+
+    void FlywaysTopoHelper::InstantiateFlows()
+    {
+        Time now = Simulator::Now();
+        while (m_lazyNext < m_lazyOrder.size()) {
+            uint32_t i = m_lazyOrder[m_lazyNext];
+            Time at = Seconds(m_lazyFlows->Get(i).beginTime) - m_lazyLead;
+            // compared in whole time steps, which is what Schedule waits
+            if ((at - now).GetTimeStep() > 0) {
+                // a single event waits for the next flows to create
+                Simulator::Schedule(at - now, &FlywaysTopoHelper::InstantiateFlows, this);
+                return;
             }
+            TrafficApp *ta = NewTrafficApp(m_lazyFlows->Get(i));
+            ta->completions = m_completions;
+            ta->index = m_lazyBase + i;
+            ta->lazy = true;
+            InstallFlow(ta, m_lazyPorts[i], now);
+            m_v_apps[m_lazyBase + i] = ta;
+            m_lazyNext++;
+        }
+    }
+
+    void FlywaysTopoHelper::FlowFinished(TrafficApp *ta, uint64_t rxBytes)
+    {
+        ta->completions->Complete(ta->index, rxBytes, Simulator::Now().GetSeconds() - ta->beginTime);
+        if (ta->lazy) {
+            // not from within the receive path of the sink
+            Simulator::ScheduleNow(&FlywaysTopoHelper::TeardownFlow, ta);
+        }
+    }
 
-            NS_ASSERT_MSG ( strlen(_next_app->proto) <10 && 
-              strlen(_next_app->dataRateString) < 30, "too long protocol or dataRate string");
-            SetupFlow(_next_app, i);
-            //cout << i << ":" << _next_app->transferSize << endl;
-            i++;
-            if (i % 1000 == 0) { cout << "set up " << i << "flows" << endl;}
-            _next_app = NULL;
+    FlywayCompletionTable &FlywaysTopoHelper::GetCompletions()
+    {
+        for (uint32_t i = 0; i < m_completions->GetN(); i++) {
+            if (!m_completions->IsCompleted(i) && m_v_apps[i] != NULL) {
+                m_completions->SetRxBytes(i, m_v_apps[i]->GetTotalRx());
+            }
+        }
+        return *m_completions;
+    }
+
+    void FlywaysTopoHelper::TeardownFlow(TrafficApp *ta)
+    {
+        if (ta->sourceApp == 0) {
+            return;
+        }
+        // Both applications have stopped and closed their sockets by now;
+        // the sink keeps what it has counted.
+        Ptr<Node> source = ta->sourceApp->GetNode();
+        Ptr<Node> sink = ta->sinkApp->GetNode();
+        source->RemoveApplication(ta->sourceApp);
+        sink->RemoveApplication(ta->sinkApp);
+        ta->sourceApp->Dispose();
+        ta->sourceApp = 0;
+        ta->sinkApp->Dispose();
+
+        // A TCP connection closes a round trip after this, or a
+        // retransmission timeout if a segment is lost; whatever is still
+        // closing then goes with the next flow torn down on the node.
+        ReleaseSockets(source);
+        ReleaseSockets(sink);
+        Simulator::Schedule(Seconds(1), &FlywaysTopoHelper::ReleaseSockets, source);
+        Simulator::Schedule(Seconds(1), &FlywaysTopoHelper::ReleaseSockets, sink);
+    }
+
+    void FlywaysTopoHelper::ReleaseSockets(Ptr<Node> node)
+    {
+        node->GetObject<TcpL4Protocol>()->ReleaseClosedSockets();
+        node->GetObject<UdpL4Protocol>()->ReleaseClosedSockets();
+    }
+
+    pid_t FlywaysTopoHelper::ForkFromSnapshot(uint32_t run)
+    {
+        NS_ABORT_MSG_IF (!Simulator::Now ().IsZero (), "FlywaysTopoHelper::ForkFromSnapshot: the simulation has already run");
+
+        // Flush, so that the child does not write out again what the
+        // parent has buffered.
+        cout.flush();
+        fflush(NULL);
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            SeedManager::SetRun(run);
+            RngStream::SetPackageSeed(SeedManager::GetSeed());
         }
+        return pid;
     }
 
     void FlywaysTopoHelper::SetupFlow(TrafficApp* ta, int i){
+        uint toPort = m_v_node2NextPort[ta->toNode]++;
+        ta->completions = m_completions;
+        ta->index = m_completions->Add(ta->beginTime, ta->fromNode, ta->toNode, ta->linkType);
+        NS_ASSERT(ta->index == m_v_apps.size());
+        InstallFlow(ta, toPort, Seconds(0));
+        m_v_apps.push_back(ta);
+    }
+
+    void FlywaysTopoHelper::InstallFlow(TrafficApp* ta, uint toPort, Time now){
 
         char protoString[100];
         if ( strcmp (ta->proto, "Tcp") == 0 )
@@ -379,13 +341,13 @@ namespace ns3 {
         }
 
         /* Receiver */
-        uint toPort = m_v_node2NextPort[ta->toNode]++;
         //cout << "port for this: " << toPort << endl;
         //NS_ASSERT_MSG ( toPort < (1<<16), "toNode ports filled up");
         PacketSinkHelper sinkHelper (protoString, InetSocketAddress(Ipv4Address::GetAny(), toPort));
         //PacketSinkHelper sinkHelper (protoString, InetSocketAddress(Ipv4Address::GetAny(), (ushort)toPort));
         ApplicationContainer sinkApp = sinkHelper.Install( GetNode(ta->toNode) );
-        sinkApp.Start(Seconds(ta->beginTime - 0.000001 > 0 ? ta->beginTime - 0.000001 : 0));
+        Time sinkStart = Seconds(ta->beginTime - 0.000001 > 0 ? ta->beginTime - 0.000001 : 0) - now;
+        sinkApp.Start(sinkStart.IsStrictlyPositive() ? sinkStart : Seconds(0));
         //sinkApp.Start(Seconds(0));
 
         /* Sender */
@@ -399,15 +361,17 @@ namespace ns3 {
         //src.SetAttribute("OffTime", RandomVariableValue(ConstantVariable(ta->beginTime)));
         ApplicationContainer srcApp;
         srcApp.Add (src.Install(GetNode(ta->fromNode)));
-        srcApp.Start (Seconds(ta->beginTime));
+        Time srcStart = Seconds(ta->beginTime) - now;
+        srcApp.Start (srcStart.IsStrictlyPositive() ? srcStart : Seconds(0));
         //srcApp.Start (Seconds(i * 1e-6));
 
         // store the sink and source app
         ta->sourceApp = srcApp.Get(0);
         ta->sinkApp = DynamicCast<PacketSink>(sinkApp.Get(0)); 
         ta->sinkApp->SetExpected(ta->transferSize);
-
-        m_v_apps.push_back(ta);
+        if (ta->completions != NULL) {
+            ta->sinkApp->TraceConnectWithoutContext("Finished", MakeBoundCallback(&FlywaysTopoHelper::FlowFinished, ta));
+        }
     }
 
     // constructor
@@ -418,144 +382,19 @@ namespace ns3 {
     {
 
         m_address = address; 
+        m_lazyFlows = NULL;
+        m_completions = new FlywayCompletionTable();
 
-        FILE *f_in;
-        if (topoFile == NULL || (f_in = fopen(topoFile, "r")) == NULL) {
-            printf("cannot read topo: %s\n", topoFile);
-            exit(-1);
-        }
-
-        // Read the topo file.
-        ReadTopo(f_in);
+        // Read the topo file, text or binary.
+        ReadTopo(topoFile);
 
         // init geometry
         InitGeometry();
 
-        m_numtors = g_Options.numTors;
         m_numdongles = g_Options.donglesPerTor;
 
-        m_numaggs = 0;
-        int unassignedTors = m_numtors;
-        while ( unassignedTors > 0 ){
-            m_numaggs += 2;
-            unassignedTors -= g_Options.aggFanOut;
-        }
-
-        m_numl3s = 0;
-        int unassignedAggs = m_numaggs;
-        while( unassignedAggs > 0 ){
-            m_numl3s += 2;
-            unassignedAggs -= g_Options.l3FanOut;
-        }
-
-        m_numnodes = m_numtors + m_numaggs + m_numl3s;
-
-        cout << "Nodes: " << m_numnodes << "ToRs/Aggs/L3s: " << m_numtors << " " << m_numaggs << " " << m_numl3s << endl;;
-        assert (m_numnodes > 0);
-
-        m_nodes.Create(m_numnodes);
-
-        stack.Install(m_nodes);
-
-        for(uint ind1=0; ind1 < m_numnodes; ind1++){
-            m_v_devices.push_back(NULL); // empty map
-            m_v_interfaces.push_back(NULL); // empty interface
-            m_v_nodeXYLocations_meter.push_back(pair<double, double>(-1, -1)); // initialize
-            m_v_node2NextPort.push_back(1); // next usable port is 1. 0 is a special value - cannot be used.
-        }
-
-        // get geo for ToRs
-        for(uint ind1=0; ind1 < m_numtors; ind1++){
-            m_v_nodeXYLocations_meter[ind1]=GetNextRackLocation();
-            cout << "[GeoLoc] node " << ind1 << " (x, y) = (" << m_v_nodeXYLocations_meter[ind1].first << ", " << m_v_nodeXYLocations_meter[ind1].second << ")" << endl; 
-        }
-
-        // connect ToRs to their Agg Switch
-        uint currentAggIndex_a = m_numtors;
-        for(uint ind1=0; ind1 < m_numtors; ind1++){
-            Time lat = MilliSeconds(0.01);
-            //Time lat = MilliSeconds(10);
-            //uint32_t qSize = g_Options.tor2Agg_Bandwidth.GetBitRate() * lat.GetSeconds() * 10/ 8;  // BDP assuming paths ~ 5hops
-            for(uint ind2=0; ind2 < 2; ind2++){
-                PointToPointHelper pointToPoint;
-                pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(g_Options.tor2Agg_Bandwidth));
-                pointToPoint.SetChannelAttribute("Delay", TimeValue(lat));
-                pointToPoint.SetQueueAttribute("Mode", EnumValue(DropTailQueue::BYTES));
-                pointToPoint.SetQueueAttribute("MaxBytes", UintegerValue(1e7));
-
-                int n1 = ind1;
-                int n2 = ind2+ currentAggIndex_a;
-            
-                NodeContainer nc = NodeContainer(m_nodes.Get(n1), m_nodes.Get(n2));
-                NetDeviceContainer linkDevices = pointToPoint.Install(nc);
-              
-                wiredUplinks[n1].Add(linkDevices.Get(0));
-
-                Ipv4InterfaceContainer linkInterfaces = m_address.Assign(linkDevices);
-            
-                AddDeviceAt(n1, n2, linkDevices.Get(0));
-                AddDeviceAt(n2, n1, linkDevices.Get(1));
-    
-                AddInterfaceAt(n1, n2, linkInterfaces.Get(0));
-                AddInterfaceAt(n2, n1, linkInterfaces.Get(1));
-           
-                m_address.NewNetwork();
-            }
-
-            m_tor2agg_index.insert(pair<int, int> (ind1, currentAggIndex_a));
-
-            if ( m_agg2tor_index.find(currentAggIndex_a) == m_agg2tor_index.end()){ 
-                m_agg2tor_index.insert(pair<uint, vector<uint>* >(currentAggIndex_a, new vector<uint> () ));
-            }
-            m_agg2tor_index[currentAggIndex_a]->push_back(ind1);
-      
-            if ( ind1 !=  m_numtors-1 && (ind1+1) % g_Options.aggFanOut == 0 ) {
-                currentAggIndex_a += 2;
-            }
-        }
-        assert ( currentAggIndex_a + 1 < m_numtors + m_numaggs);
-
-        cout << "======================================================================" << endl;
-        // get geo for agg switch
-        for(uint ind=m_numtors; ind < m_numtors+m_numaggs; ind+=2){
-            m_v_nodeXYLocations_meter[ind] = m_v_nodeXYLocations_meter[GetCentralRack ( m_agg2tor_index[ind] )];
-            m_v_nodeXYLocations_meter[ind+1] = m_v_nodeXYLocations_meter[ind];
-        }
-
-        // connect agg switches to l3
-        uint currentL3Index_a = m_numtors + m_numaggs;
-        for(uint ind1=0; ind1 < m_numaggs; ind1++){
-            Time lat = MilliSeconds(0.01);
-            //uint qSize = g_Options.agg2L3_Bandwidth.GetBitRate() * lat.GetSeconds() * 10/8;
-
-            for(uint ind2=0; ind2<2; ind2++){
-                PointToPointHelper pointToPoint;
-                pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(g_Options.agg2L3_Bandwidth));
-                pointToPoint.SetChannelAttribute("Delay", TimeValue(lat));
-                pointToPoint.SetQueueAttribute("Mode", EnumValue(DropTailQueue::BYTES));
-                pointToPoint.SetQueueAttribute("MaxBytes", UintegerValue(1e7));
-                int n1 = ind1 + m_numtors;
-                int n2 = ind2 + currentL3Index_a;
-    
-                NodeContainer nc = NodeContainer(m_nodes.Get(n1), m_nodes.Get(n2));
-                NetDeviceContainer linkDevices = pointToPoint.Install(nc);
-                Ipv4InterfaceContainer linkInterfaces = m_address.Assign(linkDevices);
-    
-                wiredUplinks[n1].Add(linkDevices.Get(0));
-
-                AddDeviceAt(n1, n2, linkDevices.Get(0));
-                AddDeviceAt(n2, n1, linkDevices.Get(1));
-    
-                AddInterfaceAt(n1, n2, linkInterfaces.Get(0));
-                AddInterfaceAt(n2, n1, linkInterfaces.Get(1));
-                   
-                m_address.NewNetwork();
-            }
-            m_agg2l3_index.insert(pair<int, int>(ind1+m_numtors, currentL3Index_a));
-            if ( ind1 != m_numaggs - 1 && (ind1+1)%g_Options.l3FanOut == 0 ) {
-                currentL3Index_a += 2;
-            }
-        } 
+        BuildWired(FlywayTopologyPlan::Generate(g_Options), stack);
+        BuildAdjacency();
         SetupMobilityModel();
         SetupWirelessInterfaces();
         // Set up traffic
@@ -568,15 +407,8 @@ namespace ns3 {
         //     }
         //     SetupFlows ( flows );
         // }
-        FILE* flows = fopen(flowFile, "r");
         cout << "new code path" << endl;
-        if ( flows == NULL ) {
-            printf("cannot read flow file: %s\n", g_Options.replayFlowFileName);
-            exit(-1);
-        }
-        SetupFlows ( flows );
-
-        assert(currentL3Index_a +1 < m_numnodes);
+        SetupFlows(flowFile);
     }
 
     FlywaysTopoHelper::FlywaysTopoHelper 
@@ -586,51 +418,52 @@ namespace ns3 {
     {
 
         m_address = address; 
+        m_lazyFlows = NULL;
+        m_completions = new FlywayCompletionTable();
 
-        FILE *f_in;
-        if (topoFile == NULL || (f_in = fopen(topoFile, "r")) == NULL) {
-            printf("cannot read topo: %s\n", topoFile);
-            exit(-1);
-        }
-
-        // Read the topo file.
-        ReadTopo(f_in);
+        // Read the topo file, text or binary.
+        ReadTopo(topoFile);
 
         // init geometry
         InitGeometry();
 
-        m_numtors = g_Options.numTors;
         m_numdongles = g_Options.donglesPerTor;
 
-        m_numaggs = 0;
-        int unassignedTors = m_numtors;
-        while ( unassignedTors > 0 ){
-            m_numaggs += 2;
-            unassignedTors -= g_Options.aggFanOut;
-        }
-
-        m_numl3s = 0;
-        int unassignedAggs = m_numaggs;
-        while( unassignedAggs > 0 ){
-            m_numl3s += 2;
-            unassignedAggs -= g_Options.l3FanOut;
+        BuildWired(FlywayTopologyPlan::Generate(g_Options), stack);
+        BuildAdjacency();
+        SetupMobilityModel();
+        SetupWirelessInterfaces();
+        // Set up traffic
+        if ( g_Options.trafficType == FW_TT_ReplayFlows ){
+            SetupFlows(g_Options.replayFlowFileName);
         }
+    }
 
-        m_numnodes = m_numtors + m_numaggs + m_numl3s;
+    void FlywaysTopoHelper::BuildWired(const FlywayTopologyPlan &plan, InternetStackHelper &stack)
+    {
+        m_numtors = plan.GetNumTors();
+        m_numaggs = plan.GetNumMiddle();
+        m_numl3s = plan.GetNumTop();
+        m_numnodes = plan.GetNumNodes();
 
         cout << "Nodes: " << m_numnodes << "ToRs/Aggs/L3s: " << m_numtors << " " << m_numaggs << " " << m_numl3s << endl;;
         assert (m_numnodes > 0);
 
-        m_nodes.Create(m_numnodes);
+        Time lat = MicroSeconds(10);
+        UintegerValue partitions;
+        g_flywaysPartitions.GetValue(partitions);
+        vector<uint32_t> systemIds(m_numnodes, 0);
+        if ( partitions.Get() > 1 ){
+            systemIds = PartitionPlan(plan, g_Options, partitions.Get(), lat);
+        }
+        for(uint32_t i=0; i < m_numnodes; i++){
+            m_nodes.Add(CreateObject<Node>(systemIds[i]));
+        }
 
         stack.Install(m_nodes);
 
-        for(uint ind1=0; ind1 < m_numnodes; ind1++){
-            m_v_devices.push_back(NULL); // empty map
-            m_v_interfaces.push_back(NULL); // empty interface
-            m_v_nodeXYLocations_meter.push_back(pair<double, double>(-1, -1)); // initialize
-            m_v_node2NextPort.push_back(1); // next usable port is 1. 0 is a special value - cannot be used.
-        }
+        m_v_nodeXYLocations_meter.assign(m_numnodes, pair<double, double>(-1, -1)); // initialize
+        m_v_node2NextPort.assign(m_numnodes, 1); // next usable port is 1. 0 is a special value - cannot be used.
 
         // get geo for ToRs
         for(uint ind1=0; ind1 < m_numtors; ind1++){
@@ -638,106 +471,112 @@ namespace ns3 {
             cout << "[GeoLoc] node " << ind1 << " (x, y) = (" << m_v_nodeXYLocations_meter[ind1].first << ", " << m_v_nodeXYLocations_meter[ind1].second << ")" << endl; 
         }
 
-        // connect ToRs to their Agg Switch
-        uint currentAggIndex_a = m_numtors;
-        for(uint ind1=0; ind1 < m_numtors; ind1++){
-            Time lat = MilliSeconds(0.01);
-            //Time lat = MilliSeconds(10);
-            //uint32_t qSize = g_Options.tor2Agg_Bandwidth.GetBitRate() * lat.GetSeconds() * 10/ 8;  // BDP assuming paths ~ 5hops
-            for(uint ind2=0; ind2 < 2; ind2++){
+        // The links are made by one helper per rate, rather than one helper
+        // per link, and the adjacency is sized for all of them up front.
+        map<uint64_t, PointToPointHelper> helpers;
+        m_pendingDevices.reserve(2 * plan.GetNLinks());
+        m_pendingAddresses.reserve(2 * plan.GetNLinks());
+        bool placed = false;
+        for(uint32_t i=0; i < plan.GetNLinks(); i++){
+            const FlywayTopologyPlan::Link &link = plan.GetLink(i);
+            if ( !placed && link.lower >= m_numtors ){
+                PlaceSwitches();
+                placed = true;
+            }
+
+            map<uint64_t, PointToPointHelper>::iterator h = helpers.find(link.rate.GetBitRate());
+            if ( h == helpers.end() ){
                 PointToPointHelper pointToPoint;
-                pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(g_Options.tor2Agg_Bandwidth));
+                pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(link.rate));
                 pointToPoint.SetChannelAttribute("Delay", TimeValue(lat));
                 pointToPoint.SetQueueAttribute("Mode", EnumValue(DropTailQueue::BYTES));
                 pointToPoint.SetQueueAttribute("MaxBytes", UintegerValue(1e7));
-
-                int n1 = ind1;
-                int n2 = ind2+ currentAggIndex_a;
-            
-                NodeContainer nc = NodeContainer(m_nodes.Get(n1), m_nodes.Get(n2));
-                NetDeviceContainer linkDevices = pointToPoint.Install(nc);
-              
-                wiredUplinks[n1].Add(linkDevices.Get(0));
-
-                Ipv4InterfaceContainer linkInterfaces = m_address.Assign(linkDevices);
-            
-                AddDeviceAt(n1, n2, linkDevices.Get(0));
-                AddDeviceAt(n2, n1, linkDevices.Get(1));
-    
-                AddInterfaceAt(n1, n2, linkInterfaces.Get(0));
-                AddInterfaceAt(n2, n1, linkInterfaces.Get(1));
-           
-                m_address.NewNetwork();
+                h = helpers.insert(pair<uint64_t, PointToPointHelper>(link.rate.GetBitRate(), pointToPoint)).first;
             }
 
-            m_tor2agg_index.insert(pair<int, int> (ind1, currentAggIndex_a));
+            int n1 = link.lower;
+            int n2 = link.upper;
 
-            if ( m_agg2tor_index.find(currentAggIndex_a) == m_agg2tor_index.end()){ 
-                m_agg2tor_index.insert(pair<uint, vector<uint>* >(currentAggIndex_a, new vector<uint> () ));
-            }
-            m_agg2tor_index[currentAggIndex_a]->push_back(ind1);
-      
-            if ( ind1 !=  m_numtors-1 && (ind1+1) % g_Options.aggFanOut == 0 ) {
-                currentAggIndex_a += 2;
-            }
-        }
-        assert ( currentAggIndex_a + 1 < m_numtors + m_numaggs);
+            NetDeviceContainer linkDevices = h->second.Install(m_nodes.Get(n1), m_nodes.Get(n2));
 
-        cout << "======================================================================" << endl;
-        // get geo for agg switch
-        for(uint ind=m_numtors; ind < m_numtors+m_numaggs; ind+=2){
-            m_v_nodeXYLocations_meter[ind] = m_v_nodeXYLocations_meter[GetCentralRack ( m_agg2tor_index[ind] )];
-            m_v_nodeXYLocations_meter[ind+1] = m_v_nodeXYLocations_meter[ind];
-        }
+            wiredUplinks[n1].Add(linkDevices.Get(0));
 
-        // connect agg switches to l3
-        uint currentL3Index_a = m_numtors + m_numaggs;
-        for(uint ind1=0; ind1 < m_numaggs; ind1++){
-            Time lat = MilliSeconds(0.01);
-            //uint qSize = g_Options.agg2L3_Bandwidth.GetBitRate() * lat.GetSeconds() * 10/8;
+            Ipv4InterfaceContainer linkInterfaces = m_address.Assign(linkDevices);
 
-            for(uint ind2=0; ind2<2; ind2++){
-                PointToPointHelper pointToPoint;
-                pointToPoint.SetDeviceAttribute("DataRate", DataRateValue(g_Options.agg2L3_Bandwidth));
-                pointToPoint.SetChannelAttribute("Delay", TimeValue(lat));
-                pointToPoint.SetQueueAttribute("Mode", EnumValue(DropTailQueue::BYTES));
-                pointToPoint.SetQueueAttribute("MaxBytes", UintegerValue(1e7));
-                int n1 = ind1 + m_numtors;
-                int n2 = ind2 + currentL3Index_a;
-    
-                NodeContainer nc = NodeContainer(m_nodes.Get(n1), m_nodes.Get(n2));
-                NetDeviceContainer linkDevices = pointToPoint.Install(nc);
-                Ipv4InterfaceContainer linkInterfaces = m_address.Assign(linkDevices);
-    
-                wiredUplinks[n1].Add(linkDevices.Get(0));
+            AddDeviceAt(n1, n2, linkDevices.Get(0));
+            AddDeviceAt(n2, n1, linkDevices.Get(1));
 
-                AddDeviceAt(n1, n2, linkDevices.Get(0));
-                AddDeviceAt(n2, n1, linkDevices.Get(1));
-    
-                AddInterfaceAt(n1, n2, linkInterfaces.Get(0));
-                AddInterfaceAt(n2, n1, linkInterfaces.Get(1));
-                   
-                m_address.NewNetwork();
+            AddInterfaceAt(n1, n2, linkInterfaces.Get(0));
+            AddInterfaceAt(n2, n1, linkInterfaces.Get(1));
+
+            m_address.NewNetwork();
+
+            if ( link.lower < m_numtors ){
+                // the first switch of a ToR is where its traffic goes up
+                m_tor2agg_index.insert(pair<int, int> (n1, n2));
+                if ( m_agg2tor_index.find(n2) == m_agg2tor_index.end()){ 
+                    m_agg2tor_index.insert(pair<uint, vector<uint>* >(n2, new vector<uint> () ));
+                }
+                m_agg2tor_index[n2]->push_back(n1);
             }
-            m_agg2l3_index.insert(pair<int, int>(ind1+m_numtors, currentL3Index_a));
-            if ( ind1 != m_numaggs - 1 && (ind1+1)%g_Options.l3FanOut == 0 ) {
-                currentL3Index_a += 2;
+            else {
+                m_agg2l3_index.insert(pair<int, int>(n1, n2));
             }
-        } 
-        SetupMobilityModel();
-        SetupWirelessInterfaces();
-        // Set up traffic
-        if ( g_Options.trafficType == FW_TT_ReplayFlows ){
+        }
+        if ( !placed ){
+            PlaceSwitches();
+        }
+    }
 
-            FILE* flows = fopen(g_Options.replayFlowFileName, "r");
-            if ( flows == NULL ) {
-                printf("cannot read flow file: %s\n", g_Options.replayFlowFileName);
-                exit(-1);
+    vector<uint32_t> FlywaysTopoHelper::PartitionPlan(const FlywayTopologyPlan &plan, const GlobalOpt &options,
+                                                      uint32_t nPartitions, Time delay)
+    {
+        NodePartitioner partitioner;
+        partitioner.AddPlan(plan, delay);
+
+        // The dongles of a tier all share one wifi channel, which no
+        // parallel run may cut, and SetupWirelessInterfaces installs those
+        // of every tier on the ToRs.
+        if ( options.donglesPerTor > 0 || options.donglesPerAgg > 0 || options.donglesPerL3 > 0 ){
+            for(uint32_t i=1; i < plan.GetNumTors(); i++){
+                partitioner.Couple(0, i);
             }
-            SetupFlows ( flows );
         }
 
-        assert( currentL3Index_a +1 < m_numnodes);
+        vector<uint32_t> systemIds = partitioner.Partition(nPartitions);
+        if ( partitioner.GetNPartitions() > 1 && partitioner.GetLookAhead().IsZero() ){
+            // The partitions could not run ahead of each other at all, and
+            // the MultithreadedSimulatorImpl refuses links without delay.
+            cout << "[Partition] Warning: the links cut have no delay, running in a single partition" << endl;
+            systemIds.assign(systemIds.size(), 0);
+            return systemIds;
+        }
+        cout << "[Partition] " << partitioner.GetNPartitions() << " partitions, "
+             << partitioner.GetNCutLinks() << " links cut, lookahead "
+             << partitioner.GetLookAhead().GetTimeStep() << "ns" << endl;
+        return systemIds;
+    }
+
+    void FlywaysTopoHelper::PlaceSwitches()
+    {
+        cout << "======================================================================" << endl;
+        // get geo for the switches right above ToRs: each goes to the central
+        // rack of its ToRs, along with the switches before it which have the
+        // same ToRs, as the two of a pair of aggs do
+        vector<uint>* last = NULL;
+        uint lastInd = 0;
+        for(uint ind=m_numtors; ind < m_numtors+m_numaggs; ind++){
+            map<uint, vector<uint>* >::iterator it = m_agg2tor_index.find(ind);
+            if ( it == m_agg2tor_index.end() )
+                continue;
+            vector<uint>* rackids = (*it).second;
+            if ( last != NULL && *last == *rackids )
+                m_v_nodeXYLocations_meter[ind] = m_v_nodeXYLocations_meter[lastInd];
+            else
+                m_v_nodeXYLocations_meter[ind] = m_v_nodeXYLocations_meter[(*rackids)[GetCentralRack(rackids)]];
+            last = rackids;
+            lastInd = ind;
+        }
     }
 
     void FlywaysTopoHelper::SetupMobilityModel()
@@ -914,12 +753,9 @@ namespace ns3 {
         if ( ind1 < 0 || ind1 >= m_numnodes )
             NS_FATAL_ERROR("too large ind1 @ AddInterfaceAt");
 
-        if ( m_v_interfaces.at(ind1) == NULL )
-        m_v_interfaces.at(ind1) = new map<uint, pair<Ptr<Ipv4>, uint> > ();
-
-        NS_ASSERT_MSG ( m_v_interfaces.at(ind1), "AddInterfaceAt creating map" );
+        NS_ASSERT_MSG ( m_adjStart.empty(), "AddInterfaceAt after BuildAdjacency" );
 
-        m_v_interfaces[ind1]->insert( pair<uint, pair< Ptr<Ipv4>, uint> > (ind2, ipv) );
+        m_pendingAddresses.push_back( make_pair(make_pair(ind1, ind2), ia) );
 
         //cout << "add interface @ " << ind1 << ":" << ind2 << endl;
 
@@ -928,6 +764,8 @@ namespace ns3 {
 
     pair<double, double> FlywaysTopoHelper::GetNextRackLocation()
     {
+        if ( g_Options.arrangeType == FW_ToA_Rows )
+            return GetNextRowLocation();
 
         if( m_currClumpNumRacksReady == g_Options.clumpNumRacks ){
             // figure out where to place the next clump
@@ -992,60 +830,131 @@ namespace ns3 {
 
     }
 
+    pair<double, double> FlywaysTopoHelper::GetNextRowLocation()
+    {
+        NS_ASSERT_MSG ( g_Options.racksPerRow > 0, "no racks in a row");
+        uint row = m_racksPlaced / g_Options.racksPerRow;
+        uint col = m_racksPlaced % g_Options.racksPerRow;
+        double xloc = col * g_Options.rackWidth_meter;
+        double yloc = row * (g_Options.rackHeight_meter + g_Options.aisleWidth_meter);
+        m_racksPlaced ++;
+
+        // keep [0, 0] to [finishedX, finishedY] around the racks placed, as
+        // GetCentralRack expects
+        double endX = ceil(xloc + g_Options.rackWidth_meter);
+        double endY = ceil(yloc + g_Options.rackHeight_meter);
+        if ( endX > m_finishedX )
+            m_finishedX = endX;
+        if ( endY > m_finishedY )
+            m_finishedY = endY;
+        return pair<double, double> (xloc, yloc);
+    }
+
     void FlywaysTopoHelper::AddDeviceAt (uint ind1, uint ind2, Ptr<NetDevice> nd){
         if ( ind1 < 0 || ind1 >= m_numnodes )
             NS_FATAL_ERROR("too large ind1 @ AddDeviceAt");
 
-        if( m_v_devices.at(ind1) == NULL )
-            m_v_devices.at(ind1) = new map< uint, Ptr<NetDevice>  > ();
-
-        NS_ASSERT_MSG ( m_v_devices.at(ind1), "AddDeviceAt creating map" );
+        NS_ASSERT_MSG ( m_adjStart.empty(), "AddDeviceAt after BuildAdjacency" );
 
-        m_v_devices[ind1]->insert( pair<uint, Ptr<NetDevice> > (ind2, nd) );
+        m_pendingDevices.push_back( make_pair(make_pair(ind1, ind2), nd) );
         //cout << "add device @ " << ind1  << ":" << ind2 << endl;
     }
 
+    template <typename T>
+    static bool LinkBefore(const pair<pair<uint, uint>, T> &a, const pair<pair<uint, uint>, T> &b)
+    {
+        return a.first < b.first;
+    }
 
-    FlywaysTopoHelper::~FlywaysTopoHelper ()
+    void FlywaysTopoHelper::BuildAdjacency()
     {
-        // fill this out, for now memory leak
+        NS_ASSERT_MSG ( m_adjStart.empty(), "BuildAdjacency called twice" );
+
+        stable_sort(m_pendingDevices.begin(), m_pendingDevices.end(), LinkBefore<Ptr<NetDevice> >);
+        stable_sort(m_pendingAddresses.begin(), m_pendingAddresses.end(), LinkBefore<Ipv4Address>);
+
+        m_adjStart.assign(m_numnodes + 1, 0);
+        m_adjNbr.reserve(m_pendingDevices.size());
+        m_adjDevice.reserve(m_pendingDevices.size());
+        m_adjAddress.reserve(m_pendingDevices.size());
+        uint32_t a = 0;
+        for (uint32_t d = 0; d < m_pendingDevices.size(); d++) {
+            pair<uint, uint> link = m_pendingDevices[d].first;
+            // the first device and address added between two nodes win
+            if (d > 0 && m_pendingDevices[d - 1].first == link)
+                continue;
+            while (a < m_pendingAddresses.size() && m_pendingAddresses[a].first < link)
+                a++;
+            if (a == m_pendingAddresses.size() || m_pendingAddresses[a].first != link)
+                NS_FATAL_ERROR("no address on the link of node " << link.first << " to " << link.second);
+            m_adjStart[link.first + 1]++;
+            m_adjNbr.push_back(link.second);
+            m_adjDevice.push_back(m_pendingDevices[d].second);
+            m_adjAddress.push_back(m_pendingAddresses[a].second);
+        }
+        for (uint n = 0; n < m_numnodes; n++)
+            m_adjStart[n + 1] += m_adjStart[n];
+
+        vector<pair<pair<uint, uint>, Ptr<NetDevice> > > ().swap(m_pendingDevices);
+        vector<pair<pair<uint, uint>, Ipv4Address> > ().swap(m_pendingAddresses);
     }
 
-    vector<uint32_t> * FlywaysTopoHelper::GetNbrsOfNode(uint32_t index)
+    int32_t FlywaysTopoHelper::FindLink(uint32_t index, int32_t nbr) const
     {
-        vector<uint32_t>* p_retval = new vector<uint32_t> ();
-        NS_ASSERT_MSG ( index <= m_numnodes, "index " << index << " > #nodes " << m_numnodes);
+        NS_ASSERT_MSG ( !m_adjStart.empty(), "adjacency not built yet" );
+        if (nbr == -1)
+            return m_adjStart[index];
+        vector<uint32_t>::const_iterator begin = m_adjNbr.begin() + m_adjStart[index];
+        vector<uint32_t>::const_iterator end = m_adjNbr.begin() + m_adjStart[index + 1];
+        vector<uint32_t>::const_iterator it = lower_bound(begin, end, (uint32_t) nbr);
+        if (it == end || *it != (uint32_t) nbr)
+            return -1;
+        return it - m_adjNbr.begin();
+    }
 
-        if ( m_v_devices[index] == NULL ) 
-            return p_retval;
 
-        map<uint, Ptr<NetDevice> >::iterator mipit;
-        for(mipit = m_v_devices[index]->begin(); mipit != m_v_devices[index]->end(); mipit++) {
-            p_retval->push_back( (*mipit).first );
+    FlywaysTopoHelper::~FlywaysTopoHelper ()
+    {
+        // The nodes themselves go away with Simulator::Destroy. Free what
+        // this helper allocated, so that a driver can build one topology
+        // after another in the same process.
+        map<uint, vector<uint>* >::iterator ait;
+        for(ait = m_agg2tor_index.begin(); ait != m_agg2tor_index.end(); ait++){
+            delete (*ait).second;
+        }
+        for(uint ind=0; ind < m_v_apps.size(); ind++){
+            delete m_v_apps[ind];
         }
-        return p_retval;
+        delete m_lazyFlows;
+        delete m_completions;
+    }
+
+    uint32_t FlywaysTopoHelper::GetNumNbrs(uint32_t index) const
+    {
+        NS_ASSERT_MSG ( index < m_numnodes, "index " << index << " >= #nodes " << m_numnodes);
+        return m_adjStart[index + 1] - m_adjStart[index];
+    }
+
+    uint32_t FlywaysTopoHelper::GetNbr(uint32_t index, uint32_t i) const
+    {
+        NS_ASSERT_MSG ( i < GetNumNbrs(index), "node " << index << " has no neighbor " << i);
+        return m_adjNbr[m_adjStart[index] + i];
     }
 
     Ptr<NetDevice> FlywaysTopoHelper::GetDevice(uint32_t index, int32_t nbr)
     {
-        if ( index < 0 || index >= m_numnodes || m_v_devices[index] == NULL )
+        if ( index >= m_numnodes || GetNumNbrs(index) == 0 )
         {
             NS_FATAL_ERROR ("Index not valid in FlywaysTopoHelper::GetDevice.");
             return NULL;
         }
 
-        if ( nbr < -1 || 
-                (nbr == -1 && m_v_devices[index] == NULL) || 
-                (nbr >= 0 && ( (uint) nbr >= m_numnodes || m_v_devices[index] == NULL || m_v_devices[index]->find(nbr) == m_v_devices[index]->end() ))) {
+        int32_t link = nbr < -1 ? -1 : FindLink(index, nbr);
+        if ( link < 0 ) {
             NS_FATAL_ERROR ("Nbr not valid in FlywaysTopoHelper::GetDevice.");
             return NULL;
         }
-
-
-        if ( nbr == -1 ) 
-            return m_v_devices[index]->begin()->second;
-        else
-        return m_v_devices[index]->find(nbr)->second;
+        return m_adjDevice[link];
     }
 
     Ptr<Node> FlywaysTopoHelper::GetNode(uint32_t index)
@@ -1059,26 +968,16 @@ namespace ns3 {
 
     Ipv4Address FlywaysTopoHelper::GetIpv4Address (uint32_t index, int32_t nbr)
     {
-        if ( index < 0 || index >= m_numnodes ||
-            m_v_interfaces[index] == NULL ){
+        if ( index >= m_numnodes || GetNumNbrs(index) == 0 ){
             NS_FATAL_ERROR ("Index not valid in FlywaysTopoHelper::GetIpv4Address.");
             return NULL;
         }
-        if (nbr < -1 || 
-            (nbr == -1 && m_v_interfaces[index] == NULL) ||
-            (nbr >= 0 && ((uint) nbr >= m_numnodes || m_v_interfaces[index] == NULL || m_v_interfaces[index]->find(nbr) == m_v_interfaces[index]->end()))){
+        int32_t link = nbr < -1 ? -1 : FindLink(index, nbr);
+        if ( link < 0 ){
             NS_FATAL_ERROR ("Nbr not valid in FlywaysTopoHelper::GetIpv4Address.");
             return NULL;
         }
-
-        pair<Ptr<Ipv4>, uint32_t> result;
-        if (nbr == -1) {
-            result =  m_v_interfaces[index]->begin()->second;
-        }
-        else {
-            result =  m_v_interfaces[index]->find(nbr)->second;
-        }
-        return (result.first)->GetAddress(result.second, 0).GetLocal();
+        return m_adjAddress[link];
     }
 
     int FlywaysTopoHelper::GetNumNodes() const
@@ -1109,7 +1008,7 @@ namespace ns3 {
 
     uint64_t FlywaysTopoHelper::GetTotalRx(int i)
     {
-        if (i < 0 || i >= GetNumApps()) 
+        if (i < 0 || i >= GetNumApps() || m_v_apps[i] == NULL)
             return 0; 
         else  
             return m_v_apps[i]->GetTotalRx();
@@ -1117,7 +1016,7 @@ namespace ns3 {
 
     bool FlywaysTopoHelper::IsFinished(int i)
     {
-        if (i < 0 || i >= GetNumApps()) 
+        if (i < 0 || i >= GetNumApps() || m_v_apps[i] == NULL)
             return false; 
         else  
             return m_v_apps[i]->IsFinished();
@@ -1125,7 +1024,7 @@ namespace ns3 {
 
     Time FlywaysTopoHelper::WhenFinished(int i)
     {
-        if (i < 0 || i >= GetNumApps()) 
+        if (i < 0 || i >= GetNumApps() || m_v_apps[i] == NULL)
             return Seconds(0); 
         else  
             return m_v_apps[i]->WhenFinished();
@@ -1133,7 +1032,7 @@ namespace ns3 {
 
     double FlywaysTopoHelper::TotalDelay(int i)
     {
-        if (i < 0 || i >= GetNumApps()) 
+        if (i < 0 || i >= GetNumApps() || m_v_apps[i] == NULL)
             return 0; 
         else  
             return m_v_apps[i]->TotalDelay();
@@ -1176,6 +1075,43 @@ namespace ns3 {
         return rxPowerDbm;
     }
 
+    void FlywaysTopoHelper::CalcSignalStrengths(int from, uint dongleFrom, const vector<int> &to, uint dongleTo,
+                                                vector<double> &rxPowerDbm)
+    {
+        Ptr<YansWifiPhy> sender = GetFlywayPhy(from, dongleFrom);
+        Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
+        Vector sender_pos = senderMobility->GetPosition();
+        Ptr<Antenna> sender_ant = sender->GetAntenna();
+        Ptr<YansWifiChannel> channel = DynamicCast<YansWifiChannel>(sender->GetChannel());
+        Ptr<PropagationLossModel> loss = channel->GetPropagationLossModel();
+
+        uint n = to.size();
+        vector<Ptr<YansWifiPhy> > receivers(n);
+        vector<Ptr<MobilityModel> > mobility(n);
+        vector<double> distance(n), azimuth(n), elevation(n), txGain(n);
+        for (uint k = 0; k < n; k++)
+        {
+            receivers[k] = GetFlywayPhy(to[k], dongleTo);
+            mobility[k] = receivers[k]->GetMobility ()->GetObject<MobilityModel> ();
+            Vector receiver_pos = mobility[k]->GetPosition();
+            distance[k] = CalculateDistance(sender_pos, receiver_pos);
+            azimuth[k] = CalculateAzimuthAngle(sender_pos, receiver_pos);
+            elevation[k] = CalculateElevationAngle(sender_pos, receiver_pos);
+        }
+
+        rxPowerDbm.resize(n);
+        if (n == 0)
+            return;
+        loss->CalcRxPowerBatch(sender->GetTxPowerEnd(), senderMobility, &mobility[0],
+                               &distance[0], &rxPowerDbm[0], n);
+        sender_ant->GetTxGainDbiBatch(&azimuth[0], &elevation[0], &txGain[0], n);
+        for (uint k = 0; k < n; k++)
+        {
+            rxPowerDbm[k] = rxPowerDbm[k] + txGain[k] +
+                receivers[k]->GetAntenna()->GetRxGainDbi(azimuth[k]+M_PI, -elevation[k]);
+        }
+    }
+
     Ptr<YansWifiPhy> FlywaysTopoHelper::GetFlywayPhy(uint nodeId, uint dongleGroup)
     {
         NetDeviceContainer flywayLinks = GetFlywayLinks(nodeId);
@@ -1259,8 +1195,7 @@ namespace ns3 {
     void FlywaysTopoHelper::PointNodeTo(uint nodeId, uint dongleGroup, double x, double y)
     {
         double angle = GetAngle(m_v_nodeXYLocations_meter[nodeId].first, m_v_nodeXYLocations_meter[nodeId].second, x, y);
-        SetAntennaAzimuthAngle(nodeId, dongleGroup, angle);
-        SetAntennaElevationAngle(nodeId, dongleGroup, 0);
+        GetFlywayPhy(nodeId, dongleGroup)->GetAntenna()->Steer(angle, 0);
     }
 
     void FlywaysTopoHelper::PointAtEachOther(uint node1, uint dongleId1, uint node2, uint dongleId2)
@@ -1269,6 +1204,19 @@ namespace ns3 {
         PointNodeTo(node2, dongleId2, m_v_nodeXYLocations_meter[node1].first, m_v_nodeXYLocations_meter[node1].second);
     }
 
+    Ptr<BeamformingTraining> FlywaysTopoHelper::GetBeamformingTraining()
+    {
+        if (m_beamforming == 0)
+            m_beamforming = CreateObject<BeamformingTraining>();
+        return m_beamforming;
+    }
+
+    void FlywaysTopoHelper::TrainAtEachOther(uint node1, uint dongleId1, uint node2, uint dongleId2,
+                                             BeamformingTraining::DoneCallback done)
+    {
+        GetBeamformingTraining()->Train(GetFlywayPhy(node1, dongleId1), GetFlywayPhy(node2, dongleId2), done);
+    }
+
     void FlywaysTopoHelper::PointNowhere(uint nodeId, uint dongleId)
     {
         SetAntennaAzimuthAngle(nodeId, dongleId, 0.123);
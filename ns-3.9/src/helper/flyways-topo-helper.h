@@ -8,6 +8,7 @@
 #include <vector>
 #include <map>
 #include <cassert>
+#include <unistd.h>
 
 #include "ns3/data-rate.h"
 #include "ns3/point-to-point-helper.h"
@@ -25,6 +26,7 @@
 #include "ns3/yans-wifi-channel.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/yans-wifi-helper.h"
+#include "ns3/beamforming-training.h"
 #include "ns3/ipv4-interface-container.h"
 #include "ns3/wifi-helper.h"
 #include "ns3/on-off-helper.h"
@@ -39,7 +41,12 @@ using namespace std;
 namespace ns3
 {
 
-enum FW_TypeOfArrangement { FW_ToA_Square, FW_ToA_Unknown };
+class FlywayFlowTable;
+class FlywayCompletionTable;
+class FlywayTopologyPlan;
+
+enum FW_TypeOfArrangement { FW_ToA_Square, FW_ToA_Unknown, FW_ToA_Rows };
+enum FW_Topology { FW_Topo_Classic, FW_Topo_FatTree, FW_Topo_VL2, FW_Topo_LeafSpine };
 enum FW_TrafficType { FW_TT_ReplayFlows, FW_TT_Unknown };
 enum FW_NodeType { FW_Node_ToR, FW_Node_Agg, FW_Node_L3 };
 enum FW_AntennaType { FW_Antenna_Cone, FW_Antenna_Measured };
@@ -62,6 +69,20 @@ class GlobalOpt{
   FW_TypeOfArrangement arrangeType;
   DataRate agg2L3_Bandwidth, tor2Agg_Bandwidth, flywayBandwidth;
 
+  // the generator of the wired network, see FlywayTopologyPlan; the rates
+  // of generated networks follow from the bandwidth of the servers of a
+  // rack and the oversubscription of its uplinks
+  FW_Topology topology;
+  int fatTreeK;
+  int numSpines;
+  double oversubscription;
+  DataRate rackBandwidth;
+
+  // for FW_ToA_Rows: racks side by side in rows, rows one behind the other
+  // with an aisle in between
+  int racksPerRow;
+  double aisleWidth_meter;
+
   FW_TrafficType trafficType;
 #define GO_MAX_FILENAMELEN 100
   char replayFlowFileName[GO_MAX_FILENAMELEN];
@@ -80,6 +101,7 @@ class TrafficApp
  public:
   uint fromNode, toNode;
   float beginTime, transferSize;
+  int linkType;
 
   char fromApp[100], toApp[100]; // type of application
   char proto[10]; // protocol
@@ -87,6 +109,12 @@ class TrafficApp
   Ptr<Application> sourceApp;
   Ptr<PacketSink> sinkApp;
 
+  // the row of the flow in completions, and whether the applications go
+  // once the flow has completed
+  FlywayCompletionTable *completions;
+  uint32_t index;
+  bool lazy;
+
   uint64_t GetTotalRx()
   {
       return sinkApp->GetTotalRx();
@@ -112,6 +140,10 @@ class TrafficApp
     bzero(toApp, 100);
     bzero(proto, 10);
     bzero(dataRateString, 30);
+    linkType = 0;
+    completions = NULL;
+    index = 0;
+    lazy = false;
   }
 };
 
@@ -126,13 +158,37 @@ class FlywaysTopoHelper
         InternetStackHelper stack,
         Ipv4AddressHelper address);
   void ReadTopo(FILE*);
+  // Read a topo file, in the text or the binary format of FlywayTopoTable.
+  void ReadTopo(const char *topoFile);
+  // Apply ScaleDownBy to options and make them those of the topology.
+  void UseOptions(const GlobalOpt &options);
   void AddDeviceAt (uint ind1, uint ind2, Ptr<NetDevice> nd);
   void AddInterfaceAt(uint ind1, uint ind2, 
 		      pair< Ptr<Ipv4>, uint32_t> ipv);
+  // Turn the links added so far into the adjacency arrays the lookups
+  // below use. No link may be added afterwards.
+  void BuildAdjacency();
+  // Create the nodes and the links of plan, and place the ToRs and the
+  // switches above them.
+  void BuildWired(const FlywayTopologyPlan &plan, InternetStackHelper &stack);
+  // The system id of every node of plan, for a parallel run in
+  // nPartitions: the nodes are split by a NodePartitioner, with the
+  // links of the given delay, and the ToRs, which hold the dongles of
+  // every tier, kept together if there are any. All the nodes go to the
+  // partition 0,
+  // with a warning, if the links cut have no delay. BuildWired uses it
+  // when the global value FlywaysPartitions is more than 1.
+  static vector<uint32_t> PartitionPlan(const FlywayTopologyPlan &plan, const GlobalOpt &options,
+                                        uint32_t nPartitions, Time delay);
+  void PlaceSwitches();
   ~FlywaysTopoHelper ();
 
+  // The device and the address of node index on its link to nbr, or on
+  // its link to its first neighbor if nbr is -1.
   Ptr<NetDevice> GetDevice(uint32_t index, int32_t nbr);
-  vector<uint32_t> * GetNbrsOfNode(uint32_t index);
+  // The wired neighbors of node index, in increasing order.
+  uint32_t GetNumNbrs(uint32_t index) const;
+  uint32_t GetNbr(uint32_t index, uint32_t i) const;
   Ptr<Node> GetNode(uint32_t index);
   Ipv4Address GetIpv4Address (uint32_t index, int32_t nbr=-1);
   int GetNumNodes() const;
@@ -144,11 +200,42 @@ class FlywaysTopoHelper
   bool IsFinished(int appId);
   Time WhenFinished(int appId);
   double TotalDelay(int appId);
+  // The completion time of every flow, recorded as the sinks receive their
+  // last byte. The bytes received by the flows which have not completed
+  // are brought up to date first.
+  FlywayCompletionTable &GetCompletions();
   pair<double, double> GetNextRackLocation();
+  pair<double, double> GetNextRowLocation();
   uint GetCentralRack(vector<uint> *rackids);
   void InitGeometry();
   void SetupFlows(FILE*);
+  // Set up the flows of flowFile on the topology built so far, in the
+  // text or the binary format of FlywayFlowTable.
+  void SetupFlows(const char *flowFile);
+  void SetupFlows(const FlywayFlowTable &table);
+  // Replay the flows of table lazily: the applications of a flow are only
+  // created lead before it begins, and removed from their nodes once its
+  // sink has received all of it; their sockets go once their connections
+  // have closed. Until it is created, a flow counts as an app which has
+  // received nothing.
+  void SetupFlowsLazily(const FlywayFlowTable &table, Time lead);
+  void InstantiateFlows();
+  static void FlowFinished(TrafficApp *ta, uint64_t rxBytes);
+  static void TeardownFlow(TrafficApp *ta);
+  static void ReleaseSockets(Ptr<Node> node);
+  // Fork a copy-on-write child which starts from the topology built so
+  // far, so that each experiment skips building it. The simulation must
+  // not have run yet. In the child, the random number streams start over
+  // in run number run; random variables already drawn from in the parent
+  // carry on with their own streams. Returns as fork() does: the pid of
+  // the child in the parent, 0 in the child, -1 on failure. The child
+  // should end with _exit(), after flushing its files, so that it does
+  // not run the static destructors and atexit handlers of the parent.
+  pid_t ForkFromSnapshot(uint32_t run);
   void SetupFlow(TrafficApp*, int i);
+  // Install the sink and the source of ta, receiving on toPort, with the
+  // begin time of the flow counted from the time now.
+  void InstallFlow(TrafficApp* ta, uint toPort, Time now);
   void SetupMobilityModel();
   void SetupWirelessInterfaces();
   void SetFlywayInterfaceUpDown(FW_NodeType nodeType, int nodeId, int dongleGroupId, bool up);
@@ -165,9 +252,19 @@ class FlywaysTopoHelper
   void PointNodeTo(uint nodeId, uint dongleGroup, double x, double y);
   void PointAtEachOther(uint node1, uint dongleId1, uint node2, uint dongleId2);
   void PointNowhere(uint nodeId, uint dongleId);
+  // Steer two dongles at each other through a sector sweep rather than
+  // from their positions; done is invoked once the antennas are steered.
+  // Pairs trained before reuse their cached sectors.
+  void TrainAtEachOther(uint node1, uint dongleId1, uint node2, uint dongleId2,
+                        BeamformingTraining::DoneCallback done);
+  Ptr<BeamformingTraining> GetBeamformingTraining();
   double Distance (pair<double, double> a, pair<double, double> b);
   double GetDistance(int node1, int node2);
   double CalcSignalStrength(int from, uint dongleFrom, int to, uint dongleTo);
+  // Signal strength from one dongle at each of the dongles dongleTo of the
+  // nodes in to, evaluated in a single pass.
+  void CalcSignalStrengths(int from, uint dongleFrom, const vector<int> &to, uint dongleTo,
+                           vector<double> &rxPowerDbm);
 
   // Mobility helper. In this case, it is just a position holder.
   MobilityHelper mobility;
@@ -203,13 +300,24 @@ class FlywaysTopoHelper
 
   // ns3 state vars
   NodeContainer m_nodes;
-  vector<map<uint, Ptr<NetDevice> >* > m_v_devices; // for eacFlywaysTopoHelperh node, a pair of <neighbor,device>
-  vector<map<uint, pair<Ptr<Ipv4>, uint> >*> m_v_interfaces; // for each node a map of <neighbor <ipaddress, nbr>>
+  // wired adjacency, in compressed sparse rows: the links of node n are
+  // m_adjStart[n] up to m_adjStart[n+1], in increasing order of neighbor,
+  // with the device and the address of n on each
+  vector<uint32_t> m_adjStart;
+  vector<uint32_t> m_adjNbr;
+  vector<Ptr<NetDevice> > m_adjDevice;
+  vector<Ipv4Address> m_adjAddress;
+  // the links added until BuildAdjacency, keyed by <node, neighbor>
+  vector<pair<pair<uint, uint>, Ptr<NetDevice> > > m_pendingDevices;
+  vector<pair<pair<uint, uint>, Ipv4Address> > m_pendingAddresses;
+  // the link of node index to nbr in the adjacency arrays, -1 if none
+  int32_t FindLink(uint32_t index, int32_t nbr) const;
   map<Ipv4Address, uint> m_m_addresses; // for each ipv4address, a nodeId
 
   // for geometry
   uint m_finishedX, m_finishedY; // [0, 0] to [finishedX, finishedY] is full
   uint m_currClumpX, m_currClumpY, m_currClumpNumRacksReady; // statistics on current clump being filled
+  uint m_racksPlaced; // for rows, the racks placed so far
 
   vector<pair<double, double> > m_v_nodeXYLocations_meter; // x, y co-ordinates of each node, in feet
 
@@ -222,6 +330,19 @@ class FlywaysTopoHelper
   // for traffic sources
   vector<uint> m_v_node2NextPort;
   vector<TrafficApp*> m_v_apps; // traffic sources
+  FlywayCompletionTable *m_completions; // one row per app
+
+  // for lazy replay: the flows, the order in which they begin and their
+  // ports. The first one is m_v_apps[m_lazyBase].
+  FlywayFlowTable *m_lazyFlows;
+  vector<uint32_t> m_lazyOrder;
+  vector<uint> m_lazyPorts;
+  uint32_t m_lazyNext;
+  uint32_t m_lazyBase;
+  Time m_lazyLead;
+
+  // sector sweeps and their cache of best sectors
+  Ptr<BeamformingTraining> m_beamforming;
 
   // constructor
   FlywaysTopoHelper();
@@ -0,0 +1,392 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable.h"
+#include "ns3/rng-stream.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "node-container.h"
+#include "point-to-point-helper.h"
+#include "internet-stack-helper.h"
+#include "ipv4-address-helper.h"
+#include "ipv4-global-routing-helper.h"
+#include "on-off-helper.h"
+#include "packet-sink-helper.h"
+#include "yans-wifi-helper.h"
+#include "nqos-wifi-mac-helper.h"
+#include "mobility-helper.h"
+
+namespace ns3 {
+
+class MultithreadedSimulatorRingTest : public TestCase
+{
+public:
+  // the sources are on and off for random times if random is true, and
+  // always on otherwise; the run is stopped by an event of the last node
+  // if stopInEvent is true, and by the main program otherwise
+  MultithreadedSimulatorRingTest (bool random, bool stopInEvent);
+  virtual ~MultithreadedSimulatorRingTest ();
+
+private:
+  enum {
+    N_NODES = 4
+  };
+  struct Sink
+  {
+    uint32_t bytes;
+    int64_t lastRx;
+  };
+  struct Result
+  {
+    Sink sinks[N_NODES];
+    int64_t end;
+    uint32_t nPartitions;
+    uint32_t nRounds;
+  };
+
+  static void SinkRx (Sink *sink, Ptr<const Packet> p, const Address &from);
+  static void StopIn (Time delay);
+  // the nodes of the ring go to the partitions node / share
+  Result RunRing (std::string simulator, uint32_t share);
+  virtual bool DoRun (void);
+
+  bool m_random;
+  bool m_stopInEvent;
+};
+
+MultithreadedSimulatorRingTest::MultithreadedSimulatorRingTest (bool random, bool stopInEvent)
+  : TestCase (random ?
+              "Threads running a ring of nodes with random on and off times give the results of a single one" :
+              stopInEvent ?
+              "Threads running a ring of nodes stopped by one of them give the results of a single one" :
+              "Threads running a ring of nodes give the results of a single one"),
+    m_random (random),
+    m_stopInEvent (stopInEvent)
+{}
+
+MultithreadedSimulatorRingTest::~MultithreadedSimulatorRingTest ()
+{}
+
+void
+MultithreadedSimulatorRingTest::SinkRx (Sink *sink, Ptr<const Packet> p, const Address &from)
+{
+  sink->bytes += p->GetSize ();
+  sink->lastRx = Simulator::Now ().GetTimeStep ();
+}
+
+void
+MultithreadedSimulatorRingTest::StopIn (Time delay)
+{
+  Simulator::Stop (delay);
+}
+
+MultithreadedSimulatorRingTest::Result
+MultithreadedSimulatorRingTest::RunRing (std::string simulator, uint32_t share)
+{
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (simulator));
+  // every run hands the same streams to the variables
+  RngStream::SetPackageSeed (SeedManager::GetSeed ());
+
+  NodeContainer nodes;
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      nodes.Add (CreateObject<Node> (i / share));
+    }
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  std::vector<Ipv4InterfaceContainer> interfaces;
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      NetDeviceContainer link = p2p.Install (nodes.Get (i), nodes.Get ((i + 1) % N_NODES));
+      interfaces.push_back (address.Assign (link));
+      address.NewNetwork ();
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  // each node sends to the one across the ring, over UDP or TCP in turn
+  Result result;
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      std::string protocol = i % 2 == 0 ? "ns3::UdpSocketFactory" : "ns3::TcpSocketFactory";
+      uint32_t to = (i + N_NODES / 2) % N_NODES;
+      Address sinkAddress (InetSocketAddress (interfaces[to].GetAddress (0), 9000 + i));
+      PacketSinkHelper sink (protocol, sinkAddress);
+      ApplicationContainer sinkApp = sink.Install (nodes.Get (to));
+      result.sinks[i].bytes = 0;
+      result.sinks[i].lastRx = 0;
+      sinkApp.Get (0)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&SinkRx, &result.sinks[i]));
+      OnOffHelper source (protocol, sinkAddress);
+      if (m_random)
+        {
+          // the variables of each source draw once, so that they take
+          // their streams here rather than in the partitions
+          UniformVariable onTime (0.01, 0.1);
+          UniformVariable offTime (0.01, 0.1);
+          onTime.GetValue ();
+          offTime.GetValue ();
+          source.SetAttribute ("OnTime", RandomVariableValue (onTime));
+          source.SetAttribute ("OffTime", RandomVariableValue (offTime));
+        }
+      else
+        {
+          source.SetAttribute ("OnTime", RandomVariableValue (ConstantVariable (1)));
+          source.SetAttribute ("OffTime", RandomVariableValue (ConstantVariable (0)));
+        }
+      source.SetAttribute ("DataRate", StringValue ("4Mbps"));
+      source.SetAttribute ("PacketSize", UintegerValue (1000));
+      ApplicationContainer sourceApp = source.Install (nodes.Get (i));
+      // the random sources all start together, so that the partitions
+      // draw from their variables at once
+      sourceApp.Start (Seconds (m_random ? 0.1 : 0.1 + 0.01 * i));
+      sourceApp.Stop (Seconds (1.5));
+    }
+
+  if (m_stopInEvent)
+    {
+      // in the middle of the flows, and later than the lookahead
+      Simulator::ScheduleWithContext (N_NODES - 1, MilliSeconds (700), &StopIn, MilliSeconds (300));
+    }
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  result.end = Simulator::Now ().GetTimeStep ();
+  result.nPartitions = 1;
+  result.nRounds = 0;
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      result.nPartitions = impl->GetNPartitions ();
+      result.nRounds = impl->GetNRounds ();
+    }
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  return result;
+}
+
+bool
+MultithreadedSimulatorRingTest::DoRun (void)
+{
+  Result expected = RunRing ("ns3::DefaultSimulatorImpl", N_NODES);
+  for (uint32_t i = 0; i < N_NODES; i++)
+    {
+      NS_TEST_ASSERT_MSG_NE (expected.sinks[i].bytes, 0, "Nothing received by the sink " << i);
+    }
+  Time stop = m_stopInEvent ? Seconds (1) : Seconds (2);
+  NS_TEST_ASSERT_MSG_EQ (expected.end, stop.GetTimeStep (), "The run did not end at the stop time");
+
+  // a single partition, then two nodes per partition, then one
+  uint32_t shares[] = {N_NODES, 2, 1};
+  for (uint32_t k = 0; k < 3; k++)
+    {
+      Result result = RunRing ("ns3::MultithreadedSimulatorImpl", shares[k]);
+      NS_TEST_EXPECT_MSG_EQ (result.nPartitions, N_NODES / shares[k], "Wrong number of partitions");
+      if (result.nPartitions > 1)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((result.nRounds > 1), true, "The partitions ran in a single round");
+        }
+      NS_TEST_EXPECT_MSG_EQ (result.end, expected.end, "Different end of run with " << result.nPartitions << " partitions");
+      for (uint32_t i = 0; i < N_NODES; i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (result.sinks[i].bytes, expected.sinks[i].bytes,
+                                 "Different bytes for the sink " << i << " with " << result.nPartitions << " partitions");
+          NS_TEST_EXPECT_MSG_EQ (result.sinks[i].lastRx, expected.sinks[i].lastRx,
+                                 "Different last reception for the sink " << i << " with " << result.nPartitions << " partitions");
+        }
+    }
+  return GetErrorStatus ();
+}
+
+class MultithreadedSimulatorWifiTest : public TestCase
+{
+public:
+  MultithreadedSimulatorWifiTest ();
+  virtual ~MultithreadedSimulatorWifiTest ();
+
+private:
+  enum {
+    N_FLOWS = 2
+  };
+  struct Sink
+  {
+    uint32_t bytes;
+    int64_t lastRx;
+  };
+  struct Result
+  {
+    Sink sinks[N_FLOWS];
+    uint32_t nPartitions;
+  };
+
+  static void SinkRx (Sink *sink, Ptr<const Packet> p, const Address &from);
+  Result RunWifi (std::string simulator, bool split);
+  virtual bool DoRun (void);
+};
+
+MultithreadedSimulatorWifiTest::MultithreadedSimulatorWifiTest ()
+  : TestCase ("Threads running 60 GHz wifi networks give the results of a single one")
+{}
+
+MultithreadedSimulatorWifiTest::~MultithreadedSimulatorWifiTest ()
+{}
+
+void
+MultithreadedSimulatorWifiTest::SinkRx (Sink *sink, Ptr<const Packet> p, const Address &from)
+{
+  sink->bytes += p->GetSize ();
+  sink->lastRx = Simulator::Now ().GetTimeStep ();
+}
+
+MultithreadedSimulatorWifiTest::Result
+MultithreadedSimulatorWifiTest::RunWifi (std::string simulator, bool split)
+{
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue (simulator));
+  RngStream::SetPackageSeed (SeedManager::GetSeed ());
+
+  // two pairs of nodes, each on a wifi channel of its own, joined by a
+  // point-to-point link; with split, each pair is a partition, and both
+  // share the caches of the wifi module
+  NodeContainer left;
+  NodeContainer right;
+  left.Add (CreateObject<Node> (0));
+  left.Add (CreateObject<Node> (0));
+  right.Add (CreateObject<Node> (split ? 1 : 0));
+  right.Add (CreateObject<Node> (split ? 1 : 0));
+  InternetStackHelper stack;
+  stack.Install (left);
+  stack.Install (right);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0.0, 0.0, 0.0));
+  positions->Add (Vector (5.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (left);
+  mobility.Install (right);
+
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ad_SC);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("VHTMCS4"),
+                                "ControlMode", StringValue ("VHTMCS1"));
+  NqosWifiMacHelper mac = NqosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetErrorRateModel ("ns3::SensitivityModel60GHz");
+  phy.SetChannel (YansWifiChannelHelper::Default ().Create ());
+  NetDeviceContainer leftDevices = wifi.Install (phy, mac, left);
+  phy.SetChannel (YansWifiChannelHelper::Default ().Create ());
+  NetDeviceContainer rightDevices = wifi.Install (phy, mac, right);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer link = p2p.Install (left.Get (1), right.Get (0));
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer leftInterfaces = address.Assign (leftDevices);
+  address.SetBase ("10.1.2.0", "255.255.255.0");
+  address.Assign (link);
+  address.SetBase ("10.1.3.0", "255.255.255.0");
+  Ipv4InterfaceContainer rightInterfaces = address.Assign (rightDevices);
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  // UDP from the far left to the far right, TCP back
+  Result result;
+  Ptr<Node> from[N_FLOWS] = {left.Get (0), right.Get (1)};
+  Ptr<Node> to[N_FLOWS] = {right.Get (1), left.Get (0)};
+  Ipv4Address toAddress[N_FLOWS] = {rightInterfaces.GetAddress (1), leftInterfaces.GetAddress (0)};
+  for (uint32_t i = 0; i < N_FLOWS; i++)
+    {
+      std::string protocol = i == 0 ? "ns3::UdpSocketFactory" : "ns3::TcpSocketFactory";
+      Address sinkAddress (InetSocketAddress (toAddress[i], 9000 + i));
+      PacketSinkHelper sink (protocol, sinkAddress);
+      ApplicationContainer sinkApp = sink.Install (to[i]);
+      result.sinks[i].bytes = 0;
+      result.sinks[i].lastRx = 0;
+      sinkApp.Get (0)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&SinkRx, &result.sinks[i]));
+      OnOffHelper source (protocol, sinkAddress);
+      source.SetAttribute ("OnTime", RandomVariableValue (ConstantVariable (1)));
+      source.SetAttribute ("OffTime", RandomVariableValue (ConstantVariable (0)));
+      source.SetAttribute ("DataRate", StringValue ("20Mbps"));
+      source.SetAttribute ("PacketSize", UintegerValue (1000));
+      ApplicationContainer sourceApp = source.Install (from[i]);
+      sourceApp.Start (Seconds (0.1 + 0.01 * i));
+      sourceApp.Stop (Seconds (1.0));
+    }
+
+  Simulator::Stop (Seconds (1.5));
+  Simulator::Run ();
+  result.nPartitions = 1;
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      result.nPartitions = impl->GetNPartitions ();
+    }
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  return result;
+}
+
+bool
+MultithreadedSimulatorWifiTest::DoRun (void)
+{
+  Result expected = RunWifi ("ns3::DefaultSimulatorImpl", false);
+  for (uint32_t i = 0; i < N_FLOWS; i++)
+    {
+      NS_TEST_ASSERT_MSG_NE (expected.sinks[i].bytes, 0, "Nothing received by the sink " << i);
+    }
+
+  Result result = RunWifi ("ns3::MultithreadedSimulatorImpl", true);
+  NS_TEST_EXPECT_MSG_EQ (result.nPartitions, 2, "Wrong number of partitions");
+  for (uint32_t i = 0; i < N_FLOWS; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (result.sinks[i].bytes, expected.sinks[i].bytes, "Different bytes for the sink " << i);
+      NS_TEST_EXPECT_MSG_EQ (result.sinks[i].lastRx, expected.sinks[i].lastRx, "Different last reception for the sink " << i);
+    }
+  return GetErrorStatus ();
+}
+
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ();
+};
+
+MultithreadedSimulatorTestSuite::MultithreadedSimulatorTestSuite ()
+  : TestSuite ("helper-multithreaded-simulator", SYSTEM)
+{
+  AddTestCase (new MultithreadedSimulatorRingTest (false, false));
+  AddTestCase (new MultithreadedSimulatorRingTest (true, false));
+  AddTestCase (new MultithreadedSimulatorRingTest (false, true));
+  AddTestCase (new MultithreadedSimulatorWifiTest ());
+}
+
+MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "node-partitioner.h"
+#include "flyway-topology-plan.h"
+#include "flyways-topo-helper.h"
+#include "node-container.h"
+#include "point-to-point-helper.h"
+#include "csma-helper.h"
+#include <set>
+
+namespace ns3 {
+
+class NodePartitionerGraphTest : public TestCase
+{
+public:
+  NodePartitionerGraphTest ();
+  virtual ~NodePartitionerGraphTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+NodePartitionerGraphTest::NodePartitionerGraphTest ()
+  : TestCase ("The partitions cut little traffic, keep the lookahead large and keep coupled nodes together")
+{}
+
+NodePartitionerGraphTest::~NodePartitionerGraphTest ()
+{}
+
+bool
+NodePartitionerGraphTest::DoRun (void)
+{
+  // two cliques of four nodes joined by a single link
+  NodePartitioner cliques;
+  for (uint32_t c = 0; c < 2; c++)
+    {
+      for (uint32_t i = 0; i < 4; i++)
+        {
+          for (uint32_t j = i + 1; j < 4; j++)
+            {
+              cliques.AddLink (4 * c + i, 4 * c + j, MilliSeconds (1), 10);
+            }
+        }
+    }
+  cliques.AddLink (3, 4, MilliSeconds (1), 1);
+  std::vector<uint32_t> part = cliques.Partition (2);
+  NS_TEST_ASSERT_MSG_EQ (part.size (), 8, "Wrong number of nodes");
+  NS_TEST_EXPECT_MSG_EQ (cliques.GetNPartitions (), 2, "Wrong number of partitions");
+  NS_TEST_EXPECT_MSG_EQ (cliques.GetNCutLinks (), 1, "The cliques were cut");
+  NS_TEST_EXPECT_MSG_EQ (cliques.GetCutTraffic (), 1, "Wrong traffic cut");
+  NS_TEST_EXPECT_MSG_EQ (cliques.GetLookAhead (), MilliSeconds (1), "Wrong lookahead");
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (part[i], i / 4, "Node " << i << " in the wrong partition");
+    }
+
+  // a chain of short links of little traffic and long links of much: the
+  // cut with the least traffic, allowed by the imbalance, would cut a
+  // short link
+  NodePartitioner chain;
+  chain.SetImbalance (0.5);
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      if (i % 2 == 0)
+        {
+          chain.AddLink (i, i + 1, MilliSeconds (1), 1);
+        }
+      else
+        {
+          chain.AddLink (i, i + 1, MilliSeconds (10), 100);
+        }
+    }
+  part = chain.Partition (2);
+  NS_TEST_EXPECT_MSG_EQ (chain.GetNPartitions (), 2, "Wrong number of partitions");
+  NS_TEST_EXPECT_MSG_EQ (chain.GetLookAhead (), MilliSeconds (10), "A short link was cut");
+  NS_TEST_EXPECT_MSG_EQ (chain.GetNCutLinks (), 1, "Wrong number of links cut");
+  for (uint32_t i = 0; i < 8; i += 2)
+    {
+      NS_TEST_EXPECT_MSG_EQ (part[i], part[i + 1], "Nodes " << i << " and " << i + 1 << " apart");
+    }
+
+  // nodes coupled in three groups, and no links: three partitions at most
+  NodePartitioner coupled;
+  coupled.SetNNodes (6);
+  coupled.Couple (0, 2);
+  coupled.Couple (2, 5);
+  coupled.Couple (1, 4);
+  part = coupled.Partition (4);
+  NS_TEST_EXPECT_MSG_EQ (coupled.GetNPartitions (), 3, "Wrong number of partitions");
+  NS_TEST_EXPECT_MSG_EQ (coupled.GetNCutLinks (), 0, "Links cut out of none");
+  NS_TEST_EXPECT_MSG_EQ (part[0], 0, "The node 0 is not in the partition 0");
+  NS_TEST_EXPECT_MSG_EQ (part[2], part[0], "Coupled nodes apart");
+  NS_TEST_EXPECT_MSG_EQ (part[5], part[0], "Coupled nodes apart");
+  NS_TEST_EXPECT_MSG_EQ (part[4], part[1], "Coupled nodes apart");
+  NS_TEST_EXPECT_MSG_NE (part[3], part[0], "A lone node was not given a partition");
+  NS_TEST_EXPECT_MSG_NE (part[3], part[1], "A lone node was not given a partition");
+  return GetErrorStatus ();
+}
+
+
+class NodePartitionerChannelsTest : public TestCase
+{
+public:
+  NodePartitionerChannelsTest ();
+  virtual ~NodePartitionerChannelsTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+NodePartitionerChannelsTest::NodePartitionerChannelsTest ()
+  : TestCase ("The graph is read from the channels of the nodes")
+{}
+
+NodePartitionerChannelsTest::~NodePartitionerChannelsTest ()
+{}
+
+bool
+NodePartitionerChannelsTest::DoRun (void)
+{
+  // 0 -2ms- 1 =csma= 2 -5ms- 3: keeping the 2ms link would leave three
+  // nodes in a partition, so the lookahead is 2ms, and the csma nodes
+  // share a partition
+  NodeContainer nodes;
+  nodes.Create (4);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.SetChannelAttribute ("Delay", StringValue ("5ms"));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+  CsmaHelper csma;
+  csma.Install (NodeContainer (nodes.Get (1), nodes.Get (2)));
+
+  NodePartitioner partitioner;
+  partitioner.AddChannels ();
+  std::vector<uint32_t> part = partitioner.Partition (2);
+  NS_TEST_ASSERT_MSG_EQ (part.size (), 4, "Wrong number of nodes");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetNPartitions (), 2, "Wrong number of partitions");
+  NS_TEST_EXPECT_MSG_EQ (part[1], part[2], "The csma nodes are apart");
+  NS_TEST_EXPECT_MSG_EQ (part[0], part[3], "Unbalanced partitions");
+  NS_TEST_EXPECT_MSG_NE (part[0], part[1], "Unbalanced partitions");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetNCutLinks (), 2, "Wrong number of links cut");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetCutTraffic (), 2e7, "Wrong traffic cut");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetLookAhead (), MilliSeconds (2), "Wrong lookahead");
+
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+
+
+class NodePartitionerFlywaysTest : public TestCase
+{
+public:
+  NodePartitionerFlywaysTest ();
+  virtual ~NodePartitionerFlywaysTest ();
+
+private:
+  virtual bool DoRun (void);
+};
+
+NodePartitionerFlywaysTest::NodePartitionerFlywaysTest ()
+  : TestCase ("The nodes of a flyway network are split, but not the ToRs with dongles")
+{}
+
+NodePartitionerFlywaysTest::~NodePartitionerFlywaysTest ()
+{}
+
+bool
+NodePartitionerFlywaysTest::DoRun (void)
+{
+  // 8 ToRs and 8 aggregation switches in 4 pods, under 4 core switches
+  FlywayTopologyPlan plan = FlywayTopologyPlan::FatTree (4, DataRate ("20Gbps"), 1);
+  GlobalOpt options;
+  std::vector<uint32_t> part = FlywaysTopoHelper::PartitionPlan (plan, options, 4, MicroSeconds (10));
+  NS_TEST_ASSERT_MSG_EQ (part.size (), 20, "Wrong number of nodes");
+  std::vector<uint32_t> size (4, 0);
+  for (uint32_t i = 0; i < part.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((part[i] < 4), true, "Node " << i << " in no partition");
+      size[part[i]]++;
+    }
+  for (uint32_t p = 0; p < 4; p++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (size[p], 5, "Unbalanced partition " << p);
+    }
+
+  // the dongles of every tier are on the ToRs
+  for (uint32_t tier = 0; tier < 3; tier++)
+    {
+      options.donglesPerTor = tier == 0 ? 1 : 0;
+      options.donglesPerAgg = tier == 1 ? 1 : 0;
+      options.donglesPerL3 = tier == 2 ? 1 : 0;
+      part = FlywaysTopoHelper::PartitionPlan (plan, options, 4, MicroSeconds (10));
+      std::set<uint32_t> used (part.begin (), part.end ());
+      NS_TEST_EXPECT_MSG_EQ ((used.size () > 1), true, "A single partition with the dongles of the tier " << tier);
+      for (uint32_t i = 1; i < plan.GetNumTors (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (part[i], part[0], "The ToR " << i << " is apart from the others, tier " << tier);
+        }
+      for (uint32_t i = plan.GetNumTors (); i < plan.GetNumNodes (); i++)
+        {
+          NS_TEST_EXPECT_MSG_NE (part[i], part[0], "The switch " << i << " is with the ToRs, tier " << tier);
+        }
+    }
+
+  // links without delay leave no lookahead to a parallel run
+  options.donglesPerTor = 0;
+  options.donglesPerAgg = 0;
+  options.donglesPerL3 = 0;
+  part = FlywaysTopoHelper::PartitionPlan (plan, options, 4, Seconds (0));
+  for (uint32_t i = 0; i < part.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (part[i], 0, "Node " << i << " split off by links without delay");
+    }
+  return GetErrorStatus ();
+}
+
+
+class NodePartitionerTestSuite : public TestSuite
+{
+public:
+  NodePartitionerTestSuite ();
+};
+
+NodePartitionerTestSuite::NodePartitionerTestSuite ()
+  : TestSuite ("helper-node-partitioner", UNIT)
+{
+  AddTestCase (new NodePartitionerGraphTest);
+  AddTestCase (new NodePartitionerChannelsTest);
+  AddTestCase (new NodePartitionerFlywaysTest);
+}
+
+NodePartitionerTestSuite g_nodePartitionerTestSuite;
+
+} // namespace ns3
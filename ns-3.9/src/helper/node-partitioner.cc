@@ -0,0 +1,486 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "node-partitioner.h"
+#include "flyway-topology-plan.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/data-rate.h"
+#include <algorithm>
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("NodePartitioner");
+
+namespace ns3 {
+
+namespace {
+const uint32_t UNASSIGNED = 0xffffffff;
+// the slack of the comparisons of sums of weights
+const double EPSILON = 1e-9;
+const uint32_t MAX_PASSES = 16;
+} // anonymous namespace
+
+NodePartitioner::NodePartitioner ()
+  : m_imbalance (0.1),
+    m_nPartitions (0),
+    m_cutTraffic (0),
+    m_nCutLinks (0),
+    m_lookAhead (0)
+{}
+
+void
+NodePartitioner::SetImbalance (double imbalance)
+{
+  NS_ASSERT (imbalance >= 0);
+  m_imbalance = imbalance;
+}
+
+void
+NodePartitioner::SetNNodes (uint32_t nNodes)
+{
+  if (nNodes > m_weight.size ())
+    {
+      m_weight.resize (nNodes, 1);
+    }
+}
+
+void
+NodePartitioner::SetNodeWeight (uint32_t node, double weight)
+{
+  NS_ASSERT (weight >= 0);
+  SetNNodes (node + 1);
+  m_weight[node] = weight;
+}
+
+void
+NodePartitioner::AddLink (uint32_t a, uint32_t b, Time delay, double traffic)
+{
+  SetNNodes (std::max (a, b) + 1);
+  Link link;
+  link.a = a;
+  link.b = b;
+  link.delay = delay.GetTimeStep ();
+  link.traffic = traffic;
+  m_links.push_back (link);
+}
+
+void
+NodePartitioner::Couple (uint32_t a, uint32_t b)
+{
+  SetNNodes (std::max (a, b) + 1);
+  m_couples.push_back (std::make_pair (a, b));
+}
+
+void
+NodePartitioner::AddChannels (void)
+{
+  SetNNodes (NodeList::GetNNodes ());
+  for (ChannelList::Iterator i = ChannelList::Begin (); i != ChannelList::End (); i++)
+    {
+      Ptr<Channel> channel = *i;
+      if (channel->GetNDevices () < 2)
+        {
+          continue;
+        }
+      uint32_t first = channel->GetDevice (0)->GetNode ()->GetId ();
+      Ptr<PointToPointChannel> p2p = DynamicCast<PointToPointChannel> (channel);
+      if (p2p != 0)
+        {
+          TimeValue delay;
+          p2p->GetAttribute ("Delay", delay);
+          DataRateValue rate;
+          p2p->GetDevice (0)->GetAttribute ("DataRate", rate);
+          AddLink (first, p2p->GetDevice (1)->GetNode ()->GetId (), delay.Get (), rate.Get ().GetBitRate ());
+          continue;
+        }
+      for (uint32_t j = 1; j < channel->GetNDevices (); j++)
+        {
+          Couple (first, channel->GetDevice (j)->GetNode ()->GetId ());
+        }
+    }
+}
+
+void
+NodePartitioner::AddPlan (const FlywayTopologyPlan &plan, Time delay)
+{
+  SetNNodes (plan.GetNumNodes ());
+  for (uint32_t i = 0; i < plan.GetNLinks (); i++)
+    {
+      const FlywayTopologyPlan::Link &link = plan.GetLink (i);
+      AddLink (link.lower, link.upper, delay, link.rate.GetBitRate ());
+    }
+}
+
+uint32_t
+NodePartitioner::Find (std::vector<uint32_t> &parent, uint32_t i)
+{
+  while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+  return i;
+}
+
+uint32_t
+NodePartitioner::Group (int64_t delay, std::vector<uint32_t> &group) const
+{
+  uint32_t n = m_weight.size ();
+  std::vector<uint32_t> parent (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      parent[i] = i;
+    }
+  for (uint32_t i = 0; i < m_couples.size (); i++)
+    {
+      parent[Find (parent, m_couples[i].first)] = Find (parent, m_couples[i].second);
+    }
+  for (uint32_t i = 0; i < m_links.size (); i++)
+    {
+      if (m_links[i].delay < delay)
+        {
+          parent[Find (parent, m_links[i].a)] = Find (parent, m_links[i].b);
+        }
+    }
+  // the groups are numbered in the order of their first node
+  group.assign (n, UNASSIGNED);
+  std::vector<uint32_t> number (n, UNASSIGNED);
+  uint32_t nGroups = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t root = Find (parent, i);
+      if (number[root] == UNASSIGNED)
+        {
+          number[root] = nGroups;
+          nGroups++;
+        }
+      group[i] = number[root];
+    }
+  return nGroups;
+}
+
+double
+NodePartitioner::GetMaxWeight (const std::vector<uint32_t> &group, uint32_t nGroups) const
+{
+  std::vector<double> weight (nGroups, 0);
+  for (uint32_t i = 0; i < group.size (); i++)
+    {
+      weight[group[i]] += m_weight[i];
+    }
+  return *std::max_element (weight.begin (), weight.end ());
+}
+
+void
+NodePartitioner::Grow (const Adjacency &adjacency, const std::vector<double> &weight,
+                       uint32_t nPartitions, std::vector<uint32_t> &part) const
+{
+  uint32_t nGroups = weight.size ();
+  double left = 0;
+  for (uint32_t i = 0; i < nGroups; i++)
+    {
+      left += weight[i];
+    }
+  part.assign (nGroups, UNASSIGNED);
+  uint32_t nLeft = nGroups;
+  std::vector<double> conn (nGroups);
+  std::vector<uint32_t> frontier;
+  for (uint32_t p = 0; p < nPartitions && nLeft > 0; p++)
+    {
+      if (p == nPartitions - 1)
+        {
+          for (uint32_t i = 0; i < nGroups; i++)
+            {
+              if (part[i] == UNASSIGNED)
+                {
+                  part[i] = p;
+                }
+            }
+          break;
+        }
+      double target = left / (nPartitions - p) * (1 + EPSILON);
+      double partWeight = 0;
+      conn.assign (nGroups, 0);
+      frontier.clear ();
+      // the partition starts from the heaviest group left
+      uint32_t next = UNASSIGNED;
+      for (uint32_t i = 0; i < nGroups; i++)
+        {
+          if (part[i] == UNASSIGNED && (next == UNASSIGNED || weight[i] > weight[next]))
+            {
+              next = i;
+            }
+        }
+      while (next != UNASSIGNED)
+        {
+          part[next] = p;
+          partWeight += weight[next];
+          left -= weight[next];
+          nLeft--;
+          for (uint32_t j = 0; j < adjacency[next].size (); j++)
+            {
+              uint32_t other = adjacency[next][j].first;
+              if (part[other] == UNASSIGNED)
+                {
+                  if (conn[other] == 0)
+                    {
+                      frontier.push_back (other);
+                    }
+                  conn[other] += adjacency[next][j].second;
+                }
+            }
+          // then takes the group it exchanges the most traffic with, as
+          // long as it fits
+          next = UNASSIGNED;
+          uint32_t kept = 0;
+          for (uint32_t j = 0; j < frontier.size (); j++)
+            {
+              uint32_t candidate = frontier[j];
+              if (part[candidate] != UNASSIGNED)
+                {
+                  continue;
+                }
+              frontier[kept] = candidate;
+              kept++;
+              if (partWeight + weight[candidate] <= target
+                  && (next == UNASSIGNED || conn[candidate] > conn[next]))
+                {
+                  next = candidate;
+                }
+            }
+          frontier.resize (kept);
+          if (next != UNASSIGNED)
+            {
+              continue;
+            }
+          // or any group which fits, if none of its neighbors does
+          for (uint32_t i = 0; i < nGroups; i++)
+            {
+              if (part[i] == UNASSIGNED && partWeight + weight[i] <= target)
+                {
+                  next = i;
+                  break;
+                }
+            }
+        }
+    }
+}
+
+void
+NodePartitioner::Refine (const Adjacency &adjacency, const std::vector<double> &weight,
+                         uint32_t nPartitions, double limit, std::vector<uint32_t> &part) const
+{
+  uint32_t nGroups = weight.size ();
+  std::vector<double> partWeight (nPartitions, 0);
+  std::vector<uint32_t> partSize (nPartitions, 0);
+  for (uint32_t i = 0; i < nGroups; i++)
+    {
+      partWeight[part[i]] += weight[i];
+      partSize[part[i]]++;
+    }
+  limit *= 1 + EPSILON;
+  std::vector<double> conn (nPartitions);
+  for (uint32_t pass = 0; pass < MAX_PASSES; pass++)
+    {
+      bool moved = false;
+      for (uint32_t i = 0; i < nGroups; i++)
+        {
+          uint32_t own = part[i];
+          if (partSize[own] == 1)
+            {
+              continue;
+            }
+          conn.assign (nPartitions, 0);
+          for (uint32_t j = 0; j < adjacency[i].size (); j++)
+            {
+              conn[part[adjacency[i][j].first]] += adjacency[i][j].second;
+            }
+          // a move must lower the traffic cut, or keep it and even out the
+          // partitions, unless it relieves a partition over the limit
+          bool over = partWeight[own] > limit;
+          uint32_t best = own;
+          double bestGain = 0;
+          for (uint32_t q = 0; q < nPartitions; q++)
+            {
+              if (q == own || partWeight[q] + weight[i] > limit)
+                {
+                  continue;
+                }
+              double gain = conn[q] - conn[own];
+              bool allowed = over || gain > 0
+                || (gain == 0 && partWeight[q] + weight[i] < partWeight[own]);
+              if (!allowed)
+                {
+                  continue;
+                }
+              if (best == own || gain > bestGain
+                  || (gain == bestGain && partWeight[q] < partWeight[best]))
+                {
+                  best = q;
+                  bestGain = gain;
+                }
+            }
+          if (best == own)
+            {
+              continue;
+            }
+          part[i] = best;
+          partWeight[own] -= weight[i];
+          partWeight[best] += weight[i];
+          partSize[own]--;
+          partSize[best]++;
+          moved = true;
+        }
+      if (!moved)
+        {
+          break;
+        }
+    }
+}
+
+std::vector<uint32_t>
+NodePartitioner::Partition (uint32_t nPartitions)
+{
+  NS_ASSERT (nPartitions > 0);
+  uint32_t n = m_weight.size ();
+  m_nPartitions = 0;
+  m_cutTraffic = 0;
+  m_nCutLinks = 0;
+  m_lookAhead = 0x7fffffffffffffffLL;
+  if (n == 0)
+    {
+      return std::vector<uint32_t> ();
+    }
+  double total = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      total += m_weight[i];
+    }
+  double limit = (1 + m_imbalance) * total / nPartitions;
+
+  // the largest delay under which all the links can be kept uncut; the
+  // groups only grow with the delay, so a binary search finds it
+  std::vector<int64_t> delays;
+  for (uint32_t i = 0; i < m_links.size (); i++)
+    {
+      delays.push_back (m_links[i].delay);
+    }
+  std::sort (delays.begin (), delays.end ());
+  delays.erase (std::unique (delays.begin (), delays.end ()), delays.end ());
+  std::vector<uint32_t> group;
+  int64_t threshold = 0;
+  uint32_t low = 0;
+  uint32_t high = delays.size ();
+  while (low < high)
+    {
+      uint32_t middle = (low + high) / 2;
+      uint32_t nGroups = Group (delays[middle], group);
+      if (nGroups >= nPartitions && GetMaxWeight (group, nGroups) <= limit * (1 + EPSILON))
+        {
+          threshold = delays[middle];
+          low = middle + 1;
+        }
+      else
+        {
+          high = middle;
+        }
+    }
+  uint32_t nGroups = Group (threshold, group);
+  NS_LOG_DEBUG ("links under " << threshold << " kept uncut, " << nGroups << " groups");
+
+  std::vector<double> weight (nGroups, 0);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      weight[group[i]] += m_weight[i];
+    }
+  std::map<std::pair<uint32_t, uint32_t>, double> traffic;
+  for (uint32_t i = 0; i < m_links.size (); i++)
+    {
+      uint32_t a = group[m_links[i].a];
+      uint32_t b = group[m_links[i].b];
+      if (a != b)
+        {
+          traffic[std::make_pair (std::min (a, b), std::max (a, b))] += m_links[i].traffic;
+        }
+    }
+  Adjacency adjacency (nGroups);
+  for (std::map<std::pair<uint32_t, uint32_t>, double>::const_iterator i = traffic.begin ();
+       i != traffic.end (); i++)
+    {
+      adjacency[i->first.first].push_back (std::make_pair (i->first.second, i->second));
+      adjacency[i->first.second].push_back (std::make_pair (i->first.first, i->second));
+    }
+
+  std::vector<uint32_t> part;
+  Grow (adjacency, weight, nPartitions, part);
+  Refine (adjacency, weight, nPartitions, limit, part);
+
+  // number the partitions in the order of their first node
+  std::vector<uint32_t> number (nPartitions, UNASSIGNED);
+  std::vector<uint32_t> assignment (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t p = part[group[i]];
+      if (number[p] == UNASSIGNED)
+        {
+          number[p] = m_nPartitions;
+          m_nPartitions++;
+        }
+      assignment[i] = number[p];
+    }
+  for (uint32_t i = 0; i < m_links.size (); i++)
+    {
+      const Link &link = m_links[i];
+      if (assignment[link.a] != assignment[link.b])
+        {
+          m_cutTraffic += link.traffic;
+          m_nCutLinks++;
+          m_lookAhead = std::min (m_lookAhead, link.delay);
+        }
+    }
+  NS_LOG_DEBUG (m_nPartitions << " partitions, " << m_nCutLinks << " links cut, traffic " <<
+                m_cutTraffic << ", lookahead " << m_lookAhead);
+  return assignment;
+}
+
+uint32_t
+NodePartitioner::GetNPartitions (void) const
+{
+  return m_nPartitions;
+}
+
+double
+NodePartitioner::GetCutTraffic (void) const
+{
+  return m_cutTraffic;
+}
+
+uint32_t
+NodePartitioner::GetNCutLinks (void) const
+{
+  return m_nCutLinks;
+}
+
+Time
+NodePartitioner::GetLookAhead (void) const
+{
+  return TimeStep (m_lookAhead);
+}
+
+} // namespace ns3
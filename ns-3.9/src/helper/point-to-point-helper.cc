@@ -29,6 +29,7 @@
 #include "ns3/packet.h"
 #include "ns3/names.h"
 #include "ns3/mpi-interface.h"
+#include "ns3/multithreaded-simulator-impl.h"
 
 #include "trace-helper.h"
 #include "point-to-point-helper.h"
@@ -236,7 +237,9 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
   devB->SetQueue (queueB);
   // If MPI is enabled, we need to see if both nodes have the same system id 
   // (rank), and the rank is the same as this instance.  If both are true, 
-  //use a normal p2p channel, otherwise use a remote channel
+  //use a normal p2p channel, otherwise use a remote channel. The
+  //multithreaded simulator needs a remote channel between nodes of
+  //different system ids (partitions) too.
   bool useNormalChannel = true;
   Ptr<PointToPointChannel> channel = 0;
   if (MpiInterface::IsEnabled())
@@ -249,6 +252,10 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
           useNormalChannel = false;
         }
     }
+  else if (a->GetSystemId () != b->GetSystemId () && MultithreadedSimulatorImpl::IsEnabled ())
+    {
+      useNormalChannel = false;
+    }
   if (useNormalChannel)
     {
       channel = m_channelFactory.Create<PointToPointChannel> ();
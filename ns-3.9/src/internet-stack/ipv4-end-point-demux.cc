@@ -41,6 +41,11 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux ()
       delete endPoint;
     }
   m_endPoints.clear ();
+  for (EndPointsI i = m_closedEndPoints.begin (); i != m_closedEndPoints.end (); i++) 
+    {
+      delete *i;
+    }
+  m_closedEndPoints.clear ();
 }
 
 void
@@ -51,6 +56,7 @@ Ipv4EndPointDemux::Clean (void)
     {
       if ((*i) && (*i)->GetClosed()) 
         {
+          m_closedEndPoints.push_back (*i);
           m_endPoints.erase(i);
 	  break; /* erase invalidates the iterator, have to exit */
         }
@@ -180,9 +186,43 @@ Ipv4EndPointDemux::DeAllocate (Ipv4EndPoint *endPoint)
           return;
         }
     }
+  for (EndPointsI i = m_closedEndPoints.begin (); i != m_closedEndPoints.end (); i++) 
+    {
+      if (*i == endPoint)
+        {
+          delete endPoint;
+          m_closedEndPoints.erase (i);
+          return;
+        }
+    }
   std::cout << "end point not found" << std::endl;
 }
 
+void 
+Ipv4EndPointDemux::DeleteClosed (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  EndPointsI i = m_endPoints.begin ();
+  while (i != m_endPoints.end ())
+    {
+      if ((*i)->GetClosed ())
+        {
+          m_closedEndPoints.push_back (*i);
+          i = m_endPoints.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+  while (!m_closedEndPoints.empty ())
+    {
+      Ipv4EndPoint *endPoint = m_closedEndPoints.front ();
+      m_closedEndPoints.pop_front ();
+      delete endPoint;
+    }
+}
+
 /*
  * return list of all available Endpoints
  */
@@ -72,6 +72,11 @@ public:
                           uint16_t peerPort);
 
   void DeAllocate (Ipv4EndPoint *endPoint);
+  /**
+   * Deletes the endpoints which have been closed, so that their
+   * DestroyCallbacks let go of their sockets.
+   */
+  void DeleteClosed (void);
 
  private:
   void Clean(void);
@@ -79,6 +84,8 @@ public:
 
   uint16_t m_ephemeral;
   EndPoints m_endPoints;
+  // closed endpoints which lookups no longer see
+  EndPoints m_closedEndPoints;
 };
 
 } // namespace ns3
@@ -476,6 +476,27 @@ TcpL4Protocol::DeAllocate (Ipv4EndPoint *endPoint)
   m_endPoints->DeAllocate (endPoint);
 }
 
+void
+TcpL4Protocol::ReleaseClosedSockets (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_endPoints->DeleteClosed ();
+  // TcpSocketImpl::Destroy has zeroed the node of the sockets whose
+  // endpoints went
+  std::vector<Ptr<TcpSocketImpl> >::iterator i = m_sockets.begin ();
+  while (i != m_sockets.end ())
+    {
+      if ((*i)->GetNode () == 0)
+        {
+          i = m_sockets.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+
 enum Ipv4L4Protocol::RxStatus
 TcpL4Protocol::Receive (Ptr<Packet> packet,
              Ipv4Header const &ipHeader,
@@ -79,6 +79,13 @@ public:
 
   void DeAllocate (Ipv4EndPoint *endPoint);
 
+  /**
+   * Lets go of the sockets whose connections have closed, along with
+   * their endpoints. Such a socket must not be used any more, and
+   * segments for its connection find no endpoint.
+   */
+  void ReleaseClosedSockets (void);
+
 //   // called by TcpSocketImpl.
 //   bool Connect (const Ipv4Address& saddr, const Ipv4Address& daddr,
 //                 uint16_t sport, uint16_t dport);
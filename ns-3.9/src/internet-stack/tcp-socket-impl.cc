@@ -1139,6 +1139,8 @@ void TcpSocketImpl::CompleteFork(Ptr<Packet> p, const TcpHeader& h, const Addres
   //equivalent to FinishBind
   m_endPoint->SetRxCallback (MakeCallback (&TcpSocketImpl::ForwardUp, Ptr<TcpSocketImpl>(this)));
   m_endPoint->SetDestroyCallback (MakeCallback (&TcpSocketImpl::Destroy, Ptr<TcpSocketImpl>(this)));
+  // the protocol keeps the forked socket, as it keeps those it creates
+  m_tcp->m_sockets.push_back (this);
   ProcessPacketAction(SYN_ACK_TX, p, h, fromAddress, toAddress);
  }
 
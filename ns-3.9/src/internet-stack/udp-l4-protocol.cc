@@ -181,6 +181,30 @@ UdpL4Protocol::DeAllocate (Ipv4EndPoint *endPoint)
   m_endPoints->DeAllocate (endPoint);
 }
 
+void
+UdpL4Protocol::ReleaseClosedSockets (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<Ptr<UdpSocketImpl> >::iterator i = m_sockets.begin ();
+  while (i != m_sockets.end ())
+    {
+      Ptr<UdpSocketImpl> socket = *i;
+      if (socket->m_shutdownSend && socket->m_shutdownRecv)
+        {
+          if (socket->m_endPoint != 0)
+            {
+              // UdpSocketImpl::Destroy zeroes m_endPoint
+              DeAllocate (socket->m_endPoint);
+            }
+          i = m_sockets.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+
 void 
 UdpL4Protocol::ReceiveIcmp (Ipv4Address icmpSource, uint8_t icmpTtl,
                             uint8_t icmpType, uint8_t icmpCode, uint32_t icmpInfo,
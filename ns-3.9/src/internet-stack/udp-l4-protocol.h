@@ -68,6 +68,12 @@ public:
 
   void DeAllocate (Ipv4EndPoint *endPoint);
 
+  /**
+   * Lets go of the sockets which have been shut down both ways, along
+   * with their endpoints. Such a socket must not be used any more.
+   */
+  void ReleaseClosedSockets (void);
+
   // called by UdpSocket.
   /**
    * \brief Send a packet via UDP
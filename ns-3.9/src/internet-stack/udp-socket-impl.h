@@ -99,6 +99,7 @@ private:
 
 
   friend class UdpSocketFactory;
+  friend class UdpL4Protocol;
   // invoked by Udp class
   int FinishBind (void);
   void ForwardUp (Ptr<Packet> p, Ipv4Header header, uint16_t port, 
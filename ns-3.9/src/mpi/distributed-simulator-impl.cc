@@ -30,6 +30,7 @@
 #include "ns3/log.h"
 
 #include <math.h>
+#include <algorithm>
 
 #ifdef NS3_MPI
 #include <mpi.h>
@@ -41,32 +42,10 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (DistributedSimulatorImpl);
 
-LbtsMessage::~LbtsMessage ()
-{
-}
-
-Time
-LbtsMessage::GetSmallestTime ()
-{
-  return m_smallestTime;
-}
-
-uint32_t
-LbtsMessage::GetTxCount ()
-{
-  return m_txCount;
-}
-
-uint32_t
-LbtsMessage::GetRxCount ()
-{
-  return m_rxCount;
-}
-uint32_t
-LbtsMessage::GetMyId ()
-{
-  return m_myId;
-}
+namespace {
+// the timestamp of the next event of a rank which has none to run
+const uint64_t NO_EVENT = 0xffffffffffffffffULL;
+} // anonymous namespace
 
 Time DistributedSimulatorImpl::m_lookAhead = Seconds (0);
 
@@ -85,15 +64,14 @@ DistributedSimulatorImpl::DistributedSimulatorImpl ()
 #ifdef NS3_MPI
   m_myId = MpiInterface::GetSystemId ();
   m_systemCount = MpiInterface::GetSize ();
-
-  // Allocate the LBTS message buffer
-  m_pLBTS = new LbtsMessage[m_systemCount];
   m_grantedTime = Seconds (0);
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
 
   m_stop = false;
+  m_lbtsPending = false;
+  m_finished = false;
   // uids are allocated from 4.
   // uid 0 is "invalid" events
   // uid 1 is "now" events
@@ -120,7 +98,6 @@ DistributedSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
-  delete [] m_pLBTS;
   SimulatorImpl::DoDispose ();
 }
 
@@ -148,7 +125,8 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
 #ifdef NS3_MPI
   if (MpiInterface::GetSize () <= 1)
     {
-      DistributedSimulatorImpl::m_lookAhead = Seconds (0);
+      // nothing to wait for
+      DistributedSimulatorImpl::m_lookAhead = GetMaximumSimulationTime ();
       m_grantedTime = Seconds (0);
     }
   else
@@ -267,54 +245,97 @@ DistributedSimulatorImpl::Next (void) const
   return TimeStep (NextTs ());
 }
 
+void
+DistributedSimulatorImpl::StartLbts (void)
+{
+#ifdef NS3_MPI
+  // The packets sent before the round must be counted by their receivers
+  // in the same round for the sums to match: receive those arrived, and
+  // send those batched since the last round.
+  MpiInterface::ReceiveMessages ();
+  MpiInterface::SendBatches ();
+  MpiInterface::TestSendComplete ();
+  m_lbtsTs[0] = m_stop || m_events->IsEmpty () ? NO_EVENT : NextTs ();
+  m_lbtsCounts[0] = MpiInterface::GetTxCount ();
+  m_lbtsCounts[1] = MpiInterface::GetRxCount ();
+  MPI_Iallreduce (&m_lbtsTs[0], &m_lbtsTs[1], 1, MPI_UINT64_T, MPI_MIN,
+                  MPI_COMM_WORLD, &m_lbtsRequests[0]);
+  MPI_Iallreduce (&m_lbtsCounts[0], &m_lbtsCounts[2], 2, MPI_UINT64_T, MPI_SUM,
+                  MPI_COMM_WORLD, &m_lbtsRequests[1]);
+  m_lbtsPending = true;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+void
+DistributedSimulatorImpl::TestLbts (bool wait)
+{
+#ifdef NS3_MPI
+  if (wait)
+    {
+      MPI_Waitall (2, m_lbtsRequests, MPI_STATUSES_IGNORE);
+    }
+  else
+    {
+      int flag = 0;
+      MPI_Testall (2, m_lbtsRequests, &flag, MPI_STATUSES_IGNORE);
+      if (!flag)
+        {
+          return;
+        }
+    }
+  m_lbtsPending = false;
+  // The totRx and totTx counts insure there are no transient
+  // messages;  If totRx != totTx, there are transients,
+  // so we don't update the granted time.
+  if (m_lbtsCounts[2] != m_lbtsCounts[3])
+    {
+      return;
+    }
+  if (m_lbtsTs[1] == NO_EVENT)
+    {
+      m_finished = true;
+      return;
+    }
+  // The packets sent after a rank took part in the round are sent by
+  // events no earlier than the timestamp it gave, so they arrive no
+  // earlier than the new granted time.
+  uint64_t lookAhead = DistributedSimulatorImpl::m_lookAhead.GetTimeStep ();
+  uint64_t granted = m_lbtsTs[1] + std::min (lookAhead, GetMaximumSimulationTime ().GetTimeStep () - m_lbtsTs[1]);
+  if (TimeStep (granted) > m_grantedTime)
+    {
+      m_grantedTime = TimeStep (granted);
+    }
+  NS_LOG_LOGIC ("granted " << granted);
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
 void
 DistributedSimulatorImpl::Run (void)
 {
 #ifdef NS3_MPI
   CalculateLookAhead ();
   m_stop = false;
-  while (!m_events->IsEmpty () && !m_stop)
+  m_finished = false;
+  m_lbtsPending = false;
+  while (!m_finished)
     {
-      Time nextTime = Next ();
-      if (nextTime > m_grantedTime)
-        { // Can't process, calculate a new LBTS
-          // First receive any pending messages
-          MpiInterface::ReceiveMessages ();
-          // reset next time
-          nextTime = Next ();
-          // And check for send completes
-          MpiInterface::TestSendComplete ();
-          // Finally calculate the lbts
-          LbtsMessage lMsg (MpiInterface::GetRxCount (), MpiInterface::GetTxCount (), m_myId, nextTime);
-          m_pLBTS[m_myId] = lMsg;
-          MPI_Allgather (&lMsg, sizeof (LbtsMessage), MPI_BYTE, m_pLBTS,
-                         sizeof (LbtsMessage), MPI_BYTE, MPI_COMM_WORLD);
-          Time smallestTime = m_pLBTS[0].GetSmallestTime ();
-          // The totRx and totTx counts insure there are no transient
-          // messages;  If totRx != totTx, there are transients,
-          // so we don't update the granted time.
-          uint32_t totRx = m_pLBTS[0].GetRxCount ();
-          uint32_t totTx = m_pLBTS[0].GetTxCount ();
-
-          for (uint32_t i = 1; i < m_systemCount; ++i)
-            {
-              if (m_pLBTS[i].GetSmallestTime () < smallestTime)
-                {
-                  smallestTime = m_pLBTS[i].GetSmallestTime ();
-                }
-              totRx += m_pLBTS[i].GetRxCount ();
-              totTx += m_pLBTS[i].GetTxCount ();
-
-            }
-          if (totRx == totTx)
-            {
-              m_grantedTime = smallestTime + DistributedSimulatorImpl::m_lookAhead;
-            }
+      if (!m_lbtsPending)
+        {
+          StartLbts ();
         }
-      if (nextTime <= m_grantedTime)
-        { // Save to process
-          ProcessOneEvent ();
+      if (m_stop || m_events->IsEmpty () || Next () > m_grantedTime)
+        {
+          // all the granted events have run: wait for the round
+          TestLbts (true);
+          continue;
         }
+      // the round progresses while the granted events run
+      TestLbts (false);
+      ProcessOneEvent ();
     }
 
   // If the simulator stopped naturally by lack of events, make a
@@ -23,66 +23,29 @@
 #include "ns3/scheduler.h"
 #include "ns3/event-impl.h"
 #include "ns3/ptr.h"
+#include "mpi-interface.h"
 
 #include <list>
 
 namespace ns3 {
 
-/**
- * \brief Structure used for all-reduce LBTS computation
- */
-class LbtsMessage
-{
-public:
-  LbtsMessage ()
-    : m_txCount (0),
-      m_rxCount (0),
-      m_myId (0)
-  {
-  }
-
-  /**
-   * \param rxc received count
-   * \param txc transmitted count
-   * \param id mpi rank
-   * \param t smallest time
-   */
-  LbtsMessage (uint32_t rxc, uint32_t txc, uint32_t id, const Time& t)
-    : m_txCount (txc),
-      m_rxCount (rxc),
-      m_myId (id),
-      m_smallestTime (t)
-  {
-  }
-
-  ~LbtsMessage ();
-
-  /**
-   * \return smallest time
-   */
-  Time GetSmallestTime ();
-  /**
-   * \return transmitted count
-   */
-  uint32_t GetTxCount ();
-  /**
-   * \return receieved count
-   */
-  uint32_t GetRxCount ();
-  /**
-   * \return id which corresponds to mpi rank
-   */
-  uint32_t GetMyId ();
-
-private:
-  uint32_t m_txCount;
-  uint32_t m_rxCount;
-  uint32_t m_myId;
-  Time     m_smallestTime;
-};
-
 /**
  * \brief distributed simulator implementation using lookahead
+ *
+ * Each rank runs the events of its nodes up to the time it was granted,
+ * the lower bound on the timestamp of the next event anywhere (LBTS)
+ * plus the lookahead, the smallest delay of the links between ranks. The
+ * LBTS is computed in rounds, each a pair of non-blocking all-reductions:
+ * the minimum of the timestamps of the next events of the ranks, and the
+ * sums of the packets they sent and received, which must be equal for
+ * the minimum to hold, as no packet is then in flight. A rank starts a
+ * round as soon as the last one is over, after it has received the
+ * packets arrived and sent those of the round before, in one message
+ * per rank, and runs its events while the round goes on; it only waits
+ * for a round when it has run all the events it was granted.
+ *
+ * A rank which has stopped, or has run out of events, takes part in the
+ * rounds until all the ranks have, and no packet is left in flight.
  */
 class DistributedSimulatorImpl : public SimulatorImpl
 {
@@ -120,6 +83,10 @@ private:
 
   void ProcessOneEvent (void);
   uint64_t NextTs (void) const;
+  // start a round of the LBTS computation
+  void StartLbts (void);
+  // complete the round if it is over, or wait for it to be if wait is true
+  void TestLbts (bool wait);
   typedef std::list<EventId> DestroyEvents;
 
   DestroyEvents m_destroyEvents;
@@ -133,12 +100,21 @@ private:
   // not counting the "destroy" events; this is used for validation
   int m_unscheduledEvents;
 
-  LbtsMessage* m_pLBTS;       // Allocated once we know how many systems
   uint32_t     m_myId;        // MPI Rank
   uint32_t     m_systemCount; // MPI Size
-  Time         m_grantedTime; // Last LBTS
+  Time         m_grantedTime; // Last LBTS plus the lookahead
   static Time  m_lookAhead;   // Lookahead value
 
+  // the round of the LBTS computation in progress: the timestamp of the
+  // next event of this rank and the smallest of all, and the packets sent
+  // and received by this rank and by all
+  bool         m_lbtsPending;
+  uint64_t     m_lbtsTs[2];
+  uint64_t     m_lbtsCounts[4];
+  MPI_Request  m_lbtsRequests[2];
+  // true once all the ranks have stopped or run out of events
+  bool         m_finished;
+
 };
 
 } // namespace ns3
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <iomanip>
 #include <list>
+#include <string.h>
 
 #include "mpi-interface.h"
 
@@ -38,6 +39,17 @@
 
 namespace ns3 {
 
+namespace {
+// the header of each packet of a message, followed by the packet
+struct PacketHeader
+{
+  uint64_t rxTime;
+  uint32_t node;
+  uint32_t dev;
+  uint32_t size;
+};
+} // anonymous namespace
+
 SentBuffer::SentBuffer ()
 {
   m_buffer = 0;
@@ -76,23 +88,15 @@ bool                  MpiInterface::m_enabled = false;
 uint32_t              MpiInterface::m_rxCount = 0;
 uint32_t              MpiInterface::m_txCount = 0;
 std::list<SentBuffer> MpiInterface::m_pendingTx;
-
-#ifdef NS3_MPI
-MPI_Request* MpiInterface::m_requests;
-char**       MpiInterface::m_pRxBuffers;
-#endif
+std::vector<std::vector<uint8_t> > MpiInterface::m_txBatches;
+std::vector<uint8_t> MpiInterface::m_rxBuffer;
 
 void
 MpiInterface::Destroy ()
 {
 #ifdef NS3_MPI
-  for (uint32_t i = 0; i < GetSize (); ++i)
-    {
-      delete [] m_pRxBuffers[i];
-    }
-  delete [] m_pRxBuffers;
-  delete [] m_requests;
-
+  m_txBatches.clear ();
+  m_rxBuffer.clear ();
   m_pendingTx.clear ();
 #endif
 }
@@ -153,115 +157,138 @@ MpiInterface::Enable (int* pargc, char*** pargv)
   MPI_Comm_size (MPI_COMM_WORLD, reinterpret_cast <int *> (&m_size));
   m_enabled = true;
   m_initialized = true;
-  // Post a non-blocking receive for all peers
-  m_pRxBuffers = new char*[m_size];
-  m_requests = new MPI_Request[m_size];
-  for (uint32_t i = 0; i < GetSize (); ++i)
-    {
-      m_pRxBuffers[i] = new char[MAX_MPI_MSG_SIZE];
-      MPI_Irecv (m_pRxBuffers[i], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
-                 MPI_COMM_WORLD, &m_requests[i]);
-    }
+  m_txBatches.resize (m_size);
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
 }
 
 void
-MpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev)
+MpiInterface::Disable ()
 {
 #ifdef NS3_MPI
-  SentBuffer sendBuf;
-  m_pendingTx.push_back (sendBuf);
-  std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
-
-  uint32_t serializedSize = p->GetSerializedSize ();
-  uint8_t* buffer =  new uint8_t[serializedSize + 16];
-  i->SetBuffer (buffer);
-  // Add the time, dest node and dest device
-  uint64_t t = rxTime.GetNanoSeconds ();
-  uint64_t* pTime = reinterpret_cast <uint64_t *> (buffer);
-  *pTime++ = t;
-  uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-  *pData++ = node;
-  *pData++ = dev;
-  // Serialize the packet
-  p->Serialize (reinterpret_cast<uint8_t *> (pData), serializedSize);
+  MPI_Finalize ();
+  m_enabled = false;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
 
+void
+MpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev)
+{
+#ifdef NS3_MPI
   // Find the system id for the destination node
   Ptr<Node> destNode = NodeList::GetNode (node);
   uint32_t nodeSysId = destNode->GetSystemId ();
-
-  MPI_Isend (reinterpret_cast<void *> (i->GetBuffer ()), serializedSize + 16, MPI_CHAR, nodeSysId,
-             0, MPI_COMM_WORLD, (i->GetRequest ()));
+  std::vector<uint8_t> &batch = m_txBatches[nodeSysId];
+
+  // Add the time, dest node and dest device, then the packet
+  PacketHeader header;
+  header.rxTime = rxTime.GetTimeStep ();
+  header.node = node;
+  header.dev = dev;
+  header.size = p->GetSerializedSize ();
+  uint32_t offset = batch.size ();
+  batch.resize (offset + sizeof (header) + header.size);
+  memcpy (&batch[offset], &header, sizeof (header));
+  p->Serialize (&batch[offset + sizeof (header)], header.size);
   m_txCount++;
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
 }
 
+void
+MpiInterface::SendBatches ()
+{
+#ifdef NS3_MPI
+  for (uint32_t i = 0; i < m_txBatches.size (); ++i)
+    {
+      std::vector<uint8_t> &batch = m_txBatches[i];
+      if (batch.empty ())
+        {
+          continue;
+        }
+      SentBuffer sendBuf;
+      m_pendingTx.push_back (sendBuf);
+      SentBuffer &sent = m_pendingTx.back ();
+      uint8_t* buffer = new uint8_t[batch.size ()];
+      memcpy (buffer, &batch[0], batch.size ());
+      sent.SetBuffer (buffer);
+      MPI_Isend (reinterpret_cast<void *> (buffer), batch.size (), MPI_CHAR, i,
+                 0, MPI_COMM_WORLD, sent.GetRequest ());
+      // keep the memory of the batch for the next round
+      batch.clear ();
+    }
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
 void
 MpiInterface::ReceiveMessages ()
-{ // Poll the non-block reads to see if data arrived
+{ // Probe for the messages arrived
 #ifdef NS3_MPI
   while (true)
     {
       int flag = 0;
-      int index = 0;
       MPI_Status status;
 
-      MPI_Testany (GetSize (), m_requests, &index, &flag, &status);
+      MPI_Iprobe (MPI_ANY_SOURCE, 0, MPI_COMM_WORLD, &flag, &status);
       if (!flag)
         {
           break;        // No more messages
         }
       int count;
       MPI_Get_count (&status, MPI_CHAR, &count);
-      m_rxCount++; // Count this receive
+      m_rxBuffer.resize (count);
+      MPI_Recv (&m_rxBuffer[0], count, MPI_CHAR, status.MPI_SOURCE, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
 
-      // Get the meta data first
-      uint64_t* pTime = reinterpret_cast<uint64_t *> (m_pRxBuffers[index]);
-      uint64_t nanoSeconds = *pTime++;
-      uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-      uint32_t node = *pData++;
-      uint32_t dev  = *pData++;
-
-      Time rxTime = NanoSeconds (nanoSeconds);
-
-      count -= sizeof (nanoSeconds) + sizeof (node) + sizeof (dev);
-
-      Ptr<Packet> p = Create<Packet> (reinterpret_cast<uint8_t *> (pData), count, true);
-
-      // Find the correct node/device to schedule receive event
-      Ptr<Node> pNode = NodeList::GetNode (node);
-      uint32_t nDevices = pNode->GetNDevices ();
-      Ptr<PointToPointNetDevice> pDev = 0;
-      for (uint32_t i = 0; i < nDevices; ++i)
+      uint32_t offset = 0;
+      while (offset < (uint32_t)count)
         {
-          Ptr<NetDevice> pThisDev = pNode->GetDevice (i);
-          if (pThisDev->GetIfIndex () == dev)
-            {
-              pDev = DynamicCast<PointToPointNetDevice> (pThisDev);
-              break;
-            }
+          PacketHeader header;
+          memcpy (&header, &m_rxBuffer[offset], sizeof (header));
+          offset += sizeof (header);
+          NS_ASSERT (offset + header.size <= (uint32_t)count);
+          m_rxCount++; // Count this receive
+          ScheduleReceive (&m_rxBuffer[offset], header.size, TimeStep (header.rxTime), header.node, header.dev);
+          offset += header.size;
         }
-
-      NS_ASSERT (pNode && pDev);
-
-      // Schedule the rx event
-      Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
-                                      &PointToPointNetDevice::Receive,
-                                      pDev, p);
-
-      // Re-queue the next read
-      MPI_Irecv (m_pRxBuffers[index], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
-                 MPI_COMM_WORLD, &m_requests[index]);
     }
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
 }
 
+void
+MpiInterface::ScheduleReceive (uint8_t *buffer, uint32_t size, const Time &rxTime, uint32_t node, uint32_t dev)
+{
+  Ptr<Packet> p = Create<Packet> (buffer, size, true);
+
+  // Find the correct node/device to schedule receive event
+  Ptr<Node> pNode = NodeList::GetNode (node);
+  uint32_t nDevices = pNode->GetNDevices ();
+  Ptr<PointToPointNetDevice> pDev = 0;
+  for (uint32_t i = 0; i < nDevices; ++i)
+    {
+      Ptr<NetDevice> pThisDev = pNode->GetDevice (i);
+      if (pThisDev->GetIfIndex () == dev)
+        {
+          pDev = DynamicCast<PointToPointNetDevice> (pThisDev);
+          break;
+        }
+    }
+
+  NS_ASSERT (pNode && pDev);
+
+  // Schedule the rx event
+  Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
+                                  &PointToPointNetDevice::Receive,
+                                  pDev, p);
+}
+
 void
 MpiInterface::TestSendComplete ()
 {
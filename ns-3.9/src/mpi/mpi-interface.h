@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <vector>
 
 #include "ns3/nstime.h"
 #include "ns3/buffer.h"
@@ -33,12 +34,6 @@ typedef struct ompi_request_t* MPI_Request;
 
 namespace ns3 {
 
-/**
- * maximum MPI message size for easy
- * buffer creation
- */
-const uint32_t MAX_MPI_MSG_SIZE = 2000;
-
 /**
  * Define a class for tracking the non-block sends
  */
@@ -70,6 +65,14 @@ class Packet;
 
 /**
  * Interface between ns-3 and MPI
+ *
+ * The packets for the nodes of another system are not sent one by one:
+ * SendPacket appends them to the batch of the system, and SendBatches
+ * sends each batch as a single message, which the DistributedSimulatorImpl
+ * does once per round of its LBTS computation. A message holds any number
+ * of packets, each after a header with its time of reception, node,
+ * device and size, and ReceiveMessages probes for the size of each
+ * message before receiving it, so that packets are not bounded in size.
  */
 class MpiInterface
 {
@@ -97,6 +100,10 @@ public:
    * Sets up MPI interface
    */
   static void Enable (int* pargc, char*** pargv);
+  /**
+   * Terminates the MPI interface, once the simulator is destroyed
+   */
+  static void Disable ();
 
   /**
    * \param p packet to send
@@ -104,11 +111,17 @@ public:
    * \param node destination node
    * \param dev destination device
    *
-   * Serialize and send a packet to the specified node and net device
+   * Serialize a packet for the specified node and net device, into the
+   * batch of the system of the node
    */
   static void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
   /**
-   * Check for received messages complete
+   * Send the batches of packets, one message per system
+   */
+  static void SendBatches ();
+  /**
+   * Receive the messages arrived, and schedule the reception of their
+   * packets
    */
   static void ReceiveMessages ();
   /**
@@ -125,6 +138,9 @@ public:
   static uint32_t GetTxCount ();
 
 private:
+  // Schedule the reception of the packet serialized in buffer
+  static void ScheduleReceive (uint8_t *buffer, uint32_t size, const Time &rxTime, uint32_t node, uint32_t dev);
+
   static uint32_t m_sid;
   static uint32_t m_size;
 
@@ -136,11 +152,11 @@ private:
   static bool     m_initialized;
   static bool     m_enabled;
 
-  // Pending non-blocking receives
-  static MPI_Request* m_requests;
+  // The packets not yet sent, per destination system
+  static std::vector<std::vector<uint8_t> > m_txBatches;
 
-  // Data buffers for non-blocking reads
-  static char**   m_pRxBuffers;
+  // The message being received
+  static std::vector<uint8_t> m_rxBuffer;
 
   // List of pending non-blocking sends
   static std::list<SentBuffer> m_pendingTx;
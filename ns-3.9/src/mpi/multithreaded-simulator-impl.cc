@@ -0,0 +1,781 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/node-list.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/core-config.h"
+
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include <sched.h>
+#endif
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+// no event at all
+const uint64_t NO_TS = ~(uint64_t) 0;
+
+enum {
+  // the turns a thread waits for the others at a barrier before it yields
+  // its core to them
+  BARRIER_SPINS = 1000
+};
+
+class DestroyLock
+{
+public:
+  DestroyLock (volatile int &lock)
+    : m_lock (lock)
+  {
+    while (__sync_lock_test_and_set (&m_lock, 1))
+      {}
+  }
+  ~DestroyLock ()
+  {
+    __sync_lock_release (&m_lock);
+  }
+private:
+  volatile int &m_lock;
+};
+
+} // anonymous namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+  ;
+  return tid;
+}
+
+bool
+MultithreadedSimulatorImpl::IsEnabled (void)
+{
+  return DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ()) != 0;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_lookAhead (NO_TS),
+    m_running (false),
+    m_stop (false),
+    m_nPartitions (1),
+    m_nRounds (0),
+    m_barrierCount (0),
+    m_barrierSense (0),
+    m_destroyLock (0)
+{
+  m_partitions.push_back (CreatePartition (0));
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  m_partitions[0]->uid = 4;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  for (uint32_t i = 0; i < m_partitions.size (); i++)
+    {
+      delete m_partitions[i];
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  Partition *p = m_partitions[0];
+  while (!p->events->IsEmpty ())
+    {
+      Scheduler::Event next = p->events->RemoveNext ();
+      next.impl->Unref ();
+    }
+  p->events = 0;
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_ASSERT (!m_running);
+  m_schedulerFactory = schedulerFactory;
+  Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+  Partition *p = m_partitions[0];
+  if (p->events != 0)
+    {
+      while (!p->events->IsEmpty ())
+        {
+          Scheduler::Event next = p->events->RemoveNext ();
+          scheduler->Insert (next);
+        }
+    }
+  p->events = scheduler;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::CreatePartition (uint32_t id)
+{
+  Partition *p = new Partition ();
+  p->sim = this;
+  p->id = id;
+  p->uid = 0;
+  p->currentUid = 0;
+  p->currentTs = 0;
+  p->currentContext = 0xffffffff;
+  p->unscheduledEvents = 0;
+  p->stop = false;
+  p->stopTs = NO_TS;
+  p->windowEnd = 0;
+  p->sendSlot = 0;
+  p->sentTs = NO_TS;
+  p->sense = 0;
+  return p;
+}
+
+MultithreadedSimulatorImpl::Partition *&
+MultithreadedSimulatorImpl::GetThreadPartition (void)
+{
+#ifdef HAVE_PTHREAD_H
+  static __thread Partition *partition = 0;
+#else
+  static Partition *partition = 0;
+#endif
+  return partition;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrent (void) const
+{
+  Partition *p = GetThreadPartition ();
+  return p != 0 ? p : m_partitions[0];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  return context < m_partitionOf.size () ? m_partitionOf[context] : 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  // the packets take the partition in the high bits of their uids, which
+  // keeps them apart across partitions
+  return GetCurrent ()->id;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return m_nPartitions;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNRounds (void) const
+{
+  return m_nRounds;
+}
+
+void
+MultithreadedSimulatorImpl::AssignPartitions (void)
+{
+  uint32_t nNodes = NodeList::GetNNodes ();
+  m_partitionOf.resize (nNodes);
+  m_nPartitions = 1;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<Node> node = NodeList::GetNode (i);
+      NS_ASSERT (node->GetId () == i);
+      m_partitionOf[i] = node->GetSystemId ();
+      m_nPartitions = std::max (m_nPartitions, node->GetSystemId () + 1);
+    }
+  for (uint32_t i = 1; i < m_nPartitions; i++)
+    {
+      Partition *p = CreatePartition (i);
+      p->events = m_schedulerFactory.Create<Scheduler> ();
+      m_partitions.push_back (p);
+    }
+  NS_LOG_INFO (nNodes << " nodes in " << m_nPartitions << " partitions");
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookAhead (void)
+{
+  m_lookAhead = NO_TS;
+  TypeId remote = TypeId::LookupByName ("ns3::PointToPointRemoteChannel");
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); i++)
+    {
+      Ptr<Node> node = *i;
+      uint32_t partition = GetPartition (node->GetId ());
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
+        {
+          Ptr<Channel> channel = node->GetDevice (j)->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          for (uint32_t k = 0; k < channel->GetNDevices (); k++)
+            {
+              Ptr<Node> peer = channel->GetDevice (k)->GetNode ();
+              if (GetPartition (peer->GetId ()) == partition)
+                {
+                  continue;
+                }
+              if (channel->GetInstanceTypeId () != remote)
+                {
+                  NS_FATAL_ERROR ("A " << channel->GetInstanceTypeId ().GetName () << " joins the nodes " <<
+                                  node->GetId () << " and " << peer->GetId () << " of different partitions");
+                }
+              TimeValue delay;
+              channel->GetAttribute ("Delay", delay);
+              if (!delay.Get ().IsStrictlyPositive ())
+                {
+                  NS_FATAL_ERROR ("The link between the nodes " << node->GetId () << " and " << peer->GetId () <<
+                                  " of different partitions has no delay");
+                }
+              m_lookAhead = std::min (m_lookAhead, (uint64_t) delay.Get ().GetTimeStep ());
+            }
+        }
+    }
+  NS_LOG_INFO ("lookahead " << m_lookAhead);
+}
+
+void
+MultithreadedSimulatorImpl::Insert (Partition *p, Scheduler::Event &ev)
+{
+  // the partitions take their uids in turn, so that an event keeps its uid
+  // when it moves to another one
+  ev.key.m_uid = p->uid;
+  p->uid += m_partitions.size ();
+  p->unscheduledEvents++;
+  p->events->Insert (ev);
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *p)
+{
+  Scheduler::Event next = p->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= p->currentTs);
+  p->unscheduledEvents--;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  p->currentTs = next.key.m_ts;
+  p->currentContext = next.key.m_context;
+  p->currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs (Partition *p) const
+{
+  if (p->events->IsEmpty ())
+    {
+      return NO_TS;
+    }
+  Scheduler::Event ev = p->events->PeekNext ();
+  return ev.key.m_ts;
+}
+
+void
+MultithreadedSimulatorImpl::Deliver (Partition *p, uint32_t slot)
+{
+  for (uint32_t i = 0; i < m_partitions.size (); i++)
+    {
+      Events &in = m_partitions[i]->outbox[slot][p->id];
+      for (Events::iterator j = in.begin (); j != in.end (); j++)
+        {
+          Insert (p, *j);
+        }
+      in.clear ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Publish (Partition *p, uint32_t slot)
+{
+  Report &report = p->report[slot];
+  report.nextTs = std::min (NextTs (p), p->sentTs);
+  report.stopTs = p->stopTs;
+  report.stop = p->stop;
+}
+
+void
+MultithreadedSimulatorImpl::Barrier (Partition *p)
+{
+  // a sense-reversing barrier: the last thread to reach it flips the sense
+  // the others wait on
+  p->sense = !p->sense;
+  if (__sync_add_and_fetch (&m_barrierCount, 1) == m_partitions.size ())
+    {
+      m_barrierCount = 0;
+      __sync_synchronize ();
+      m_barrierSense = p->sense;
+    }
+  else
+    {
+      uint32_t spins = 0;
+      while (m_barrierSense != p->sense)
+        {
+          spins++;
+          if (spins > BARRIER_SPINS)
+            {
+#ifdef HAVE_PTHREAD_H
+              sched_yield ();
+#endif
+            }
+        }
+      __sync_synchronize ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Partition::Run (void)
+{
+  sim->RunPartition (this);
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition (Partition *p)
+{
+  if (p->id != 0)
+    {
+      GetThreadPartition () = p;
+    }
+  // The events sent in a round are taken at the start of the next one,
+  // from the slot of the round, and the reports which tell its bounds come
+  // from the same slot. The barrier at the end of a round is the only one:
+  // a slot is written again two rounds later, once all the partitions are
+  // done reading it.
+  Publish (p, 0);
+  Barrier (p);
+  for (uint32_t round = 0; ; round++)
+    {
+      uint32_t slot = round & 1;
+      uint64_t lbts = NO_TS;
+      uint64_t stopTs = NO_TS;
+      bool stop = false;
+      for (uint32_t i = 0; i < m_partitions.size (); i++)
+        {
+          const Report &report = m_partitions[i]->report[slot];
+          lbts = std::min (lbts, report.nextTs);
+          stopTs = std::min (stopTs, report.stopTs);
+          stop = stop || report.stop;
+        }
+      Deliver (p, slot);
+      if (stop || lbts == NO_TS || lbts > stopTs)
+        {
+          break;
+        }
+      p->sendSlot = 1 - slot;
+      p->sentTs = NO_TS;
+      // a stop time set in any partition by the last round is known to all
+      // of them now, and every window ends with it; one set in this round
+      // ends the window of its own partition at once
+      p->stopTs = stopTs;
+      p->windowEnd = lbts > NO_TS - m_lookAhead ? NO_TS : lbts + m_lookAhead;
+      p->windowEnd = std::min (p->windowEnd, stopTs == NO_TS ? NO_TS : stopTs + 1);
+      while (!p->events->IsEmpty () && !p->stop)
+        {
+          uint64_t ts = NextTs (p);
+          if (ts >= p->windowEnd || ts > p->stopTs)
+            {
+              break;
+            }
+          ProcessOneEvent (p);
+        }
+      Publish (p, 1 - slot);
+      if (p->id == 0)
+        {
+          m_nRounds++;
+        }
+      Barrier (p);
+    }
+  if (p->id != 0)
+    {
+      GetThreadPartition () = 0;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_ASSERT (!m_running);
+  Partition *first = m_partitions[0];
+  AssignPartitions ();
+  CalculateLookAhead ();
+
+  uint32_t nPartitions = m_partitions.size ();
+  uint32_t uid = first->uid;
+  for (uint32_t i = 0; i < nPartitions; i++)
+    {
+      Partition *p = m_partitions[i];
+      p->uid = uid + i;
+      p->currentTs = first->currentTs;
+      p->currentUid = first->currentUid;
+      p->stop = false;
+      p->sentTs = NO_TS;
+      p->sense = 0;
+      p->outbox[0].resize (nPartitions);
+      p->outbox[1].resize (nPartitions);
+    }
+  // hand the events to their partitions
+  Events events;
+  while (!first->events->IsEmpty ())
+    {
+      events.push_back (first->events->RemoveNext ());
+    }
+  for (Events::iterator i = events.begin (); i != events.end (); i++)
+    {
+      Partition *p = m_partitions[GetPartition (i->key.m_context)];
+      p->events->Insert (*i);
+      first->unscheduledEvents--;
+      p->unscheduledEvents++;
+    }
+  m_barrierCount = 0;
+  m_barrierSense = 0;
+  m_nRounds = 0;
+  m_stop = false;
+  m_running = true;
+
+#ifdef HAVE_PTHREAD_H
+  if (nPartitions > 1)
+    {
+      Packet::SetConcurrent (true);
+    }
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < nPartitions; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&Partition::Run, m_partitions[i]));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+  RunPartition (first);
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Join ();
+    }
+  Packet::SetConcurrent (false);
+#else
+  if (nPartitions > 1)
+    {
+      NS_FATAL_ERROR ("MultithreadedSimulatorImpl needs threads to run " << nPartitions << " partitions");
+    }
+  RunPartition (first);
+#endif
+
+  m_running = false;
+  NS_LOG_INFO (m_nRounds << " rounds");
+
+  // take back the events left in the partitions, and end the run at the
+  // time of the stop, if any
+  uint64_t endTs = 0;
+  uint64_t stopTs = NO_TS;
+  Partition *stopped = 0;
+  for (uint32_t i = 0; i < nPartitions; i++)
+    {
+      Partition *p = m_partitions[i];
+      endTs = std::max (endTs, p->currentTs);
+      stopTs = std::min (stopTs, p->stopTs);
+      uid = std::max (uid, p->uid);
+      if (p->stop && (stopped == 0 || p->currentTs < stopped->currentTs))
+        {
+          stopped = p;
+        }
+    }
+  first->uid = uid;
+  first->currentUid = uid;
+  if (stopped != 0)
+    {
+      m_stop = true;
+      endTs = stopped->currentTs;
+      first->currentUid = stopped->currentUid;
+    }
+  else if (stopTs != NO_TS)
+    {
+      endTs = stopTs;
+      stopTs = NO_TS;
+    }
+  for (uint32_t i = 1; i < nPartitions; i++)
+    {
+      Partition *p = m_partitions[i];
+      while (!p->events->IsEmpty ())
+        {
+          first->events->Insert (p->events->RemoveNext ());
+        }
+      first->unscheduledEvents += p->unscheduledEvents;
+      delete p;
+    }
+  m_partitions.resize (1);
+  first->currentTs = endTs;
+  first->stopTs = stopTs;
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  NS_ASSERT (!first->events->IsEmpty () || first->unscheduledEvents == 0);
+}
+
+void
+MultithreadedSimulatorImpl::RunOneEvent (void)
+{
+  ProcessOneEvent (GetCurrent ());
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  return GetCurrent ()->events->IsEmpty () || m_stop;
+}
+
+Time
+MultithreadedSimulatorImpl::Next (void) const
+{
+  Partition *p = GetCurrent ();
+  NS_ASSERT (!p->events->IsEmpty ());
+  return TimeStep (NextTs (p));
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  GetCurrent ()->stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &time)
+{
+  Partition *p = GetCurrent ();
+  p->stopTs = std::min (p->stopTs, p->currentTs + time.GetTimeStep ());
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &time, EventImpl *event)
+{
+  Partition *p = GetCurrent ();
+  Time tAbsolute = time + TimeStep (p->currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (p->currentTs));
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_context = p->currentContext;
+  Insert (p, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event)
+{
+  Partition *p = GetCurrent ();
+  NS_LOG_FUNCTION (this << context << time.GetTimeStep () << p->currentTs << event);
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = p->currentTs + time.GetTimeStep ();
+  ev.key.m_context = context;
+  uint32_t partition = m_running ? GetPartition (context) : p->id;
+  if (partition == p->id)
+    {
+      Insert (p, ev);
+      return;
+    }
+  if (ev.key.m_ts < p->windowEnd)
+    {
+      NS_FATAL_ERROR ("Event for the node " << context << " at " << ev.key.m_ts <<
+                      " within the lookahead of its partition, at " << p->currentTs);
+    }
+  // its uid comes from the partition which takes it
+  p->outbox[p->sendSlot][partition].push_back (ev);
+  p->sentTs = std::min (p->sentTs, ev.key.m_ts);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  Partition *p = GetCurrent ();
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = p->currentTs;
+  ev.key.m_context = p->currentContext;
+  Insert (p, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  EventId id (Ptr<EventImpl> (event, false), GetCurrent ()->currentTs, 0xffffffff, 2);
+  DestroyLock lock (m_destroyLock);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  return TimeStep (GetCurrent ()->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrent ()->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      DestroyLock lock (m_destroyLock);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *p = GetCurrent ();
+  NS_ASSERT_MSG (!m_running || GetPartition (id.GetContext ()) == p->id,
+                 "Remove of an event of the partition " << GetPartition (id.GetContext ()) <<
+                 " from the partition " << p->id);
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  p->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  p->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &ev) const
+{
+  if (ev.GetUid () == 2)
+    {
+      if (ev.PeekEventImpl () == 0 ||
+          ev.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      DestroyLock lock (m_destroyLock);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == ev)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  Partition *p = GetCurrent ();
+  if (ev.PeekEventImpl () == 0 ||
+      ev.GetTs () < p->currentTs ||
+      (ev.GetTs () == p->currentTs &&
+       ev.GetUid () <= p->currentUid) ||
+      ev.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return GetCurrent ()->currentContext;
+}
+
+} // namespace ns3
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/ptr.h"
+
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief conservative parallel simulator on the threads of one host
+ *
+ * The nodes are split into partitions by their system id, as for the
+ * DistributedSimulatorImpl, and each partition runs its own events in a
+ * thread of its own: the partition 0 in the thread which calls Run, the
+ * others in threads started by Run. The partition of an event is the one
+ * of the node of its context; the events without the context of a node
+ * belong to the partition 0.
+ *
+ * Only point-to-point links may join nodes of different partitions, and
+ * the PointToPointHelper makes them PointToPointRemoteChannel ones when
+ * this simulator is selected; the smallest delay of these links is the
+ * lookahead. The partitions run in rounds: at the start of each, every
+ * partition computes the same lower bound on the timestamp of the next
+ * event anywhere, from what the others reported at the barrier which
+ * ended the last round, and then runs its events up to that bound plus
+ * the lookahead. The events a partition schedules for another one cannot
+ * be earlier than the end of the round; they are queued for it, one queue
+ * per pair of partitions, and inserted by it at the start of the next
+ * round, in the order of the partitions and then of their scheduling, so
+ * that a run is as repeatable as a sequential one. As only the barrier
+ * separates the writer and the reader of a queue, the queues need no lock
+ * and no atomic operation.
+ *
+ * The code of the models run in the partitions must not share any state
+ * across them, which holds for the nodes and their stacks but not for
+ * the trace sinks or the statistics shared by several nodes. Packets
+ * cross partitions serialized and so lose their tags.
+ *
+ * Some global state is shared all the same:
+ *  - the packets keep free lists, heuristics and a uid counter in global
+ *    variables: Run makes them leave the first two alone and take their
+ *    uids atomically while the partitions run (Packet::SetConcurrent);
+ *  - a random variable takes its RngStream from the package seed on its
+ *    first draw. The seed is locked, but the variables which first draw
+ *    in the partitions take their streams in the order in which the
+ *    threads get there, and so differ from run to run. To repeat a
+ *    sequential run, the variables used in the partitions must draw once
+ *    before Run, in the same order in both runs; the copies of a variable
+ *    which has drawn repeat its stream, so that each application must be
+ *    given a variable of its own;
+ *  - the wifi module keeps tables by WifiMode: the payload durations in
+ *    the InterferenceHelper and the offsets of the SensitivityModel60GHz.
+ *    They are filled when the phys are made and only read afterwards, and
+ *    so cover the modes made before the nodes;
+ *  - the Config paths, the global values, the logging and the trace
+ *    sources and sinks shared by several nodes are not protected at all,
+ *    and must not be changed while the partitions run.
+ *
+ * Stop (time) stops the partitions after they have run all the events up
+ * to this time, included; Stop () stops the run at the end of the round.
+ * A stop time set by an event reaches the other partitions at the end of
+ * the round, and then ends every window; so that they run no event past
+ * it, it must be at least the lookahead after the event, as for an event
+ * sent to them. A closer one lets them run up to the end of the round.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+  /**
+   * \returns true if the simulator in use is a MultithreadedSimulatorImpl
+   */
+  static bool IsEnabled (void);
+
+  MultithreadedSimulatorImpl ();
+  ~MultithreadedSimulatorImpl ();
+
+  // virtual from SimulatorImpl
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual Time Next (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &time);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual void RunOneEvent (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \returns the number of partitions of the last Run
+   */
+  uint32_t GetNPartitions (void) const;
+  /**
+   * \returns the number of rounds of the last Run
+   */
+  uint32_t GetNRounds (void) const;
+
+private:
+  typedef std::vector<Scheduler::Event> Events;
+  struct Report
+  {
+    // the timestamp of the next event of the partition, or of the earliest
+    // one it sent to the others
+    uint64_t nextTs;
+    uint64_t stopTs;
+    bool stop;
+  };
+  struct Partition
+  {
+    void Run (void);
+
+    MultithreadedSimulatorImpl *sim;
+    uint32_t id;
+    Ptr<Scheduler> events;
+    uint32_t uid;
+    uint32_t currentUid;
+    uint64_t currentTs;
+    uint32_t currentContext;
+    int unscheduledEvents;
+    bool stop;
+    uint64_t stopTs;
+    // the end of the current round, before which no event may be sent
+    uint64_t windowEnd;
+    // the events sent to each partition, for the next round and for the
+    // current one, which the partitions take in the current round
+    std::vector<Events> outbox[2];
+    uint32_t sendSlot;
+    uint64_t sentTs;
+    Report report[2];
+    uint32_t sense;
+  };
+  typedef std::list<EventId> DestroyEvents;
+
+  // the partition of the calling thread, zero outside the started threads
+  static Partition *&GetThreadPartition (void);
+
+  virtual void DoDispose (void);
+  Partition *CreatePartition (uint32_t id);
+  Partition *GetCurrent (void) const;
+  uint32_t GetPartition (uint32_t context) const;
+  void AssignPartitions (void);
+  void CalculateLookAhead (void);
+  void RunPartition (Partition *p);
+  void Deliver (Partition *p, uint32_t slot);
+  void Publish (Partition *p, uint32_t slot);
+  void Barrier (Partition *p);
+  void ProcessOneEvent (Partition *p);
+  void Insert (Partition *p, Scheduler::Event &ev);
+  uint64_t NextTs (Partition *p) const;
+
+  ObjectFactory m_schedulerFactory;
+  // the partition 0 holds all the events outside of Run
+  std::vector<Partition *> m_partitions;
+  // the partition of each node, by id
+  std::vector<uint32_t> m_partitionOf;
+  uint64_t m_lookAhead;
+  bool m_running;
+  bool m_stop;
+  uint32_t m_nPartitions;
+  uint32_t m_nRounds;
+  volatile uint32_t m_barrierCount;
+  volatile uint32_t m_barrierSense;
+  DestroyEvents m_destroyEvents;
+  mutable volatile int m_destroyLock;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
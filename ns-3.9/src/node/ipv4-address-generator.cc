@@ -255,6 +255,27 @@ Ipv4AddressGeneratorImpl::AddAllocated (const Ipv4Address address)
 
   NS_ABORT_MSG_UNLESS (addr, "Ipv4AddressGeneratorImpl::Add(): Allocating the broadcast address is not a good idea"); 
  
+//
+// Addresses are mostly allocated in increasing order, one network after the
+// other, so look at the last block first: an address above it is appended
+// without walking the whole list.
+//
+  if (!m_entries.empty () && addr > m_entries.back ().addrHigh)
+    {
+      if (addr == m_entries.back ().addrHigh + 1)
+        {
+          NS_LOG_LOGIC ("New addrHigh = " << Ipv4Address (addr));
+          m_entries.back ().addrHigh = addr;
+        }
+      else
+        {
+          Entry entry;
+          entry.addrLow = entry.addrHigh = addr;
+          m_entries.push_back (entry);
+        }
+      return true;
+    }
+
   std::list<Entry>::iterator i;
 
   for (i = m_entries.begin (); i != m_entries.end (); ++i)
@@ -149,6 +149,20 @@ Node::GetNApplications (void) const
 {
   return m_applications.size ();
 }
+void 
+Node::RemoveApplication (Ptr<Application> application)
+{
+  for (std::vector<Ptr<Application> >::iterator i = m_applications.begin ();
+       i != m_applications.end (); i++)
+    {
+      if (*i == application)
+        {
+          m_applications.erase (i);
+          return;
+        }
+    }
+  NS_ASSERT_MSG (false, "Application is not associated to node " << GetId ());
+}
 
 void 
 Node::DoDispose()
@@ -127,6 +127,14 @@ public:
    * \returns the number of applications associated to this Node.
    */
   uint32_t GetNApplications (void) const;
+  /**
+   * \param application an Application associated to this Node.
+   *
+   * Dissociates the Application from this Node, which lets go of it.
+   * The Application is neither stopped nor disposed of here, and the
+   * indices of the applications which follow it move down by one.
+   */
+  void RemoveApplication (Ptr<Application> application);
 
   /**
    * A protocol handler
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<DaryHeapScheduler> ()
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+{}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  // the removed events still in the heap are referenced by it
+  for (Heap::iterator i = m_heap.begin (); i != m_heap.end (); i++)
+    {
+      if (m_removed.find (i->key.m_uid) != m_removed.end ())
+        {
+          i->impl->Unref ();
+        }
+    }
+}
+
+void
+DaryHeapScheduler::SiftUp (uint32_t index)
+{
+  Event ev = m_heap[index];
+  while (index > 0)
+    {
+      uint32_t parent = (index - 1) / ARITY;
+      if (!(ev.key < m_heap[parent].key))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[parent];
+      index = parent;
+    }
+  m_heap[index] = ev;
+}
+
+void
+DaryHeapScheduler::SiftDown (uint32_t index)
+{
+  uint32_t size = m_heap.size ();
+  Event ev = m_heap[index];
+  while (true)
+    {
+      uint32_t first = index * ARITY + 1;
+      if (first >= size)
+        {
+          break;
+        }
+      uint32_t last = first + ARITY < size ? first + ARITY : size;
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; child++)
+        {
+          if (m_heap[child].key < m_heap[smallest].key)
+            {
+              smallest = child;
+            }
+        }
+      if (!(m_heap[smallest].key < ev.key))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[smallest];
+      index = smallest;
+    }
+  m_heap[index] = ev;
+}
+
+void
+DaryHeapScheduler::PopRoot (void)
+{
+  m_heap[0] = m_heap.back ();
+  m_heap.pop_back ();
+  if (!m_heap.empty ())
+    {
+      SiftDown (0);
+    }
+}
+
+void
+DaryHeapScheduler::DropRemoved (void)
+{
+  while (!m_removed.empty () && !m_heap.empty ())
+    {
+      std::set<uint32_t>::iterator i = m_removed.find (m_heap[0].key.m_uid);
+      if (i == m_removed.end ())
+        {
+          return;
+        }
+      NS_LOG_DEBUG ("drop removed event " << m_heap[0].key.m_uid);
+      m_removed.erase (i);
+      EventImpl *impl = m_heap[0].impl;
+      PopRoot ();
+      impl->Unref ();
+    }
+}
+
+void
+DaryHeapScheduler::Insert (const Event &ev)
+{
+  m_heap.push_back (ev);
+  SiftUp (m_heap.size () - 1);
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  return m_heap.empty ();
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  return m_heap[0];
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_ASSERT (!IsEmpty ());
+  Event next = m_heap[0];
+  PopRoot ();
+  DropRemoved ();
+  return next;
+}
+
+void
+DaryHeapScheduler::Remove (const Event &ev)
+{
+  NS_ASSERT (!IsEmpty ());
+  // The caller lets go of its reference to the event once removed; the
+  // heap keeps one until it drops the event.
+  ev.impl->Ref ();
+  m_removed.insert (ev.key.m_uid);
+  DropRemoved ();
+}
+
+} // namespace ns3
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+#include <set>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler
+ *
+ * The events are kept in an implicit heap of arity 4, in a single
+ * contiguous array of Scheduler::Event records (24 bytes each on 64 bit
+ * hosts): the children of the event at index i are at 4i+1 to 4i+4, so
+ * the four of them usually share one or two cache lines, and the heap is
+ * half as deep as a binary one. No memory is allocated per event, unlike
+ * the MapScheduler.
+ *
+ * Remove does not look for the event in the array: it only records the
+ * uid of the event and keeps a reference to it, and the event is dropped
+ * once it reaches the root. The root is never a removed event, so that
+ * PeekNext and IsEmpty need not skip any.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  DaryHeapScheduler ();
+  virtual ~DaryHeapScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  enum {
+    ARITY = 4
+  };
+  typedef std::vector<Event> Heap;
+
+  void SiftUp (uint32_t index);
+  void SiftDown (uint32_t index);
+  void PopRoot (void);
+  // drop the removed events at the root, until it is a live one
+  void DropRemoved (void);
+
+  Heap m_heap;
+  // the uids of the events removed but still in the heap
+  std::set<uint32_t> m_removed;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
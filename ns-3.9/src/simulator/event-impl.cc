@@ -19,9 +19,223 @@
  */
 
 #include "event-impl.h"
+#include "ns3/core-config.h"
+#include <new>
+
+// the free lists are per thread, which needs thread-local storage, and the
+// pools of the threads gone are taken over through a pthread key
+#if defined (__GNUC__) && defined (__linux__) && defined (HAVE_PTHREAD_H)
+#define EVENT_IMPL_POOL 1
+#include <pthread.h>
+#endif
 
 namespace ns3 {
 
+#ifdef EVENT_IMPL_POOL
+namespace {
+
+enum {
+  // the sizes of the classes are multiples of it, and so their alignment
+  POOL_GRANULE = 16,
+  // up to 256 bytes: five arguments and the object of a member function
+  POOL_CLASSES = 16,
+  POOL_CHUNK = 64 * 1024
+};
+
+struct Pool;
+
+// the first POOL_GRANULE bytes of every block, before the event
+struct BlockHeader
+{
+  Pool *owner;
+  uint32_t sizeClass;
+};
+
+struct FreeBlock
+{
+  FreeBlock *next;
+};
+
+struct Pool
+{
+  FreeBlock *free[POOL_CLASSES];
+  // the blocks freed by other threads: they push them one by one, the
+  // owner takes them all at once
+  FreeBlock * volatile returned;
+  // the memory of the last chunk not handed out yet
+  char *chunkNext;
+  char *chunkEnd;
+  EventImpl::PoolCounters counters;
+  // the next pool left by a thread gone
+  Pool *nextOrphan;
+};
+
+__thread Pool *g_pool;
+pthread_once_t g_poolKeyOnce = PTHREAD_ONCE_INIT;
+pthread_key_t g_poolKey;
+pthread_mutex_t g_orphansMutex = PTHREAD_MUTEX_INITIALIZER;
+Pool *g_orphans;
+
+BlockHeader *
+HeaderOf (FreeBlock *block)
+{
+  return reinterpret_cast<BlockHeader *> (reinterpret_cast<char *> (block) - POOL_GRANULE);
+}
+
+// called on the exit of a thread which has a pool
+void
+LeavePool (void *p)
+{
+  Pool *pool = static_cast<Pool *> (p);
+  g_pool = 0;
+  pthread_mutex_lock (&g_orphansMutex);
+  pool->nextOrphan = g_orphans;
+  g_orphans = pool;
+  pthread_mutex_unlock (&g_orphansMutex);
+}
+
+void
+CreatePoolKey (void)
+{
+  pthread_key_create (&g_poolKey, &LeavePool);
+}
+
+Pool *
+TakePool (void)
+{
+  pthread_once (&g_poolKeyOnce, &CreatePoolKey);
+  pthread_mutex_lock (&g_orphansMutex);
+  Pool *pool = g_orphans;
+  if (pool != 0)
+    {
+      g_orphans = pool->nextOrphan;
+    }
+  pthread_mutex_unlock (&g_orphansMutex);
+  if (pool == 0)
+    {
+      // never deleted: its blocks may outlive every thread
+      pool = new Pool ();
+    }
+  pthread_setspecific (g_poolKey, pool);
+  g_pool = pool;
+  return pool;
+}
+
+void
+TakeReturned (Pool &pool)
+{
+  FreeBlock *block = __sync_lock_test_and_set (&pool.returned, (FreeBlock *)0);
+  while (block != 0)
+    {
+      FreeBlock *next = block->next;
+      uint32_t sizeClass = HeaderOf (block)->sizeClass;
+      block->next = pool.free[sizeClass];
+      pool.free[sizeClass] = block;
+      pool.counters.returned++;
+      block = next;
+    }
+}
+
+void *
+AllocateFromChunk (Pool &pool, uint32_t sizeClass)
+{
+  size_t blockSize = (sizeClass + 2) * POOL_GRANULE;
+  if (pool.chunkNext + blockSize > pool.chunkEnd)
+    {
+      // the end of the last chunk, if any, is too small for the block and
+      // is lost
+      pool.chunkNext = static_cast<char *> (::operator new (POOL_CHUNK));
+      pool.chunkEnd = pool.chunkNext + POOL_CHUNK;
+      pool.counters.chunkBytes += POOL_CHUNK;
+    }
+  BlockHeader *header = reinterpret_cast<BlockHeader *> (pool.chunkNext);
+  header->owner = &pool;
+  header->sizeClass = sizeClass;
+  pool.chunkNext += blockSize;
+  return reinterpret_cast<char *> (header) + POOL_GRANULE;
+}
+
+} // anonymous namespace
+#endif /* EVENT_IMPL_POOL */
+
+void *
+EventImpl::operator new (size_t size)
+{
+#ifdef EVENT_IMPL_POOL
+  size_t sizeClass = (size + POOL_GRANULE - 1) / POOL_GRANULE - 1;
+  if (sizeClass < POOL_CLASSES)
+    {
+      Pool *pool = g_pool;
+      if (pool == 0)
+        {
+          pool = TakePool ();
+        }
+      pool->counters.allocations++;
+      FreeBlock *block = pool->free[sizeClass];
+      if (block == 0 && pool->returned != 0)
+        {
+          TakeReturned (*pool);
+          block = pool->free[sizeClass];
+        }
+      if (block != 0)
+        {
+          pool->free[sizeClass] = block->next;
+          pool->counters.recycled++;
+          return block;
+        }
+      return AllocateFromChunk (*pool, sizeClass);
+    }
+#endif /* EVENT_IMPL_POOL */
+  return ::operator new (size);
+}
+
+void
+EventImpl::operator delete (void *p, size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+#ifdef EVENT_IMPL_POOL
+  size_t sizeClass = (size + POOL_GRANULE - 1) / POOL_GRANULE - 1;
+  if (sizeClass < POOL_CLASSES)
+    {
+      FreeBlock *block = static_cast<FreeBlock *> (p);
+      Pool *owner = HeaderOf (block)->owner;
+      if (owner == g_pool)
+        {
+          block->next = owner->free[sizeClass];
+          owner->free[sizeClass] = block;
+          return;
+        }
+      // the owner takes the whole list at once, so pushing needs no
+      // protection from ABA
+      FreeBlock *head;
+      do
+        {
+          head = owner->returned;
+          block->next = head;
+        }
+      while (__sync_val_compare_and_swap (&owner->returned, head, block) != head);
+      return;
+    }
+#endif /* EVENT_IMPL_POOL */
+  ::operator delete (p);
+}
+
+EventImpl::PoolCounters
+EventImpl::GetPoolCounters (void)
+{
+#ifdef EVENT_IMPL_POOL
+  if (g_pool != 0)
+    {
+      return g_pool->counters;
+    }
+#endif /* EVENT_IMPL_POOL */
+  PoolCounters counters = {0, 0, 0, 0};
+  return counters;
+}
+
 EventImpl::~EventImpl ()
 {}
 
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "ns3/simple-ref-count.h"
 
 namespace ns3 {
@@ -39,6 +40,21 @@ namespace ns3 {
 class EventImpl : public SimpleRefCount<EventImpl>
 {
 public:
+  /**
+   * The counters of the event allocator of a thread.
+   */
+  struct PoolCounters
+  {
+    // the events allocated
+    uint64_t allocations;
+    // those of them which took the memory of an event gone
+    uint64_t recycled;
+    // the events freed by other threads and given back to this one
+    uint64_t returned;
+    // the memory taken from the system for events
+    uint64_t chunkBytes;
+  };
+
   EventImpl ();
   virtual ~EventImpl () = 0;
   /**
@@ -58,6 +74,26 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * The events are allocated by the thread which creates them, from free
+   * lists of a few classes of sizes, which grow by chunks of memory and
+   * never shrink: once a simulation has reached its steady state,
+   * scheduling and running an event calls neither malloc nor free.
+   *
+   * Every block records the pool it came from. An event deleted by
+   * another thread, as when a partition of a parallel simulator runs an
+   * event made by another, is handed back to that pool without a lock and
+   * reused by its owner. The pool of a thread which exits is kept, with
+   * the events it still has out, for the next thread which starts.
+   * The events larger than the largest class are left to malloc.
+   */
+  static void *operator new (size_t size);
+  static void operator delete (void *p, size_t size);
+  /**
+   * \returns the counters of the event allocator of the calling thread
+   */
+  static PoolCounters GetPoolCounters (void);
+
 protected:
   virtual void Notify (void) = 0;
 
@@ -0,0 +1,297 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+namespace {
+struct EventLess
+{
+  bool operator () (const Scheduler::Event &a, const Scheduler::Event &b) const
+  {
+    return a.key < b.key;
+  }
+};
+} // anonymous namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_topMin (0),
+    m_topMax (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0),
+    m_bottomHead (0)
+{}
+
+LadderScheduler::~LadderScheduler ()
+{}
+
+uint64_t
+LadderScheduler::GetCurrentTs (const Rung &rung)
+{
+  return rung.start + rung.current * rung.width;
+}
+
+void
+LadderScheduler::SpawnRung (const Bucket &events, uint64_t start, uint64_t end)
+{
+  NS_ASSERT (m_nRungs < MAX_RUNGS && !events.empty () && start < end);
+  uint64_t span = end - start;
+  uint64_t n = events.size ();
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+  rung.start = start;
+  rung.width = (span + n - 1) / n;
+  rung.current = 0;
+  rung.nBuckets = (span + rung.width - 1) / rung.width;
+  rung.count = events.size ();
+  // the buckets of a rung dropped earlier are empty, and keep their memory
+  if (rung.buckets.size () < rung.nBuckets)
+    {
+      rung.buckets.resize (rung.nBuckets);
+    }
+  NS_LOG_DEBUG ("rung " << m_nRungs - 1 << " from " << start << " of " << rung.nBuckets <<
+                " buckets of " << rung.width << " for " << n << " events");
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      rung.buckets[(i->key.m_ts - start) / rung.width].push_back (*i);
+    }
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_ASSERT (m_bottomHead == m_bottom.size ());
+  m_bottom.clear ();
+  m_bottomHead = 0;
+  while (true)
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+          SpawnRung (m_top, m_topMin, m_topMax + 1);
+          const Rung &first = m_rungs[0];
+          m_topStart = first.start + first.nBuckets * first.width;
+          m_top.clear ();
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      if (rung.count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      Bucket &bucket = rung.buckets[rung.current];
+      uint64_t start = GetCurrentTs (rung);
+      rung.current++;
+      rung.count -= bucket.size ();
+      if (bucket.size () > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          SpawnRung (bucket, start, start + rung.width);
+          bucket.clear ();
+          continue;
+        }
+      // hand over the memory of the bottom to the bucket
+      m_bottom.swap (bucket);
+      std::sort (m_bottom.begin (), m_bottom.end (), EventLess ());
+      if (rung.count == 0)
+        {
+          m_nRungs--;
+        }
+      return;
+    }
+}
+
+void
+LadderScheduler::InsertBottom (const Event &ev)
+{
+  Bucket::iterator end = m_bottom.end ();
+  Bucket::iterator i = std::lower_bound (m_bottom.begin () + m_bottomHead, end, ev, EventLess ());
+  if (i == end)
+    {
+      m_bottom.push_back (ev);
+    }
+  else if (i == m_bottom.begin () + m_bottomHead && m_bottomHead > 0)
+    {
+      m_bottomHead--;
+      m_bottom[m_bottomHead] = ev;
+    }
+  else
+    {
+      m_bottom.insert (i, ev);
+    }
+  if (m_bottom.size () - m_bottomHead <= THRESHOLD || m_nRungs == MAX_RUNGS
+      || m_bottom.back ().key.m_ts == m_bottom[m_bottomHead].key.m_ts)
+    {
+      return;
+    }
+  // too long to insert into: spread it over a new lowest rung
+  uint64_t endTs = m_nRungs > 0 ? GetCurrentTs (m_rungs[m_nRungs - 1]) : m_topStart;
+  Bucket events (m_bottom.begin () + m_bottomHead, m_bottom.end ());
+  SpawnRung (events, events.front ().key.m_ts, endTs);
+  m_bottomHead = m_bottom.size ();
+  Refill ();
+}
+
+void
+LadderScheduler::RemoveBottom (const Event &ev)
+{
+  Bucket::iterator i = std::lower_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (), ev, EventLess ());
+  NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+  m_bottom.erase (i);
+}
+
+void
+LadderScheduler::RemoveFrom (Bucket &bucket, const Event &ev)
+{
+  for (Bucket::iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          *i = bucket.back ();
+          bucket.pop_back ();
+          return;
+        }
+    }
+  NS_ASSERT_MSG (false, "event " << ev.key.m_uid << " not found");
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      m_top.push_back (ev);
+    }
+  else
+    {
+      uint32_t i;
+      for (i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= GetCurrentTs (rung))
+            {
+              rung.buckets[(ts - rung.start) / rung.width].push_back (ev);
+              rung.count++;
+              break;
+            }
+        }
+      if (i == m_nRungs)
+        {
+          InsertBottom (ev);
+        }
+    }
+  // the bottom is only ever empty if the others are too
+  if (m_bottomHead == m_bottom.size ())
+    {
+      Refill ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_bottomHead == m_bottom.size ();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_ASSERT (!IsEmpty ());
+  Event next = m_bottom[m_bottomHead];
+  m_bottomHead++;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      Refill ();
+    }
+  return next;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      // m_topMin and m_topMax may now be loose bounds, which is fine
+      RemoveFrom (m_top, ev);
+    }
+  else
+    {
+      uint32_t i;
+      for (i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= GetCurrentTs (rung))
+            {
+              RemoveFrom (rung.buckets[(ts - rung.start) / rung.width], ev);
+              rung.count--;
+              break;
+            }
+        }
+      if (i == m_nRungs)
+        {
+          RemoveBottom (ev);
+        }
+    }
+  if (m_bottomHead == m_bottom.size ())
+    {
+      Refill ();
+    }
+}
+
+} // namespace ns3
@@ -34,6 +34,7 @@
 #include <math.h>
 #include <fstream>
 #include <list>
+#include <map>
 #include <vector>
 #include <iostream>
 
@@ -384,8 +385,11 @@ Simulator::GetImplementation (void)
 #include "list-scheduler.h"
 #include "heap-scheduler.h"
 #include "map-scheduler.h"
+#include "dary-heap-scheduler.h"
 #include "calendar-scheduler.h"
 #include "ns2-calendar-scheduler.h"
+#include "ladder-scheduler.h"
+#include "ns3/system-thread.h"
 
 namespace ns3 {
 
@@ -532,6 +536,338 @@ SimulatorEventsTestCase::DoRun (void)
   return false;
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual bool DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+class SchedulerOrderTestEvent : public EventImpl
+{
+protected:
+  virtual void Notify (void) {}
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that events removed anywhere in the list are not returned by " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+bool
+SchedulerOrderTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  std::vector<Scheduler::Event> events;
+  uint32_t seed = 1;
+  for (uint32_t uid = 0; uid < 1000; uid++)
+    {
+      seed = seed * 1103515245 + 12345;
+      Scheduler::Event ev;
+      ev.impl = new SchedulerOrderTestEvent ();
+      // plenty of events at the same time, told apart by their uid
+      ev.key.m_ts = (seed >> 16) % 300;
+      ev.key.m_uid = uid;
+      ev.key.m_context = 0;
+      scheduler->Insert (ev);
+      events.push_back (ev);
+    }
+  // remove every third event, wherever it is, and the next one
+  uint32_t removed = 0;
+  for (uint32_t i = 0; i < events.size (); i += 3)
+    {
+      scheduler->Remove (events[i]);
+      events[i].impl->Unref ();
+      events[i].impl = 0;
+      removed++;
+    }
+  Scheduler::Event first = scheduler->PeekNext ();
+  for (uint32_t i = 0; i < events.size (); i++)
+    {
+      if (events[i].impl != 0 && events[i].key < first.key)
+        {
+          first = events[i];
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->PeekNext ().key.m_uid, first.key.m_uid, "Wrong next event");
+  scheduler->Remove (first);
+  first.impl->Unref ();
+  events[first.key.m_uid].impl = 0;
+  removed++;
+
+  Scheduler::EventKey last = {0, 0, 0};
+  uint32_t n = 0;
+  while (!scheduler->IsEmpty ())
+    {
+      Scheduler::Event next = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ ((n == 0 || last < next.key), true, "Events out of order");
+      NS_TEST_ASSERT_MSG_EQ (events[next.key.m_uid].impl, next.impl, "A removed event was returned");
+      last = next.key;
+      next.impl->Unref ();
+      n++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n + removed, events.size (), "Events were lost");
+  return GetErrorStatus ();
+}
+
+class SchedulerHoldTestCase : public TestCase
+{
+public:
+  SchedulerHoldTestCase (ObjectFactory schedulerFactory);
+  virtual bool DoRun (void);
+  uint64_t NextDelay (void);
+  ObjectFactory m_schedulerFactory;
+  uint32_t m_seed;
+};
+
+SchedulerHoldTestCase::SchedulerHoldTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that a bimodal mix of near and far events comes out in order of " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory),
+    m_seed (1)
+{}
+
+uint64_t
+SchedulerHoldTestCase::NextDelay (void)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  uint32_t r = m_seed >> 8;
+  // nine events in ten are a few ns to a few us away, like MAC timers,
+  // the others 100ms to 1s away, like transport timers
+  if (r % 10 != 0)
+    {
+      return (r >> 4) % 5000;
+    }
+  return 100000000 + (uint64_t)((r >> 4) % 900000) * 1000;
+}
+
+bool
+SchedulerHoldTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  std::map<uint32_t, Scheduler::Event> pending;
+  uint32_t uid = 0;
+  for (; uid < 1000; uid++)
+    {
+      Scheduler::Event ev;
+      ev.impl = new SchedulerOrderTestEvent ();
+      ev.key.m_ts = NextDelay ();
+      ev.key.m_uid = uid;
+      ev.key.m_context = 0;
+      scheduler->Insert (ev);
+      pending[uid] = ev;
+    }
+  Scheduler::EventKey last = {0, 0, 0};
+  for (uint32_t i = 0; i < 30000; i++)
+    {
+      Scheduler::Event next = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ ((i == 0 || last < next.key), true, "Events out of order");
+      NS_TEST_ASSERT_MSG_EQ (pending.erase (next.key.m_uid), 1, "A removed event was returned");
+      last = next.key;
+      next.impl->Unref ();
+
+      Scheduler::Event ev;
+      ev.impl = new SchedulerOrderTestEvent ();
+      ev.key.m_ts = last.m_ts + NextDelay ();
+      ev.key.m_uid = uid++;
+      ev.key.m_context = 0;
+      scheduler->Insert (ev);
+      pending[ev.key.m_uid] = ev;
+      if (i % 7 == 0)
+        {
+          // cancel some pending event, near or far
+          std::map<uint32_t, Scheduler::Event>::iterator j = pending.lower_bound (NextDelay () % uid);
+          if (j == pending.end ())
+            {
+              j = pending.begin ();
+            }
+          scheduler->Remove (j->second);
+          j->second.impl->Unref ();
+          pending.erase (j);
+          // and schedule a replacement
+          ev.impl = new SchedulerOrderTestEvent ();
+          ev.key.m_ts = last.m_ts + NextDelay ();
+          ev.key.m_uid = uid++;
+          scheduler->Insert (ev);
+          pending[ev.key.m_uid] = ev;
+        }
+    }
+  while (!scheduler->IsEmpty ())
+    {
+      Scheduler::Event next = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ ((last < next.key), true, "Events out of order");
+      NS_TEST_ASSERT_MSG_EQ (pending.erase (next.key.m_uid), 1, "A removed event was returned");
+      last = next.key;
+      next.impl->Unref ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (pending.size (), 0, "Events were lost");
+  return GetErrorStatus ();
+}
+
+class EventPoolTestCase : public TestCase
+{
+public:
+  EventPoolTestCase ();
+  virtual bool DoRun (void);
+  void Cb (uint32_t a, double b) {}
+};
+
+EventPoolTestCase::EventPoolTestCase ()
+  : TestCase ("Check that the memory of events gone is reused")
+{}
+
+bool
+EventPoolTestCase::DoRun (void)
+{
+  EventImpl::PoolCounters before = EventImpl::GetPoolCounters ();
+  EventImpl *first = MakeEvent (&EventPoolTestCase::Cb, this, 1, 2.0);
+  first->Unref ();
+  if (EventImpl::GetPoolCounters ().allocations == before.allocations)
+    {
+      // the events are left to malloc on this platform
+      return false;
+    }
+  EventImpl *second = MakeEvent (&EventPoolTestCase::Cb, this, 3, 4.0);
+  NS_TEST_EXPECT_MSG_EQ (second, first, "The memory of the first event was not reused");
+  second->Unref ();
+  EventImpl::PoolCounters after = EventImpl::GetPoolCounters ();
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 2, "Wrong number of allocations");
+  NS_TEST_EXPECT_MSG_EQ (after.recycled - before.recycled, 1, "Wrong number of events recycled");
+
+  // a simulation in a steady state takes no more memory
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventPoolTestCase::Cb, this, i, 0.0);
+    }
+  Simulator::Run ();
+  before = EventImpl::GetPoolCounters ();
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventPoolTestCase::Cb, this, i, 0.0);
+    }
+  Simulator::Run ();
+  after = EventImpl::GetPoolCounters ();
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 1000, "Wrong number of allocations");
+  NS_TEST_EXPECT_MSG_EQ (after.recycled - before.recycled, 1000, "Events were not recycled");
+  NS_TEST_EXPECT_MSG_EQ (after.chunkBytes, before.chunkBytes, "More memory was taken");
+  Simulator::Destroy ();
+  return GetErrorStatus ();
+}
+
+#ifdef HAVE_PTHREAD_H
+class EventThreadTestCase : public TestCase
+{
+public:
+  EventThreadTestCase ();
+  virtual bool DoRun (void);
+  void Make (void);
+  void Release (void);
+  void MakeAndCount (void);
+  void ReleaseAndMake (void);
+  void RunThread (void (EventThreadTestCase::*f) (void));
+  void Cb (uint32_t i) { m_sum += i; }
+  std::vector<EventImpl *> m_events;
+  EventImpl::PoolCounters m_counters;
+  uint64_t m_sum;
+};
+
+EventThreadTestCase::EventThreadTestCase ()
+  : TestCase ("Check that events can be made on one thread and freed on another"),
+    m_sum (0)
+{}
+
+void
+EventThreadTestCase::Make (void)
+{
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      m_events.push_back (MakeEvent (&EventThreadTestCase::Cb, this, i));
+    }
+}
+
+void
+EventThreadTestCase::Release (void)
+{
+  for (uint32_t i = 0; i < m_events.size (); i++)
+    {
+      m_events[i]->Invoke ();
+      m_events[i]->Unref ();
+    }
+  m_events.clear ();
+}
+
+void
+EventThreadTestCase::MakeAndCount (void)
+{
+  Make ();
+  m_counters = EventImpl::GetPoolCounters ();
+}
+
+void
+EventThreadTestCase::ReleaseAndMake (void)
+{
+  Release ();
+  Make ();
+  m_counters = EventImpl::GetPoolCounters ();
+}
+
+void
+EventThreadTestCase::RunThread (void (EventThreadTestCase::*f) (void))
+{
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (f, this));
+  thread->Start ();
+  thread->Join ();
+}
+
+bool
+EventThreadTestCase::DoRun (void)
+{
+  for (uint32_t round = 0; round < 10; round++)
+    {
+      // the partitions of a parallel simulator run each other's events
+      RunThread (&EventThreadTestCase::Make);
+      RunThread (&EventThreadTestCase::Release);
+      Make ();
+      RunThread (&EventThreadTestCase::Release);
+      RunThread (&EventThreadTestCase::Make);
+      Release ();
+    }
+
+  // the events freed by another thread go back to the pool they came from
+  Make ();
+  EventImpl::PoolCounters before = EventImpl::GetPoolCounters ();
+  RunThread (&EventThreadTestCase::Release);
+  Make ();
+  EventImpl::PoolCounters after = EventImpl::GetPoolCounters ();
+  Release ();
+  if (after.allocations != before.allocations)
+    {
+      NS_TEST_EXPECT_MSG_EQ (after.returned - before.returned, 10000, "The events were not given back");
+      NS_TEST_EXPECT_MSG_EQ (after.recycled - before.recycled, 10000, "The events given back were not reused");
+      NS_TEST_EXPECT_MSG_EQ (after.chunkBytes, before.chunkBytes, "More memory was taken");
+    }
+
+  // a thread which starts takes over the pool of the last one gone, with
+  // the events freed since
+  RunThread (&EventThreadTestCase::MakeAndCount);
+  before = m_counters;
+  RunThread (&EventThreadTestCase::ReleaseAndMake);
+  after = m_counters;
+  Release ();
+  if (before.allocations != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 10000, "The pool was not taken over");
+      NS_TEST_EXPECT_MSG_EQ (after.returned - before.returned, 10000, "The events were not given back");
+      NS_TEST_EXPECT_MSG_EQ (after.chunkBytes, before.chunkBytes, "More memory was taken");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m_sum, 34 * (uint64_t)(10000 * 9999 / 2), "Events were lost");
+  return GetErrorStatus ();
+}
+#endif /* HAVE_PTHREAD_H */
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -842,6 +1178,43 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory));
     factory.SetTypeId (Ns2CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory));
+
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (Ns2CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerOrderTestCase (factory));
+
+    AddTestCase (new EventPoolTestCase ());
+#ifdef HAVE_PTHREAD_H
+    AddTestCase (new EventThreadTestCase ());
+#endif /* HAVE_PTHREAD_H */
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerHoldTestCase (factory));
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerHoldTestCase (factory));
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerHoldTestCase (factory));
+    factory.SetTypeId (Ns2CalendarScheduler::GetTypeId ());
+    AddTestCase (new SchedulerHoldTestCase (factory));
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerHoldTestCase (factory));
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SchedulerHoldTestCase (factory));
   }
 } g_simulatorTestSuite;
 
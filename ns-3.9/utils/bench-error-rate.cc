@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measures the per-call cost of ErrorRateModel::GetChunkSuccessRate, the
+ * function InterferenceHelper evaluates for every SNIR chunk of every
+ * received frame.
+ */
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/error-rate-model.h"
+#include "ns3/sensitivity-model-60-ghz.h"
+#include "ns3/yans-error-rate-model.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+static double g_sink = 0;
+
+static void
+runBench (Ptr<ErrorRateModel> model, const std::vector<WifiMode> &modes,
+          uint32_t n, char const *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WifiMode mode = modes[i % modes.size ()];
+      /* sweep the SNR from -10 dB to 40 dB */
+      double snr = pow (10.0, (-10.0 + (i % 500) * 0.1) / 10.0);
+      sum += model->GetChunkSuccessRate (mode, snr, 8 * 1500);
+    }
+  uint64_t deltaMs = time.End ();
+  g_sink += sum;
+  double ns = deltaMs;
+  ns *= 1000000;
+  ns /= n;
+  std::cout << name << "=" << ns << " ns/call" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  while (argc > 0) {
+      if (strncmp ("--n=", argv[0],strlen ("--n=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--n=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> n;
+        }
+      argc--;
+      argv++;
+  }
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of calls must be specified " <<
+        "by command-line argument --n=(number of calls)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-error-rate with n=" << n << std::endl;
+
+  std::vector<WifiMode> vht;
+  vht.push_back (WifiPhy::GetVHTMCS0 ());
+  vht.push_back (WifiPhy::GetVHTMCS1 ());
+  vht.push_back (WifiPhy::GetVHTMCS4 ());
+  vht.push_back (WifiPhy::GetVHTMCS8 ());
+  vht.push_back (WifiPhy::GetVHTMCS12 ());
+  vht.push_back (WifiPhy::GetVHTMCS18 ());
+  vht.push_back (WifiPhy::GetVHTMCS13a ());
+  vht.push_back (WifiPhy::GetVHTMCS24a ());
+  vht.push_back (WifiPhy::GetVHTMCS21a ());
+  runBench (CreateObject<SensitivityModel60GHz> (), vht, n, "sensitivity-60ghz");
+
+  std::vector<WifiMode> ofdm;
+  ofdm.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  ofdm.push_back (WifiPhy::GetOfdmRate24Mbps ());
+  ofdm.push_back (WifiPhy::GetOfdmRate54Mbps ());
+  runBench (CreateObject<YansErrorRateModel> (), ofdm, n, "yans-ofdm");
+
+  return g_sink < 0;
+}
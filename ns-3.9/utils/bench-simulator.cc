@@ -24,6 +24,7 @@
 #include <fstream>
 #include <vector>
 #include <string.h>
+#include <sys/resource.h>
 
 using namespace ns3;
 
@@ -35,6 +36,7 @@ class Bench
 public:
   Bench ();
   void ReadDistribution (std::istream &istream);
+  void GenerateBimodal (uint32_t n);
   void SetTotal (uint32_t total);
   void RunBench (void);
 private:
@@ -76,6 +78,23 @@ Bench::ReadDistribution (std::istream &input)
     }
 }
 
+/* A data center mix: most events are MAC and PHY timers a few
+ * microseconds away, the others transport timers and application events
+ * a fraction of a second away.
+ */
+void
+Bench::GenerateBimodal (uint32_t n)
+{
+  UniformVariable which;
+  ExponentialVariable near (10e-6);
+  UniformVariable far (0.1, 1.0);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double data = which.GetValue () < 0.9 ? near.GetValue () : far.GetValue ();
+      m_distribution.push_back ((uint64_t) (data * 1000000000));
+    }
+}
+
 void
 Bench::RunBench (void) 
 {
@@ -105,6 +124,12 @@ Bench::RunBench (void)
       "simu " << ((double)m_n) / simu<< " hold/s, avg hold=" << 
       simu / ((double)m_n) << "s" << std::endl
       ;
+  EventImpl::PoolCounters counters = EventImpl::GetPoolCounters ();
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  std::cout <<
+      "events allocated=" << counters.allocations << ", recycled=" << counters.recycled <<
+      ", pool=" << counters.chunkBytes / 1024 << "KB, maxrss=" << usage.ru_maxrss << "KB" << std::endl;
 }
 
 void
@@ -131,11 +156,18 @@ void
 PrintHelp (void)
 {
   std::cout << "bench-simulator filename [options]"<<std::endl;
+  std::cout << "bench-simulator --bimodal=n [options]"<<std::endl;
   std::cout << "  filename: a string which identifies the input distribution. \"-\" represents stdin." << std::endl;
   std::cout << "  Options:"<<std::endl;
   std::cout << "      --list: use std::list scheduler"<<std::endl;
   std::cout << "      --map: use std::map cheduler"<<std::endl;
   std::cout << "      --heap: use Binary Heap scheduler"<<std::endl;
+  std::cout << "      --dary: use 4-ary Heap scheduler (the default)"<<std::endl;
+  std::cout << "      --calendar: use Calendar scheduler"<<std::endl;
+  std::cout << "      --ns2calendar: use ns-2 Calendar scheduler"<<std::endl;
+  std::cout << "      --ladder: use Ladder Queue scheduler"<<std::endl;
+  std::cout << "      --bimodal=n: instead of reading a distribution, draw n delays, 90% exponential"<<std::endl;
+  std::cout << "          with a mean of 10us and 10% uniform between 100ms and 1s"<<std::endl;
   std::cout << "      --debug: enable some debugging"<<std::endl;
 }
 
@@ -145,20 +177,22 @@ int main (int argc, char *argv[])
   std::istream *input;
   uint32_t n = 1;
   uint32_t total = 20000;
+  uint32_t bimodal = 0;
   if (argc == 1)
     {
       PrintHelp ();
       return 0;
     }
-  argc-=2;
-  argv+= 2;
-  if (strcmp (filename, "-") == 0) 
+  if (strncmp ("--", filename, 2) == 0)
     {
-      input = &std::cin;
-    } 
-  else 
+      filename = 0;
+      argc--;
+      argv++;
+    }
+  else
     {
-      input = new std::ifstream (filename);
+      argc-=2;
+      argv+= 2;
     }
   while (argc > 0) 
     {
@@ -175,14 +209,29 @@ int main (int argc, char *argv[])
         } 
       else if (strcmp ("--map", argv[0]) == 0) 
         {
-          factory.SetTypeId ("ns3::HeapScheduler");
+          factory.SetTypeId ("ns3::MapScheduler");
           Simulator::SetScheduler (factory);
         } 
+      else if (strcmp ("--dary", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::DaryHeapScheduler");
+          Simulator::SetScheduler (factory);
+        }
       else if (strcmp ("--calendar", argv[0]) == 0)
         {
           factory.SetTypeId ("ns3::CalendarScheduler");
           Simulator::SetScheduler (factory);
         }
+      else if (strcmp ("--ns2calendar", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::Ns2CalendarScheduler");
+          Simulator::SetScheduler (factory);
+        }
+      else if (strcmp ("--ladder", argv[0]) == 0)
+        {
+          factory.SetTypeId ("ns3::LadderScheduler");
+          Simulator::SetScheduler (factory);
+        }
       else if (strcmp ("--debug", argv[0]) == 0) 
         {
           g_debug = true;
@@ -195,12 +244,36 @@ int main (int argc, char *argv[])
         {
           n = atoi (argv[0]+strlen ("--n="));
         } 
+      else if (strncmp ("--bimodal=", argv[0], strlen("--bimodal=")) == 0)
+        {
+          bimodal = atoi (argv[0]+strlen ("--bimodal="));
+        }
 
       argc--;
       argv++;
   }
   Bench *bench = new Bench ();
-  bench->ReadDistribution (*input);
+  if (bimodal > 0)
+    {
+      bench->GenerateBimodal (bimodal);
+    }
+  else if (filename == 0)
+    {
+      PrintHelp ();
+      return 0;
+    }
+  else
+    {
+      if (strcmp (filename, "-") == 0)
+        {
+          input = &std::cin;
+        }
+      else
+        {
+          input = new std::ifstream (filename);
+        }
+      bench->ReadDistribution (*input);
+    }
   bench->SetTotal (total);
   for (uint32_t i = 0; i < n; i++)
     {